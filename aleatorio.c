@@ -0,0 +1,92 @@
+#include "trading_system.h"
+
+// Gerador de números aleatórios por thread (xoshiro256**)
+// Substitui rand(): a glibc protege o estado global do rand() com um lock,
+// então traders, executor, price updater e monitor disputavam o mesmo lock
+// a cada sorteio, e a sequência de cada thread dependia do escalonamento.
+// Aqui cada thread tem o próprio estado, derivado da semente mestre e do
+// número do fluxo (trader, executor, ...) via splitmix64: com a mesma semente
+// cada fluxo sorteia sempre a mesma sequência, sem lock nenhum.
+
+typedef struct {
+    unsigned long long s[4];
+    int iniciado;
+} EstadoAleatorio;
+
+static unsigned long long semente_mestre = SEMENTE_SIMULACAO_PADRAO;
+static unsigned int proximo_fluxo_automatico = FLUXO_ALEATORIO_AUTOMATICO;
+static __thread EstadoAleatorio estado_thread;
+
+// Função splitmix64 (espalha sementes próximas em estados independentes)
+static unsigned long long splitmix64(unsigned long long* x) {
+    unsigned long long z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static unsigned long long rotacionar(unsigned long long x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Função para definir a semente mestre e reiniciar o fluxo principal da thread chamadora
+// Deve ser chamada antes de criar as threads/processos que sorteiam
+void aleatorio_configurar_semente(unsigned long long semente) {
+    semente_mestre = semente;
+    aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_PRINCIPAL);
+}
+
+// Função para definir a semente mestre a partir de TRADING_SEED (ou do relógio)
+// Retorna a semente usada, para que a execução possa ser repetida
+unsigned long long aleatorio_configurar_semente_do_ambiente() {
+    const char* env_semente = getenv("TRADING_SEED");
+    unsigned long long semente;
+    if (env_semente) {
+        semente = strtoull(env_semente, NULL, 10);
+    } else {
+        semente = (unsigned long long)time(NULL);
+    }
+    aleatorio_configurar_semente(semente);
+    return semente;
+}
+
+// Função para obter a semente mestre
+unsigned long long aleatorio_obter_semente() {
+    return semente_mestre;
+}
+
+// Função para iniciar o fluxo da thread atual (semente mestre + número do fluxo)
+void aleatorio_iniciar_fluxo(unsigned int fluxo) {
+    unsigned long long x = semente_mestre;
+    unsigned long long deslocamento = fluxo;
+    x ^= splitmix64(&deslocamento);
+    for (int i = 0; i < 4; i++) {
+        estado_thread.s[i] = splitmix64(&x);
+    }
+    estado_thread.iniciado = 1;
+}
+
+// Função para verificar se a thread atual já tem fluxo próprio
+int aleatorio_fluxo_iniciado() {
+    return estado_thread.iniciado;
+}
+
+// Função para sortear um inteiro em [0, ALEATORIO_MAX] (substitui rand())
+int aleatorio_proximo() {
+    EstadoAleatorio* estado = &estado_thread;
+    if (!estado->iniciado) {
+        aleatorio_iniciar_fluxo(__atomic_fetch_add(&proximo_fluxo_automatico, 1, __ATOMIC_RELAXED));
+    }
+
+    unsigned long long* s = estado->s;
+    unsigned long long resultado = rotacionar(s[1] * 5, 7) * 9;
+    unsigned long long t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotacionar(s[3], 45);
+
+    return (int)(resultado >> 33); // 31 bits mais altos (os de melhor qualidade)
+}
@@ -15,12 +15,15 @@ typedef struct {
     time_t timestamp;
     int executada;
     double lucro_realizado;
+    int par_id;          // Par em pares_relacionadas (e no motor de z-score)
+    int sinal;           // SINAL_PAR_* que abriu a oportunidade
 } OportunidadeArbitragem;
 
 // Estrutura para estatísticas de arbitragem
 typedef struct {
     int total_oportunidades_detectadas;
     int total_arbitragens_executadas;
+    int total_sinais_saida;
     double lucro_total_potencial;
     double lucro_total_realizado;
     double maior_spread_detectado;
@@ -57,12 +60,39 @@ static ParAcoesRelacionadas pares_relacionadas[] = {
     {-1, -1, NULL, 0.0, 0.0} // Terminador
 };
 
+// Z-score do spread de cada par relacionado (índice p do motor = par p)
+// A oportunidade abre quando o z-score cruza ±ZSCORE_ENTRADA_PADRAO, não
+// mais quando a diferença entre os níveis de preço passa de 2%
+static MotorPares motor_detector;
+
+// Detecção por evento de preço
+// Quem muda um preço marca a ação como alterada e acorda o detector, que
+// reavalia só os pares que envolvem as ações marcadas (antes a thread
+// dormia 3 s e reavaliava todos os pares). Pares e ações em máscaras de bits.
+#define INTERVALO_RELATORIO_DETECTOR_MS 3000 // Relatórios no ritmo dos antigos ciclos
+
+typedef char verificar_mascara_acoes_detector[(MAX_ACOES <= 32) ? 1 : -1];
+
+static unsigned int pares_da_acao[MAX_ACOES];       // Bit p: pares_relacionadas[p] envolve a ação
+static unsigned int acoes_alteradas = 0;            // Bit i: preço da ação i mudou
+static long long instante_alteracao_ns[MAX_ACOES];  // Primeira mudança ainda não avaliada
+static int detector_escutando = 0;
+static EventoNotificacao evento_precos_detector;
+static pthread_mutex_t mutex_alteracoes = PTHREAD_MUTEX_INITIALIZER;
+
+static long long tempo_monotonico_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
 // Função para inicializar estatísticas de arbitragem
 void inicializar_estatisticas_arbitragem() {
-    printf("=== INICIALIZANDO DETECTOR DE ARBITRAGEM ===\n");
+    LOG_INFO("=== INICIALIZANDO DETECTOR DE ARBITRAGEM ===\n");
     
     estatisticas_arbitragem.total_oportunidades_detectadas = 0;
     estatisticas_arbitragem.total_arbitragens_executadas = 0;
+    estatisticas_arbitragem.total_sinais_saida = 0;
     estatisticas_arbitragem.lucro_total_potencial = 0.0;
     estatisticas_arbitragem.lucro_total_realizado = 0.0;
     estatisticas_arbitragem.maior_spread_detectado = 0.0;
@@ -73,13 +103,28 @@ void inicializar_estatisticas_arbitragem() {
     }
     
     pthread_mutex_init(&estatisticas_arbitragem.mutex, NULL);
+    registrar_pares_relacionados_monitor();
+    
+    motor_pares_inicializar(&motor_detector, ZSCORE_ENTRADA_PADRAO, ZSCORE_SAIDA_PADRAO);
+    for (int i = 0; pares_relacionadas[i].acao1_id != -1; i++) {
+        motor_pares_adicionar(&motor_detector, pares_relacionadas[i].acao1_id, pares_relacionadas[i].acao2_id);
+    }
     
-    printf("✓ Estatísticas de arbitragem inicializadas\n");
-    printf("✓ Critério de spread mínimo: 2%%\n");
-    printf("✓ Monitoramento de %ld pares de ações relacionadas\n", 
+    LOG_INFO("✓ Estatísticas de arbitragem inicializadas\n");
+    LOG_INFO("✓ Critério: |z-score do spread| acima de %.1f (saída abaixo de %.1f, janela de %d ticks)\n",
+             ZSCORE_ENTRADA_PADRAO, ZSCORE_SAIDA_PADRAO, JANELA_PARES_ZSCORE);
+    LOG_INFO("✓ Monitoramento de %ld pares de ações relacionadas\n", 
            sizeof(pares_relacionadas) / sizeof(ParAcoesRelacionadas) - 1);
 }
 
+// Função para registrar os pares relacionados no monitor de arbitragem
+// (além dos pares de mesmo setor que ele já acompanha)
+void registrar_pares_relacionados_monitor() {
+    for (int i = 0; pares_relacionadas[i].acao1_id != -1; i++) {
+        registrar_par_monitorado(pares_relacionadas[i].acao1_id, pares_relacionadas[i].acao2_id);
+    }
+}
+
 // Função para calcular spread entre duas ações
 double calcular_spread(double preco1, double preco2) {
     if (preco1 <= 0 || preco2 <= 0) return 0.0;
@@ -88,111 +133,190 @@ double calcular_spread(double preco1, double preco2) {
     return spread;
 }
 
-// Função para determinar qual ação comprar e qual vender
-int determinar_acao_compra_venda(double preco1, double preco2, int acao1_id, int acao2_id, 
-                                int* acao_compra, int* acao_venda, double* preco_compra, double* preco_venda) {
-    if (preco1 < preco2) {
-        *acao_compra = acao1_id;
-        *acao_venda = acao2_id;
-        *preco_compra = preco1;
-        *preco_venda = preco2;
-        return 1;
-    } else {
-        *acao_compra = acao2_id;
-        *acao_venda = acao1_id;
-        *preco_compra = preco2;
-        *preco_venda = preco1;
-        return 1;
-    }
-}
-
 // Função para calcular lucro potencial
 double calcular_lucro_potencial(double preco_compra, double preco_venda, int volume) {
     return (preco_venda - preco_compra) * volume;
 }
 
-// Função para detectar oportunidades de arbitragem
-void detectar_oportunidades_arbitragem(TradingSystem* sistema) {
-    for (int i = 0; pares_relacionadas[i].acao1_id != -1; i++) {
-        ParAcoesRelacionadas* par = &pares_relacionadas[i];
+// Função para avaliar um par relacionado: o tick entra no z-score do par e,
+// se o z-score cruzou o limiar de entrada, registra a oportunidade
+static void avaliar_par(TradingSystem* sistema, int par_id) {
+    ParAcoesRelacionadas* par = &pares_relacionadas[par_id];
+    preco_t preco1_fixo = ler_preco_atual(&sistema->acoes[par->acao1_id]);
+    preco_t preco2_fixo = ler_preco_atual(&sistema->acoes[par->acao2_id]);
+    
+    SinalPar sinal;
+    if (!motor_pares_atualizar(&motor_detector, par_id, preco1_fixo, preco2_fixo, &sinal)) {
+        return;
+    }
+    
+    if (sinal.tipo == SINAL_PAR_NEUTRO) {
+        pthread_mutex_lock(&estatisticas_arbitragem.mutex);
+        estatisticas_arbitragem.total_sinais_saida++;
+        pthread_mutex_unlock(&estatisticas_arbitragem.mutex);
+        LOG_DEBUG("↩️  Spread %s/%s voltou à média (z = %.2f)\n",
+                  sistema->acoes[par->acao1_id].nome, sistema->acoes[par->acao2_id].nome, sinal.zscore);
+        return;
+    }
+    
+    double preco1 = PRECO_EM_REAIS(preco1_fixo);
+    double preco2 = PRECO_EM_REAIS(preco2_fixo);
+    
+    // Spread acima da média: ação 1 cara em relação à 2
+    int acao_compra, acao_venda;
+    double preco_compra, preco_venda;
+    if (sinal.tipo == SINAL_PAR_VENDER_SPREAD) {
+        acao_compra = par->acao2_id;
+        acao_venda = par->acao1_id;
+        preco_compra = preco2;
+        preco_venda = preco1;
+    } else {
+        acao_compra = par->acao1_id;
+        acao_venda = par->acao2_id;
+        preco_compra = preco1;
+        preco_venda = preco2;
+    }
+    
+    // Desvio do spread em relação à média (log, ~ fração do preço)
+    double spread = fabs(sinal.spread);
+    int volume_disponivel = 1000; // Volume padrão para arbitragem
+    
+    // Lucro potencial: o desvio se desfazer na perna comprada
+    double lucro_potencial = spread * preco_compra * volume_disponivel;
+    
+    // Criar oportunidade
+    if (num_oportunidades < MAX_OPORTUNIDADES) {
+        OportunidadeArbitragem* op = &oportunidades[num_oportunidades];
+        op->acao_compra_id = acao_compra;
+        op->acao_venda_id = acao_venda;
+        op->preco_compra = preco_compra;
+        op->preco_venda = preco_venda;
+        op->spread_percentual = spread * 100.0;
+        op->lucro_potencial = lucro_potencial;
+        op->volume_disponivel = volume_disponivel;
+        op->timestamp = relogio_mercado();
+        op->executada = 0;
+        op->lucro_realizado = 0.0;
+        op->par_id = par_id;
+        op->sinal = sinal.tipo;
         
-        // Obter preços das ações
-        double preco1 = sistema->acoes[par->acao1_id].preco_atual;
-        double preco2 = sistema->acoes[par->acao2_id].preco_atual;
+        num_oportunidades++;
         
-        // Calcular spread
-        double spread = calcular_spread(preco1, preco2);
+        // Atualizar estatísticas
+        pthread_mutex_lock(&estatisticas_arbitragem.mutex);
+        estatisticas_arbitragem.total_oportunidades_detectadas++;
+        estatisticas_arbitragem.lucro_total_potencial += lucro_potencial;
         
-        // Verificar se spread é maior que o mínimo
-        if (spread > par->spread_minimo) {
-            int acao_compra, acao_venda;
-            double preco_compra, preco_venda;
-            
-            if (determinar_acao_compra_venda(preco1, preco2, par->acao1_id, par->acao2_id,
-                                           &acao_compra, &acao_venda, &preco_compra, &preco_venda)) {
-                
-                // Calcular volume disponível (mínimo entre as duas ações)
-                int volume_disponivel = 1000; // Volume padrão para arbitragem
-                
-                // Calcular lucro potencial
-                double lucro_potencial = calcular_lucro_potencial(preco_compra, preco_venda, volume_disponivel);
-                
-                // Criar oportunidade
-                if (num_oportunidades < MAX_OPORTUNIDADES) {
-                    OportunidadeArbitragem* op = &oportunidades[num_oportunidades];
-                    op->acao_compra_id = acao_compra;
-                    op->acao_venda_id = acao_venda;
-                    op->preco_compra = preco_compra;
-                    op->preco_venda = preco_venda;
-                    op->spread_percentual = spread * 100.0;
-                    op->lucro_potencial = lucro_potencial;
-                    op->volume_disponivel = volume_disponivel;
-                    op->timestamp = time(NULL);
-                    op->executada = 0;
-                    op->lucro_realizado = 0.0;
-                    
-                    num_oportunidades++;
-                    
-                    // Atualizar estatísticas
-                    pthread_mutex_lock(&estatisticas_arbitragem.mutex);
-                    estatisticas_arbitragem.total_oportunidades_detectadas++;
-                    estatisticas_arbitragem.lucro_total_potencial += lucro_potencial;
-                    
-                    if (spread > estatisticas_arbitragem.maior_spread_detectado) {
-                        estatisticas_arbitragem.maior_spread_detectado = spread;
-                    }
-                    
-                    // Contar por setor
-                    for (int j = 0; j < 10; j++) {
-                        if (strcmp(par->setor, sistema->acoes[acao_compra].setor) == 0) {
-                            estatisticas_arbitragem.oportunidades_por_setor[j]++;
-                            break;
-                        }
-                    }
-                    pthread_mutex_unlock(&estatisticas_arbitragem.mutex);
-                    
-                    printf("🚀 OPORTUNIDADE DE ARBITRAGEM DETECTADA!\n");
-                    printf("   Compra: %s a R$ %.2f\n", sistema->acoes[acao_compra].nome, preco_compra);
-                    printf("   Venda: %s a R$ %.2f\n", sistema->acoes[acao_venda].nome, preco_venda);
-                    printf("   Spread: %.2f%%\n", spread * 100.0);
-                    printf("   Lucro potencial: R$ %.2f\n", lucro_potencial);
-                    printf("   Volume: %d ações\n", volume_disponivel);
-                }
+        if (spread > estatisticas_arbitragem.maior_spread_detectado) {
+            estatisticas_arbitragem.maior_spread_detectado = spread;
+        }
+        
+        // Contar por setor
+        for (int j = 0; j < 10; j++) {
+            if (strcmp(par->setor, sistema->acoes[acao_compra].setor) == 0) {
+                estatisticas_arbitragem.oportunidades_por_setor[j]++;
+                break;
             }
         }
+        pthread_mutex_unlock(&estatisticas_arbitragem.mutex);
+        
+        LOG_INFO("🚀 OPORTUNIDADE DE ARBITRAGEM DETECTADA!\n"
+                 "   Compra: %s a R$ %.2f\n"
+                 "   Venda: %s a R$ %.2f\n"
+                 "   Z-score: %.2f (hedge ratio %.2f)\n"
+                 "   Desvio do spread: %.2f%%\n"
+                 "   Lucro potencial: R$ %.2f\n"
+                 "   Volume: %d ações\n",
+                 sistema->acoes[acao_compra].nome, preco_compra,
+                 sistema->acoes[acao_venda].nome, preco_venda,
+                 sinal.zscore, sinal.hedge,
+                 spread * 100.0, lucro_potencial, volume_disponivel);
     }
 }
 
+// Função para detectar oportunidades de arbitragem (varredura de todos os pares)
+void detectar_oportunidades_arbitragem(TradingSystem* sistema) {
+    for (int i = 0; pares_relacionadas[i].acao1_id != -1; i++) {
+        avaliar_par(sistema, i);
+    }
+}
+
+// Função para indexar os pares relacionados por ação
+static void indexar_pares_por_acao() {
+    memset(pares_da_acao, 0, sizeof(pares_da_acao));
+    for (int p = 0; p < 32 && pares_relacionadas[p].acao1_id != -1; p++) {
+        pares_da_acao[pares_relacionadas[p].acao1_id] |= 1u << p;
+        pares_da_acao[pares_relacionadas[p].acao2_id] |= 1u << p;
+    }
+}
+
+// Função para sinalizar ao detector que o preço da ação mudou
+// Sem a thread do detector (simulação, processos) não faz nada
+void sinalizar_preco_arbitragem(int acao_id) {
+    if (!__atomic_load_n(&detector_escutando, __ATOMIC_ACQUIRE) || acao_id < 0 || acao_id >= MAX_ACOES) {
+        return;
+    }
+
+    unsigned int bit = 1u << acao_id;
+    pthread_mutex_lock(&mutex_alteracoes);
+    if (!(acoes_alteradas & bit)) {
+        acoes_alteradas |= bit;
+        instante_alteracao_ns[acao_id] = tempo_monotonico_ns();
+    }
+    pthread_mutex_unlock(&mutex_alteracoes);
+
+    evento_notificar(&evento_precos_detector);
+}
+
+// Função para reavaliar os pares das ações sinalizadas desde a última chamada
+// Registra a latência da mudança de preço até a avaliação do par
+// Retorna o número de pares avaliados
+int detectar_oportunidades_alteradas(TradingSystem* sistema) {
+    long long instantes[MAX_ACOES];
+    pthread_mutex_lock(&mutex_alteracoes);
+    unsigned int acoes = acoes_alteradas;
+    acoes_alteradas = 0;
+    memcpy(instantes, instante_alteracao_ns, sizeof(instantes));
+    pthread_mutex_unlock(&mutex_alteracoes);
+
+    if (acoes == 0) {
+        return 0;
+    }
+
+    unsigned int pares = 0;
+    for (int i = 0; i < MAX_ACOES; i++) {
+        if (acoes & (1u << i)) {
+            pares |= pares_da_acao[i];
+        }
+    }
+
+    int avaliados = 0;
+    for (int p = 0; p < 32 && pares_relacionadas[p].acao1_id != -1; p++) {
+        if (pares & (1u << p)) {
+            avaliar_par(sistema, p);
+            avaliados++;
+        }
+    }
+
+    long long agora = tempo_monotonico_ns();
+    for (int i = 0; i < MAX_ACOES; i++) {
+        if (acoes & (1u << i)) {
+            registrar_latencia_preco_deteccao((agora - instantes[i]) / 1e6);
+        }
+    }
+    return avaliados;
+}
+
 // Função para executar arbitragem
 void executar_arbitragem_detector(TradingSystem* sistema, void* oportunidade_void) {
     OportunidadeArbitragem* oportunidade = (OportunidadeArbitragem*)oportunidade_void;
-    printf("💰 EXECUTANDO ARBITRAGEM!\n");
-    printf("   Comprando %d ações de %s a R$ %.2f\n", 
+    LOG_INFO("💰 EXECUTANDO ARBITRAGEM!\n");
+    LOG_INFO("   Comprando %d ações de %s a R$ %.2f\n", 
            oportunidade->volume_disponivel, 
            sistema->acoes[oportunidade->acao_compra_id].nome, 
            oportunidade->preco_compra);
     
-    printf("   Vendendo %d ações de %s a R$ %.2f\n", 
+    LOG_INFO("   Vendendo %d ações de %s a R$ %.2f\n", 
            oportunidade->volume_disponivel, 
            sistema->acoes[oportunidade->acao_venda_id].nome, 
            oportunidade->preco_venda);
@@ -205,8 +329,18 @@ void executar_arbitragem_detector(TradingSystem* sistema, void* oportunidade_voi
     double novo_preco_compra = oportunidade->preco_compra * 1.001; // Pequeno aumento
     double novo_preco_venda = oportunidade->preco_venda * 0.999;   // Pequena diminuição
     
-    sistema->acoes[oportunidade->acao_compra_id].preco_atual = novo_preco_compra;
-    sistema->acoes[oportunidade->acao_venda_id].preco_atual = novo_preco_venda;
+    Acao* acao_compra = &sistema->acoes[oportunidade->acao_compra_id];
+    Acao* acao_venda = &sistema->acoes[oportunidade->acao_venda_id];
+    preco_t antigo_compra = acao_compra->preco_atual;
+    preco_t antigo_venda = acao_venda->preco_atual;
+    publicar_preco_acao(acao_compra, PRECO_DE_REAIS(novo_preco_compra), acao_compra->preco_anterior, acao_compra->variacao);
+    publicar_preco_acao(acao_venda, PRECO_DE_REAIS(novo_preco_venda), acao_venda->preco_anterior, acao_venda->variacao);
+    historico_ticks_registrar(acao_compra, oportunidade->acao_compra_id, antigo_compra,
+                              acao_compra->preco_atual, MOTIVO_TICK_ARBITRAGEM);
+    historico_ticks_registrar(acao_venda, oportunidade->acao_venda_id, antigo_venda,
+                              acao_venda->preco_atual, MOTIVO_TICK_ARBITRAGEM);
+    barras_registrar_preco(oportunidade->acao_compra_id, acao_compra->preco_atual);
+    barras_registrar_preco(oportunidade->acao_venda_id, acao_venda->preco_atual);
     
     // Calcular lucro realizado (considerando custos de transação)
     double custos_transacao = oportunidade->lucro_potencial * 0.001; // 0.1% de custos
@@ -227,9 +361,10 @@ void executar_arbitragem_detector(TradingSystem* sistema, void* oportunidade_voi
     }
     pthread_mutex_unlock(&estatisticas_arbitragem.mutex);
     
-    printf("   ✅ Arbitragem executada com sucesso!\n");
-    printf("   Lucro realizado: R$ %.2f (após custos)\n", oportunidade->lucro_realizado);
-    printf("   Novos preços: %.2f / %.2f\n", novo_preco_compra, novo_preco_venda);
+    LOG_INFO("   ✅ Arbitragem executada com sucesso!\n"
+             "   Lucro realizado: R$ %.2f (após custos)\n"
+             "   Novos preços: %.2f / %.2f\n",
+             oportunidade->lucro_realizado, novo_preco_compra, novo_preco_venda);
 }
 
 // Função para processar oportunidades pendentes
@@ -238,17 +373,13 @@ void processar_oportunidades_pendentes(TradingSystem* sistema) {
         OportunidadeArbitragem* op = &oportunidades[i];
         
         if (!op->executada) {
-            // Verificar se ainda é uma oportunidade válida
-            double preco_compra_atual = sistema->acoes[op->acao_compra_id].preco_atual;
-            double preco_venda_atual = sistema->acoes[op->acao_venda_id].preco_atual;
-            double spread_atual = calcular_spread(preco_compra_atual, preco_venda_atual);
-            
-            // Se spread ainda é atrativo, executar
-            if (spread_atual > 0.02) { // 2% mínimo
+            // Ainda válida enquanto o par não saiu da posição do sinal
+            const ParZscore* par = &motor_detector.pares[op->par_id];
+            if (par->posicao == op->sinal) {
                 executar_arbitragem_detector(sistema, op);
             } else {
-                printf("⚠️  Oportunidade %d expirou (spread atual: %.2f%%)\n", 
-                       i, spread_atual * 100.0);
+                LOG_DEBUG("⚠️  Oportunidade %d expirou (z-score atual: %.2f)\n", 
+                       i, par->zscore);
                 op->executada = 1; // Marcar como expirada
             }
         }
@@ -262,6 +393,7 @@ void exibir_estatisticas_arbitragem() {
     printf("\n=== ESTATÍSTICAS DE ARBITRAGEM ===\n");
     printf("Total de oportunidades detectadas: %d\n", estatisticas_arbitragem.total_oportunidades_detectadas);
     printf("Total de arbitragens executadas: %d\n", estatisticas_arbitragem.total_arbitragens_executadas);
+    printf("Sinais de saída (spread de volta à média): %d\n", estatisticas_arbitragem.total_sinais_saida);
     printf("Taxa de execução: %.1f%%\n", 
            estatisticas_arbitragem.total_oportunidades_detectadas > 0 ? 
            (double)estatisticas_arbitragem.total_arbitragens_executadas / 
@@ -312,41 +444,56 @@ void exibir_oportunidades_ativas() {
 // Função principal da thread de arbitragem
 void* thread_arbitragem_detector(void* arg) {
     TradingSystem* sistema = (TradingSystem*)arg;
+    aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_DETECTOR);
     
-    printf("🚀 THREAD DETECTOR DE ARBITRAGEM INICIADA\n");
-    printf("Monitorando %ld pares de ações relacionadas...\n", 
+    LOG_INFO("🚀 THREAD DETECTOR DE ARBITRAGEM INICIADA\n");
+    LOG_INFO("Monitorando %ld pares de ações relacionadas...\n", 
            sizeof(pares_relacionadas) / sizeof(ParAcoesRelacionadas) - 1);
     
-    // Inicializar estatísticas
+    // Inicializar estatísticas e passar a receber os sinais de preço
     inicializar_estatisticas_arbitragem();
+    indexar_pares_por_acao();
+    evento_inicializar(&evento_precos_detector);
+    __atomic_store_n(&detector_escutando, 1, __ATOMIC_RELEASE);
+    
+    // Varredura completa inicial: preços publicados antes dos sinais
+    detectar_oportunidades_arbitragem(sistema);
+    processar_oportunidades_pendentes(sistema);
     
     int ciclo = 0;
+    long long proximo_relatorio = tempo_monotonico_ns() + INTERVALO_RELATORIO_DETECTOR_MS * 1000000LL;
     while (arbitragem_ativa && sistema->sistema_ativo) {
-        ciclo++;
-        
-        printf("\n--- CICLO DE ARBITRAGEM %d ---\n", ciclo);
-        
-        // Detectar novas oportunidades
-        detectar_oportunidades_arbitragem(sistema);
-        
-        // Processar oportunidades pendentes
-        processar_oportunidades_pendentes(sistema);
+        unsigned int observado = evento_observar(&evento_precos_detector);
         
-        // Exibir estatísticas a cada 5 ciclos
-        if (ciclo % 5 == 0) {
-            exibir_estatisticas_arbitragem();
+        // Reavaliar os pares das ações com preço novo
+        if (detectar_oportunidades_alteradas(sistema) > 0) {
+            processar_oportunidades_pendentes(sistema);
         }
         
-        // Exibir oportunidades ativas a cada 3 ciclos
-        if (ciclo % 3 == 0) {
-            exibir_oportunidades_ativas();
+        long long agora = tempo_monotonico_ns();
+        if (agora >= proximo_relatorio) {
+            ciclo++;
+            LOG_DEBUG("\n--- CICLO DE ARBITRAGEM %d ---\n", ciclo);
+            
+            // Exibir estatísticas a cada 5 ciclos
+            if (ciclo % 5 == 0) {
+                exibir_estatisticas_arbitragem();
+            }
+            
+            // Exibir oportunidades ativas a cada 3 ciclos
+            if (ciclo % 3 == 0) {
+                exibir_oportunidades_ativas();
+            }
+            proximo_relatorio = agora + INTERVALO_RELATORIO_DETECTOR_MS * 1000000LL;
         }
         
-        // Aguardar antes do próximo ciclo
-        sleep(3); // 3 segundos entre ciclos
+        // Aguardar o próximo sinal de preço ou o próximo relatório
+        evento_aguardar(&evento_precos_detector, observado,
+                        (int)((proximo_relatorio - agora) / 1000000LL) + 1);
     }
     
-    printf("✅ THREAD DETECTOR DE ARBITRAGEM FINALIZADA\n");
+    __atomic_store_n(&detector_escutando, 0, __ATOMIC_RELEASE);
+    LOG_INFO("✅ THREAD DETECTOR DE ARBITRAGEM FINALIZADA\n");
     
     // Exibir estatísticas finais
     exibir_estatisticas_arbitragem();
@@ -361,18 +508,19 @@ int criar_thread_arbitragem_detector(TradingSystem* sistema) {
     int resultado = pthread_create(&thread_arbitragem, NULL, thread_arbitragem_detector, sistema);
     
     if (resultado != 0) {
-        printf("❌ Erro ao criar thread detector de arbitragem: %s\n", strerror(resultado));
+        LOG_ERRO("❌ Erro ao criar thread detector de arbitragem: %s\n", strerror(resultado));
         return 0;
     }
     
-    printf("✅ Thread detector de arbitragem criada com sucesso\n");
+    LOG_INFO("✅ Thread detector de arbitragem criada com sucesso\n");
     return 1;
 }
 
 // Função para parar detector de arbitragem
 void parar_detector_arbitragem() {
     arbitragem_ativa = 0;
-    printf("🛑 Sinal de parada enviado para detector de arbitragem\n");
+    evento_notificar_todos(&evento_precos_detector);
+    LOG_INFO("🛑 Sinal de parada enviado para detector de arbitragem\n");
 }
 
 // Função para obter estatísticas de arbitragem
@@ -28,31 +28,103 @@ static AlertaMercado alertas[MAX_ALERTAS];
 static int num_oportunidades = 0;
 static int num_alertas = 0;
 
+// Pares monitorados: ações do mesmo setor e pares relacionados registrados
+// (os do detector de arbitragem), indexados por ação
+#define MAX_PARES_CONFIGURADOS 64
+
+static IndicePares indice_monitor;
+static int indice_monitor_pronto = 0;
+static ParAcoes pares_configurados[MAX_PARES_CONFIGURADOS];
+static int num_pares_configurados = 0;
+static pthread_mutex_t mutex_indice_monitor = PTHREAD_MUTEX_INITIALIZER;
+
+// Função para registrar um par relacionado a monitorar além dos do setor
+// O índice é reconstruído na próxima rodada do monitor
+void registrar_par_monitorado(int acao1_id, int acao2_id) {
+    pthread_mutex_lock(&mutex_indice_monitor);
+    for (int i = 0; i < num_pares_configurados; i++) {
+        ParAcoes* par = &pares_configurados[i];
+        if ((par->acao1 == acao1_id && par->acao2 == acao2_id) ||
+            (par->acao1 == acao2_id && par->acao2 == acao1_id)) {
+            pthread_mutex_unlock(&mutex_indice_monitor);
+            return;
+        }
+    }
+    if (num_pares_configurados < MAX_PARES_CONFIGURADOS) {
+        pares_configurados[num_pares_configurados].acao1 = acao1_id;
+        pares_configurados[num_pares_configurados].acao2 = acao2_id;
+        num_pares_configurados++;
+        indice_monitor_pronto = 0;
+    }
+    pthread_mutex_unlock(&mutex_indice_monitor);
+}
+
+// Função para (re)construir o índice: um grupo por setor (chamador segura o mutex)
+static void construir_indice_monitor(TradingSystem* sistema) {
+    int grupos[MAX_ACOES];
+    for (int i = 0; i < sistema->num_acoes; i++) {
+        grupos[i] = i;
+        for (int j = 0; j < i; j++) {
+            if (strcmp(sistema->acoes[i].setor, sistema->acoes[j].setor) == 0) {
+                grupos[i] = grupos[j];
+                break;
+            }
+        }
+    }
+
+    if (indice_monitor.pares) {
+        indice_pares_liberar(&indice_monitor);
+    }
+    indice_monitor_pronto = indice_pares_construir(&indice_monitor, sistema->num_acoes, grupos,
+                                                   pares_configurados, num_pares_configurados);
+    if (indice_monitor_pronto) {
+        LOG_DEBUG("Monitor de arbitragem: %d pares indexados (de %d possíveis)\n",
+                  indice_monitor.num_pares, sistema->num_acoes * (sistema->num_acoes - 1) / 2);
+    }
+}
+
+// Função para avaliar a diferença de preço de um par
+static void avaliar_par_monitor(const preco_t* precos, const ParAcoes* par) {
+    preco_t preco1 = precos[par->acao1];
+    preco_t preco2 = precos[par->acao2];
+    
+    double diferenca = PRECO_EM_REAIS(llabs(preco1 - preco2));
+    double media = PRECO_EM_REAIS(preco1 + preco2) / 2.0;
+    double percentual_diferenca = diferenca / media;
+    
+    // Se diferença é maior que 2%, é uma oportunidade
+    if (percentual_diferenca > 0.02) {
+        registrar_oportunidade_arbitragem(par->acao1, par->acao2, diferenca, percentual_diferenca);
+    }
+}
+
 void monitorar_arbitragem(TradingSystem* sistema) {
     // Limpar oportunidades antigas (mais de 60 segundos)
-    time_t agora = time(NULL);
+    time_t agora = relogio_mercado();
     for (int i = 0; i < num_oportunidades; i++) {
         if (agora - oportunidades[i].timestamp > 60) {
             oportunidades[i].ativa = 0;
         }
     }
     
-    // Procurar novas oportunidades
-    for (int i = 0; i < sistema->num_acoes - 1; i++) {
-        for (int j = i + 1; j < sistema->num_acoes; j++) {
-            Acao* acao1 = &sistema->acoes[i];
-            Acao* acao2 = &sistema->acoes[j];
-            
-            double diferenca = fabs(acao1->preco_atual - acao2->preco_atual);
-            double media = (acao1->preco_atual + acao2->preco_atual) / 2.0;
-            double percentual_diferenca = diferenca / media;
-            
-            // Se diferença é maior que 2%, é uma oportunidade
-            if (percentual_diferenca > 0.02) {
-                registrar_oportunidade_arbitragem(i, j, diferenca, percentual_diferenca);
-            }
+    // Procurar novas oportunidades só nos pares das ações com preço novo
+    preco_t precos[MAX_ACOES];
+    for (int i = 0; i < sistema->num_acoes; i++) {
+        precos[i] = ler_preco_atual(&sistema->acoes[i]);
+    }
+    
+    pthread_mutex_lock(&mutex_indice_monitor);
+    if (!indice_monitor_pronto) {
+        construir_indice_monitor(sistema);
+    }
+    if (indice_monitor_pronto) {
+        const int* pares;
+        int num_pares = indice_pares_alterados(&indice_monitor, precos, &pares);
+        for (int k = 0; k < num_pares; k++) {
+            avaliar_par_monitor(precos, &indice_monitor.pares[pares[k]]);
         }
     }
+    pthread_mutex_unlock(&mutex_indice_monitor);
     
     // Verificar outras condições de mercado
     detectar_arbitragem(sistema);
@@ -62,12 +134,13 @@ void monitorar_arbitragem(TradingSystem* sistema) {
 void detectar_arbitragem(TradingSystem* sistema) {
     // Detectar arbitragem entre diferentes ações do mesmo setor
     for (int i = 0; i < sistema->num_acoes; i++) {
-        Acao* acao = &sistema->acoes[i];
+        InstantaneoPreco instantaneo;
+        ler_preco_acao(&sistema->acoes[i], &instantaneo);
         
         // Verificar se preço está muito acima da média histórica
-        double preco_atual = acao->preco_atual;
-        double preco_anterior = acao->preco_anterior;
-        double variacao = acao->variacao;
+        double preco_atual = PRECO_EM_REAIS(instantaneo.preco_atual);
+        double preco_anterior = PRECO_EM_REAIS(instantaneo.preco_anterior);
+        double variacao = instantaneo.variacao;
         
         // Alerta para variações extremas
         if (fabs(variacao) > 0.10) { // Variação maior que 10%
@@ -106,12 +179,12 @@ void registrar_oportunidade_arbitragem(int acao1_id, int acao2_id, double difere
     nova->acao2_id = acao2_id;
     nova->diferenca_preco = diferenca;
     nova->percentual_diferenca = percentual;
-    nova->timestamp = time(NULL);
+    nova->timestamp = relogio_mercado();
     nova->ativa = 1;
     
     num_oportunidades++;
     
-    printf("OPORTUNIDADE DE ARBITRAGEM: Ações %d e %d com diferença de %.2f%%\n", 
+    LOG_INFO("OPORTUNIDADE DE ARBITRAGEM: Ações %d e %d com diferença de %.2f%%\n", 
            acao1_id, acao2_id, percentual * 100);
 }
 
@@ -130,8 +203,10 @@ void verificar_condicoes_mercado(TradingSystem* sistema) {
     
     // Verificar número de ordens pendentes
     int ordens_pendentes = 0;
-    for (int i = 0; i < sistema->num_ordens; i++) {
-        if (sistema->ordens[i].status == 0) {
+    int limite = pool_ordens_limite(&sistema->ordens);
+    for (int i = 0; i < limite; i++) {
+        Ordem* ordem = pool_ordens_slot(&sistema->ordens, i);
+        if (ordem && ordem->status == 0) {
             ordens_pendentes++;
         }
     }
@@ -145,10 +220,10 @@ void verificar_condicoes_mercado(TradingSystem* sistema) {
     // Verificar saldo dos traders
     for (int i = 0; i < sistema->num_traders; i++) {
         Trader* trader = &sistema->traders[i];
-        if (trader->saldo < 1000) {
+        if (trader->saldo < 1000 * ESCALA_PRECO) {
             criar_alerta("SALDO BAIXO", 
                         "Trader com saldo muito baixo", 
-                        trader->saldo, 2);
+                        PRECO_EM_REAIS(trader->saldo), 2);
         }
     }
 }
@@ -166,7 +241,7 @@ void criar_alerta(const char* tipo, const char* descricao, double valor, int pri
     strcpy(novo->tipo, tipo);
     strcpy(novo->descricao, descricao);
     novo->valor = valor;
-    novo->timestamp = time(NULL);
+    novo->timestamp = relogio_mercado();
     novo->prioridade = prioridade;
     
     num_alertas++;
@@ -179,7 +254,7 @@ void criar_alerta(const char* tipo, const char* descricao, double valor, int pri
         default: strcpy(prioridade_str, "DESCONHECIDA"); break;
     }
     
-    printf("ALERTA [%s]: %s - %.2f\n", prioridade_str, descricao, valor);
+    LOG_INFO("ALERTA [%s]: %s - %.2f\n", prioridade_str, descricao, valor);
 }
 
 void imprimir_oportunidades_arbitragem() {
@@ -204,7 +279,7 @@ void imprimir_oportunidades_arbitragem() {
 
 void imprimir_alertas() {
     printf("\n=== ALERTAS DE MERCADO ===\n");
-    time_t agora = time(NULL);
+    time_t agora = relogio_mercado();
     
     for (int i = 0; i < num_alertas; i++) {
         AlertaMercado* alerta = &alertas[i];
@@ -245,9 +320,10 @@ void calcular_estatisticas_arbitragem(TradingSystem* sistema) {
     
     // Encontrar ação mais volátil
     for (int i = 0; i < sistema->num_acoes; i++) {
-        Acao* acao = &sistema->acoes[i];
-        if (fabs(acao->variacao) > maior_volatilidade) {
-            maior_volatilidade = fabs(acao->variacao);
+        InstantaneoPreco instantaneo;
+        ler_preco_acao(&sistema->acoes[i], &instantaneo);
+        if (fabs(instantaneo.variacao) > maior_volatilidade) {
+            maior_volatilidade = fabs(instantaneo.variacao);
             acao_mais_volatil = i;
         }
     }
@@ -263,15 +339,15 @@ void calcular_estatisticas_arbitragem(TradingSystem* sistema) {
 
 // Função para simular eventos de mercado que afetam arbitragem
 void simular_evento_mercado(TradingSystem* sistema) {
-    int tipo_evento = rand() % 4;
+    int tipo_evento = aleatorio_proximo() % 4;
     
     switch (tipo_evento) {
         case 0: // Notícia positiva
             {
-                int acao = rand() % sistema->num_acoes;
-                double impacto = (rand() % 100 + 50) / 1000.0; // +5% a +15%
+                int acao = aleatorio_proximo() % sistema->num_acoes;
+                double impacto = (aleatorio_proximo() % 100 + 50) / 1000.0; // +5% a +15%
                 
-                printf("EVENTO: Notícia positiva para %s (+%.2f%%)\n", 
+                LOG_INFO("EVENTO: Notícia positiva para %s (+%.2f%%)\n", 
                        sistema->acoes[acao].nome, impacto * 100);
                 
                 // Atualizar preço (usar função do price_updater.c)
@@ -281,13 +357,13 @@ void simular_evento_mercado(TradingSystem* sistema) {
             
         case 1: // Notícia negativa
             {
-                int acao = rand() % sistema->num_acoes;
-                double impacto = -(rand() % 100 + 50) / 1000.0; // -5% a -15%
-                double novo_preco = sistema->acoes[acao].preco_atual * (1.0 + impacto);
+                int acao = aleatorio_proximo() % sistema->num_acoes;
+                double impacto = -(aleatorio_proximo() % 100 + 50) / 1000.0; // -5% a -15%
+                double novo_preco = PRECO_EM_REAIS(sistema->acoes[acao].preco_atual) * (1.0 + impacto);
                 
                 if (novo_preco < 1.0) novo_preco = 1.0;
                 
-                printf("EVENTO: Notícia negativa para %s (%.2f%%)\n", 
+                LOG_INFO("EVENTO: Notícia negativa para %s (%.2f%%)\n", 
                        sistema->acoes[acao].nome, impacto * 100);
                 
                 // Atualizar preço (usar função do price_updater.c)
@@ -296,14 +372,14 @@ void simular_evento_mercado(TradingSystem* sistema) {
             break;
             
         case 2: // Alta volatilidade
-            printf("EVENTO: Período de alta volatilidade no mercado\n");
+            LOG_INFO("EVENTO: Período de alta volatilidade no mercado\n");
             criar_alerta("ALTA VOLATILIDADE", 
                         "Período de alta volatilidade detectado", 
                         0.0, 3);
             break;
             
         case 3: // Baixa liquidez
-            printf("EVENTO: Período de baixa liquidez no mercado\n");
+            LOG_INFO("EVENTO: Período de baixa liquidez no mercado\n");
             criar_alerta("BAIXA LIQUIDEZ", 
                         "Período de baixa liquidez detectado", 
                         0.0, 2);
@@ -315,26 +391,28 @@ void simular_evento_mercado(TradingSystem* sistema) {
 void verificar_arbitragem_estatistica(TradingSystem* sistema) {
     for (int i = 0; i < sistema->num_acoes; i++) {
         Acao* acao = &sistema->acoes[i];
+        InstantaneoPreco instantaneo;
+        ler_preco_acao(acao, &instantaneo);
         
         // Verificar se preço está muito desviado da média
-        double preco_atual = acao->preco_atual;
-        double preco_anterior = acao->preco_anterior;
-        double variacao = acao->variacao;
+        double preco_atual = PRECO_EM_REAIS(instantaneo.preco_atual);
+        double preco_anterior = PRECO_EM_REAIS(instantaneo.preco_anterior);
+        double variacao = instantaneo.variacao;
         
         // Se variação é muito alta, pode ser uma oportunidade
         if (fabs(variacao) > 0.05) {
-            printf("OPORTUNIDADE ESTATÍSTICA: %s com variação de %.2f%%\n", 
+            LOG_INFO("OPORTUNIDADE ESTATÍSTICA: %s com variação de %.2f%%\n", 
                    acao->nome, variacao * 100);
         }
         
         // Verificar se preço está muito baixo comparado ao histórico
         if (preco_atual < preco_anterior * 0.90) {
-            printf("OPORTUNIDADE DE COMPRA: %s com preço muito baixo\n", acao->nome);
+            LOG_INFO("OPORTUNIDADE DE COMPRA: %s com preço muito baixo\n", acao->nome);
         }
         
         // Verificar se preço está muito alto comparado ao histórico
         if (preco_atual > preco_anterior * 1.10) {
-            printf("OPORTUNIDADE DE VENDA: %s com preço muito alto\n", acao->nome);
+            LOG_INFO("OPORTUNIDADE DE VENDA: %s com preço muito alto\n", acao->nome);
         }
     }
 } 
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "trading_system.h"
+
+// Barras OHLCV incrementais
+// Os preços só ficavam como último preço, variação e a janela de 100 valores
+// das estatísticas; quem quisesse barras por intervalo teria de varrer o
+// histórico de ticks. Aqui cada mudança de preço (execução, variação,
+// notícia, arbitragem, abertura, replay) e cada negócio liquidado atualiza a
+// barra corrente dos três períodos da ação: abertura no primeiro evento,
+// máxima e mínima por comparação, fechamento no último, volume e contagens
+// somados. Barras fechadas não mudam mais e ficam no anel até serem
+// sobrescritas.
+// As barras são do processo: na versão processos cada processo só vê os
+// eventos que ele mesmo gera (preços no price updater, negócios no executor).
+
+static const long long DURACOES_PERIODOS_NS[NUM_PERIODOS_BARRAS] = {
+    1000000000LL, 60 * 1000000000LL, 300 * 1000000000LL
+};
+static const char* NOMES_PERIODOS[NUM_PERIODOS_BARRAS] = { "1s", "1min", "5min" };
+
+// Barras do sistema, um mutex por ação (price updater e executores
+// registram ao mesmo tempo em ações diferentes)
+static SerieBarras series_sistema[MAX_ACOES][NUM_PERIODOS_BARRAS];
+static pthread_mutex_t mutexes_series[MAX_ACOES];
+static pthread_once_t series_inicializadas = PTHREAD_ONCE_INIT;
+
+// Função para preparar uma série vazia de barras do período dado
+void serie_barras_inicializar(SerieBarras* serie, long long periodo_ns) {
+    serie->periodo_ns = periodo_ns;
+    serie->total = 0;
+}
+
+// Função para registrar um evento na série
+// quantidade > 0: negócio (entra no volume); 0: mudança de preço.
+// Um evento com instante anterior ao da barra corrente (threads que chegam
+// fora de ordem) entra na barra corrente: barras fechadas não são reabertas.
+void serie_barras_registrar(SerieBarras* serie, long long instante_ns, preco_t preco, int quantidade) {
+    long long inicio = instante_ns - instante_ns % serie->periodo_ns;
+    BarraOHLCV* barra = serie->total > 0 ? &serie->barras[(serie->total - 1) % BARRAS_RETIDAS] : NULL;
+
+    if (!barra || inicio > barra->inicio_ns) {
+        barra = &serie->barras[serie->total % BARRAS_RETIDAS];
+        serie->total++;
+        barra->inicio_ns = inicio;
+        barra->abertura = preco;
+        barra->maxima = preco;
+        barra->minima = preco;
+        barra->volume = 0;
+        barra->negocios = 0;
+        barra->atualizacoes = 0;
+    }
+
+    if (preco > barra->maxima) barra->maxima = preco;
+    if (preco < barra->minima) barra->minima = preco;
+    barra->fechamento = preco;
+    if (quantidade > 0) {
+        barra->volume += quantidade;
+        barra->negocios++;
+    } else {
+        barra->atualizacoes++;
+    }
+}
+
+// Função para obter o número de barras guardadas (até BARRAS_RETIDAS)
+int serie_barras_quantidade(const SerieBarras* serie) {
+    return serie->total < BARRAS_RETIDAS ? (int)serie->total : BARRAS_RETIDAS;
+}
+
+// Função para copiar uma barra: atras = 0 é a corrente (ainda aberta),
+// 1 a anterior, e assim por diante
+// Retorna 1 se a barra ainda está guardada
+int serie_barras_obter(const SerieBarras* serie, int atras, BarraOHLCV* barra) {
+    if (atras < 0 || atras >= serie_barras_quantidade(serie)) {
+        return 0;
+    }
+    *barra = serie->barras[(serie->total - 1 - atras) % BARRAS_RETIDAS];
+    return 1;
+}
+
+static void inicializar_series_sistema() {
+    for (int i = 0; i < MAX_ACOES; i++) {
+        pthread_mutex_init(&mutexes_series[i], NULL);
+        for (int p = 0; p < NUM_PERIODOS_BARRAS; p++) {
+            serie_barras_inicializar(&series_sistema[i][p], DURACOES_PERIODOS_NS[p]);
+        }
+    }
+}
+
+static void registrar_evento(int acao_id, preco_t preco, int quantidade) {
+    if (acao_id < 0 || acao_id >= MAX_ACOES || preco <= 0) {
+        return;
+    }
+    pthread_once(&series_inicializadas, inicializar_series_sistema);
+
+    long long instante = relogio_mercado_ns();
+    pthread_mutex_lock(&mutexes_series[acao_id]);
+    for (int p = 0; p < NUM_PERIODOS_BARRAS; p++) {
+        serie_barras_registrar(&series_sistema[acao_id][p], instante, preco, quantidade);
+    }
+    pthread_mutex_unlock(&mutexes_series[acao_id]);
+}
+
+// Função para registrar uma mudança de preço nas barras da ação
+void barras_registrar_preco(int acao_id, preco_t preco) {
+    registrar_evento(acao_id, preco, 0);
+}
+
+// Função para registrar um negócio liquidado nas barras da ação
+void barras_registrar_negocio(int acao_id, preco_t preco, int quantidade) {
+    if (quantidade > 0) {
+        registrar_evento(acao_id, preco, quantidade);
+    }
+}
+
+// Função para consultar uma barra da ação (atras = 0: barra corrente)
+// Retorna 1 se a barra existe
+int barras_obter(int acao_id, int periodo, int atras, BarraOHLCV* barra) {
+    if (acao_id < 0 || acao_id >= MAX_ACOES || periodo < 0 || periodo >= NUM_PERIODOS_BARRAS) {
+        return 0;
+    }
+    pthread_once(&series_inicializadas, inicializar_series_sistema);
+
+    pthread_mutex_lock(&mutexes_series[acao_id]);
+    int ok = serie_barras_obter(&series_sistema[acao_id][periodo], atras, barra);
+    pthread_mutex_unlock(&mutexes_series[acao_id]);
+    return ok;
+}
+
+// Função para copiar as 'max' barras mais recentes da ação, da corrente
+// (barras[0]) para as mais antigas, num único acesso ao mutex
+// Retorna o número de barras copiadas
+int barras_recentes(int acao_id, int periodo, BarraOHLCV* barras, int max) {
+    if (acao_id < 0 || acao_id >= MAX_ACOES || periodo < 0 || periodo >= NUM_PERIODOS_BARRAS) {
+        return 0;
+    }
+    pthread_once(&series_inicializadas, inicializar_series_sistema);
+
+    pthread_mutex_lock(&mutexes_series[acao_id]);
+    const SerieBarras* serie = &series_sistema[acao_id][periodo];
+    int copiadas = 0;
+    while (copiadas < max && serie_barras_obter(serie, copiadas, &barras[copiadas])) {
+        copiadas++;
+    }
+    pthread_mutex_unlock(&mutexes_series[acao_id]);
+    return copiadas;
+}
+
+// Função para descartar todas as barras (início de uma sessão simulada)
+void barras_reiniciar() {
+    pthread_once(&series_inicializadas, inicializar_series_sistema);
+    for (int i = 0; i < MAX_ACOES; i++) {
+        pthread_mutex_lock(&mutexes_series[i]);
+        for (int p = 0; p < NUM_PERIODOS_BARRAS; p++) {
+            series_sistema[i][p].total = 0;
+        }
+        pthread_mutex_unlock(&mutexes_series[i]);
+    }
+}
+
+const char* nome_periodo_barra(int periodo) {
+    if (periodo < 0 || periodo >= NUM_PERIODOS_BARRAS) {
+        return "desconhecido";
+    }
+    return NOMES_PERIODOS[periodo];
+}
+
+// Função para imprimir a barra corrente de cada ação (painel)
+void imprimir_barras_ohlcv(TradingSystem* sistema, int periodo) {
+    printf("\n=== BARRAS OHLCV (%s) ===\n", nome_periodo_barra(periodo));
+    // Larguras do cabeçalho compensam os bytes a mais dos acentos em UTF-8
+    printf("%-10s %-10s %9s %10s %10s %9s %8s %10s\n",
+           "AÇÃO", "INÍCIO", "ABERTURA", "MÁXIMA", "MÍNIMA", "FECHAM.", "VOLUME", "NEGÓCIOS");
+    for (int i = 0; i < sistema->num_acoes; i++) {
+        BarraOHLCV barra;
+        if (!barras_obter(i, periodo, 0, &barra)) {
+            printf("%-8s sem barras\n", sistema->acoes[i].nome);
+            continue;
+        }
+        time_t segundos = (time_t)(barra.inicio_ns / 1000000000LL);
+        char inicio[16];
+        strftime(inicio, sizeof(inicio), "%H:%M:%S", localtime(&segundos));
+        printf("%-8s %-9s %9.2f %9.2f %9.2f %9.2f %8lld %9d\n",
+               sistema->acoes[i].nome, inicio,
+               PRECO_EM_REAIS(barra.abertura), PRECO_EM_REAIS(barra.maxima),
+               PRECO_EM_REAIS(barra.minima), PRECO_EM_REAIS(barra.fechamento),
+               barra.volume, barra.negocios);
+    }
+}
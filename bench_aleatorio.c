@@ -0,0 +1,124 @@
+#include "trading_system.h"
+
+// Benchmark do gerador aleatório por thread
+// Compara rand() da glibc (estado global protegido por lock) com
+// aleatorio_proximo() (xoshiro256** em estado por thread) com 1, 2 e 4
+// threads sorteando ao mesmo tempo, e confere a reprodutibilidade: com a
+// mesma semente cada fluxo repete a sequência, e fluxos diferentes divergem.
+
+#define SORTEIOS_POR_THREAD 5000000
+#define MAX_THREADS_BENCH 4
+#define SORTEIOS_VERIFICACAO 1000
+
+typedef struct {
+    int usar_rand;
+    int fluxo;
+    long long soma; // Impede que o compilador descarte os sorteios
+} ParametrosSorteio;
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void* thread_sorteio(void* arg) {
+    ParametrosSorteio* params = (ParametrosSorteio*)arg;
+    long long soma = 0;
+    if (params->usar_rand) {
+        for (int i = 0; i < SORTEIOS_POR_THREAD; i++) {
+            soma += rand() % 100;
+        }
+    } else {
+        aleatorio_iniciar_fluxo(params->fluxo);
+        for (int i = 0; i < SORTEIOS_POR_THREAD; i++) {
+            soma += aleatorio_proximo() % 100;
+        }
+    }
+    params->soma = soma;
+    return NULL;
+}
+
+// Retorna ns por sorteio (tempo de parede / sorteios de uma thread)
+static double medir(int usar_rand, int num_threads) {
+    pthread_t threads[MAX_THREADS_BENCH];
+    ParametrosSorteio params[MAX_THREADS_BENCH];
+
+    long long inicio = tempo_atual_ns();
+    for (int i = 0; i < num_threads; i++) {
+        params[i].usar_rand = usar_rand;
+        params[i].fluxo = FLUXO_ALEATORIO_TRADER + i;
+        pthread_create(&threads[i], NULL, thread_sorteio, &params[i]);
+    }
+    for (int i = 0; i < num_threads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    return (double)(tempo_atual_ns() - inicio) / ((double)SORTEIOS_POR_THREAD * num_threads);
+}
+
+// Mesma semente e mesmo fluxo: mesma sequência; fluxo ou semente diferentes: outra
+static int verificar_reprodutibilidade() {
+    int primeira[SORTEIOS_VERIFICACAO];
+    aleatorio_configurar_semente(12345);
+    aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_TRADER + 2);
+    for (int i = 0; i < SORTEIOS_VERIFICACAO; i++) {
+        primeira[i] = aleatorio_proximo();
+    }
+
+    int ok = 1;
+    aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_TRADER + 2);
+    for (int i = 0; i < SORTEIOS_VERIFICACAO; i++) {
+        ok &= aleatorio_proximo() == primeira[i];
+    }
+
+    int iguais_outro_fluxo = 0;
+    aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_TRADER + 3);
+    for (int i = 0; i < SORTEIOS_VERIFICACAO; i++) {
+        iguais_outro_fluxo += aleatorio_proximo() == primeira[i];
+    }
+
+    int iguais_outra_semente = 0;
+    aleatorio_configurar_semente(12346);
+    aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_TRADER + 2);
+    for (int i = 0; i < SORTEIOS_VERIFICACAO; i++) {
+        iguais_outra_semente += aleatorio_proximo() == primeira[i];
+    }
+
+    return ok && iguais_outro_fluxo == 0 && iguais_outra_semente == 0;
+}
+
+int main() {
+    printf("=== BENCHMARK DO GERADOR ALEATÓRIO ===\n");
+    printf("Sorteios por thread: %d\n\n", SORTEIOS_POR_THREAD);
+
+    aleatorio_configurar_semente(SEMENTE_SIMULACAO_PADRAO);
+    srand(SEMENTE_SIMULACAO_PADRAO);
+
+    printf("%-10s %-18s %-22s %s\n", "THREADS", "rand() (ns)", "aleatorio_proximo (ns)", "GANHO");
+    for (int num_threads = 1; num_threads <= MAX_THREADS_BENCH; num_threads *= 2) {
+        double ns_rand = medir(1, num_threads);
+        double ns_xoshiro = medir(0, num_threads);
+        printf("%-10d %-18.2f %-22.2f %.1fx\n", num_threads, ns_rand, ns_xoshiro, ns_rand / ns_xoshiro);
+    }
+    printf("\n");
+
+    if (!verificar_reprodutibilidade()) {
+        printf("✗ Sequências não reproduzíveis ou fluxos correlacionados\n");
+        return 1;
+    }
+    printf("✓ Mesma semente e fluxo repetem a sequência; outro fluxo ou semente divergem\n");
+
+    // Valores dentro de [0, ALEATORIO_MAX] e médios perto do centro
+    double soma = 0.0;
+    for (int i = 0; i < 1000000; i++) {
+        int valor = aleatorio_proximo();
+        if (valor < 0) {
+            printf("✗ Valor fora da faixa: %d\n", valor);
+            return 1;
+        }
+        soma += (double)valor / ALEATORIO_MAX;
+    }
+    printf("✓ Média de 1M sorteios normalizados: %.4f (esperado 0,5)\n", soma / 1000000);
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
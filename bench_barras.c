@@ -0,0 +1,192 @@
+#include "trading_system.h"
+
+// Benchmark das barras OHLCV incrementais
+// Gera um fluxo de mudanças de preço e negócios de 13 ações e mede:
+// - a agregação incremental (barras de 1 s, 1 min e 5 min a cada evento);
+// - a consulta da barra corrente nas séries mantidas;
+// - a alternativa sem agregador: montar a barra corrente de 5 min varrendo
+//   para trás os eventos guardados, a cada consulta.
+// Depois remonta todas as barras guardadas a partir dos eventos e confere
+// que são iguais às agregadas.
+
+#define EVENTOS_BENCH 2000000
+#define CONSULTAS_VARREDURA 2000
+#define NUM_SIMBOLOS 13
+
+typedef struct {
+    long long instante_ns;
+    preco_t preco;
+    int quantidade;  // 0: mudança de preço
+    int simbolo;
+} EventoBarra;
+
+static EventoBarra eventos[EVENTOS_BENCH];
+static SerieBarras series[NUM_SIMBOLOS][NUM_PERIODOS_BARRAS];
+static const long long PERIODOS_NS[NUM_PERIODOS_BARRAS] = {
+    1000000000LL, 60 * 1000000000LL, 300 * 1000000000LL
+};
+
+static volatile long long sumidouro; // Impede que o compilador descarte as consultas
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Passeio aleatório de preços, um evento a cada ~1 ms de pregão, um em
+// cada quatro é um negócio
+static void gerar_eventos() {
+    aleatorio_configurar_semente(SEMENTE_SIMULACAO_PADRAO);
+    preco_t precos[NUM_SIMBOLOS];
+    for (int s = 0; s < NUM_SIMBOLOS; s++) {
+        precos[s] = PRECO_DE_REAIS(10.0 + s * 5);
+    }
+
+    long long instante = INICIO_PREGAO_SIMULADO * 1000000000LL;
+    for (int i = 0; i < EVENTOS_BENCH; i++) {
+        int s = aleatorio_proximo() % NUM_SIMBOLOS;
+        precos[s] += ((long long)(aleatorio_proximo() % 21) - 10) * TAMANHO_TICK_PADRAO;
+        if (precos[s] < MIN_PRECO_ACAO) precos[s] = MIN_PRECO_ACAO;
+        instante += 1 + aleatorio_proximo() % 2000000;
+
+        eventos[i].instante_ns = instante;
+        eventos[i].preco = precos[s];
+        eventos[i].quantidade = aleatorio_proximo() % 4 == 0 ? 100 : 0;
+        eventos[i].simbolo = s;
+    }
+}
+
+// Função para montar a barra corrente do período varrendo os eventos para
+// trás a partir de 'fim' (exclusive)
+static int barra_por_varredura(int fim, int simbolo, long long periodo_ns, BarraOHLCV* barra) {
+    int encontrada = 0;
+    long long inicio = 0;
+    for (int i = fim - 1; i >= 0; i--) {
+        const EventoBarra* evento = &eventos[i];
+        if (encontrada && evento->instante_ns < inicio) {
+            break;
+        }
+        if (evento->simbolo != simbolo) {
+            continue;
+        }
+        if (!encontrada) {
+            inicio = evento->instante_ns - evento->instante_ns % periodo_ns;
+            memset(barra, 0, sizeof(BarraOHLCV));
+            barra->inicio_ns = inicio;
+            barra->fechamento = evento->preco;
+            barra->maxima = evento->preco;
+            barra->minima = evento->preco;
+            encontrada = 1;
+        }
+        barra->abertura = evento->preco;
+        if (evento->preco > barra->maxima) barra->maxima = evento->preco;
+        if (evento->preco < barra->minima) barra->minima = evento->preco;
+        barra->volume += evento->quantidade;
+        if (evento->quantidade > 0) barra->negocios++; else barra->atualizacoes++;
+    }
+    return encontrada;
+}
+
+static int barras_iguais(const BarraOHLCV* a, const BarraOHLCV* b) {
+    return a->inicio_ns == b->inicio_ns && a->abertura == b->abertura &&
+           a->maxima == b->maxima && a->minima == b->minima &&
+           a->fechamento == b->fechamento && a->volume == b->volume &&
+           a->negocios == b->negocios && a->atualizacoes == b->atualizacoes;
+}
+
+// Função para conferir todas as barras guardadas de uma série, remontando-as
+// numa varredura para trás dos eventos
+// Retorna o número de barras divergentes
+static int conferir_serie(int simbolo, int periodo) {
+    const SerieBarras* serie = &series[simbolo][periodo];
+    int guardadas = serie_barras_quantidade(serie);
+    int divergentes = 0;
+    int atras = 0;
+    int fim = EVENTOS_BENCH;
+
+    while (atras < guardadas) {
+        BarraOHLCV esperada, agregada;
+        if (!barra_por_varredura(fim, simbolo, PERIODOS_NS[periodo], &esperada)) {
+            break;
+        }
+        serie_barras_obter(serie, atras, &agregada);
+        divergentes += !barras_iguais(&esperada, &agregada);
+        atras++;
+
+        // Próxima barra: eventos antes do início desta
+        while (fim > 0 && eventos[fim - 1].instante_ns >= esperada.inicio_ns) {
+            fim--;
+        }
+    }
+    return divergentes + (guardadas - atras);
+}
+
+int main() {
+    printf("=== BENCHMARK DAS BARRAS OHLCV ===\n");
+    printf("Eventos: %d, ações: %d, períodos: 1s, 1min, 5min\n\n", EVENTOS_BENCH, NUM_SIMBOLOS);
+
+    gerar_eventos();
+    for (int s = 0; s < NUM_SIMBOLOS; s++) {
+        for (int p = 0; p < NUM_PERIODOS_BARRAS; p++) {
+            serie_barras_inicializar(&series[s][p], PERIODOS_NS[p]);
+        }
+    }
+
+    // Agregação incremental
+    long long inicio = tempo_atual_ns();
+    for (int i = 0; i < EVENTOS_BENCH; i++) {
+        const EventoBarra* evento = &eventos[i];
+        for (int p = 0; p < NUM_PERIODOS_BARRAS; p++) {
+            serie_barras_registrar(&series[evento->simbolo][p], evento->instante_ns,
+                                   evento->preco, evento->quantidade);
+        }
+    }
+    double ns_agregacao = (double)(tempo_atual_ns() - inicio) / EVENTOS_BENCH;
+
+    // Consulta da barra corrente nas séries
+    BarraOHLCV barra;
+    long long soma = 0;
+    inicio = tempo_atual_ns();
+    for (int i = 0; i < EVENTOS_BENCH; i++) {
+        serie_barras_obter(&series[i % NUM_SIMBOLOS][PERIODO_BARRA_5MIN], 0, &barra);
+        soma += barra.fechamento;
+    }
+    double ns_consulta = (double)(tempo_atual_ns() - inicio) / EVENTOS_BENCH;
+    sumidouro = soma;
+
+    // Barra corrente de 5 min por varredura, em pontos espalhados do fluxo
+    soma = 0;
+    inicio = tempo_atual_ns();
+    for (int q = 0; q < CONSULTAS_VARREDURA; q++) {
+        int fim = (int)((long long)(q + 1) * EVENTOS_BENCH / CONSULTAS_VARREDURA);
+        if (barra_por_varredura(fim, q % NUM_SIMBOLOS, PERIODOS_NS[PERIODO_BARRA_5MIN], &barra)) {
+            soma += barra.fechamento;
+        }
+    }
+    double ns_varredura = (double)(tempo_atual_ns() - inicio) / CONSULTAS_VARREDURA;
+    sumidouro = soma;
+
+    printf("%-36s %s\n", "OPERAÇÃO", "NS");
+    printf("%-36s %.1f\n", "Agregação (3 períodos, por evento)", ns_agregacao);
+    printf("%-36s %.1f\n", "Consulta da barra corrente", ns_consulta);
+    printf("%-36s %.1f\n", "Barra de 5 min por varredura", ns_varredura);
+    printf("Consulta: %.0fx mais rápida que a varredura\n\n", ns_varredura / ns_consulta);
+
+    // Conferir todas as barras guardadas
+    int divergentes = 0;
+    int guardadas = 0;
+    for (int s = 0; s < NUM_SIMBOLOS; s++) {
+        for (int p = 0; p < NUM_PERIODOS_BARRAS; p++) {
+            divergentes += conferir_serie(s, p);
+            guardadas += serie_barras_quantidade(&series[s][p]);
+        }
+    }
+    if (divergentes > 0) {
+        printf("✗ %d de %d barras diferem das remontadas a partir dos eventos\n", divergentes, guardadas);
+        return 1;
+    }
+    printf("✓ %d barras guardadas iguais às remontadas a partir dos eventos\n", guardadas);
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
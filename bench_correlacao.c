@@ -0,0 +1,161 @@
+#include "trading_system.h"
+
+// Benchmark da matriz de correlação deslizante
+// Para universos de 100 a 2000 ativos, mede o custo de inserir uma amostra
+// (atualização O(n²) das somas) e de ler a correlação de todos os pares
+// (O(1) por par), comparado ao cálculo antigo, que varria a janela para
+// cada par (O(janela) por par). Os retornos seguem um modelo de fator por
+// setor, e as correlações lidas são conferidas contra o cálculo direto.
+
+#define AMOSTRAS_AQUECIMENTO 150   // Passa da janela: mede a troca de amostras
+#define AMOSTRAS_MEDIDAS 20
+#define ATIVOS_POR_SETOR 10
+#define PARES_VERIFICADOS 2000
+#define TOLERANCIA_CORRELACAO 1e-9
+
+static const int UNIVERSOS[] = {100, 500, 1000, 2000};
+#define NUM_UNIVERSOS (int)(sizeof(UNIVERSOS) / sizeof(UNIVERSOS[0]))
+
+static volatile double sumidouro; // Impede que o compilador descarte os cálculos
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Sorteio uniforme em [-1, 1]
+static double sortear_choque() {
+    return (double)aleatorio_proximo() / ALEATORIO_MAX * 2.0 - 1.0;
+}
+
+// Próxima amostra de preços: mercado + setor + ruído próprio
+static void gerar_amostra(double* precos, int num_ativos) {
+    double mercado = sortear_choque() * 0.005;
+    double setor = 0.0;
+    for (int i = 0; i < num_ativos; i++) {
+        if (i % ATIVOS_POR_SETOR == 0) {
+            setor = sortear_choque() * 0.01;
+        }
+        precos[i] *= 1.0 + mercado + setor + sortear_choque() * 0.01;
+    }
+}
+
+// Cálculo antigo: varrer os retornos da janela para o par
+static double correlacao_direta(const MatrizCorrelacao* matriz, int i, int j) {
+    int n = matriz->num_ativos;
+    double media_i = 0.0, media_j = 0.0;
+    for (int k = 0; k < matriz->tamanho; k++) {
+        media_i += matriz->retornos[(long long)k * n + i];
+        media_j += matriz->retornos[(long long)k * n + j];
+    }
+    media_i /= matriz->tamanho;
+    media_j /= matriz->tamanho;
+
+    double soma_produtos = 0.0, soma_quadrados_i = 0.0, soma_quadrados_j = 0.0;
+    for (int k = 0; k < matriz->tamanho; k++) {
+        double di = matriz->retornos[(long long)k * n + i] - media_i;
+        double dj = matriz->retornos[(long long)k * n + j] - media_j;
+        soma_produtos += di * dj;
+        soma_quadrados_i += di * di;
+        soma_quadrados_j += dj * dj;
+    }
+    if (soma_quadrados_i == 0 || soma_quadrados_j == 0) {
+        return 0.0;
+    }
+    return soma_produtos / sqrt(soma_quadrados_i * soma_quadrados_j);
+}
+
+// Retorna 1 se as correlações conferem com o cálculo direto
+static int medir_universo(int num_ativos) {
+    MatrizCorrelacao matriz;
+    if (!matriz_correlacao_inicializar(&matriz, num_ativos, JANELA_CORRELACAO)) {
+        printf("✗ Sem memória para %d ativos\n", num_ativos);
+        return 0;
+    }
+
+    double* precos = malloc(sizeof(double) * num_ativos);
+    for (int i = 0; i < num_ativos; i++) {
+        precos[i] = 10.0 + i % 90;
+    }
+
+    for (int k = 0; k < AMOSTRAS_AQUECIMENTO; k++) {
+        gerar_amostra(precos, num_ativos);
+        matriz_correlacao_adicionar_amostra(&matriz, precos);
+    }
+
+    long long inicio = tempo_atual_ns();
+    for (int k = 0; k < AMOSTRAS_MEDIDAS; k++) {
+        gerar_amostra(precos, num_ativos);
+        matriz_correlacao_adicionar_amostra(&matriz, precos);
+    }
+    double ms_amostra = (tempo_atual_ns() - inicio) / 1e6 / AMOSTRAS_MEDIDAS;
+
+    // Todos os pares: leitura O(1)
+    double soma = 0.0;
+    inicio = tempo_atual_ns();
+    for (int i = 0; i < num_ativos; i++) {
+        for (int j = i + 1; j < num_ativos; j++) {
+            soma += matriz_correlacao_obter(&matriz, i, j);
+        }
+    }
+    double ms_pares = (tempo_atual_ns() - inicio) / 1e6;
+    sumidouro = soma;
+
+    // Todos os pares: varredura da janela (cálculo antigo)
+    soma = 0.0;
+    inicio = tempo_atual_ns();
+    for (int i = 0; i < num_ativos; i++) {
+        for (int j = i + 1; j < num_ativos; j++) {
+            soma += correlacao_direta(&matriz, i, j);
+        }
+    }
+    double ms_direto = (tempo_atual_ns() - inicio) / 1e6;
+    sumidouro = soma;
+
+    // Conferir pares sorteados e a estrutura por setor
+    int ok = 1;
+    double mesmo_setor = 0.0, setores_diferentes = 0.0;
+    for (int p = 0; p < PARES_VERIFICADOS; p++) {
+        int i = aleatorio_proximo() % num_ativos;
+        int j = aleatorio_proximo() % num_ativos;
+        double incremental = matriz_correlacao_obter(&matriz, i, j);
+        double direta = correlacao_direta(&matriz, i, j);
+        if (fabs(incremental - direta) > TOLERANCIA_CORRELACAO) {
+            printf("✗ Par (%d, %d): incremental %.12f, direta %.12f\n", i, j, incremental, direta);
+            ok = 0;
+            break;
+        }
+        int vizinho = (i / ATIVOS_POR_SETOR) * ATIVOS_POR_SETOR + (i + 1) % ATIVOS_POR_SETOR;
+        if (vizinho < num_ativos) {
+            mesmo_setor += matriz_correlacao_obter(&matriz, i, vizinho);
+        }
+        setores_diferentes += matriz_correlacao_obter(&matriz, i, (i + ATIVOS_POR_SETOR) % num_ativos);
+    }
+
+    printf("%-8d %-14.3f %-18.2f %-18.2f %5.0fx    %.2f / %.2f\n", num_ativos, ms_amostra, ms_pares, ms_direto,
+           ms_direto / ms_pares, mesmo_setor / PARES_VERIFICADOS, setores_diferentes / PARES_VERIFICADOS);
+
+    free(precos);
+    matriz_correlacao_liberar(&matriz);
+    return ok;
+}
+
+int main() {
+    printf("=== BENCHMARK DA MATRIZ DE CORRELAÇÃO ===\n");
+    printf("Janela: %d amostras, %d ativos por setor\n\n", JANELA_CORRELACAO, ATIVOS_POR_SETOR);
+
+    aleatorio_configurar_semente(SEMENTE_SIMULACAO_PADRAO);
+
+    printf("%-8s %-14s %-18s %-18s %-9s %s\n", "ATIVOS", "AMOSTRA (ms)", "PARES O(1) (ms)",
+           "PARES DIRETO (ms)", "GANHO", "CORR. SETOR / FORA");
+    for (int u = 0; u < NUM_UNIVERSOS; u++) {
+        if (!medir_universo(UNIVERSOS[u])) {
+            return 1;
+        }
+    }
+
+    printf("\n✓ Correlações incrementais iguais ao cálculo direto (%d pares por universo)\n", PARES_VERIFICADOS);
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
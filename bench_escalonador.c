@@ -0,0 +1,171 @@
+#define _DEFAULT_SOURCE
+#include "trading_system.h"
+#include <math.h>
+#include <sched.h>
+
+// Benchmark do escalonador de executores com carga concentrada em poucas ações
+// As ações são sorteadas com distribuição de Zipf (a ação 0 é a mais negociada,
+// como PETR4/VALE3 nos perfis de trader). Compara shards fixos (acao_id % N)
+// com roubo de trabalho e verifica que a ordem das ordens por ação foi mantida.
+// O custo de cada ordem é uma espera (como a latência de confirmação da bolsa),
+// então os executores progridem em paralelo mesmo com poucos núcleos.
+
+#define TOTAL_ORDENS_BENCH 20000
+#define CUSTO_ORDEM_US 20
+#define EXPOENTE_ZIPF_PADRAO 1.0
+
+static double cdf_zipf[MAX_ACOES];
+static int proxima_sequencia[MAX_ACOES];   // Próximo id esperado por ação
+static int ordens_por_acao[MAX_ACOES];
+static int ordens_processadas = 0;
+static int ordem_violada = 0;
+
+static double tempo_atual_s() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Gerador xorshift local (determinístico entre rodadas)
+static unsigned int estado_aleatorio;
+
+static double aleatorio_uniforme() {
+    estado_aleatorio ^= estado_aleatorio << 13;
+    estado_aleatorio ^= estado_aleatorio >> 17;
+    estado_aleatorio ^= estado_aleatorio << 5;
+    return (estado_aleatorio & 0xFFFFFF) / (double)0x1000000;
+}
+
+static void preparar_zipf(double expoente) {
+    double soma = 0.0;
+    for (int i = 0; i < MAX_ACOES; i++) {
+        soma += 1.0 / pow(i + 1, expoente);
+        cdf_zipf[i] = soma;
+    }
+    for (int i = 0; i < MAX_ACOES; i++) {
+        cdf_zipf[i] /= soma;
+    }
+}
+
+static int sortear_acao() {
+    double u = aleatorio_uniforme();
+    for (int i = 0; i < MAX_ACOES; i++) {
+        if (u < cdf_zipf[i]) return i;
+    }
+    return MAX_ACOES - 1;
+}
+
+// Processamento sintético: verifica a ordem por ação e espera o custo do lote
+static void processar_lote_bench(int executor_id, Ordem* ordens, int quantidade, void* contexto) {
+    (void)executor_id;
+    (void)contexto;
+
+    for (int i = 0; i < quantidade; i++) {
+        int acao_id = ordens[i].acao_id;
+        // Apenas o detentor do token da ação escreve proxima_sequencia[acao_id]
+        if (ordens[i].id != proxima_sequencia[acao_id]) {
+            __atomic_store_n(&ordem_violada, 1, __ATOMIC_RELAXED);
+        }
+        proxima_sequencia[acao_id] = ordens[i].id + 1;
+    }
+
+    struct timespec espera;
+    long custo_ns = (long)quantidade * CUSTO_ORDEM_US * 1000L;
+    espera.tv_sec = custo_ns / 1000000000L;
+    espera.tv_nsec = custo_ns % 1000000000L;
+    nanosleep(&espera, NULL);
+
+    __atomic_add_fetch(&ordens_processadas, quantidade, __ATOMIC_RELEASE);
+}
+
+// Executa uma rodada e retorna o tempo total (s)
+static double executar_rodada(int num_executores, int modo, int* ordens_executores, int* roubos) {
+    memset(proxima_sequencia, 0, sizeof(proxima_sequencia));
+    memset(ordens_por_acao, 0, sizeof(ordens_por_acao));
+    ordens_processadas = 0;
+    ordem_violada = 0;
+    estado_aleatorio = 2463534242u;
+
+    escalonador_inicializar(num_executores, modo, processar_lote_bench, NULL);
+
+    Ordem ordem;
+    memset(&ordem, 0, sizeof(Ordem));
+    ordem.tipo = 'C';
+    ordem.preco = PRECO_DE_REAIS(25.50);
+    ordem.quantidade = 100;
+
+    double inicio = tempo_atual_s();
+    escalonador_iniciar();
+
+    for (int i = 0; i < TOTAL_ORDENS_BENCH; i++) {
+        ordem.acao_id = sortear_acao();
+        ordem.id = ordens_por_acao[ordem.acao_id]++;
+        while (!escalonador_submeter(&ordem)) {
+            sched_yield();
+        }
+    }
+
+    while (__atomic_load_n(&ordens_processadas, __ATOMIC_ACQUIRE) < TOTAL_ORDENS_BENCH) {
+        usleep(100);
+    }
+    double duracao = tempo_atual_s() - inicio;
+    escalonador_parar();
+
+    if (ordem_violada) {
+        printf("ERRO: Ordem das ordens por ação não foi preservada\n");
+        exit(1);
+    }
+
+    *roubos = 0;
+    for (int i = 0; i < num_executores; i++) {
+        int roubos_executor = 0;
+        escalonador_obter_estatisticas(i, &ordens_executores[i], NULL, &roubos_executor);
+        *roubos += roubos_executor;
+    }
+    return duracao;
+}
+
+// Desequilíbrio: maior carga de um executor dividida pela carga média
+static double calcular_desequilibrio(int* ordens_executores, int num_executores) {
+    int maior = 0;
+    for (int i = 0; i < num_executores; i++) {
+        if (ordens_executores[i] > maior) maior = ordens_executores[i];
+    }
+    return maior / ((double)TOTAL_ORDENS_BENCH / num_executores);
+}
+
+int main(int argc, char* argv[]) {
+    double expoente = argc > 1 ? atof(argv[1]) : EXPOENTE_ZIPF_PADRAO;
+    int executores[] = {2, 4, 8};
+    int num_configuracoes = sizeof(executores) / sizeof(executores[0]);
+
+    preparar_zipf(expoente);
+
+    printf("=== BENCHMARK DO ESCALONADOR DE EXECUTORES ===\n");
+    printf("Ordens por rodada: %d, custo por ordem: %d us, Zipf s=%.2f, ações: %d, CPUs: %ld\n",
+           TOTAL_ORDENS_BENCH, CUSTO_ORDEM_US, expoente, MAX_ACOES, sysconf(_SC_NPROCESSORS_ONLN));
+    printf("Ação mais negociada: %.1f%% das ordens\n", cdf_zipf[0] * 100.0);
+    printf("%-11s %-16s %-13s %-16s %-13s %-8s\n", "EXECUTORES",
+           "ESTÁTICO (op/s)", "DESEQUILÍBRIO", "ROUBO (op/s)", "DESEQUILÍBRIO", "ROUBOS");
+
+    for (int i = 0; i < num_configuracoes; i++) {
+        int ordens_estatico[MAX_EXECUTORES] = {0};
+        int ordens_roubo[MAX_EXECUTORES] = {0};
+        int roubos_estatico, roubos;
+
+        double tempo_estatico = executar_rodada(executores[i], MODO_ESCALONADOR_ESTATICO,
+                                                ordens_estatico, &roubos_estatico);
+        double tempo_roubo = executar_rodada(executores[i], MODO_ESCALONADOR_ROUBO,
+                                             ordens_roubo, &roubos);
+
+        printf("%-11d %-16.0f %-13.2f %-16.0f %-13.2f %-8d\n", executores[i],
+               TOTAL_ORDENS_BENCH / tempo_estatico,
+               calcular_desequilibrio(ordens_estatico, executores[i]),
+               TOTAL_ORDENS_BENCH / tempo_roubo,
+               calcular_desequilibrio(ordens_roubo, executores[i]), roubos);
+    }
+
+    printf("✓ Ordem por ação preservada em todas as rodadas\n");
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
@@ -0,0 +1,116 @@
+#define _DEFAULT_SOURCE
+#include "trading_system.h"
+#include <sys/resource.h>
+
+// Benchmark de latência de despertar por estratégia de espera
+// Um produtor publica o instante atual e notifica o evento; o consumidor,
+// parado em evento_aguardar, mede quanto tempo levou para acordar e responde
+// em um segundo evento. Entre amostras o produtor dorme, então o consumidor
+// sempre entra na espera antes da notificação (como o executor sem ordens).
+
+#define AMOSTRAS_BENCH 5000
+#define INTERVALO_ENTRE_AMOSTRAS_US 50
+
+static EventoNotificacao evento_ping;
+static EventoNotificacao evento_pong;
+static long long instante_notificacao_ns;
+static double latencias_us[AMOSTRAS_BENCH];
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static double tempo_cpu_s() {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_utime.tv_sec + uso.ru_utime.tv_usec / 1e6 +
+           uso.ru_stime.tv_sec + uso.ru_stime.tv_usec / 1e6;
+}
+
+static void* thread_consumidor(void* arg) {
+    int amostras = *(int*)arg;
+    for (int i = 0; i < amostras; i++) {
+        unsigned int observado = evento_observar(&evento_ping);
+        // Sinalizar que está pronto para esperar a próxima amostra
+        evento_notificar(&evento_pong);
+        while (evento_observar(&evento_ping) == observado) {
+            evento_aguardar(&evento_ping, observado, 1000);
+        }
+        long long despertar = tempo_atual_ns();
+        long long notificacao = __atomic_load_n(&instante_notificacao_ns, __ATOMIC_ACQUIRE);
+        latencias_us[i] = (despertar - notificacao) / 1000.0;
+    }
+    evento_notificar(&evento_pong);
+    return NULL;
+}
+
+static int comparar_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void executar_rodada(int estrategia, int amostras) {
+    pthread_t consumidor;
+
+    configurar_estrategia_espera(estrategia);
+    evento_inicializar(&evento_ping);
+    evento_inicializar(&evento_pong);
+
+    double cpu_inicio = tempo_cpu_s();
+    long long inicio = tempo_atual_ns();
+    unsigned int pronto = evento_observar(&evento_pong);
+    pthread_create(&consumidor, NULL, thread_consumidor, &amostras);
+
+    for (int i = 0; i < amostras; i++) {
+        // Aguardar o consumidor ficar pronto e dar tempo para ele entrar na espera
+        while (evento_observar(&evento_pong) == pronto) {
+            evento_aguardar(&evento_pong, pronto, 1000);
+        }
+        pronto = evento_observar(&evento_pong);
+        usleep(INTERVALO_ENTRE_AMOSTRAS_US);
+
+        __atomic_store_n(&instante_notificacao_ns, tempo_atual_ns(), __ATOMIC_RELEASE);
+        evento_notificar(&evento_ping);
+    }
+
+    pthread_join(consumidor, NULL);
+    double duracao_s = (tempo_atual_ns() - inicio) / 1e9;
+    double cpu_s = tempo_cpu_s() - cpu_inicio;
+
+    double soma = 0.0;
+    for (int i = 0; i < amostras; i++) {
+        soma += latencias_us[i];
+    }
+    qsort(latencias_us, amostras, sizeof(double), comparar_double);
+
+    printf("%-12s %-11.2f %-11.2f %-11.2f %-11.2f %-9.0f %d\n", nome_estrategia_espera(estrategia),
+           soma / amostras, latencias_us[amostras / 2],
+           latencias_us[amostras * 99 / 100], latencias_us[amostras - 1],
+           duracao_s > 0 ? cpu_s / duracao_s * 100.0 : 0.0, amostras);
+}
+
+int main() {
+    int estrategias[] = {ESTRATEGIA_ESPERA_BLOQUEIO, ESTRATEGIA_ESPERA_SPIN, ESTRATEGIA_ESPERA_SPIN_PARK};
+    int num_estrategias = sizeof(estrategias) / sizeof(estrategias[0]);
+
+    printf("=== BENCHMARK DE LATÊNCIA DE DESPERTAR ===\n");
+    printf("Amostras por estratégia: %d, intervalo entre amostras: %d us, CPUs: %ld\n",
+           AMOSTRAS_BENCH, INTERVALO_ENTRE_AMOSTRAS_US, sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%-12s %-11s %-11s %-11s %-11s %-9s %s\n", "ESTRATÉGIA",
+           "MÉDIA (us)", "P50 (us)", "P99 (us)", "MÁX (us)", "CPU (%)", "AMOSTRAS");
+
+    // Com um núcleo o spin só cede a CPU por preempção (fatias de ms por amostra)
+    int um_nucleo = sysconf(_SC_NPROCESSORS_ONLN) == 1;
+
+    for (int i = 0; i < num_estrategias; i++) {
+        int amostras = (um_nucleo && estrategias[i] == ESTRATEGIA_ESPERA_SPIN) ?
+                       AMOSTRAS_BENCH / 10 : AMOSTRAS_BENCH;
+        executar_rodada(estrategias[i], amostras);
+    }
+
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "trading_system.h"
+
+// Benchmark das estatísticas de janela deslizante
+// Compara o histórico antigo do price updater (a cada preço novo, média e
+// desvio recalculados varrendo os 100 preços, e mínimo/máximo por varredura)
+// com EstatisticasJanela (Welford, deques monotônicos e EMA em O(1)), e
+// confere que os dois dão os mesmos valores ao longo de milhões de preços.
+
+#define PRECOS_BENCH 2000000
+#define INTERVALO_VERIFICACAO 997 // Confere a cada N preços (primo: varia a posição no anel)
+#define TOLERANCIA_RELATIVA 1e-9
+
+// Histórico antigo (como era em price_updater.c), mais mínimo e máximo
+typedef struct {
+    double precos[JANELA_ESTATISTICAS];
+    int indice;
+    int total_precos;
+    double preco_medio;
+    double volatilidade;
+    double minimo;
+    double maximo;
+} HistoricoAntigo;
+
+static double precos[PRECOS_BENCH];
+static volatile double sumidouro; // Impede que o compilador descarte os cálculos
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Passeio aleatório de ±1% por preço (com piso de R$ 1,00)
+static void gerar_precos() {
+    aleatorio_configurar_semente(SEMENTE_SIMULACAO_PADRAO);
+    double preco = 25.0;
+    for (int i = 0; i < PRECOS_BENCH; i++) {
+        double variacao = (aleatorio_proximo() % 200 - 100) / 10000.0;
+        preco *= 1.0 + variacao;
+        if (preco < 1.0) preco = 1.0;
+        precos[i] = preco;
+    }
+}
+
+static void historico_antigo_adicionar(HistoricoAntigo* historico, double preco) {
+    historico->precos[historico->indice] = preco;
+    historico->indice = (historico->indice + 1) % JANELA_ESTATISTICAS;
+    if (historico->total_precos < JANELA_ESTATISTICAS) {
+        historico->total_precos++;
+    }
+
+    int total = historico->total_precos;
+    double soma = 0.0;
+    for (int i = 0; i < total; i++) {
+        soma += historico->precos[i];
+    }
+    historico->preco_medio = soma / total;
+
+    double soma_quadrados = 0.0;
+    historico->minimo = historico->precos[0];
+    historico->maximo = historico->precos[0];
+    for (int i = 0; i < total; i++) {
+        double diferenca = historico->precos[i] - historico->preco_medio;
+        soma_quadrados += diferenca * diferenca;
+        if (historico->precos[i] < historico->minimo) historico->minimo = historico->precos[i];
+        if (historico->precos[i] > historico->maximo) historico->maximo = historico->precos[i];
+    }
+    historico->volatilidade = sqrt(soma_quadrados / total) / historico->preco_medio;
+}
+
+static int proximos(double a, double b) {
+    return fabs(a - b) <= TOLERANCIA_RELATIVA * (fabs(a) > fabs(b) ? fabs(a) : fabs(b)) + 1e-12;
+}
+
+int main() {
+    printf("=== BENCHMARK DAS ESTATÍSTICAS DE JANELA ===\n");
+    printf("Preços: %d, janela: %d\n\n", PRECOS_BENCH, JANELA_ESTATISTICAS);
+
+    gerar_precos();
+
+    // Histórico antigo: varredura completa a cada preço
+    static HistoricoAntigo historico;
+    long long inicio = tempo_atual_ns();
+    for (int i = 0; i < PRECOS_BENCH; i++) {
+        historico_antigo_adicionar(&historico, precos[i]);
+        sumidouro = historico.volatilidade + historico.minimo + historico.maximo;
+    }
+    double ns_antigo = (double)(tempo_atual_ns() - inicio) / PRECOS_BENCH;
+
+    // Janela O(1)
+    static EstatisticasJanela janela;
+    estatisticas_janela_inicializar(&janela, PERIODO_MEDIA_EXPONENCIAL);
+    inicio = tempo_atual_ns();
+    for (int i = 0; i < PRECOS_BENCH; i++) {
+        estatisticas_janela_adicionar(&janela, precos[i]);
+        sumidouro = estatisticas_janela_volatilidade(&janela) +
+                    estatisticas_janela_minimo(&janela) + estatisticas_janela_maximo(&janela);
+    }
+    double ns_janela = (double)(tempo_atual_ns() - inicio) / PRECOS_BENCH;
+
+    printf("%-28s %s\n", "VERSÃO", "NS POR PREÇO");
+    printf("%-28s %.1f\n", "Histórico com varredura", ns_antigo);
+    printf("%-28s %.1f\n", "Janela O(1)", ns_janela);
+    printf("Ganho: %.1fx\n\n", ns_antigo / ns_janela);
+
+    // Conferir as duas versões lado a lado
+    memset(&historico, 0, sizeof(historico));
+    estatisticas_janela_inicializar(&janela, PERIODO_MEDIA_EXPONENCIAL);
+    double maior_erro_media = 0.0, maior_erro_volatilidade = 0.0;
+    int verificacoes = 0;
+    for (int i = 0; i < PRECOS_BENCH; i++) {
+        historico_antigo_adicionar(&historico, precos[i]);
+        estatisticas_janela_adicionar(&janela, precos[i]);
+        if (i % INTERVALO_VERIFICACAO != 0 && i >= JANELA_ESTATISTICAS) continue;
+
+        verificacoes++;
+        double media = estatisticas_janela_media(&janela);
+        double volatilidade = estatisticas_janela_volatilidade(&janela);
+        if (!proximos(media, historico.preco_medio) ||
+            (historico.total_precos >= 2 && !proximos(volatilidade, historico.volatilidade)) ||
+            estatisticas_janela_minimo(&janela) != historico.minimo ||
+            estatisticas_janela_maximo(&janela) != historico.maximo ||
+            estatisticas_janela_valor(&janela, 0) != precos[i]) {
+            printf("✗ Divergência no preço %d: média %.10f vs %.10f, volatilidade %.10f vs %.10f\n",
+                   i, media, historico.preco_medio, volatilidade, historico.volatilidade);
+            return 1;
+        }
+        double erro_media = fabs(media - historico.preco_medio) / historico.preco_medio;
+        double erro_volatilidade = fabs(volatilidade - historico.volatilidade);
+        if (erro_media > maior_erro_media) maior_erro_media = erro_media;
+        if (erro_volatilidade > maior_erro_volatilidade) maior_erro_volatilidade = erro_volatilidade;
+    }
+    printf("✓ %d verificações: mínimo, máximo e último preço iguais\n", verificacoes);
+    printf("✓ Maior erro relativo da média: %.2e, da volatilidade: %.2e\n",
+           maior_erro_media, maior_erro_volatilidade);
+
+    // EMA ao final, para comparar com a faixa recente
+    double ema = estatisticas_janela_ema(&janela);
+    printf("✓ EMA final: %.4f (janela: %.4f - %.4f)\n",
+           ema, estatisticas_janela_minimo(&janela), estatisticas_janela_maximo(&janela));
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
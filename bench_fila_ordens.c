@@ -0,0 +1,173 @@
+#include "trading_system.h"
+#include <sched.h>
+
+// Benchmark da fila de ordens: FilaOrdens (mutex/condvar) vs FilaOrdensLockFree
+// Mede taxa de enfileiramento e desenfileiramento com 1 a 64 produtores e um
+// consumidor, como no pipeline traders -> executor.
+
+#define TOTAL_ORDENS_BENCH 1000000
+
+static FilaOrdens fila_mutex;
+static FilaOrdensLockFree fila_lockfree;
+
+typedef struct {
+    int produtor_id;
+    int num_ordens;
+    int usar_lockfree;
+} ParametrosProdutor;
+
+typedef struct {
+    int total_ordens;
+    int usar_lockfree;
+    long long soma_ids;
+} ParametrosConsumidor;
+
+static double tempo_atual_s() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Implementação original da fila (sem o printf dentro do lock)
+static void fila_mutex_adicionar(Ordem* ordem) {
+    pthread_mutex_lock(&fila_mutex.mutex);
+    while (fila_mutex.tamanho >= MAX_FILA_ORDENS) {
+        pthread_cond_wait(&fila_mutex.cond_nao_cheia, &fila_mutex.mutex);
+    }
+    fila_mutex.ordens[fila_mutex.fim] = *ordem;
+    fila_mutex.fim = (fila_mutex.fim + 1) % MAX_FILA_ORDENS;
+    fila_mutex.tamanho++;
+    pthread_cond_signal(&fila_mutex.cond_nao_vazia);
+    pthread_mutex_unlock(&fila_mutex.mutex);
+}
+
+static void fila_mutex_remover(Ordem* ordem) {
+    pthread_mutex_lock(&fila_mutex.mutex);
+    while (fila_mutex.tamanho == 0) {
+        pthread_cond_wait(&fila_mutex.cond_nao_vazia, &fila_mutex.mutex);
+    }
+    *ordem = fila_mutex.ordens[fila_mutex.inicio];
+    fila_mutex.inicio = (fila_mutex.inicio + 1) % MAX_FILA_ORDENS;
+    fila_mutex.tamanho--;
+    pthread_cond_signal(&fila_mutex.cond_nao_cheia);
+    pthread_mutex_unlock(&fila_mutex.mutex);
+}
+
+static void* thread_produtor(void* arg) {
+    ParametrosProdutor* params = (ParametrosProdutor*)arg;
+    Ordem ordem;
+    memset(&ordem, 0, sizeof(Ordem));
+    ordem.trader_id = params->produtor_id;
+    ordem.tipo = 'C';
+    ordem.preco = PRECO_DE_REAIS(25.50);
+    ordem.quantidade = 100;
+
+    for (int i = 0; i < params->num_ordens; i++) {
+        ordem.id = i;
+        ordem.acao_id = i % MAX_ACOES;
+        if (params->usar_lockfree) {
+            while (!fila_lockfree_enfileirar(&fila_lockfree, &ordem)) {
+                sched_yield();
+            }
+        } else {
+            fila_mutex_adicionar(&ordem);
+        }
+    }
+    return NULL;
+}
+
+static void* thread_consumidor(void* arg) {
+    ParametrosConsumidor* params = (ParametrosConsumidor*)arg;
+    Ordem ordem;
+
+    for (int i = 0; i < params->total_ordens; i++) {
+        if (params->usar_lockfree) {
+            while (!fila_lockfree_desenfileirar(&fila_lockfree, &ordem)) {
+                sched_yield();
+            }
+        } else {
+            fila_mutex_remover(&ordem);
+        }
+        params->soma_ids += ordem.id;
+    }
+    return NULL;
+}
+
+// Executa uma rodada e retorna taxas de enfileiramento/desenfileiramento (ops/s)
+static void executar_rodada(int num_produtores, int usar_lockfree,
+                            double* taxa_enfileirar, double* taxa_desenfileirar) {
+    pthread_t produtores[64];
+    ParametrosProdutor params_produtores[64];
+    pthread_t consumidor;
+    ParametrosConsumidor params_consumidor;
+    int ordens_por_produtor = TOTAL_ORDENS_BENCH / num_produtores;
+
+    if (usar_lockfree) {
+        fila_lockfree_inicializar(&fila_lockfree);
+    } else {
+        fila_mutex.inicio = 0;
+        fila_mutex.fim = 0;
+        fila_mutex.tamanho = 0;
+        pthread_mutex_init(&fila_mutex.mutex, NULL);
+        pthread_cond_init(&fila_mutex.cond_nao_vazia, NULL);
+        pthread_cond_init(&fila_mutex.cond_nao_cheia, NULL);
+    }
+
+    params_consumidor.total_ordens = ordens_por_produtor * num_produtores;
+    params_consumidor.usar_lockfree = usar_lockfree;
+    params_consumidor.soma_ids = 0;
+
+    double inicio = tempo_atual_s();
+    pthread_create(&consumidor, NULL, thread_consumidor, &params_consumidor);
+    for (int i = 0; i < num_produtores; i++) {
+        params_produtores[i].produtor_id = i;
+        params_produtores[i].num_ordens = ordens_por_produtor;
+        params_produtores[i].usar_lockfree = usar_lockfree;
+        pthread_create(&produtores[i], NULL, thread_produtor, &params_produtores[i]);
+    }
+    for (int i = 0; i < num_produtores; i++) {
+        pthread_join(produtores[i], NULL);
+    }
+    double fim_produtores = tempo_atual_s();
+    pthread_join(consumidor, NULL);
+    double fim_consumidor = tempo_atual_s();
+
+    // Verificar que nenhuma ordem foi perdida ou duplicada
+    long long soma_esperada = (long long)num_produtores *
+                              ((long long)ordens_por_produtor * (ordens_por_produtor - 1) / 2);
+    if (params_consumidor.soma_ids != soma_esperada) {
+        printf("ERRO: Ordens perdidas/duplicadas (%lld != %lld)\n",
+               params_consumidor.soma_ids, soma_esperada);
+        exit(1);
+    }
+
+    *taxa_enfileirar = params_consumidor.total_ordens / (fim_produtores - inicio);
+    *taxa_desenfileirar = params_consumidor.total_ordens / (fim_consumidor - inicio);
+
+    if (!usar_lockfree) {
+        pthread_mutex_destroy(&fila_mutex.mutex);
+        pthread_cond_destroy(&fila_mutex.cond_nao_vazia);
+        pthread_cond_destroy(&fila_mutex.cond_nao_cheia);
+    }
+}
+
+int main() {
+    int produtores[] = {1, 2, 4, 8, 16, 32, 64};
+    int num_configuracoes = sizeof(produtores) / sizeof(produtores[0]);
+
+    printf("=== BENCHMARK DA FILA DE ORDENS ===\n");
+    printf("Ordens por rodada: %d, CPUs: %ld\n", TOTAL_ORDENS_BENCH, sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%-11s %-18s %-18s %-18s %-18s\n", "PRODUTORES",
+           "MUTEX ENQ (op/s)", "MUTEX DEQ (op/s)", "LOCKFREE ENQ", "LOCKFREE DEQ");
+
+    for (int i = 0; i < num_configuracoes; i++) {
+        double mutex_enq, mutex_deq, lockfree_enq, lockfree_deq;
+        executar_rodada(produtores[i], 0, &mutex_enq, &mutex_deq);
+        executar_rodada(produtores[i], 1, &lockfree_enq, &lockfree_deq);
+        printf("%-11d %-18.0f %-18.0f %-18.0f %-18.0f\n", produtores[i],
+               mutex_enq, mutex_deq, lockfree_enq, lockfree_deq);
+    }
+
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "trading_system.h"
+
+// Benchmark de cancelamento e modificação de ordens em repouso
+// Enche o livro com N ordens vivas que não se cruzam e executa um fluxo
+// dominado por cancelamentos: cada passo cancela uma ordem viva aleatória e
+// submete uma nova no lugar (o número de ordens vivas fica constante).
+// Compara o livro em lista (cancelamento por varredura) com o livro por
+// ticks (cancelamento pelo índice hash) e mede a modificação de quantidade.
+
+#define OPERACOES_CANCELAMENTO 20000
+#define PRECO_MEDIO_BENCH (25 * ESCALA_PRECO)
+#define FAIXA_REPOUSO_TICKS 200 // Ordens entre 1 e 200 ticks do médio, sem cruzar
+
+static int ordens_vivas[50000];
+static int num_ordens_vivas = 0;
+static int proximo_id = 1;
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Gerador xorshift local (fluxo determinístico)
+static unsigned int estado_aleatorio = 2463534242u;
+
+static unsigned int aleatorio() {
+    estado_aleatorio ^= estado_aleatorio << 13;
+    estado_aleatorio ^= estado_aleatorio >> 17;
+    estado_aleatorio ^= estado_aleatorio << 5;
+    return estado_aleatorio;
+}
+
+// Ordem passiva: compras abaixo do médio, vendas acima
+static Ordem gerar_ordem_passiva() {
+    Ordem ordem;
+    memset(&ordem, 0, sizeof(Ordem));
+    ordem.id = proximo_id++;
+    ordem.trader_id = aleatorio() % MAX_TRADERS;
+    ordem.tipo = (aleatorio() & 1) ? 'C' : 'V';
+    int deslocamento = 1 + (int)(aleatorio() % FAIXA_REPOUSO_TICKS);
+    if (ordem.tipo == 'C') deslocamento = -deslocamento;
+    ordem.preco = PRECO_MEDIO_BENCH + deslocamento * TAMANHO_TICK_PADRAO;
+    ordem.quantidade = 100 * (1 + aleatorio() % 10);
+    return ordem;
+}
+
+// Função para retirar uma ordem viva aleatória da lista de vivas
+static int sortear_ordem_viva() {
+    int posicao = aleatorio() % num_ordens_vivas;
+    int ordem_id = ordens_vivas[posicao];
+    ordens_vivas[posicao] = ordens_vivas[--num_ordens_vivas];
+    return ordem_id;
+}
+
+// Rodada no livro em lista: retorna ns por cancelamento (-1 se algum cancelamento falhou)
+static double rodada_lista(int ordens_iniciais) {
+    LivroOrdens livro;
+    livro_inicializar(&livro, 0, TAMANHO_TICK_PADRAO);
+    estado_aleatorio = 2463534242u;
+    num_ordens_vivas = 0;
+    proximo_id = 1;
+
+    for (int i = 0; i < ordens_iniciais; i++) {
+        Ordem ordem = gerar_ordem_passiva();
+        livro_submeter_ordem(&livro, &ordem, NULL, NULL);
+        ordens_vivas[num_ordens_vivas++] = ordem.id;
+    }
+
+    int falhas = 0;
+    long long tempo_cancelamento = 0;
+    for (int i = 0; i < OPERACOES_CANCELAMENTO; i++) {
+        int ordem_id = sortear_ordem_viva();
+        long long antes = tempo_atual_ns();
+        if (livro_cancelar_ordem(&livro, ordem_id) <= 0) falhas++;
+        tempo_cancelamento += tempo_atual_ns() - antes;
+
+        Ordem ordem = gerar_ordem_passiva();
+        livro_submeter_ordem(&livro, &ordem, NULL, NULL);
+        ordens_vivas[num_ordens_vivas++] = ordem.id;
+    }
+    livro_liberar(&livro);
+
+    return falhas ? -1.0 : (double)tempo_cancelamento / OPERACOES_CANCELAMENTO;
+}
+
+// Rodada no livro por ticks: mesmo fluxo, mais uma passada de modificações
+static double rodada_ticks(int ordens_iniciais, double* ns_modificacao) {
+    LivroTicks* livro = malloc(sizeof(LivroTicks));
+    if (!livro || !livro_ticks_inicializar(livro, 0, PRECO_MEDIO_BENCH, TAMANHO_TICK_PADRAO)) {
+        free(livro);
+        return -1.0;
+    }
+    estado_aleatorio = 2463534242u;
+    num_ordens_vivas = 0;
+    proximo_id = 1;
+
+    for (int i = 0; i < ordens_iniciais; i++) {
+        Ordem ordem = gerar_ordem_passiva();
+        livro_ticks_submeter_ordem(livro, &ordem, NULL, NULL);
+        ordens_vivas[num_ordens_vivas++] = ordem.id;
+    }
+
+    int falhas = 0;
+    long long tempo_cancelamento = 0;
+    for (int i = 0; i < OPERACOES_CANCELAMENTO; i++) {
+        int ordem_id = sortear_ordem_viva();
+        long long antes = tempo_atual_ns();
+        if (livro_ticks_cancelar_ordem(livro, ordem_id) <= 0) falhas++;
+        tempo_cancelamento += tempo_atual_ns() - antes;
+
+        Ordem ordem = gerar_ordem_passiva();
+        livro_ticks_submeter_ordem(livro, &ordem, NULL, NULL);
+        ordens_vivas[num_ordens_vivas++] = ordem.id;
+    }
+
+    // Modificações alternando redução (mantém a fila) e aumento (vai para o fim)
+    long long tempo_modificacao = 0;
+    for (int i = 0; i < OPERACOES_CANCELAMENTO; i++) {
+        int ordem_id = ordens_vivas[aleatorio() % num_ordens_vivas];
+        int nova_quantidade = (i & 1) ? 1000 : 100;
+        long long antes = tempo_atual_ns();
+        if (!livro_ticks_modificar_ordem(livro, ordem_id, nova_quantidade)) falhas++;
+        tempo_modificacao += tempo_atual_ns() - antes;
+    }
+
+    if (livro->ordens_em_repouso != ordens_iniciais || livro->indice.quantidade != ordens_iniciais) {
+        falhas++;
+    }
+    livro_ticks_liberar(livro);
+    free(livro);
+
+    *ns_modificacao = (double)tempo_modificacao / OPERACOES_CANCELAMENTO;
+    return falhas ? -1.0 : (double)tempo_cancelamento / OPERACOES_CANCELAMENTO;
+}
+
+int main() {
+    int tamanhos[] = {1000, 10000, 50000};
+    int num_tamanhos = sizeof(tamanhos) / sizeof(tamanhos[0]);
+
+    printf("=== BENCHMARK DE CANCELAMENTO POR ID ===\n");
+    printf("Operações por rodada: %d (cancelar + repor), ordens a até %d ticks do médio\n",
+           OPERACOES_CANCELAMENTO, FAIXA_REPOUSO_TICKS);
+    printf("%-14s %-20s %-20s %-18s %s\n", "ORDENS VIVAS", "CANCELAR LISTA (ns)",
+           "CANCELAR ÍNDICE (ns)", "MODIFICAR (ns)", "GANHO");
+
+    for (int i = 0; i < num_tamanhos; i++) {
+        double ns_modificacao = 0.0;
+        double ns_lista = rodada_lista(tamanhos[i]);
+        double ns_ticks = rodada_ticks(tamanhos[i], &ns_modificacao);
+        if (ns_lista < 0 || ns_ticks < 0) {
+            printf("✗ Cancelamento ou modificação falhou com %d ordens vivas\n", tamanhos[i]);
+            return 1;
+        }
+        printf("%-14d %-20.0f %-20.0f %-18.0f %.0fx\n", tamanhos[i], ns_lista, ns_ticks,
+               ns_modificacao, ns_ticks > 0 ? ns_lista / ns_ticks : 0.0);
+    }
+
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
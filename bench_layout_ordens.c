@@ -0,0 +1,263 @@
+#define _POSIX_C_SOURCE 200809L
+#include "trading_system.h"
+#include <stddef.h>
+
+// Benchmark de layout de ordens e ações
+// Compara duas varreduras de ordens (pendentes por ação e oportunidades com o
+// critério de verificar_oportunidades_execucao) em dois layouts: o registro antigo de
+// 48 bytes e o registro compacto de 32 bytes.
+// Em seguida compara a leitura dos preços de muitas ações com o layout
+// antigo de Acao (preços depois dos nomes) e o atual (bloco quente no início).
+
+#define TOTAL_ORDENS_LAYOUT 1000000
+#define PERCENTUAL_PENDENTES 20
+#define REPETICOES_VARREDURA 5
+#define NUM_ACOES_LAYOUT 16384       // Universo grande para as ações não caberem na cache
+#define REPETICOES_PRECOS 50
+
+// Layout antigo da ordem (campos na ordem de declaração original, com preenchimento)
+typedef struct {
+    int id;
+    int trader_id;
+    int acao_id;
+    char tipo;
+    preco_t preco;
+    int quantidade;
+    time_t timestamp;
+    int status;
+} OrdemAntiga;
+
+// Layout antigo da ação (nomes antes dos preços)
+typedef struct {
+    char nome[MAX_NOME];
+    char setor[MAX_NOME];
+    preco_t preco_atual;
+    preco_t preco_anterior;
+    preco_t preco_maximo;
+    preco_t preco_minimo;
+    preco_t tamanho_tick;
+    double variacao;
+    double volatilidade;
+    int volume_negociado;
+    int volume_diario;
+    int volume_total;
+    int num_operacoes;
+    double variacao_diaria;
+    double variacao_semanal;
+    double variacao_mensal;
+    double historico_precos[30];
+    int indice_historico;
+    pthread_mutex_t mutex;
+} AcaoAntiga;
+
+static OrdemAntiga ordens_antigas[TOTAL_ORDENS_LAYOUT];
+static Ordem ordens[TOTAL_ORDENS_LAYOUT];
+static preco_t precos_referencia[MAX_ACOES];
+static volatile long long sumidouro; // Impede que o compilador descarte as varreduras
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Gerador xorshift local (fluxo determinístico)
+static unsigned int estado_aleatorio = 2463534242u;
+
+static unsigned int aleatorio() {
+    estado_aleatorio ^= estado_aleatorio << 13;
+    estado_aleatorio ^= estado_aleatorio >> 17;
+    estado_aleatorio ^= estado_aleatorio << 5;
+    return estado_aleatorio;
+}
+
+// Gera as mesmas ordens nos três layouts: preços até ±4% da referência
+static void gerar_ordens() {
+    for (int i = 0; i < MAX_ACOES; i++) {
+        precos_referencia[i] = (10 + 5 * i) * ESCALA_PRECO;
+    }
+
+    for (int i = 0; i < TOTAL_ORDENS_LAYOUT; i++) {
+        Ordem ordem;
+        memset(&ordem, 0, sizeof(Ordem));
+        ordem.id = i;
+        ordem.trader_id = aleatorio() % MAX_TRADERS;
+        ordem.acao_id = aleatorio() % MAX_ACOES;
+        ordem.tipo = (aleatorio() & 1) ? 'C' : 'V';
+        preco_t referencia = precos_referencia[ordem.acao_id];
+        ordem.preco = referencia + referencia * ((int)(aleatorio() % 801) - 400) / 10000;
+        ordem.quantidade = 100 * (1 + aleatorio() % 10);
+        ordem.timestamp = 1700000000 + i;
+        ordem.status = ((int)(aleatorio() % 100) < PERCENTUAL_PENDENTES) ? 0 : 1 + aleatorio() % 2;
+
+        ordens[i] = ordem;
+
+        OrdemAntiga* antiga = &ordens_antigas[i];
+        memset(antiga, 0, sizeof(OrdemAntiga));
+        antiga->id = ordem.id;
+        antiga->trader_id = ordem.trader_id;
+        antiga->acao_id = ordem.acao_id;
+        antiga->tipo = ordem.tipo;
+        antiga->preco = ordem.preco;
+        antiga->quantidade = ordem.quantidade;
+        antiga->timestamp = ordem.timestamp;
+        antiga->status = ordem.status;
+    }
+}
+
+// Varreduras: oportunidades de todas as ações (uma passada por ação)
+// Mesmo laço sem desvios nos dois layouts, para medir só o acesso à memória
+static long long varrer_antigas() {
+    long long total = 0;
+    for (int acao = 0; acao < MAX_ACOES; acao++) {
+        preco_t referencia = precos_referencia[acao];
+        for (int i = 0; i < TOTAL_ORDENS_LAYOUT; i++) {
+            const OrdemAntiga* ordem = &ordens_antigas[i];
+            total += (ordem->status == 0) & (ordem->acao_id == acao) &
+                     (llabs(ordem->preco - referencia) * 50 <= referencia);
+        }
+    }
+    return total;
+}
+
+static long long varrer_compactas() {
+    long long total = 0;
+    for (int acao = 0; acao < MAX_ACOES; acao++) {
+        preco_t referencia = precos_referencia[acao];
+        for (int i = 0; i < TOTAL_ORDENS_LAYOUT; i++) {
+            const Ordem* ordem = &ordens[i];
+            total += (ordem->status == 0) & (ordem->acao_id == acao) &
+                     (llabs(ordem->preco - referencia) * 50 <= referencia);
+        }
+    }
+    return total;
+}
+
+// Contagem de pendentes por ação (status e ação apenas)
+static long long contar_antigas() {
+    long long total = 0;
+    for (int acao = 0; acao < MAX_ACOES; acao++) {
+        for (int i = 0; i < TOTAL_ORDENS_LAYOUT; i++) {
+            total += (ordens_antigas[i].status == 0) & (ordens_antigas[i].acao_id == acao);
+        }
+    }
+    return total;
+}
+
+static long long contar_compactas() {
+    long long total = 0;
+    for (int acao = 0; acao < MAX_ACOES; acao++) {
+        for (int i = 0; i < TOTAL_ORDENS_LAYOUT; i++) {
+            total += (ordens[i].status == 0) & (ordens[i].acao_id == acao);
+        }
+    }
+    return total;
+}
+
+// Função para medir a melhor de várias repetições (ns por ordem varrida)
+static double medir_varredura(long long (*varrer)(void), long long* resultado) {
+    double melhor = 0.0;
+    for (int r = 0; r < REPETICOES_VARREDURA; r++) {
+        long long inicio = tempo_atual_ns();
+        *resultado = varrer();
+        double ns = (double)(tempo_atual_ns() - inicio) / ((double)TOTAL_ORDENS_LAYOUT * MAX_ACOES);
+        if (r == 0 || ns < melhor) melhor = ns;
+    }
+    sumidouro += *resultado;
+    return melhor;
+}
+
+// Leitura dos preços de todas as ações (variação entre atual e anterior)
+static double medir_precos_antigos(AcaoAntiga* acoes) {
+    double melhor = 0.0;
+    for (int r = 0; r < REPETICOES_PRECOS; r++) {
+        long long inicio = tempo_atual_ns();
+        long long soma = 0;
+        for (int i = 0; i < NUM_ACOES_LAYOUT; i++) {
+            soma += acoes[i].preco_atual - acoes[i].preco_anterior + acoes[i].volume_negociado;
+        }
+        sumidouro += soma;
+        double ns = (double)(tempo_atual_ns() - inicio) / NUM_ACOES_LAYOUT;
+        if (r == 0 || ns < melhor) melhor = ns;
+    }
+    return melhor;
+}
+
+static double medir_precos_atuais(Acao* acoes) {
+    double melhor = 0.0;
+    for (int r = 0; r < REPETICOES_PRECOS; r++) {
+        long long inicio = tempo_atual_ns();
+        long long soma = 0;
+        for (int i = 0; i < NUM_ACOES_LAYOUT; i++) {
+            soma += acoes[i].preco_atual - acoes[i].preco_anterior + acoes[i].volume_negociado;
+        }
+        sumidouro += soma;
+        double ns = (double)(tempo_atual_ns() - inicio) / NUM_ACOES_LAYOUT;
+        if (r == 0 || ns < melhor) melhor = ns;
+    }
+    return melhor;
+}
+
+int main() {
+    gerar_ordens();
+
+    printf("=== BENCHMARK DE LAYOUT DE ORDENS ===\n");
+    printf("Ordens: %d (%d%% pendentes), ações: %d\n", TOTAL_ORDENS_LAYOUT, PERCENTUAL_PENDENTES, MAX_ACOES);
+    printf("Consultas por ação: pendentes (status e ação) e oportunidades (pendentes a até 2%% do preço)\n");
+    printf("%-20s %-13s %-20s %-22s %s\n", "LAYOUT", "BYTES/ORDEM", "PENDENTES (ns/ordem)",
+           "OPORTUNIDADES (ns/ordem)", "RESULTADOS");
+
+    const char* nomes[] = {"registro antigo", "registro compacto"};
+    size_t bytes[] = {sizeof(OrdemAntiga), sizeof(Ordem)};
+    long long (*contar[])(void) = {contar_antigas, contar_compactas};
+    long long (*varrer[])(void) = {varrer_antigas, varrer_compactas};
+    long long pendentes[2], oportunidades[2];
+    double ns_pendentes[2], ns_oportunidades[2];
+
+    for (int i = 0; i < 2; i++) {
+        ns_pendentes[i] = medir_varredura(contar[i], &pendentes[i]);
+        ns_oportunidades[i] = medir_varredura(varrer[i], &oportunidades[i]);
+        printf("%-20s %-13zu %-20.3f %-22.3f %lld / %lld\n", nomes[i], bytes[i],
+               ns_pendentes[i], ns_oportunidades[i], pendentes[i], oportunidades[i]);
+    }
+
+    if (pendentes[1] != pendentes[0] || oportunidades[1] != oportunidades[0]) {
+        printf("✗ Layout %s divergiu do registro antigo\n", nomes[1]);
+        return 1;
+    }
+    printf("✓ Mesmos resultados nos dois layouts\n");
+    printf("Ganho do registro compacto sobre o antigo: pendentes %.1fx, oportunidades %.1fx\n",
+           ns_pendentes[0] / ns_pendentes[1], ns_oportunidades[0] / ns_oportunidades[1]);
+
+    // Preços das ações: mesmo conteúdo nos dois layouts
+    AcaoAntiga* acoes_antigas = calloc(NUM_ACOES_LAYOUT, sizeof(AcaoAntiga));
+    // Alinhadas a uma linha de cache, como no sistema (malloc garante só 16 bytes)
+    Acao* acoes = NULL;
+    if (posix_memalign((void**)&acoes, TAMANHO_CACHE_LINE, NUM_ACOES_LAYOUT * sizeof(Acao)) == 0) {
+        memset(acoes, 0, NUM_ACOES_LAYOUT * sizeof(Acao));
+    }
+    if (!acoes_antigas || !acoes) {
+        printf("✗ Falha ao alocar ações\n");
+        free(acoes_antigas);
+        free(acoes);
+        return 1;
+    }
+    for (int i = 0; i < NUM_ACOES_LAYOUT; i++) {
+        acoes_antigas[i].preco_atual = acoes[i].preco_atual = (10 + i % 100) * ESCALA_PRECO;
+        acoes_antigas[i].preco_anterior = acoes[i].preco_anterior = (10 + (i + 1) % 100) * ESCALA_PRECO;
+        acoes_antigas[i].volume_negociado = acoes[i].volume_negociado = i;
+    }
+
+    printf("\n=== LEITURA DE PREÇOS DAS AÇÕES ===\n");
+    printf("Ações: %d, campos lidos: preco_atual, preco_anterior, volume_negociado\n", NUM_ACOES_LAYOUT);
+    printf("%-22s %-16s %-18s %s\n", "LAYOUT", "BYTES/AÇÃO", "OFFSET PREÇO", "NS/AÇÃO");
+    printf("%-22s %-16zu %-18zu %.2f\n", "layout antigo", sizeof(AcaoAntiga),
+           offsetof(AcaoAntiga, preco_atual), medir_precos_antigos(acoes_antigas));
+    printf("%-22s %-16zu %-18zu %.2f\n", "bloco quente", sizeof(Acao),
+           offsetof(Acao, preco_atual), medir_precos_atuais(acoes));
+
+    free(acoes_antigas);
+    free(acoes);
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
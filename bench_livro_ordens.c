@@ -0,0 +1,225 @@
+#include "trading_system.h"
+
+// Microbenchmark do motor de casamento (livro de ofertas preço-tempo)
+// Gera um fluxo sintético de ordens limitadas em torno de um preço médio que
+// oscila em passeio aleatório; parte das ordens cruza o livro (negócios
+// totais e parciais) e o restante fica em repouso. Algumas ordens caem fora
+// da faixa contígua do livro por ticks para exercitar a reserva.
+// O mesmo fluxo é reproduzido no livro em lista ordenada (LivroOrdens) e no
+// livro indexado por tick (LivroTicks): os negócios precisam ser idênticos e
+// o benchmark compara ordens/s e a distribuição da latência de submissão.
+
+#define TOTAL_ORDENS_BENCH 500000
+#define PRECO_MEDIO_INICIAL (25 * ESCALA_PRECO)
+#define ORDENS_POR_PASSO_MEDIO 1000
+#define ORDENS_POR_ORDEM_DISTANTE 500   // Uma ordem a cada 500 cai fora da faixa contígua
+#define DESLOCAMENTO_DISTANTE_TICKS 2200
+
+static Ordem fluxo[TOTAL_ORDENS_BENCH];
+static double latencias_ns[TOTAL_ORDENS_BENCH];
+
+// Resultado de uma reprodução do fluxo
+typedef struct {
+    long negocios;
+    long quantidade;
+    unsigned long long assinatura; // Hash da sequência de negócios (ids, preço e quantidade)
+    int ordens_em_repouso;
+    double vazao;
+    double p50, p99, p999, maximo;
+} ResultadoLivro;
+
+// Interface comum aos dois livros
+typedef struct {
+    const char* nome;
+    void* (*criar)(void);
+    int (*submeter)(void* livro, const Ordem* ordem, CallbackNegocio callback, void* contexto);
+    int (*ordens_em_repouso)(void* livro);
+    void (*destruir)(void* livro);
+} ImplementacaoLivro;
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Gerador xorshift local (fluxo determinístico)
+static unsigned int estado_aleatorio = 2463534242u;
+
+static unsigned int aleatorio() {
+    estado_aleatorio ^= estado_aleatorio << 13;
+    estado_aleatorio ^= estado_aleatorio >> 17;
+    estado_aleatorio ^= estado_aleatorio << 5;
+    return estado_aleatorio;
+}
+
+// Compras entre -15 e +5 ticks do médio, vendas entre -5 e +15:
+// as pontas mais agressivas cruzam o livro
+static void gerar_fluxo() {
+    preco_t preco_medio = PRECO_MEDIO_INICIAL;
+
+    for (int i = 0; i < TOTAL_ORDENS_BENCH; i++) {
+        if (i % ORDENS_POR_PASSO_MEDIO == 0 && i > 0) {
+            preco_medio += ((int)(aleatorio() % 3) - 1) * TAMANHO_TICK_PADRAO;
+        }
+
+        Ordem* ordem = &fluxo[i];
+        memset(ordem, 0, sizeof(Ordem));
+        ordem->id = i + 1;
+        // Um participante por ordem: com poucos traders a prevenção de
+        // autonegociação recusaria quase todo cruzamento e não haveria o que medir
+        ordem->trader_id = i;
+        ordem->acao_id = 0;
+        ordem->tipo = (aleatorio() & 1) ? 'C' : 'V';
+        int deslocamento = (int)(aleatorio() % 21) - 15;
+        if (ordem->tipo == 'V') deslocamento = -deslocamento;
+        ordem->quantidade = 100 * (1 + aleatorio() % 10);
+
+        // Ordens distantes: metade fica em repouso fora da faixa, metade varre o lado oposto
+        if (i % ORDENS_POR_ORDEM_DISTANTE == ORDENS_POR_ORDEM_DISTANTE - 1) {
+            deslocamento = (aleatorio() & 1) ? DESLOCAMENTO_DISTANTE_TICKS : -DESLOCAMENTO_DISTANTE_TICKS;
+            ordem->quantidade = 100;
+        }
+        ordem->preco = preco_medio + deslocamento * TAMANHO_TICK_PADRAO;
+    }
+}
+
+static void contar_negocio(const Negocio* negocio, void* contexto) {
+    ResultadoLivro* resultado = (ResultadoLivro*)contexto;
+    resultado->negocios++;
+    resultado->quantidade += negocio->quantidade;
+    resultado->assinatura = resultado->assinatura * 1099511628211ULL ^
+                            ((unsigned long long)negocio->ordem_compra_id << 32 | (unsigned)negocio->ordem_venda_id);
+    resultado->assinatura = resultado->assinatura * 1099511628211ULL ^
+                            ((unsigned long long)(negocio->preco / TAMANHO_TICK_PADRAO) << 20 | negocio->quantidade);
+}
+
+static int comparar_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Adaptadores do livro em lista ordenada
+static void* criar_lista(void) {
+    LivroOrdens* livro = malloc(sizeof(LivroOrdens));
+    if (livro) livro_inicializar(livro, 0, TAMANHO_TICK_PADRAO);
+    return livro;
+}
+
+static int submeter_lista(void* livro, const Ordem* ordem, CallbackNegocio callback, void* contexto) {
+    return livro_submeter_ordem((LivroOrdens*)livro, ordem, callback, contexto);
+}
+
+static int repouso_lista(void* livro) {
+    return ((LivroOrdens*)livro)->ordens_em_repouso;
+}
+
+static void destruir_lista(void* livro) {
+    livro_liberar((LivroOrdens*)livro);
+    free(livro);
+}
+
+// Adaptadores do livro por ticks (faixa centrada no preço médio inicial)
+static void* criar_ticks(void) {
+    LivroTicks* livro = malloc(sizeof(LivroTicks));
+    if (livro && !livro_ticks_inicializar(livro, 0, PRECO_MEDIO_INICIAL, TAMANHO_TICK_PADRAO)) {
+        free(livro);
+        return NULL;
+    }
+    return livro;
+}
+
+static int submeter_ticks(void* livro, const Ordem* ordem, CallbackNegocio callback, void* contexto) {
+    return livro_ticks_submeter_ordem((LivroTicks*)livro, ordem, callback, contexto);
+}
+
+static int repouso_ticks(void* livro) {
+    LivroTicks* ticks = (LivroTicks*)livro;
+    return ticks->ordens_em_repouso + ticks->fora_da_faixa.ordens_em_repouso;
+}
+
+static void destruir_ticks(void* livro) {
+    livro_ticks_liberar((LivroTicks*)livro);
+    free(livro);
+}
+
+// Função para reproduzir o fluxo em um livro: vazão, negócios e latência
+static int reproduzir_fluxo(const ImplementacaoLivro* impl, ResultadoLivro* resultado) {
+    memset(resultado, 0, sizeof(ResultadoLivro));
+
+    // Vazão: fluxo inteiro sem relógio por ordem
+    void* livro = impl->criar();
+    if (!livro) return 0;
+    long long inicio = tempo_atual_ns();
+    for (int i = 0; i < TOTAL_ORDENS_BENCH; i++) {
+        impl->submeter(livro, &fluxo[i], contar_negocio, resultado);
+    }
+    double duracao_s = (tempo_atual_ns() - inicio) / 1e9;
+    resultado->ordens_em_repouso = impl->ordens_em_repouso(livro);
+    resultado->vazao = TOTAL_ORDENS_BENCH / duracao_s;
+    impl->destruir(livro);
+
+    // Latência: mesmo fluxo medindo cada submissão
+    livro = impl->criar();
+    if (!livro) return 0;
+    for (int i = 0; i < TOTAL_ORDENS_BENCH; i++) {
+        long long antes = tempo_atual_ns();
+        impl->submeter(livro, &fluxo[i], NULL, NULL);
+        latencias_ns[i] = (double)(tempo_atual_ns() - antes);
+    }
+    impl->destruir(livro);
+
+    qsort(latencias_ns, TOTAL_ORDENS_BENCH, sizeof(double), comparar_double);
+    resultado->p50 = latencias_ns[TOTAL_ORDENS_BENCH / 2];
+    resultado->p99 = latencias_ns[(long)TOTAL_ORDENS_BENCH * 99 / 100];
+    resultado->p999 = latencias_ns[(long)TOTAL_ORDENS_BENCH * 999 / 1000];
+    resultado->maximo = latencias_ns[TOTAL_ORDENS_BENCH - 1];
+    return 1;
+}
+
+int main() {
+    ImplementacaoLivro implementacoes[] = {
+        {"lista", criar_lista, submeter_lista, repouso_lista, destruir_lista},
+        {"ticks", criar_ticks, submeter_ticks, repouso_ticks, destruir_ticks},
+    };
+    int num_implementacoes = sizeof(implementacoes) / sizeof(implementacoes[0]);
+    ResultadoLivro resultados[2];
+
+    gerar_fluxo();
+
+    printf("=== BENCHMARK DO MOTOR DE CASAMENTO ===\n");
+    printf("Ordens: %d, preço médio inicial: R$ %.2f, tick: R$ %.2f, níveis contíguos: %d\n",
+           TOTAL_ORDENS_BENCH, PRECO_EM_REAIS(PRECO_MEDIO_INICIAL), PRECO_EM_REAIS(TAMANHO_TICK_PADRAO), NIVEIS_LIVRO_TICKS);
+    printf("%-7s %-14s %-10s %-10s %-10s %-10s %-11s %s\n", "LIVRO", "ORDENS/S",
+           "P50 (ns)", "P99 (ns)", "P99.9 (ns)", "MÁX (ns)", "NEGÓCIOS", "REPOUSO");
+
+    for (int i = 0; i < num_implementacoes; i++) {
+        ResultadoLivro* r = &resultados[i];
+        if (!reproduzir_fluxo(&implementacoes[i], r)) {
+            printf("✗ Falha ao criar livro %s\n", implementacoes[i].nome);
+            return 1;
+        }
+        printf("%-7s %-14.0f %-10.0f %-10.0f %-10.0f %-10.0f %-11ld %d\n", implementacoes[i].nome,
+               r->vazao, r->p50, r->p99, r->p999, r->maximo, r->negocios, r->ordens_em_repouso);
+    }
+
+    // Os dois livros precisam produzir exatamente a mesma sequência de negócios
+    if (resultados[0].negocios != resultados[1].negocios ||
+        resultados[0].quantidade != resultados[1].quantidade ||
+        resultados[0].assinatura != resultados[1].assinatura ||
+        resultados[0].ordens_em_repouso != resultados[1].ordens_em_repouso) {
+        printf("✗ Livros divergiram: %ld/%ld negócios, %ld/%ld ações, %d/%d em repouso\n",
+               resultados[0].negocios, resultados[1].negocios,
+               resultados[0].quantidade, resultados[1].quantidade,
+               resultados[0].ordens_em_repouso, resultados[1].ordens_em_repouso);
+        return 1;
+    }
+    printf("✓ Mesma sequência de negócios nos dois livros (%ld ações negociadas)\n", resultados[0].quantidade);
+    printf("Ganho do livro por ticks: %.1fx em vazão, %.1fx no p99\n",
+           resultados[1].vazao / resultados[0].vazao,
+           resultados[1].p99 > 0 ? resultados[0].p99 / resultados[1].p99 : 0.0);
+
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
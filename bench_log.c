@@ -0,0 +1,135 @@
+#include "trading_system.h"
+
+// Benchmark do logger assíncrono
+// Mede a vazão do executor (executar_ordens_pendentes, que registra cada
+// execução e um log_evento por ordem) em três modos de log: sem destino,
+// síncrono (formata e escreve na hora, como o printf antigo) e assíncrono
+// (anel por thread + thread de fundo). Os dois últimos escrevem em /dev/null
+// para medir só o custo de CPU, sem o terminal.
+
+#define ORDENS_POR_RODADA 5000 // 2 registros por ordem cabem no anel de uma thread
+#define NUM_RODADAS 40
+
+#define MODO_LOG_DESLIGADO 0
+#define MODO_LOG_SINCRONO 1
+#define MODO_LOG_ASSINCRONO 2
+
+static HandleOrdem handles[ORDENS_POR_RODADA];
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Ordens pendentes no preço atual, com saldo e ações de sobra: todas executam
+static void preparar_rodada(TradingSystem* sistema, int rodada) {
+    for (int i = 0; i < ORDENS_POR_RODADA; i++) {
+        Ordem ordem;
+        memset(&ordem, 0, sizeof(Ordem));
+        ordem.trader_id = i % sistema->num_traders;
+        ordem.acao_id = (i + rodada) % sistema->num_acoes;
+        ordem.tipo = (i & 1) ? 'V' : 'C';
+        ordem.preco = sistema->acoes[ordem.acao_id].preco_atual;
+        ordem.quantidade = 1 + i % 10;
+        ordem.timestamp = time(NULL);
+        ordem.id = gerar_id_ordem(sistema);
+        handles[i] = pool_ordens_alocar(&sistema->ordens, &ordem, NULL);
+    }
+}
+
+// O executor devolve ao pool as ordens que executa ou cancela; as que sobraram saem aqui
+static void encerrar_rodada(TradingSystem* sistema) {
+    for (int i = 0; i < ORDENS_POR_RODADA; i++) {
+        pool_ordens_liberar_ordem(&sistema->ordens, handles[i]);
+    }
+}
+
+// Retorna ns por ordem no executor; *ns_drenagem recebe o tempo até o
+// logger esvaziar os anéis (só no modo assíncrono)
+static double medir_modo(TradingSystem* sistema, int modo, FILE* nulo, double* ns_drenagem,
+                         int* executadas) {
+    log_definir_destino(modo == MODO_LOG_DESLIGADO ? NULL : nulo);
+    if (modo == MODO_LOG_ASSINCRONO) {
+        log_assincrono_iniciar(nulo);
+    }
+
+    int executadas_antes = sistema->executor.ordens_executadas;
+    long long total_executor = 0;
+    long long total_drenagem = 0;
+    for (int rodada = 0; rodada < NUM_RODADAS; rodada++) {
+        preparar_rodada(sistema, rodada);
+
+        long long inicio = tempo_atual_ns();
+        executar_ordens_pendentes(sistema);
+        long long fim = tempo_atual_ns();
+        total_executor += fim - inicio;
+
+        if (modo == MODO_LOG_ASSINCRONO) {
+            log_assincrono_aguardar();
+            total_drenagem += tempo_atual_ns() - fim;
+        }
+        encerrar_rodada(sistema);
+    }
+
+    log_assincrono_parar();
+    *executadas = sistema->executor.ordens_executadas - executadas_antes;
+    *ns_drenagem = (double)total_drenagem / (NUM_RODADAS * ORDENS_POR_RODADA);
+    return (double)total_executor / (NUM_RODADAS * ORDENS_POR_RODADA);
+}
+
+int main() {
+    printf("=== BENCHMARK DO LOGGER ASSÍNCRONO ===\n");
+    printf("Ordens: %d rodadas x %d, registro de %zu bytes, anel de %d registros\n\n",
+           NUM_RODADAS, ORDENS_POR_RODADA, sizeof(RegistroLog), CAPACIDADE_ANEL_LOG);
+
+    TradingSystem* sistema = inicializar_sistema();
+    if (!sistema) {
+        return 1;
+    }
+    for (int i = 0; i < sistema->num_traders; i++) {
+        sistema->traders[i].saldo = PRECO_DE_REAIS(1e9);
+        for (int j = 0; j < sistema->num_acoes; j++) {
+            sistema->traders[i].acoes_possuidas[j] = 1000000000;
+        }
+    }
+
+    FILE* nulo = fopen("/dev/null", "w");
+    if (!nulo) {
+        perror("fopen /dev/null");
+        return 1;
+    }
+
+    const char* nomes[] = {"sem destino", "síncrono", "assíncrono"};
+    double ns_ordem[3], ns_drenagem[3];
+    int executadas[3];
+    for (int modo = 0; modo < 3; modo++) {
+        ns_ordem[modo] = medir_modo(sistema, modo, nulo, &ns_drenagem[modo], &executadas[modo]);
+    }
+    log_definir_destino(stdout);
+
+    printf("%-14s %-16s %-18s %-20s %s\n", "LOG", "NS/ORDEM", "ORDENS/S", "DRENAGEM (ns/ordem)", "EXECUTADAS");
+    for (int modo = 0; modo < 3; modo++) {
+        printf("%-14s %-16.1f %-18.0f %-20.1f %d\n", nomes[modo], ns_ordem[modo],
+               1e9 / ns_ordem[modo], ns_drenagem[modo], executadas[modo]);
+    }
+    printf("Executor com log assíncrono: %.1fx a vazão do log síncrono (%.0f%% acima do custo sem destino)\n",
+           ns_ordem[MODO_LOG_SINCRONO] / ns_ordem[MODO_LOG_ASSINCRONO],
+           100.0 * (ns_ordem[MODO_LOG_ASSINCRONO] - ns_ordem[MODO_LOG_DESLIGADO]) / ns_ordem[MODO_LOG_DESLIGADO]);
+
+    int total = NUM_RODADAS * ORDENS_POR_RODADA;
+    int ok = executadas[0] == total && executadas[1] == total && executadas[2] == total &&
+             log_registros_descartados() == 0;
+
+    fclose(nulo);
+    limpar_sistema(sistema);
+
+    if (!ok) {
+        printf("✗ Nem todas as ordens executaram ou houve registros descartados (%lu)\n",
+               log_registros_descartados());
+        return 1;
+    }
+    printf("✓ %d ordens executadas em cada modo, nenhum registro descartado\n", total);
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
@@ -0,0 +1,192 @@
+#include "trading_system.h"
+
+// Benchmark do índice de pares do monitor de arbitragem
+// Universo sintético de N ações em grupos (setores) de TAMANHO_GRUPO_BENCH,
+// mais N/4 pares relacionados entre grupos. A cada rodada N/100 ações (no
+// mínimo uma) mudam de preço, e o monitor procura diferenças acima de 2%:
+// - varredura completa: todos os n(n-1)/2 pares (o monitor antigo);
+// - índice: só os pares indexados das ações que mudaram.
+// Confere numa rodada que o índice encontra exatamente as oportunidades da
+// força bruta restrita aos pares monitorados das ações alteradas.
+
+#define TAMANHO_GRUPO_BENCH 8
+#define PARES_VARREDURA_BENCH 200000000LL // Pares comparados por tamanho na varredura completa
+#define RODADAS_INDICE_BENCH 20000
+
+static const int TAMANHOS_BENCH[] = {13, 1000, 10000};
+#define NUM_TAMANHOS_BENCH 3
+
+static volatile long long sumidouro; // Impede que o compilador descarte as contagens
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Mesmo critério do monitor: diferença acima de 2% da média
+static inline int par_com_oportunidade(preco_t preco1, preco_t preco2) {
+    double diferenca = PRECO_EM_REAIS(llabs(preco1 - preco2));
+    double media = PRECO_EM_REAIS(preco1 + preco2) / 2.0;
+    return diferenca / media > 0.02;
+}
+
+// Função para mudar o preço de N/100 ações (no mínimo uma)
+static void variar_precos(preco_t* precos, int num_acoes) {
+    int mudancas = num_acoes / 100 > 0 ? num_acoes / 100 : 1;
+    for (int m = 0; m < mudancas; m++) {
+        int acao = aleatorio_proximo() % num_acoes;
+        long long passo = (long long)(aleatorio_proximo() % 10) + 1;
+        precos[acao] += (aleatorio_proximo() % 2 ? passo : -passo) * TAMANHO_TICK_PADRAO;
+        if (precos[acao] < MIN_PRECO_ACAO) precos[acao] = MIN_PRECO_ACAO + TAMANHO_TICK_PADRAO;
+    }
+}
+
+static long long varredura_completa(const preco_t* precos, int num_acoes) {
+    long long encontradas = 0;
+    for (int i = 0; i < num_acoes - 1; i++) {
+        for (int j = i + 1; j < num_acoes; j++) {
+            encontradas += par_com_oportunidade(precos[i], precos[j]);
+        }
+    }
+    return encontradas;
+}
+
+static long long varredura_indice(IndicePares* indice, const preco_t* precos, int* avaliados) {
+    const int* pares;
+    int num_pares = indice_pares_alterados(indice, precos, &pares);
+    long long encontradas = 0;
+    for (int k = 0; k < num_pares; k++) {
+        const ParAcoes* par = &indice->pares[pares[k]];
+        encontradas += par_com_oportunidade(precos[par->acao1], precos[par->acao2]);
+    }
+    *avaliados = num_pares;
+    return encontradas;
+}
+
+static int par_indexado(const IndicePares* indice, int acao1, int acao2) {
+    int inicio = 0, fim = indice->num_pares - 1;
+    while (inicio <= fim) {
+        int meio = (inicio + fim) / 2;
+        const ParAcoes* par = &indice->pares[meio];
+        if (par->acao1 == acao1 && par->acao2 == acao2) return 1;
+        if (par->acao1 < acao1 || (par->acao1 == acao1 && par->acao2 < acao2)) {
+            inicio = meio + 1;
+        } else {
+            fim = meio - 1;
+        }
+    }
+    return 0;
+}
+
+// Função para medir e conferir um tamanho de universo
+// Retorna 1 se o índice conferiu com a força bruta
+static int executar_tamanho(int num_acoes) {
+    preco_t* precos = malloc(sizeof(preco_t) * num_acoes);
+    int* grupos = malloc(sizeof(int) * num_acoes);
+    int num_extras = num_acoes / 4;
+    ParAcoes* extras = malloc(sizeof(ParAcoes) * (num_extras + 1));
+    preco_t* anteriores = malloc(sizeof(preco_t) * num_acoes);
+
+    aleatorio_configurar_semente(SEMENTE_SIMULACAO_PADRAO + num_acoes);
+    for (int i = 0; i < num_acoes; i++) {
+        precos[i] = PRECO_DE_REAIS(20.0) + (aleatorio_proximo() % 2000) * TAMANHO_TICK_PADRAO;
+        grupos[i] = i / TAMANHO_GRUPO_BENCH;
+    }
+    for (int e = 0; e < num_extras; e++) {
+        extras[e].acao1 = aleatorio_proximo() % num_acoes;
+        extras[e].acao2 = aleatorio_proximo() % num_acoes;
+    }
+
+    IndicePares indice;
+    if (!indice_pares_construir(&indice, num_acoes, grupos, extras, num_extras)) {
+        printf("✗ Falha ao construir o índice para %d ações\n", num_acoes);
+        return 0;
+    }
+    int avaliados;
+    varredura_indice(&indice, precos, &avaliados); // Primeira rodada: preços iniciais
+
+    // Varredura completa
+    long long total_pares = (long long)num_acoes * (num_acoes - 1) / 2;
+    int rodadas_completa = (int)(PARES_VARREDURA_BENCH / total_pares);
+    if (rodadas_completa < 3) rodadas_completa = 3;
+    if (rodadas_completa > RODADAS_INDICE_BENCH) rodadas_completa = RODADAS_INDICE_BENCH;
+    long long encontradas = 0;
+    long long inicio = tempo_atual_ns();
+    for (int r = 0; r < rodadas_completa; r++) {
+        variar_precos(precos, num_acoes);
+        encontradas += varredura_completa(precos, num_acoes);
+    }
+    double us_completa = (tempo_atual_ns() - inicio) / 1e3 / rodadas_completa;
+    sumidouro = encontradas;
+
+    // Índice: só os pares das ações alteradas
+    long long soma_avaliados = 0;
+    encontradas = 0;
+    varredura_indice(&indice, precos, &avaliados); // Absorve as mudanças da varredura completa
+    inicio = tempo_atual_ns();
+    for (int r = 0; r < RODADAS_INDICE_BENCH; r++) {
+        variar_precos(precos, num_acoes);
+        encontradas += varredura_indice(&indice, precos, &avaliados);
+        soma_avaliados += avaliados;
+    }
+    double us_indice = (tempo_atual_ns() - inicio) / 1e3 / RODADAS_INDICE_BENCH;
+    sumidouro = encontradas;
+
+    printf("%-8d %-12lld %-10d %-14.1f %-12.1f %-12.2f %.0fx\n",
+           num_acoes, total_pares, indice.num_pares, (double)soma_avaliados / RODADAS_INDICE_BENCH,
+           us_completa, us_indice, us_completa / us_indice);
+
+    // Conferir uma rodada contra a força bruta nos pares indexados
+    // (alterada: preço diferente do anterior à rodada)
+    memcpy(anteriores, precos, sizeof(preco_t) * num_acoes);
+    variar_precos(precos, num_acoes);
+    const int* pares;
+    int num_pares = indice_pares_alterados(&indice, precos, &pares);
+    long long esperadas = 0, obtidas = 0;
+    int esperados_avaliados = 0;
+    for (int i = 0; i < num_acoes - 1; i++) {
+        for (int j = i + 1; j < num_acoes; j++) {
+            if ((precos[i] != anteriores[i] || precos[j] != anteriores[j]) && par_indexado(&indice, i, j)) {
+                esperados_avaliados++;
+                esperadas += par_com_oportunidade(precos[i], precos[j]);
+            }
+        }
+    }
+    for (int k = 0; k < num_pares; k++) {
+        const ParAcoes* par = &indice.pares[pares[k]];
+        obtidas += par_com_oportunidade(precos[par->acao1], precos[par->acao2]);
+    }
+    int ok = num_pares == esperados_avaliados && obtidas == esperadas;
+    if (!ok) {
+        printf("✗ %d ações: índice avaliou %d pares (%lld oportunidades), força bruta %d (%lld)\n",
+               num_acoes, num_pares, obtidas, esperados_avaliados, esperadas);
+    }
+
+    indice_pares_liberar(&indice);
+    free(precos);
+    free(grupos);
+    free(extras);
+    free(anteriores);
+    return ok;
+}
+
+int main() {
+    printf("=== BENCHMARK DO ÍNDICE DE PARES DO MONITOR DE ARBITRAGEM ===\n");
+    printf("Grupos de %d ações, N/4 pares relacionados, N/100 ações alteradas por rodada\n\n",
+           TAMANHO_GRUPO_BENCH);
+    printf("%-8s %-12s %-10s %-14s %-12s %-12s %s\n",
+           "AÇÕES", "PARES", "INDEXADOS", "AVALIADOS/RD", "US COMPLETA", "US ÍNDICE", "GANHO");
+
+    int ok = 1;
+    for (int t = 0; t < NUM_TAMANHOS_BENCH; t++) {
+        ok &= executar_tamanho(TAMANHOS_BENCH[t]);
+    }
+
+    if (!ok) {
+        return 1;
+    }
+    printf("\n✓ Índice encontra as mesmas oportunidades da força bruta nos pares monitorados\n");
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
@@ -0,0 +1,217 @@
+#include "trading_system.h"
+#include <sys/wait.h>
+
+// Benchmark do pool de ordens
+// Compara o pool em blocos (lista livre, sem malloc por ordem) com malloc/free
+// de cada ordem em três cargas: carga inicial de milhões de ordens vivas,
+// rotatividade (libera uma ordem aleatória e aloca outra) e varredura de todas
+// as ordens, como fazem executor e monitor. Também confere que
+// handles obsoletos são rejeitados e que ordens alocadas por um processo filho
+// ficam visíveis ao pai no modo compartilhado.
+
+#define TOTAL_ORDENS_POOL 2000000
+#define OPERACOES_ROTATIVIDADE 4000000
+#define ORDENS_PROCESSO_FILHO (ORDENS_POR_SLAB * 3)
+
+static HandleOrdem handles[TOTAL_ORDENS_POOL];
+static Ordem* ponteiros[TOTAL_ORDENS_POOL];
+static volatile long long sumidouro; // Impede que o compilador descarte as varreduras
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Gerador xorshift local (fluxo determinístico)
+static unsigned int estado_aleatorio = 2463534242u;
+
+static unsigned int aleatorio() {
+    estado_aleatorio ^= estado_aleatorio << 13;
+    estado_aleatorio ^= estado_aleatorio >> 17;
+    estado_aleatorio ^= estado_aleatorio << 5;
+    return estado_aleatorio;
+}
+
+static Ordem montar_ordem(int i) {
+    Ordem ordem;
+    memset(&ordem, 0, sizeof(Ordem));
+    ordem.id = i;
+    ordem.trader_id = i % MAX_TRADERS;
+    ordem.acao_id = i % MAX_ACOES;
+    ordem.tipo = (i & 1) ? 'C' : 'V';
+    ordem.preco = (10 + i % 90) * ESCALA_PRECO;
+    ordem.quantidade = 100;
+    return ordem;
+}
+
+// Carga inicial + rotatividade + varredura no pool. Retorna ns/operação de cada fase
+static void medir_pool(PoolOrdens* pool, double* ns_carga, double* ns_rotatividade, double* ns_varredura) {
+    estado_aleatorio = 2463534242u;
+
+    long long inicio = tempo_atual_ns();
+    for (int i = 0; i < TOTAL_ORDENS_POOL; i++) {
+        Ordem ordem = montar_ordem(i);
+        handles[i] = pool_ordens_alocar(pool, &ordem, NULL);
+    }
+    *ns_carga = (double)(tempo_atual_ns() - inicio) / TOTAL_ORDENS_POOL;
+
+    inicio = tempo_atual_ns();
+    for (int i = 0; i < OPERACOES_ROTATIVIDADE; i++) {
+        int posicao = aleatorio() % TOTAL_ORDENS_POOL;
+        pool_ordens_liberar_ordem(pool, handles[posicao]);
+        Ordem ordem = montar_ordem(i);
+        handles[posicao] = pool_ordens_alocar(pool, &ordem, NULL);
+    }
+    *ns_rotatividade = (double)(tempo_atual_ns() - inicio) / OPERACOES_ROTATIVIDADE;
+
+    // Mesmo laço de verificar_oportunidades_execucao(): todos os slots até o limite
+    inicio = tempo_atual_ns();
+    long long total = 0;
+    int limite = pool_ordens_limite(pool);
+    for (int i = 0; i < limite; i++) {
+        Ordem* ordem = pool_ordens_slot(pool, i);
+        if (ordem) total += ordem->quantidade;
+    }
+    *ns_varredura = (double)(tempo_atual_ns() - inicio) / limite;
+    sumidouro = total;
+}
+
+// Mesma carga com malloc/free de cada ordem
+static void medir_malloc(double* ns_carga, double* ns_rotatividade, double* ns_varredura) {
+    estado_aleatorio = 2463534242u;
+
+    long long inicio = tempo_atual_ns();
+    for (int i = 0; i < TOTAL_ORDENS_POOL; i++) {
+        ponteiros[i] = malloc(sizeof(Ordem));
+        *ponteiros[i] = montar_ordem(i);
+    }
+    *ns_carga = (double)(tempo_atual_ns() - inicio) / TOTAL_ORDENS_POOL;
+
+    inicio = tempo_atual_ns();
+    for (int i = 0; i < OPERACOES_ROTATIVIDADE; i++) {
+        int posicao = aleatorio() % TOTAL_ORDENS_POOL;
+        free(ponteiros[posicao]);
+        ponteiros[posicao] = malloc(sizeof(Ordem));
+        *ponteiros[posicao] = montar_ordem(i);
+    }
+    *ns_rotatividade = (double)(tempo_atual_ns() - inicio) / OPERACOES_ROTATIVIDADE;
+
+    inicio = tempo_atual_ns();
+    long long total = 0;
+    for (int i = 0; i < TOTAL_ORDENS_POOL; i++) {
+        total += ponteiros[i]->quantidade;
+    }
+    *ns_varredura = (double)(tempo_atual_ns() - inicio) / TOTAL_ORDENS_POOL;
+    sumidouro = total;
+
+    for (int i = 0; i < TOTAL_ORDENS_POOL; i++) {
+        free(ponteiros[i]);
+    }
+}
+
+// Handles liberados não podem mais acessar o slot, mesmo após reuso
+static int verificar_handles_obsoletos() {
+    PoolOrdens pool;
+    pool_ordens_inicializar(&pool, 0);
+
+    Ordem ordem = montar_ordem(7);
+    HandleOrdem antigo = pool_ordens_alocar(&pool, &ordem, NULL);
+    int ok = pool_ordens_obter(&pool, antigo) != NULL;
+    ok &= pool_ordens_liberar_ordem(&pool, antigo) == 1;
+    ok &= pool_ordens_obter(&pool, antigo) == NULL;
+    ok &= pool_ordens_liberar_ordem(&pool, antigo) == 0; // Liberação dupla rejeitada
+
+    HandleOrdem novo = pool_ordens_alocar(&pool, &ordem, NULL);
+    ok &= (novo & 0xFFFFFFFFu) == (antigo & 0xFFFFFFFFu); // Mesmo slot reaproveitado
+    ok &= pool_ordens_obter(&pool, antigo) == NULL;
+    ok &= pool_ordens_obter(&pool, novo) != NULL;
+    ok &= pool_ordens_obter(&pool, HANDLE_ORDEM_INVALIDO) == NULL;
+
+    pool_ordens_liberar(&pool);
+    return ok;
+}
+
+// Pool em memória compartilhada: o filho cria blocos novos, o pai lê as ordens
+static int verificar_modo_compartilhado() {
+    int shm_pool = shmget(IPC_PRIVATE, sizeof(PoolOrdens), IPC_CREAT | 0666);
+    if (shm_pool == -1) {
+        perror("shmget");
+        return 0;
+    }
+    PoolOrdens* pool = (PoolOrdens*)shmat(shm_pool, NULL, 0);
+    if (pool == (void*)-1) {
+        perror("shmat");
+        shmctl(shm_pool, IPC_RMID, NULL);
+        return 0;
+    }
+    pool_ordens_inicializar(pool, 1);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        for (int i = 0; i < ORDENS_PROCESSO_FILHO; i++) {
+            Ordem ordem = montar_ordem(i);
+            if (pool_ordens_alocar(pool, &ordem, NULL) == HANDLE_ORDEM_INVALIDO) {
+                _exit(1);
+            }
+        }
+        _exit(0);
+    }
+
+    int status = 1;
+    waitpid(pid, &status, 0);
+    int ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    ok &= pool_ordens_vivas(pool) == ORDENS_PROCESSO_FILHO;
+    for (int i = 0; ok && i < ORDENS_PROCESSO_FILHO; i++) {
+        Ordem* ordem = pool_ordens_slot(pool, i);
+        ok &= ordem != NULL && ordem->id == i && ordem->preco == montar_ordem(i).preco;
+    }
+
+    pool_ordens_liberar(pool);
+    shmdt(pool);
+    shmctl(shm_pool, IPC_RMID, NULL);
+    return ok;
+}
+
+int main() {
+    printf("=== BENCHMARK DO POOL DE ORDENS ===\n");
+    printf("Ordens vivas: %d, operações de rotatividade: %d, ordens por bloco: %d\n",
+           TOTAL_ORDENS_POOL, OPERACOES_ROTATIVIDADE, ORDENS_POR_SLAB);
+    printf("Capacidade do pool: %d ordens (%zu bytes por slot)\n\n", MAX_ORDENS, sizeof(SlotOrdem));
+
+    PoolOrdens pool;
+    pool_ordens_inicializar(&pool, 0);
+    double ns_pool[3], ns_malloc[3];
+    medir_pool(&pool, &ns_pool[0], &ns_pool[1], &ns_pool[2]);
+    int vivas = pool_ordens_vivas(&pool);
+    int limite = pool_ordens_limite(&pool);
+    pool_ordens_liberar(&pool);
+    medir_malloc(&ns_malloc[0], &ns_malloc[1], &ns_malloc[2]);
+
+    printf("%-16s %-18s %-22s %s\n", "ALOCADOR", "CARGA (ns/ordem)", "ROTATIVIDADE (ns/op)", "VARREDURA (ns/ordem)");
+    printf("%-16s %-18.2f %-22.2f %.2f\n", "malloc/free", ns_malloc[0], ns_malloc[1], ns_malloc[2]);
+    printf("%-16s %-18.2f %-22.2f %.2f\n", "pool em blocos", ns_pool[0], ns_pool[1], ns_pool[2]);
+    printf("Pool / malloc: carga %.1fx, rotatividade %.1fx, varredura %.1fx\n\n",
+           ns_malloc[0] / ns_pool[0], ns_malloc[1] / ns_pool[1], ns_malloc[2] / ns_pool[2]);
+
+    if (vivas != TOTAL_ORDENS_POOL || limite != TOTAL_ORDENS_POOL) {
+        printf("✗ Pool terminou com %d ordens vivas e limite %d (esperado %d)\n",
+               vivas, limite, TOTAL_ORDENS_POOL);
+        return 1;
+    }
+    printf("✓ Slots liberados reaproveitados (limite %d após rotatividade)\n", limite);
+
+    if (!verificar_handles_obsoletos()) {
+        printf("✗ Handle obsoleto aceito pelo pool\n");
+        return 1;
+    }
+    printf("✓ Handles obsoletos rejeitados após liberação e reuso do slot\n");
+
+    if (!verificar_modo_compartilhado()) {
+        printf("✗ Ordens do processo filho não visíveis no pool compartilhado\n");
+        return 1;
+    }
+    printf("✓ %d ordens alocadas por processo filho visíveis no pai\n", ORDENS_PROCESSO_FILHO);
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
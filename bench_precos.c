@@ -0,0 +1,150 @@
+#define _POSIX_C_SOURCE 200809L
+#include "trading_system.h"
+
+// Benchmark da leitura de preços publicados
+// Um escritor (o price updater) atualiza preço atual, anterior e variação
+// de uma ação sem parar, com o mutex da ação; leitores (traders, monitor)
+// leem os três campos de três formas:
+// - direto nos campos, sem lock (como antes): rápido, mas pode misturar
+//   campos de duas atualizações;
+// - com o mutex da ação: consistente, mas disputa o lock com o escritor;
+// - com ler_preco_acao (seqlock): consistente e sem lock.
+// Cada leitura confere se a variação bate com o preço atual e o anterior.
+
+#define DURACAO_MODO_MS 1000
+#define MAX_LEITORES 4
+
+#define MODO_DIRETO 0
+#define MODO_MUTEX 1
+#define MODO_SEQLOCK 2
+
+static const char* NOMES_MODOS[] = {"Campos sem lock", "Mutex da ação", "Seqlock"};
+
+static Acao acao;
+static int modo_atual;
+static volatile int executando;
+
+typedef struct {
+    long long leituras;
+    long long inconsistentes;
+} ResultadoLeitor;
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static double variacao_esperada(preco_t atual, preco_t anterior) {
+    return (double)(atual - anterior) / anterior;
+}
+
+static void* thread_escritor(void* arg) {
+    (void)arg;
+    preco_t preco = PRECO_DE_REAIS(25.0);
+    long long passo = 0;
+    while (executando) {
+        preco_t novo = preco + ((passo++ & 1) ? TAMANHO_TICK_PADRAO * 3 : -TAMANHO_TICK_PADRAO * 2);
+        pthread_mutex_lock(&acao.mutex);
+        if (modo_atual == MODO_SEQLOCK) {
+            publicar_preco_acao(&acao, novo, preco, variacao_esperada(novo, preco));
+        } else {
+            acao.preco_anterior = preco;
+            acao.preco_atual = novo;
+            acao.variacao = variacao_esperada(novo, preco);
+        }
+        pthread_mutex_unlock(&acao.mutex);
+        preco = novo;
+    }
+    return NULL;
+}
+
+static void* thread_leitor(void* arg) {
+    ResultadoLeitor* resultado = (ResultadoLeitor*)arg;
+    long long leituras = 0, inconsistentes = 0;
+    InstantaneoPreco instantaneo;
+    while (executando) {
+        if (modo_atual == MODO_SEQLOCK) {
+            ler_preco_acao(&acao, &instantaneo);
+        } else if (modo_atual == MODO_MUTEX) {
+            pthread_mutex_lock(&acao.mutex);
+            instantaneo.preco_atual = acao.preco_atual;
+            instantaneo.preco_anterior = acao.preco_anterior;
+            instantaneo.variacao = acao.variacao;
+            pthread_mutex_unlock(&acao.mutex);
+        } else {
+            instantaneo.preco_atual = *(volatile preco_t*)&acao.preco_atual;
+            instantaneo.preco_anterior = *(volatile preco_t*)&acao.preco_anterior;
+            instantaneo.variacao = *(volatile double*)&acao.variacao;
+        }
+        if (instantaneo.variacao != variacao_esperada(instantaneo.preco_atual, instantaneo.preco_anterior)) {
+            inconsistentes++;
+        }
+        leituras++;
+    }
+    resultado->leituras = leituras;
+    resultado->inconsistentes = inconsistentes;
+    return NULL;
+}
+
+// Retorna o número de leituras inconsistentes
+static long long medir(int modo, int num_leitores) {
+    pthread_t escritor, leitores[MAX_LEITORES];
+    ResultadoLeitor resultados[MAX_LEITORES];
+
+    modo_atual = modo;
+    acao.preco_atual = PRECO_DE_REAIS(25.0);
+    acao.preco_anterior = PRECO_DE_REAIS(25.0);
+    acao.variacao = 0.0;
+    executando = 1;
+
+    pthread_create(&escritor, NULL, thread_escritor, NULL);
+    for (int i = 0; i < num_leitores; i++) {
+        pthread_create(&leitores[i], NULL, thread_leitor, &resultados[i]);
+    }
+
+    long long inicio = tempo_atual_ns();
+    struct timespec duracao = {DURACAO_MODO_MS / 1000, (DURACAO_MODO_MS % 1000) * 1000000L};
+    nanosleep(&duracao, NULL);
+    executando = 0;
+
+    pthread_join(escritor, NULL);
+    long long leituras = 0, inconsistentes = 0;
+    for (int i = 0; i < num_leitores; i++) {
+        pthread_join(leitores[i], NULL);
+        leituras += resultados[i].leituras;
+        inconsistentes += resultados[i].inconsistentes;
+    }
+    double segundos = (tempo_atual_ns() - inicio) / 1e9;
+
+    printf("%-18s %-9d %-18.1f %lld\n", NOMES_MODOS[modo], num_leitores,
+           leituras / segundos / 1e6, inconsistentes);
+    return inconsistentes;
+}
+
+int main() {
+    printf("=== BENCHMARK DA LEITURA DE PREÇOS PUBLICADOS ===\n");
+    printf("Um escritor contínuo, %d ms por medição\n\n", DURACAO_MODO_MS);
+
+    memset(&acao, 0, sizeof(acao));
+    pthread_mutex_init(&acao.mutex, NULL);
+
+    printf("%-18s %-9s %-18s %s\n", "MODO", "LEITORES", "LEITURAS (M/s)", "INCONSISTENTES");
+    long long inconsistentes_seqlock = 0;
+    for (int num_leitores = 1; num_leitores <= MAX_LEITORES; num_leitores *= 2) {
+        medir(MODO_DIRETO, num_leitores);
+        medir(MODO_MUTEX, num_leitores);
+        inconsistentes_seqlock += medir(MODO_SEQLOCK, num_leitores);
+    }
+    printf("\n");
+
+    pthread_mutex_destroy(&acao.mutex);
+
+    if (inconsistentes_seqlock > 0) {
+        printf("✗ Seqlock entregou %lld leituras inconsistentes\n", inconsistentes_seqlock);
+        return 1;
+    }
+    printf("✓ Nenhuma leitura inconsistente com o seqlock\n");
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "trading_system.h"
+
+// Benchmark do replay de ticks
+// Grava um histórico de ticks e mede:
+// - leitura com o LeitorTicks (fread, uma cópia por registro);
+// - leitura do mapeamento do replay (mmap, sem cópia);
+// - replay completo no sistema na velocidade máxima (preço publicado,
+//   estatísticas da janela e log por tick), o limite do price updater.
+// Confere que o preço final de cada ação é o último tick gravado.
+
+#define TICKS_BENCH 2000000
+
+static volatile long long sumidouro; // Impede que o compilador descarte as leituras
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Passeio aleatório das ações do sistema, um tick a cada ~1 ms de pregão
+static int gravar_historico(const char* caminho, TradingSystem* sistema, preco_t* ultimos) {
+    remove(caminho);
+    static GravadorTicks gravador;
+    if (!gravador_ticks_abrir(&gravador, caminho)) {
+        return 0;
+    }
+
+    for (int i = 0; i < sistema->num_acoes; i++) {
+        ultimos[i] = sistema->acoes[i].preco_atual;
+    }
+    aleatorio_configurar_semente(SEMENTE_SIMULACAO_PADRAO);
+    long long instante = INICIO_PREGAO_SIMULADO * 1000000000LL;
+    for (int i = 0; i < TICKS_BENCH; i++) {
+        int acao_id = aleatorio_proximo() % sistema->num_acoes;
+        RegistroTick registro;
+        memset(&registro, 0, sizeof(registro));
+        registro.instante_ns = instante;
+        registro.preco_anterior = ultimos[acao_id];
+        ultimos[acao_id] += ((long long)(aleatorio_proximo() % 21) - 10) * TAMANHO_TICK_PADRAO;
+        if (ultimos[acao_id] < MIN_PRECO_ACAO) ultimos[acao_id] = MIN_PRECO_ACAO;
+        registro.preco_novo = ultimos[acao_id];
+        strncpy(registro.simbolo, sistema->acoes[acao_id].nome, TAMANHO_SIMBOLO_TICK - 1);
+        registro.acao_id = (unsigned short)acao_id;
+        registro.motivo = MOTIVO_TICK_VARIACAO;
+        gravador_ticks_registrar(&gravador, &registro);
+        instante += 1000000LL;
+    }
+    gravador_ticks_fechar(&gravador);
+    return 1;
+}
+
+int main() {
+    printf("=== BENCHMARK DO REPLAY DE TICKS ===\n");
+    printf("Ticks: %d\n\n", TICKS_BENCH);
+
+    configurar_nivel_log(NIVEL_LOG_ERRO);
+    TradingSystem* sistema = inicializar_sistema();
+    if (!sistema) {
+        printf("✗ Falha ao inicializar sistema\n");
+        return 1;
+    }
+
+    char caminho[64];
+    snprintf(caminho, sizeof(caminho), "/tmp/bench_replay_%d.bin", (int)getpid());
+    preco_t ultimos[MAX_ACOES];
+    if (!gravar_historico(caminho, sistema, ultimos)) {
+        limpar_sistema(sistema);
+        return 1;
+    }
+
+    // Leitura com fread
+    LeitorTicks leitor;
+    RegistroTick registro;
+    long long soma = 0;
+    long long inicio = tempo_atual_ns();
+    leitor_ticks_abrir(&leitor, caminho);
+    while (leitor_ticks_proximo(&leitor, &registro)) {
+        soma += registro.preco_novo;
+    }
+    leitor_ticks_fechar(&leitor);
+    double ns_fread = (double)(tempo_atual_ns() - inicio) / TICKS_BENCH;
+    sumidouro = soma;
+
+    // Leitura do mapeamento
+    FonteReplay replay;
+    const RegistroTick* mapeado;
+    soma = 0;
+    inicio = tempo_atual_ns();
+    replay_abrir(&replay, caminho, 0.0);
+    while ((mapeado = replay_proximo(&replay)) != NULL) {
+        soma += mapeado->preco_novo;
+    }
+    replay_fechar(&replay);
+    double ns_mmap = (double)(tempo_atual_ns() - inicio) / TICKS_BENCH;
+    sumidouro = soma;
+
+    // Replay completo no sistema, velocidade máxima
+    int ms_ate_proximo = 0;
+    replay_abrir(&replay, caminho, 0.0);
+    inicio = tempo_atual_ns();
+    while (ms_ate_proximo >= 0) {
+        replay_avancar(sistema, &replay, LOTE_REPLAY_TICKS, &ms_ate_proximo);
+    }
+    double ns_replay = (double)(tempo_atual_ns() - inicio) / TICKS_BENCH;
+    long long aplicados = replay.aplicados;
+    replay_fechar(&replay);
+    remove(caminho);
+
+    printf("%-32s %-14s %s\n", "ETAPA", "NS POR TICK", "MILHÕES DE TICKS/S");
+    printf("%-32s %-14.1f %.1f\n", "Leitura com fread", ns_fread, 1e3 / ns_fread);
+    printf("%-32s %-14.1f %.1f\n", "Leitura do mapeamento (mmap)", ns_mmap, 1e3 / ns_mmap);
+    printf("%-32s %-14.1f %.1f\n\n", "Replay no sistema", ns_replay, 1e3 / ns_replay);
+
+    int ok = aplicados == TICKS_BENCH;
+    for (int i = 0; i < sistema->num_acoes; i++) {
+        ok &= ler_preco_atual(&sistema->acoes[i]) == ultimos[i];
+    }
+    limpar_sistema(sistema);
+
+    if (!ok) {
+        printf("✗ Replay aplicou %lld de %d ticks ou terminou com preços diferentes dos gravados\n",
+               aplicados, TICKS_BENCH);
+        return 1;
+    }
+    printf("✓ %d ticks aplicados, preços finais iguais aos últimos gravados\n", TICKS_BENCH);
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
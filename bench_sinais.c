@@ -0,0 +1,191 @@
+#include "trading_system.h"
+#include <math.h>
+
+// Benchmark dos sinais estatísticos de pares
+// Gera ticks de 8 pares cointegrados em níveis de preço diferentes
+// (log p1 = a + b·log p2 + ruído que volta à média) e mede:
+// - o motor de z-score incremental (somas da janela, O(1) por tick);
+// - a alternativa recalculada: regressão e desvio varrendo a janela a cada tick;
+// - quantos ticks o critério antigo (diferença de nível acima de 2%) marca
+//   como oportunidade, contra os cruzamentos de limiar do z-score.
+// Confere que o z-score incremental e os sinais são iguais aos recalculados.
+
+#define TICKS_BENCH 1000000
+#define NUM_PARES_BENCH 8
+
+typedef struct {
+    int par;
+    preco_t preco1;
+    preco_t preco2;
+} TickPar;
+
+static TickPar ticks[TICKS_BENCH];
+static double zscores[TICKS_BENCH]; // z-score do motor após cada tick (NAN: sem z-score)
+static MotorPares motor;
+
+static volatile long long sumidouro; // Impede que o compilador descarte os cálculos
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static double uniforme() {
+    return ((double)(aleatorio_proximo() % 2001) - 1000.0) / 1000.0;
+}
+
+// Passeio aleatório da ação 2 de cada par; a ação 1 segue com hedge b e um
+// desvio que volta à média (coeficiente 0.95 por tick)
+static void gerar_ticks() {
+    aleatorio_configurar_semente(SEMENTE_SIMULACAO_PADRAO);
+    double base1[NUM_PARES_BENCH], base2[NUM_PARES_BENCH], hedge[NUM_PARES_BENCH];
+    double y[NUM_PARES_BENCH], desvio[NUM_PARES_BENCH];
+    for (int p = 0; p < NUM_PARES_BENCH; p++) {
+        base1[p] = log(20.0 + p * 5.0);
+        base2[p] = log(50.0 + p * 10.0);
+        hedge[p] = 0.6 + 0.1 * p;
+        y[p] = 0.0;
+        desvio[p] = 0.0;
+    }
+
+    for (int i = 0; i < TICKS_BENCH; i++) {
+        int p = aleatorio_proximo() % NUM_PARES_BENCH;
+        y[p] += 0.001 * uniforme();
+        desvio[p] = 0.95 * desvio[p] + 0.002 * uniforme();
+        ticks[i].par = p;
+        ticks[i].preco1 = PRECO_DE_REAIS(exp(base1[p] + hedge[p] * y[p] + desvio[p]));
+        ticks[i].preco2 = PRECO_DE_REAIS(exp(base2[p] + y[p]));
+    }
+}
+
+// Função para calcular o z-score da amostra mais nova varrendo a janela
+// (duas passagens: médias, depois somas centradas)
+// Retorna 0 nas mesmas condições do motor
+static int zscore_por_varredura(const double* x, const double* y, int n, int mais_nova, double* zscore) {
+    if (n < MIN_AMOSTRAS_ZSCORE) {
+        return 0;
+    }
+    double mx = 0.0, my = 0.0;
+    for (int k = 0; k < n; k++) {
+        mx += x[k];
+        my += y[k];
+    }
+    mx /= n;
+    my /= n;
+    double cxx = 0.0, cyy = 0.0, cxy = 0.0;
+    for (int k = 0; k < n; k++) {
+        cxx += (x[k] - mx) * (x[k] - mx);
+        cyy += (y[k] - my) * (y[k] - my);
+        cxy += (x[k] - mx) * (y[k] - my);
+    }
+    if (cyy <= 1e-14) {
+        return 0;
+    }
+    double hedge = cxy / cyy;
+    double residuos = cxx - hedge * cxy;
+    if (residuos <= 1e-14) {
+        return 0;
+    }
+    double spread = (x[mais_nova] - mx) - hedge * (y[mais_nova] - my);
+    *zscore = spread / sqrt(residuos / n);
+    return 1;
+}
+
+int main() {
+    printf("=== BENCHMARK DOS SINAIS ESTATÍSTICOS DE PARES ===\n");
+    printf("Ticks: %d, pares: %d, janela: %d, entrada |z| > %.1f, saída |z| < %.1f\n\n",
+           TICKS_BENCH, NUM_PARES_BENCH, JANELA_PARES_ZSCORE, ZSCORE_ENTRADA_PADRAO, ZSCORE_SAIDA_PADRAO);
+
+    gerar_ticks();
+    motor_pares_inicializar(&motor, ZSCORE_ENTRADA_PADRAO, ZSCORE_SAIDA_PADRAO);
+    for (int p = 0; p < NUM_PARES_BENCH; p++) {
+        motor_pares_adicionar(&motor, 2 * p, 2 * p + 1);
+    }
+
+    // Motor incremental
+    int sinais_motor = 0;
+    SinalPar sinal;
+    long long inicio = tempo_atual_ns();
+    for (int i = 0; i < TICKS_BENCH; i++) {
+        sinais_motor += motor_pares_atualizar(&motor, ticks[i].par, ticks[i].preco1, ticks[i].preco2, &sinal);
+        const ParZscore* par = &motor.pares[ticks[i].par];
+        zscores[i] = par->tamanho >= MIN_AMOSTRAS_ZSCORE ? par->zscore : NAN;
+    }
+    double ns_motor = (double)(tempo_atual_ns() - inicio) / TICKS_BENCH;
+
+    // Recalculado a cada tick, com as mesmas transições de posição
+    static double x[NUM_PARES_BENCH][JANELA_PARES_ZSCORE], y[NUM_PARES_BENCH][JANELA_PARES_ZSCORE];
+    double base1[NUM_PARES_BENCH], base2[NUM_PARES_BENCH];
+    long long amostras[NUM_PARES_BENCH] = {0};
+    int posicoes[NUM_PARES_BENCH] = {0};
+    int sinais_varredura = 0;
+    int divergentes = 0;
+    double maior_diferenca = 0.0;
+    inicio = tempo_atual_ns();
+    for (int i = 0; i < TICKS_BENCH; i++) {
+        int p = ticks[i].par;
+        double log1 = log(PRECO_EM_REAIS(ticks[i].preco1));
+        double log2 = log(PRECO_EM_REAIS(ticks[i].preco2));
+        if (amostras[p] == 0) {
+            base1[p] = log1;
+            base2[p] = log2;
+        }
+        int slot = (int)(amostras[p] % JANELA_PARES_ZSCORE);
+        x[p][slot] = log1 - base1[p];
+        y[p][slot] = log2 - base2[p];
+        amostras[p]++;
+
+        int n = amostras[p] < JANELA_PARES_ZSCORE ? (int)amostras[p] : JANELA_PARES_ZSCORE;
+        double z;
+        if (!zscore_por_varredura(x[p], y[p], n, slot, &z)) {
+            continue;
+        }
+        int posicao = posicoes[p];
+        if (z > ZSCORE_ENTRADA_PADRAO) posicao = SINAL_PAR_VENDER_SPREAD;
+        else if (z < -ZSCORE_ENTRADA_PADRAO) posicao = SINAL_PAR_COMPRAR_SPREAD;
+        else if (posicao == SINAL_PAR_VENDER_SPREAD && z < ZSCORE_SAIDA_PADRAO) posicao = SINAL_PAR_NEUTRO;
+        else if (posicao == SINAL_PAR_COMPRAR_SPREAD && z > -ZSCORE_SAIDA_PADRAO) posicao = SINAL_PAR_NEUTRO;
+        sinais_varredura += posicao != posicoes[p];
+        posicoes[p] = posicao;
+
+        double diferenca = fabs(z - zscores[i]);
+        if (isnan(zscores[i]) || diferenca > 1e-6) {
+            divergentes++;
+        } else if (diferenca > maior_diferenca) {
+            maior_diferenca = diferenca;
+        }
+    }
+    double ns_varredura = (double)(tempo_atual_ns() - inicio) / TICKS_BENCH;
+    sumidouro = sinais_varredura;
+
+    // Critério antigo: diferença de nível acima de 2% da média
+    int marcados_nivel = 0;
+    for (int i = 0; i < TICKS_BENCH; i++) {
+        double preco1 = PRECO_EM_REAIS(ticks[i].preco1);
+        double preco2 = PRECO_EM_REAIS(ticks[i].preco2);
+        marcados_nivel += fabs(preco1 - preco2) / ((preco1 + preco2) / 2.0) > 0.02;
+    }
+
+    // Larguras compensam os bytes a mais dos acentos em UTF-8
+    printf("%-38s %s\n", "CÁLCULO DO Z-SCORE", "NS POR TICK");
+    printf("%-36s %.1f\n", "Incremental (somas da janela)", ns_motor);
+    printf("%-36s %.1f\n", "Recalculado varrendo a janela", ns_varredura);
+    printf("Incremental: %.0fx mais rápido\n\n", ns_varredura / ns_motor);
+
+    printf("%-37s %s\n", "CRITÉRIO", "SINAIS");
+    printf("%-38s %d (%.1f%% dos ticks)\n", "Diferença de nível > 2%", marcados_nivel,
+           100.0 * marcados_nivel / TICKS_BENCH);
+    printf("%-36s %d (%.2f%% dos ticks)\n\n", "Cruzamentos de limiar do z-score", sinais_motor,
+           100.0 * sinais_motor / TICKS_BENCH);
+
+    if (divergentes > 0 || sinais_motor != sinais_varredura) {
+        printf("✗ %d z-scores divergentes; sinais: motor %d, recalculado %d\n",
+               divergentes, sinais_motor, sinais_varredura);
+        return 1;
+    }
+    printf("✓ Z-scores iguais aos recalculados (maior diferença %.1e), %d sinais em ambos\n",
+           maior_diferenca, sinais_motor);
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
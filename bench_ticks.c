@@ -0,0 +1,160 @@
+#include "trading_system.h"
+
+// Benchmark da gravação do histórico de ticks
+// Compara três formas de guardar cada mudança de preço:
+// - texto com fopen/fprintf/fclose por gravação (como salvar_historico_precos
+//   fazia a cada snapshot, agora para cada tick);
+// - texto com fprintf num arquivo mantido aberto (buffer do stdio);
+// - GravadorTicks: registros binários de 40 bytes, um write() a cada
+//   CAPACIDADE_BUFFER_TICKS registros.
+// Depois lê o arquivo binário com o LeitorTicks e confere todos os registros.
+
+#define TICKS_BENCH 1000000
+#define TICKS_FOPEN 20000  // fopen/fclose por tick é lento demais para o total
+#define NUM_SIMBOLOS 13
+
+static const char* SIMBOLOS[NUM_SIMBOLOS] = {
+    "PETR4", "VALE3", "ITUB4", "ABEV3", "BBAS3", "BBDC4",
+    "WEGE3", "RENT3", "LREN3", "MGLU3", "JBSS3", "SUZB3", "GGBR4"
+};
+
+static RegistroTick ticks[TICKS_BENCH];
+
+static long long tempo_atual_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static long long tamanho_arquivo(const char* caminho) {
+    FILE* arquivo = fopen(caminho, "rb");
+    if (!arquivo) return 0;
+    fseek(arquivo, 0, SEEK_END);
+    long long tamanho = ftell(arquivo);
+    fclose(arquivo);
+    return tamanho;
+}
+
+// Passeio aleatório de preços, um tick a cada ~50 us de pregão
+static void gerar_ticks() {
+    aleatorio_configurar_semente(SEMENTE_SIMULACAO_PADRAO);
+    preco_t precos[NUM_SIMBOLOS];
+    for (int s = 0; s < NUM_SIMBOLOS; s++) {
+        precos[s] = PRECO_DE_REAIS(10.0 + s * 5);
+    }
+
+    long long instante = INICIO_PREGAO_SIMULADO * 1000000000LL;
+    for (int i = 0; i < TICKS_BENCH; i++) {
+        int s = aleatorio_proximo() % NUM_SIMBOLOS;
+        preco_t anterior = precos[s];
+        precos[s] += ((long long)(aleatorio_proximo() % 21) - 10) * TAMANHO_TICK_PADRAO;
+        if (precos[s] < MIN_PRECO_ACAO) precos[s] = MIN_PRECO_ACAO;
+        instante += 1 + aleatorio_proximo() % 100000;
+
+        RegistroTick* tick = &ticks[i];
+        memset(tick, 0, sizeof(RegistroTick));
+        tick->instante_ns = instante;
+        tick->preco_anterior = anterior;
+        tick->preco_novo = precos[s];
+        strncpy(tick->simbolo, SIMBOLOS[s], TAMANHO_SIMBOLO_TICK - 1);
+        tick->acao_id = (unsigned short)s;
+        tick->motivo = (unsigned char)(aleatorio_proximo() % 2);
+    }
+}
+
+static void escrever_texto(FILE* arquivo, const RegistroTick* tick) {
+    fprintf(arquivo, "%lld,%s,%.2f,%.2f,%s\n", tick->instante_ns, tick->simbolo,
+            PRECO_EM_REAIS(tick->preco_anterior), PRECO_EM_REAIS(tick->preco_novo),
+            nome_motivo_tick(tick->motivo));
+}
+
+int main() {
+    printf("=== BENCHMARK DO HISTÓRICO DE TICKS ===\n");
+    printf("Ticks: %d (fopen por tick: %d)\n\n", TICKS_BENCH, TICKS_FOPEN);
+
+    char caminho_texto[64], caminho_binario[64];
+    snprintf(caminho_texto, sizeof(caminho_texto), "/tmp/bench_ticks_%d.txt", (int)getpid());
+    snprintf(caminho_binario, sizeof(caminho_binario), "/tmp/bench_ticks_%d.bin", (int)getpid());
+
+    gerar_ticks();
+
+    // Texto: abrir, escrever e fechar a cada tick
+    remove(caminho_texto);
+    long long inicio = tempo_atual_ns();
+    for (int i = 0; i < TICKS_FOPEN; i++) {
+        FILE* arquivo = fopen(caminho_texto, "a");
+        if (!arquivo) {
+            perror("Erro ao abrir arquivo de texto");
+            return 1;
+        }
+        escrever_texto(arquivo, &ticks[i]);
+        fclose(arquivo);
+    }
+    double ns_fopen = (double)(tempo_atual_ns() - inicio) / TICKS_FOPEN;
+    double bytes_fopen = (double)tamanho_arquivo(caminho_texto) / TICKS_FOPEN;
+
+    // Texto: arquivo aberto, fprintf por tick
+    remove(caminho_texto);
+    inicio = tempo_atual_ns();
+    FILE* arquivo = fopen(caminho_texto, "a");
+    if (!arquivo) {
+        perror("Erro ao abrir arquivo de texto");
+        return 1;
+    }
+    for (int i = 0; i < TICKS_BENCH; i++) {
+        escrever_texto(arquivo, &ticks[i]);
+    }
+    fclose(arquivo);
+    double ns_fprintf = (double)(tempo_atual_ns() - inicio) / TICKS_BENCH;
+    double bytes_fprintf = (double)tamanho_arquivo(caminho_texto) / TICKS_BENCH;
+    remove(caminho_texto);
+
+    // Binário com buffer
+    remove(caminho_binario);
+    static GravadorTicks gravador;
+    inicio = tempo_atual_ns();
+    if (!gravador_ticks_abrir(&gravador, caminho_binario)) {
+        return 1;
+    }
+    for (int i = 0; i < TICKS_BENCH; i++) {
+        gravador_ticks_registrar(&gravador, &ticks[i]);
+    }
+    gravador_ticks_fechar(&gravador);
+    double ns_binario = (double)(tempo_atual_ns() - inicio) / TICKS_BENCH;
+    double bytes_binario = (double)tamanho_arquivo(caminho_binario) / TICKS_BENCH;
+
+    printf("%-30s %-14s %s\n", "GRAVAÇÃO", "NS POR TICK", "BYTES POR TICK");
+    printf("%-30s %-14.1f %.1f\n", "Texto, fopen/fclose por tick", ns_fopen, bytes_fopen);
+    printf("%-30s %-14.1f %.1f\n", "Texto, fprintf", ns_fprintf, bytes_fprintf);
+    printf("%-30s %-14.1f %.1f\n", "Binário com buffer", ns_binario, bytes_binario);
+    printf("Ganho sobre fprintf: %.1fx, sobre fopen por tick: %.0fx\n\n",
+           ns_fprintf / ns_binario, ns_fopen / ns_binario);
+
+    // Ler de volta e conferir
+    LeitorTicks leitor;
+    if (!leitor_ticks_abrir(&leitor, caminho_binario)) {
+        printf("✗ Histórico binário não abriu para leitura\n");
+        return 1;
+    }
+    RegistroTick lido;
+    long long divergentes = 0;
+    inicio = tempo_atual_ns();
+    while (leitor_ticks_proximo(&leitor, &lido)) {
+        if (leitor.lidos > TICKS_BENCH ||
+            memcmp(&lido, &ticks[leitor.lidos - 1], sizeof(RegistroTick)) != 0) {
+            divergentes++;
+        }
+    }
+    double ns_leitura = (double)(tempo_atual_ns() - inicio) / TICKS_BENCH;
+    leitor_ticks_fechar(&leitor);
+    remove(caminho_binario);
+
+    printf("Leitura: %.1f ns por tick\n", ns_leitura);
+    if (leitor.lidos != TICKS_BENCH || leitor.total != TICKS_BENCH || divergentes > 0) {
+        printf("✗ Lidos %lld de %d registros, %lld divergentes\n", leitor.lidos, TICKS_BENCH, divergentes);
+        return 1;
+    }
+    printf("✓ %d registros lidos de volta, todos iguais aos gravados\n", TICKS_BENCH);
+    printf("✓ Benchmark concluído\n");
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include "trading_system.h"
+
+// Matriz de correlação deslizante
+// Antes calcular_correlacao() recalculava a covariância varrendo os 100
+// preços das duas ações a cada chamada, e quem imprimia ou procurava pares
+// chamava para cada par: O(n² · janela). Aqui as somas de retornos e de
+// produtos cruzados da janela são mantidas a cada amostra, e a correlação de
+// um par sai de cinco somas:
+//   corr = (N·Sij - Si·Sj) / sqrt((N·Sii - Si²) · (N·Sjj - Sj²))
+// A correlação é dos retornos entre amostras, não dos preços: preços têm
+// tendência (a correlação de dois passeios aleatórios é alta por acaso) e a
+// média dos retornos fica perto de zero, o que mantém as somas sem
+// cancelamento catastrófico.
+
+static MatrizCorrelacao matriz_sistema;
+static pthread_mutex_t mutex_matriz_sistema = PTHREAD_MUTEX_INITIALIZER;
+
+// Início da linha i no triângulo empacotado, deslocado para ser indexado por j
+static long long deslocamento_linha(int num_ativos, int i) {
+    return (long long)i * num_ativos - (long long)i * (i - 1) / 2 - i;
+}
+
+// Função para acumular uma linha de produtos: linha[j] += a_i·a[j] - b_i·b[j]
+// Ponteiros restrict e laço contíguo para o compilador vetorizar
+static void acumular_linha(double* restrict linha, const double* restrict a, double a_i,
+                           const double* restrict b, double b_i, int inicio, int fim) {
+    for (int j = inicio; j < fim; j++) {
+        linha[j] += a_i * a[j] - b_i * b[j];
+    }
+}
+
+// Função para recalcular somas e produtos varrendo as amostras da janela
+static void recalcular_somas(MatrizCorrelacao* matriz) {
+    int n = matriz->num_ativos;
+    memset(matriz->somas, 0, sizeof(double) * n);
+    memset(matriz->produtos, 0, sizeof(double) * ((long long)n * (n + 1) / 2));
+
+    for (int k = 0; k < matriz->tamanho; k++) {
+        const double* r = &matriz->retornos[(long long)k * n];
+        for (int i = 0; i < n; i++) {
+            matriz->somas[i] += r[i];
+            acumular_linha(matriz->produtos + deslocamento_linha(n, i), r, r[i], r, 0.0, i, n);
+        }
+    }
+}
+
+// Função para inicializar a matriz (janela de 'janela' amostras)
+// Retorna 1 em sucesso, 0 se faltar memória
+int matriz_correlacao_inicializar(MatrizCorrelacao* matriz, int num_ativos, int janela) {
+    memset(matriz, 0, sizeof(MatrizCorrelacao));
+    if (num_ativos <= 0 || janela <= 1) {
+        return 0;
+    }
+
+    matriz->num_ativos = num_ativos;
+    matriz->janela = janela;
+    matriz->precos_anteriores = calloc(num_ativos, sizeof(double));
+    matriz->retornos_novos = calloc(num_ativos, sizeof(double));
+    matriz->retornos = calloc((size_t)janela * num_ativos, sizeof(double));
+    matriz->somas = calloc(num_ativos, sizeof(double));
+    matriz->produtos = calloc((size_t)num_ativos * (num_ativos + 1) / 2, sizeof(double));
+
+    if (!matriz->precos_anteriores || !matriz->retornos_novos || !matriz->retornos || !matriz->somas || !matriz->produtos) {
+        matriz_correlacao_liberar(matriz);
+        return 0;
+    }
+    return 1;
+}
+
+// Função para liberar a matriz
+void matriz_correlacao_liberar(MatrizCorrelacao* matriz) {
+    free(matriz->precos_anteriores);
+    free(matriz->retornos_novos);
+    free(matriz->retornos);
+    free(matriz->somas);
+    free(matriz->produtos);
+    memset(matriz, 0, sizeof(MatrizCorrelacao));
+}
+
+// Função para inserir uma amostra de preços (um por ativo)
+// A primeira amostra só guarda os preços; as seguintes entram como retornos
+void matriz_correlacao_adicionar_amostra(MatrizCorrelacao* matriz, const double* precos) {
+    int n = matriz->num_ativos;
+    if (!matriz->tem_precos_anteriores) {
+        memcpy(matriz->precos_anteriores, precos, sizeof(double) * n);
+        matriz->tem_precos_anteriores = 1;
+        return;
+    }
+
+    // O slot da amostra nova é o da mais antiga (que sai com a janela cheia)
+    double* slot = &matriz->retornos[(matriz->total_amostras % matriz->janela) * n];
+    double* novos = matriz->retornos_novos;
+    for (int i = 0; i < n; i++) {
+        double anterior = matriz->precos_anteriores[i];
+        novos[i] = anterior > 0.0 ? (precos[i] - anterior) / anterior : 0.0;
+        matriz->precos_anteriores[i] = precos[i];
+    }
+
+    if (matriz->tamanho == matriz->janela) {
+        // Trocar a amostra antiga pela nova: Sij += novo_i·novo_j - antigo_i·antigo_j
+        for (int i = 0; i < n; i++) {
+            matriz->somas[i] += novos[i] - slot[i];
+            acumular_linha(matriz->produtos + deslocamento_linha(n, i), novos, novos[i], slot, slot[i], i, n);
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            matriz->somas[i] += novos[i];
+            acumular_linha(matriz->produtos + deslocamento_linha(n, i), novos, novos[i], slot, 0.0, i, n);
+        }
+        matriz->tamanho++;
+    }
+
+    memcpy(slot, novos, sizeof(double) * n);
+    matriz->total_amostras++;
+
+    // Evitar acúmulo de erro de arredondamento nas subtrações
+    if (matriz->total_amostras % RECALCULO_CORRELACAO == 0) {
+        recalcular_somas(matriz);
+    }
+}
+
+// Função para obter o número de amostras de retorno na janela
+int matriz_correlacao_amostras(const MatrizCorrelacao* matriz) {
+    return matriz->tamanho;
+}
+
+// Função para obter a correlação entre dois ativos (O(1))
+// Retorna 0 com menos de MIN_AMOSTRAS_CORRELACAO amostras ou variância nula
+double matriz_correlacao_obter(const MatrizCorrelacao* matriz, int ativo1, int ativo2) {
+    if (ativo1 < 0 || ativo1 >= matriz->num_ativos ||
+        ativo2 < 0 || ativo2 >= matriz->num_ativos ||
+        matriz->tamanho < MIN_AMOSTRAS_CORRELACAO) {
+        return 0.0;
+    }
+
+    int i = ativo1 < ativo2 ? ativo1 : ativo2;
+    int j = ativo1 < ativo2 ? ativo2 : ativo1;
+    int n = matriz->num_ativos;
+    double amostras = matriz->tamanho;
+
+    double si = matriz->somas[i];
+    double sj = matriz->somas[j];
+    double sii = matriz->produtos[deslocamento_linha(n, i) + i];
+    double sjj = matriz->produtos[deslocamento_linha(n, j) + j];
+    double sij = matriz->produtos[deslocamento_linha(n, i) + j];
+
+    double variancia_i = amostras * sii - si * si;
+    double variancia_j = amostras * sjj - sj * sj;
+    if (variancia_i <= 1e-18 || variancia_j <= 1e-18) {
+        return 0.0;
+    }
+
+    double correlacao = (amostras * sij - si * sj) / sqrt(variancia_i * variancia_j);
+    if (correlacao > 1.0) correlacao = 1.0;
+    if (correlacao < -1.0) correlacao = -1.0;
+    return correlacao;
+}
+
+// Função para registrar uma amostra dos preços atuais de todas as ações
+// Chamada pelo price updater ao fim de cada rodada de variação de mercado
+void registrar_amostra_correlacao(TradingSystem* sistema) {
+    double precos[MAX_ACOES];
+    for (int i = 0; i < sistema->num_acoes; i++) {
+        precos[i] = PRECO_EM_REAIS(sistema->acoes[i].preco_atual);
+    }
+
+    pthread_mutex_lock(&mutex_matriz_sistema);
+    if (matriz_sistema.num_ativos != sistema->num_acoes) {
+        matriz_correlacao_liberar(&matriz_sistema);
+        if (!matriz_correlacao_inicializar(&matriz_sistema, sistema->num_acoes, JANELA_CORRELACAO)) {
+            pthread_mutex_unlock(&mutex_matriz_sistema);
+            return;
+        }
+    }
+    matriz_correlacao_adicionar_amostra(&matriz_sistema, precos);
+    pthread_mutex_unlock(&mutex_matriz_sistema);
+}
+
+// Função para liberar a matriz do sistema
+void liberar_correlacao_sistema() {
+    pthread_mutex_lock(&mutex_matriz_sistema);
+    matriz_correlacao_liberar(&matriz_sistema);
+    pthread_mutex_unlock(&mutex_matriz_sistema);
+}
+
+// Função para calcular correlação entre ações (retornos na janela recente)
+// Na versão processos a matriz fica no processo do price updater
+double calcular_correlacao(TradingSystem* sistema, int acao1, int acao2) {
+    if (acao1 < 0 || acao1 >= sistema->num_acoes ||
+        acao2 < 0 || acao2 >= sistema->num_acoes) {
+        return 0.0;
+    }
+
+    pthread_mutex_lock(&mutex_matriz_sistema);
+    double correlacao = matriz_correlacao_obter(&matriz_sistema, acao1, acao2);
+    pthread_mutex_unlock(&mutex_matriz_sistema);
+    return correlacao;
+}
@@ -0,0 +1,282 @@
+#include "trading_system.h"
+
+// Escalonador multi-executor com roubo de trabalho
+//
+// Cada ação tem sua própria fila lock-free de ordens e um token "agendada".
+// Quem detém o token é o único consumidor da fila da ação, o que preserva a
+// ordem das ordens por ação. Ações com ordens pendentes ficam em um deque
+// por executor (o executor "dono" é acao_id % num_executores). Um executor
+// ocioso rouba metade das ações prontas do deque mais carregado; como o token
+// viaja junto com a ação, a ordem por ação continua garantida.
+
+#define TIMEOUT_OCIOSO_MS 10 // Espera máxima de um executor sem trabalho
+
+// Deque de ações prontas de um executor
+typedef struct {
+    int acoes[MAX_ACOES]; // Cada ação está em no máximo um deque
+    int inicio;
+    int tamanho;
+    pthread_mutex_t mutex;
+} __attribute__((aligned(TAMANHO_CACHE_LINE))) DequeExecutor;
+
+// Estatísticas por executor
+typedef struct {
+    int ordens_processadas;
+    int lotes_processados;
+    int roubos_realizados;
+    int acoes_roubadas;
+} __attribute__((aligned(TAMANHO_CACHE_LINE))) EstatisticasExecutor;
+
+static FilaOrdensLockFree filas_acoes[MAX_ACOES];
+static int acao_agendada[MAX_ACOES];
+static DequeExecutor deques[MAX_EXECUTORES];
+static EstatisticasExecutor estatisticas_executores[MAX_EXECUTORES];
+static EventoNotificacao eventos_executores[MAX_EXECUTORES]; // Acorda executor ocioso
+static unsigned int proximo_ladrao = 0;
+static pthread_t threads_escalonador[MAX_EXECUTORES];
+static int ids_escalonador[MAX_EXECUTORES];
+static int num_executores_escalonador = 1;
+static int modo_escalonador = MODO_ESCALONADOR_ESTATICO;
+static int escalonador_ativo = 0;
+static int threads_escalonador_criadas = 0;
+static ProcessarLoteExecutor processar_lote = NULL;
+static void* contexto_processamento = NULL;
+
+// Função para inserir ação no fim do deque (retorna o novo tamanho)
+static int deque_inserir(DequeExecutor* deque, int acao_id) {
+    pthread_mutex_lock(&deque->mutex);
+    deque->acoes[(deque->inicio + deque->tamanho) % MAX_ACOES] = acao_id;
+    int tamanho = deque->tamanho + 1;
+    __atomic_store_n(&deque->tamanho, tamanho, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&deque->mutex);
+    return tamanho;
+}
+
+// Função para o dono retirar ação do início do deque (-1 se vazio)
+static int deque_retirar(DequeExecutor* deque) {
+    int acao_id = -1;
+    pthread_mutex_lock(&deque->mutex);
+    if (deque->tamanho > 0) {
+        acao_id = deque->acoes[deque->inicio];
+        deque->inicio = (deque->inicio + 1) % MAX_ACOES;
+        __atomic_store_n(&deque->tamanho, deque->tamanho - 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&deque->mutex);
+    return acao_id;
+}
+
+// Função para roubar metade das ações do fim do deque da vítima
+static int deque_roubar(DequeExecutor* deque, int* roubadas) {
+    int quantidade = 0;
+    pthread_mutex_lock(&deque->mutex);
+    if (deque->tamanho > 0) {
+        quantidade = (deque->tamanho + 1) / 2;
+        for (int i = 0; i < quantidade; i++) {
+            int indice = (deque->inicio + deque->tamanho - 1 - i) % MAX_ACOES;
+            roubadas[i] = deque->acoes[indice];
+        }
+        __atomic_store_n(&deque->tamanho, deque->tamanho - quantidade, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&deque->mutex);
+    return quantidade;
+}
+
+// Função para escolher a vítima com mais ações prontas (-1 se nenhuma)
+static int escolher_vitima(int executor_id) {
+    int vitima = -1;
+    int maior_tamanho = 0;
+    for (int i = 0; i < num_executores_escalonador; i++) {
+        if (i == executor_id) continue;
+        int tamanho = __atomic_load_n(&deques[i].tamanho, __ATOMIC_RELAXED);
+        if (tamanho > maior_tamanho) {
+            maior_tamanho = tamanho;
+            vitima = i;
+        }
+    }
+    return vitima;
+}
+
+// Função para obter próxima ação a processar (local ou roubada)
+static int obter_proxima_acao(int executor_id) {
+    int acao_id = deque_retirar(&deques[executor_id]);
+    if (acao_id >= 0 || modo_escalonador != MODO_ESCALONADOR_ROUBO) {
+        return acao_id;
+    }
+
+    int vitima = escolher_vitima(executor_id);
+    if (vitima < 0) {
+        return -1;
+    }
+
+    int roubadas[MAX_ACOES];
+    int quantidade = deque_roubar(&deques[vitima], roubadas);
+    if (quantidade == 0) {
+        return -1;
+    }
+
+    // Processar a primeira agora e manter as demais no deque local
+    for (int i = 1; i < quantidade; i++) {
+        deque_inserir(&deques[executor_id], roubadas[i]);
+    }
+
+    estatisticas_executores[executor_id].roubos_realizados++;
+    estatisticas_executores[executor_id].acoes_roubadas += quantidade;
+    return roubadas[0];
+}
+
+// Função da thread de cada executor do escalonador
+static void* thread_executor_escalonador(void* arg) {
+    int executor_id = *(int*)arg;
+    EstatisticasExecutor* estatisticas = &estatisticas_executores[executor_id];
+    Ordem lote[TAMANHO_MAX_LOTE_EXECUTOR];
+
+    while (__atomic_load_n(&escalonador_ativo, __ATOMIC_RELAXED)) {
+        unsigned int observado = evento_observar(&eventos_executores[executor_id]);
+        int acao_id = obter_proxima_acao(executor_id);
+        if (acao_id < 0) {
+            evento_aguardar(&eventos_executores[executor_id], observado, TIMEOUT_OCIOSO_MS);
+            continue;
+        }
+
+        // Este executor detém o token da ação: é o único consumidor da fila
+        int tamanho_lote = fila_lockfree_desenfileirar_lote(&filas_acoes[acao_id], lote,
+                                                            TAMANHO_MAX_LOTE_EXECUTOR);
+        if (tamanho_lote > 0) {
+            processar_lote(executor_id, lote, tamanho_lote, contexto_processamento);
+            estatisticas->ordens_processadas += tamanho_lote;
+            estatisticas->lotes_processados++;
+        }
+
+        // Liberar o token e reagendar se chegaram ordens nesse meio tempo
+        __atomic_store_n(&acao_agendada[acao_id], 0, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (fila_lockfree_tamanho(&filas_acoes[acao_id]) > 0) {
+            int esperado = 0;
+            if (__atomic_compare_exchange_n(&acao_agendada[acao_id], &esperado, 1, 0,
+                                            __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+                deque_inserir(&deques[executor_id], acao_id);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+// Função para inicializar o escalonador
+void escalonador_inicializar(int num_executores, int modo, ProcessarLoteExecutor processar, void* contexto) {
+    if (num_executores < 1) num_executores = 1;
+    if (num_executores > MAX_EXECUTORES) num_executores = MAX_EXECUTORES;
+
+    num_executores_escalonador = num_executores;
+    modo_escalonador = modo;
+    processar_lote = processar;
+    contexto_processamento = contexto;
+
+    for (int i = 0; i < MAX_ACOES; i++) {
+        fila_lockfree_inicializar(&filas_acoes[i]);
+        acao_agendada[i] = 0;
+    }
+
+    for (int i = 0; i < MAX_EXECUTORES; i++) {
+        deques[i].inicio = 0;
+        deques[i].tamanho = 0;
+        pthread_mutex_init(&deques[i].mutex, NULL);
+        evento_inicializar(&eventos_executores[i]);
+        memset(&estatisticas_executores[i], 0, sizeof(EstatisticasExecutor));
+    }
+}
+
+// Função para criar as threads do escalonador
+int escalonador_iniciar() {
+    if (!processar_lote) {
+        printf("ERRO: Escalonador sem função de processamento\n");
+        return 0;
+    }
+
+    __atomic_store_n(&escalonador_ativo, 1, __ATOMIC_RELAXED);
+    threads_escalonador_criadas = 0;
+
+    for (int i = 0; i < num_executores_escalonador; i++) {
+        ids_escalonador[i] = i;
+        int resultado = pthread_create(&threads_escalonador[i], NULL,
+                                       thread_executor_escalonador, &ids_escalonador[i]);
+        if (resultado != 0) {
+            printf("ERRO: Falha ao criar executor %d do escalonador: %s\n", i, strerror(resultado));
+            break;
+        }
+        threads_escalonador_criadas++;
+    }
+
+    return threads_escalonador_criadas > 0;
+}
+
+// Função para submeter ordem ao escalonador (seguro para vários produtores)
+// Retorna 1 se a ordem foi aceita, 0 se a fila da ação está cheia ou a ação é inválida
+int escalonador_submeter(const Ordem* ordem) {
+    int acao_id = ordem->acao_id;
+    if (acao_id < 0 || acao_id >= MAX_ACOES) {
+        return 0;
+    }
+
+    if (!fila_lockfree_enfileirar(&filas_acoes[acao_id], ordem)) {
+        return 0;
+    }
+
+    // Primeira ordem pendente da ação: agendá-la no deque do executor dono
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int esperado = 0;
+    if (__atomic_compare_exchange_n(&acao_agendada[acao_id], &esperado, 1, 0,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+        int dono = acao_id % num_executores_escalonador;
+        int tamanho = deque_inserir(&deques[dono], acao_id);
+        evento_notificar(&eventos_executores[dono]);
+        
+        // Dono já tem ações na fila: acordar outro executor para roubar
+        if (modo_escalonador == MODO_ESCALONADOR_ROUBO && tamanho > 1 && num_executores_escalonador > 1) {
+            unsigned int deslocamento = __atomic_fetch_add(&proximo_ladrao, 1, __ATOMIC_RELAXED);
+            int ladrao = (dono + 1 + deslocamento % (num_executores_escalonador - 1)) % num_executores_escalonador;
+            evento_notificar(&eventos_executores[ladrao]);
+        }
+    }
+    return 1;
+}
+
+// Função para parar o escalonador e aguardar suas threads
+void escalonador_parar() {
+    __atomic_store_n(&escalonador_ativo, 0, __ATOMIC_RELAXED);
+    for (int i = 0; i < num_executores_escalonador; i++) {
+        evento_notificar_todos(&eventos_executores[i]);
+    }
+
+    for (int i = 0; i < threads_escalonador_criadas; i++) {
+        pthread_join(threads_escalonador[i], NULL);
+    }
+    threads_escalonador_criadas = 0;
+
+    for (int i = 0; i < MAX_EXECUTORES; i++) {
+        pthread_mutex_destroy(&deques[i].mutex);
+    }
+}
+
+// Função para obter estatísticas de um executor do escalonador
+void escalonador_obter_estatisticas(int executor_id, int* ordens, int* lotes, int* roubos) {
+    if (executor_id < 0 || executor_id >= MAX_EXECUTORES) {
+        return;
+    }
+    EstatisticasExecutor* estatisticas = &estatisticas_executores[executor_id];
+    if (ordens) *ordens = estatisticas->ordens_processadas;
+    if (lotes) *lotes = estatisticas->lotes_processados;
+    if (roubos) *roubos = estatisticas->roubos_realizados;
+}
+
+// Função para imprimir estatísticas do escalonador
+void escalonador_imprimir_estatisticas() {
+    printf("\n=== ESTATÍSTICAS DO ESCALONADOR (%s) ===\n",
+           modo_escalonador == MODO_ESCALONADOR_ROUBO ? "ROUBO DE TRABALHO" : "ESTÁTICO");
+    for (int i = 0; i < num_executores_escalonador; i++) {
+        EstatisticasExecutor* estatisticas = &estatisticas_executores[i];
+        printf("Executor %d: %d ordens, %d lotes, %d roubos (%d ações roubadas)\n",
+               i, estatisticas->ordens_processadas, estatisticas->lotes_processados,
+               estatisticas->roubos_realizados, estatisticas->acoes_roubadas);
+    }
+}
@@ -0,0 +1,150 @@
+#include "trading_system.h"
+
+// Estatísticas de janela deslizante
+// Substitui o histórico que recalculava média e desvio varrendo os 100
+// preços a cada atualização. Cada valor novo entra em O(1):
+// - média e variância por Welford; com a janela cheia o valor mais antigo é
+//   trocado pelo novo numa única atualização;
+// - mínimo e máximo por deques monotônicos de posições: cada posição entra e
+//   sai de cada deque uma vez só;
+// - média móvel exponencial, sem janela.
+// Média e variância são recalculadas do zero a cada RECALCULO_ESTATISTICAS
+// valores para o erro de arredondamento das subtrações não se acumular.
+
+// Função para recalcular média e variância varrendo a janela
+static void recalcular_media_variancia(EstatisticasJanela* janela) {
+    double soma = 0.0;
+    for (int i = 0; i < janela->tamanho; i++) {
+        soma += estatisticas_janela_valor(janela, i);
+    }
+    janela->media = soma / janela->tamanho;
+
+    double m2 = 0.0;
+    for (int i = 0; i < janela->tamanho; i++) {
+        double diferenca = estatisticas_janela_valor(janela, i) - janela->media;
+        m2 += diferenca * diferenca;
+    }
+    janela->m2 = m2;
+}
+
+// Função para inicializar a janela vazia
+void estatisticas_janela_inicializar(EstatisticasJanela* janela, int periodo_ema) {
+    memset(janela, 0, sizeof(EstatisticasJanela));
+    janela->alfa_ema = 2.0 / (periodo_ema + 1);
+}
+
+// Função para inserir um valor (descarta o mais antigo com a janela cheia)
+void estatisticas_janela_adicionar(EstatisticasJanela* janela, double valor) {
+    long long posicao = janela->total;
+    int slot = (int)(posicao % JANELA_ESTATISTICAS);
+
+    // Média e variância (Welford)
+    if (janela->tamanho < JANELA_ESTATISTICAS) {
+        janela->tamanho++;
+        double diferenca = valor - janela->media;
+        janela->media += diferenca / janela->tamanho;
+        janela->m2 += diferenca * (valor - janela->media);
+    } else {
+        double antigo = janela->valores[slot];
+        double media_anterior = janela->media;
+        janela->media += (valor - antigo) / JANELA_ESTATISTICAS;
+        janela->m2 += (valor - antigo) * (valor - janela->media + antigo - media_anterior);
+        if (janela->m2 < 0.0) {
+            janela->m2 = 0.0;
+        }
+    }
+
+    // Retirar das frentes a posição que saiu da janela
+    long long primeira_valida = posicao - JANELA_ESTATISTICAS + 1;
+    if (janela->tamanho_minimo > 0 && janela->deque_minimo[janela->inicio_minimo] < primeira_valida) {
+        janela->inicio_minimo = (janela->inicio_minimo + 1) % JANELA_ESTATISTICAS;
+        janela->tamanho_minimo--;
+    }
+    if (janela->tamanho_maximo > 0 && janela->deque_maximo[janela->inicio_maximo] < primeira_valida) {
+        janela->inicio_maximo = (janela->inicio_maximo + 1) % JANELA_ESTATISTICAS;
+        janela->tamanho_maximo--;
+    }
+
+    janela->valores[slot] = valor;
+
+    // Retirar do fundo as posições que não podem mais ser mínimo/máximo
+    while (janela->tamanho_minimo > 0) {
+        int fundo = (janela->inicio_minimo + janela->tamanho_minimo - 1) % JANELA_ESTATISTICAS;
+        if (janela->valores[janela->deque_minimo[fundo] % JANELA_ESTATISTICAS] < valor) break;
+        janela->tamanho_minimo--;
+    }
+    janela->deque_minimo[(janela->inicio_minimo + janela->tamanho_minimo) % JANELA_ESTATISTICAS] = posicao;
+    janela->tamanho_minimo++;
+
+    while (janela->tamanho_maximo > 0) {
+        int fundo = (janela->inicio_maximo + janela->tamanho_maximo - 1) % JANELA_ESTATISTICAS;
+        if (janela->valores[janela->deque_maximo[fundo] % JANELA_ESTATISTICAS] > valor) break;
+        janela->tamanho_maximo--;
+    }
+    janela->deque_maximo[(janela->inicio_maximo + janela->tamanho_maximo) % JANELA_ESTATISTICAS] = posicao;
+    janela->tamanho_maximo++;
+
+    // Média móvel exponencial (o primeiro valor inicia a média)
+    if (posicao == 0) {
+        janela->ema = valor;
+    } else {
+        janela->ema += janela->alfa_ema * (valor - janela->ema);
+    }
+
+    janela->total++;
+    if (janela->total % RECALCULO_ESTATISTICAS == 0) {
+        recalcular_media_variancia(janela);
+    }
+}
+
+// Função para obter o número de valores na janela
+int estatisticas_janela_tamanho(const EstatisticasJanela* janela) {
+    return janela->tamanho;
+}
+
+// Função para obter um valor da janela (atras = 0: mais recente)
+double estatisticas_janela_valor(const EstatisticasJanela* janela, int atras) {
+    if (atras < 0 || atras >= janela->tamanho) {
+        return 0.0;
+    }
+    return janela->valores[(janela->total - 1 - atras) % JANELA_ESTATISTICAS];
+}
+
+double estatisticas_janela_media(const EstatisticasJanela* janela) {
+    return janela->media;
+}
+
+// Variância populacional (como o cálculo antigo do histórico)
+double estatisticas_janela_variancia(const EstatisticasJanela* janela) {
+    return janela->tamanho > 0 ? janela->m2 / janela->tamanho : 0.0;
+}
+
+double estatisticas_janela_desvio(const EstatisticasJanela* janela) {
+    return sqrt(estatisticas_janela_variancia(janela));
+}
+
+// Função para obter a volatilidade (desvio padrão relativo à média)
+double estatisticas_janela_volatilidade(const EstatisticasJanela* janela) {
+    if (janela->tamanho < 2 || janela->media == 0.0) {
+        return 0.0;
+    }
+    return estatisticas_janela_desvio(janela) / janela->media;
+}
+
+double estatisticas_janela_minimo(const EstatisticasJanela* janela) {
+    if (janela->tamanho_minimo == 0) {
+        return 0.0;
+    }
+    return janela->valores[janela->deque_minimo[janela->inicio_minimo] % JANELA_ESTATISTICAS];
+}
+
+double estatisticas_janela_maximo(const EstatisticasJanela* janela) {
+    if (janela->tamanho_maximo == 0) {
+        return 0.0;
+    }
+    return janela->valores[janela->deque_maximo[janela->inicio_maximo] % JANELA_ESTATISTICAS];
+}
+
+double estatisticas_janela_ema(const EstatisticasJanela* janela) {
+    return janela->ema;
+}
@@ -9,6 +9,7 @@ void inicializar_executor(TradingSystem* sistema) {
     sistema->executor.total_ordens = 0;
     sistema->executor.ordens_executadas = 0;
     sistema->executor.ordens_canceladas = 0;
+    __atomic_store_n(&sistema->proximo_id_ordem, 0, __ATOMIC_RELEASE);
     
     pthread_mutex_init(&sistema->executor.mutex, NULL);
     
@@ -18,33 +19,35 @@ void inicializar_executor(TradingSystem* sistema) {
 void executar_ordens_pendentes(TradingSystem* sistema) {
     pthread_mutex_lock(&sistema->mutex_geral);
     
-    for (int i = 0; i < sistema->num_ordens; i++) {
-        Ordem* ordem = &sistema->ordens[i];
+    int limite = pool_ordens_limite(&sistema->ordens);
+    for (int i = 0; i < limite; i++) {
+        Ordem* ordem = pool_ordens_slot(&sistema->ordens, i);
         
-        if (ordem->status == 0) { // Ordem pendente
-            processar_ordem(sistema, i);
+        if (ordem && ordem->status == 0) { // Ordem pendente
+            processar_ordem(sistema, pool_ordens_handle(&sistema->ordens, i));
         }
     }
     
     pthread_mutex_unlock(&sistema->mutex_geral);
 }
 
-void processar_ordem(TradingSystem* sistema, int ordem_id) {
-    if (ordem_id < 0 || ordem_id >= sistema->num_ordens) {
+// Função para liquidar ordem pendente do pool ao preço da ordem
+// Executada ou cancelada, a ordem volta ao pool e o handle fica obsoleto
+void processar_ordem(TradingSystem* sistema, HandleOrdem handle) {
+    Ordem* ordem = pool_ordens_obter(&sistema->ordens, handle);
+    if (!ordem) {
         return;
     }
     
-    Ordem* ordem = &sistema->ordens[ordem_id];
     Trader* trader = &sistema->traders[ordem->trader_id];
     Acao* acao = &sistema->acoes[ordem->acao_id];
     
     // Verificar se a ordem ainda é válida (preço atual próximo ao preço da ordem)
-    double diferenca_preco = fabs(ordem->preco - acao->preco_atual);
-    double percentual_diferenca = diferenca_preco / acao->preco_atual;
+    preco_t diferenca_preco = llabs(ordem->preco - acao->preco_atual);
     
-    // Se diferença é maior que 5%, cancelar a ordem
-    if (percentual_diferenca > 0.05) {
-        cancelar_ordem(sistema, ordem_id);
+    // Se diferença é maior que 5% (diferença * 20 > preço), cancelar a ordem
+    if (diferenca_preco * 20 > acao->preco_atual) {
+        cancelar_ordem(sistema, handle);
         return;
     }
     
@@ -52,10 +55,10 @@ void processar_ordem(TradingSystem* sistema, int ordem_id) {
     pthread_mutex_lock(&acao->mutex);
     
     if (ordem->tipo == 'C') { // Ordem de compra
-        double custo_total = ordem->preco * ordem->quantidade;
+        preco_t custo_total = ordem->preco * ordem->quantidade;
         
-        // Verificar se o trader tem saldo suficiente
-        if (trader->saldo >= custo_total) {
+        // Verificar se o trader tem saldo suficiente (fora o reservado pelas ordens no livro)
+        if (trader->saldo - trader->saldo_reservado >= custo_total) {
             // Executar a compra
             trader->saldo -= custo_total;
             trader->acoes_possuidas[ordem->acao_id] += ordem->quantidade;
@@ -64,20 +67,19 @@ void processar_ordem(TradingSystem* sistema, int ordem_id) {
             ordem->status = 1; // Executada
             sistema->executor.ordens_executadas++;
             
-            printf("EXECUTADA: Trader %d comprou %d ações de %s a R$ %.2f\n", 
-                   ordem->trader_id, ordem->quantidade, acao->nome, ordem->preco);
+            log_registrar_ordem(REGISTRO_LOG_EXECUTADA, ordem, 0, acao->nome);
+            pool_ordens_liberar_ordem(&sistema->ordens, handle);
             
             log_evento("Ordem de compra executada");
         } else {
             // Saldo insuficiente
-            cancelar_ordem(sistema, ordem_id);
-            printf("CANCELADA: Trader %d não tem saldo suficiente para comprar %d ações de %s\n", 
-                   ordem->trader_id, ordem->quantidade, acao->nome);
+            log_registrar_ordem(REGISTRO_LOG_SEM_SALDO, ordem, 0, acao->nome);
+            cancelar_ordem(sistema, handle);
         }
     } else if (ordem->tipo == 'V') { // Ordem de venda
-        // Verificar se o trader possui ações suficientes
-        if (trader->acoes_possuidas[ordem->acao_id] >= ordem->quantidade) {
-            double valor_recebido = ordem->preco * ordem->quantidade;
+        // Verificar se o trader possui ações suficientes (fora as reservadas pelas ordens no livro)
+        if (trader->acoes_possuidas[ordem->acao_id] - trader->acoes_reservadas[ordem->acao_id] >= ordem->quantidade) {
+            preco_t valor_recebido = ordem->preco * ordem->quantidade;
             
             // Executar a venda
             trader->saldo += valor_recebido;
@@ -87,15 +89,14 @@ void processar_ordem(TradingSystem* sistema, int ordem_id) {
             ordem->status = 1; // Executada
             sistema->executor.ordens_executadas++;
             
-            printf("EXECUTADA: Trader %d vendeu %d ações de %s a R$ %.2f\n", 
-                   ordem->trader_id, ordem->quantidade, acao->nome, ordem->preco);
+            log_registrar_ordem(REGISTRO_LOG_EXECUTADA, ordem, 0, acao->nome);
+            pool_ordens_liberar_ordem(&sistema->ordens, handle);
             
             log_evento("Ordem de venda executada");
         } else {
             // Ações insuficientes
-            cancelar_ordem(sistema, ordem_id);
-            printf("CANCELADA: Trader %d não possui ações suficientes para vender %d ações de %s\n", 
-                   ordem->trader_id, ordem->quantidade, acao->nome);
+            log_registrar_ordem(REGISTRO_LOG_SEM_ACOES, ordem, 0, acao->nome);
+            cancelar_ordem(sistema, handle);
         }
     }
     
@@ -103,51 +104,111 @@ void processar_ordem(TradingSystem* sistema, int ordem_id) {
     pthread_mutex_unlock(&trader->mutex);
 }
 
-void cancelar_ordem(TradingSystem* sistema, int ordem_id) {
-    if (ordem_id < 0 || ordem_id >= sistema->num_ordens) {
-        return;
+// Função para cancelar ordem do pool pelo handle
+// Ordem em repouso sai do livro da ação (O(1) pelo id no índice do livro) e libera
+// a sua reserva; ordem pendente que ainda não chegou ao livro só é descartada.
+// Em ambos os casos (e se a ordem já tinha sido executada no livro) ela volta
+// ao pool, e o handle fica obsoleto.
+// Retorna a quantidade retirada do livro
+int cancelar_ordem(TradingSystem* sistema, HandleOrdem handle) {
+    Ordem* ordem = pool_ordens_obter(&sistema->ordens, handle);
+    if (!ordem) {
+        return 0;
+    }
+    
+    int cancelada = 0;
+    if (ordem->status == 3) { // Em repouso no livro
+        cancelada = cancelar_ordem_no_livro(sistema, ordem);
+        if (cancelada == 0) {
+            // Saiu do livro executada antes do cancelamento
+            pool_ordens_liberar_ordem(&sistema->ordens, handle);
+            return 0;
+        }
+    } else if (ordem->status != 0) {
+        return 0;
     }
     
-    Ordem* ordem = &sistema->ordens[ordem_id];
-    ordem->status = 2; // Cancelada
     sistema->executor.ordens_canceladas++;
     
-    printf("CANCELADA: Ordem %d do trader %d foi cancelada\n", ordem_id, ordem->trader_id);
+    log_registrar_ordem(REGISTRO_LOG_CANCELADA, ordem, 0, NULL);
     log_evento("Ordem cancelada");
+    pool_ordens_liberar_ordem(&sistema->ordens, handle);
+    return cancelada;
 }
 
-int criar_ordem(TradingSystem* sistema, int trader_id, int acao_id, char tipo, double preco, int quantidade) {
+// Função para modificar a quantidade de uma ordem em repouso pelo handle
+// (nova_quantidade <= 0 cancela; mudança de preço é cancelar e criar outra)
+// Retorna 1 se a ordem foi modificada no livro
+int modificar_ordem(TradingSystem* sistema, HandleOrdem handle, int nova_quantidade) {
+    Ordem* ordem = pool_ordens_obter(&sistema->ordens, handle);
+    if (!ordem || ordem->status != 3) {
+        return 0;
+    }
+    if (nova_quantidade <= 0) {
+        return cancelar_ordem(sistema, handle) > 0;
+    }
+    
+    int resultado = modificar_ordem_no_livro(sistema, ordem, nova_quantidade);
+    if (resultado == 0) {
+        // Saiu do livro executada antes da modificação: volta ao pool
+        pool_ordens_liberar_ordem(&sistema->ordens, handle);
+        return 0;
+    }
+    if (resultado < 0) {
+        return 0; // Sem saldo/ações para o aumento: a ordem continua como estava
+    }
+    ordem->quantidade = nova_quantidade;
+    return 1;
+}
+
+// Função para gerar id único de ordem (seguro entre threads e processos)
+// Substitui gerar_id_aleatorio() para ordens que entram no livro, onde ids
+// repetidos tornariam o cancelamento por id ambíguo
+int gerar_id_ordem(TradingSystem* sistema) {
+    return __atomic_add_fetch(&sistema->proximo_id_ordem, 1, __ATOMIC_RELAXED);
+}
+
+// Função para criar ordem pendente no pool
+// Retorna o handle da ordem (HANDLE_ORDEM_INVALIDO se inválida ou sem espaço)
+HandleOrdem criar_ordem(TradingSystem* sistema, int trader_id, int acao_id, char tipo, preco_t preco, int quantidade) {
     if (trader_id < 0 || trader_id >= sistema->num_traders || 
-        acao_id < 0 || acao_id >= sistema->num_acoes ||
-        sistema->num_ordens >= MAX_ORDENS) {
-        return -1;
+        acao_id < 0 || acao_id >= sistema->num_acoes) {
+        return HANDLE_ORDEM_INVALIDO;
     }
     
+    Ordem nova_ordem;
+    memset(&nova_ordem, 0, sizeof(Ordem));
+    nova_ordem.trader_id = trader_id;
+    nova_ordem.acao_id = acao_id;
+    nova_ordem.tipo = tipo;
+    nova_ordem.preco = preco;
+    nova_ordem.quantidade = quantidade;
+    nova_ordem.timestamp = relogio_mercado();
+    nova_ordem.status = 0; // Pendente
+    // Mesmo gerador das ordens das threads: o id é a chave da ordem no livro
+    // da ação, e o handle (o retorno) só endereça a ordem no pool
+    nova_ordem.id = gerar_id_ordem(sistema);
+    
     pthread_mutex_lock(&sistema->mutex_geral);
     
-    Ordem* nova_ordem = &sistema->ordens[sistema->num_ordens];
-    nova_ordem->id = sistema->num_ordens;
-    nova_ordem->trader_id = trader_id;
-    nova_ordem->acao_id = acao_id;
-    nova_ordem->tipo = tipo;
-    nova_ordem->preco = preco;
-    nova_ordem->quantidade = quantidade;
-    nova_ordem->timestamp = time(NULL);
-    nova_ordem->status = 0; // Pendente
-    
-    sistema->num_ordens++;
+    HandleOrdem handle = pool_ordens_alocar(&sistema->ordens, &nova_ordem, NULL);
+    if (handle == HANDLE_ORDEM_INVALIDO) {
+        pthread_mutex_unlock(&sistema->mutex_geral);
+        printf("ERRO: Pool de ordens sem espaço, ordem do trader %d descartada\n", trader_id);
+        return HANDLE_ORDEM_INVALIDO;
+    }
     sistema->executor.total_ordens++;
     
-    printf("NOVA ORDEM: Trader %d %s %d ações de %s a R$ %.2f\n", 
+    LOG_DEBUG("NOVA ORDEM: Trader %d %s %d ações de %s a R$ %.2f\n", 
            trader_id, (tipo == 'C' ? "compra" : "vende"), quantidade, 
-           sistema->acoes[acao_id].nome, preco);
+           sistema->acoes[acao_id].nome, PRECO_EM_REAIS(preco));
     
     pthread_mutex_unlock(&sistema->mutex_geral);
     
     // Sinalizar que há novas ordens para processar
     sem_post(&sistema->sem_ordens);
     
-    return nova_ordem->id;
+    return handle;
 }
 
 void imprimir_estado_executor(TradingSystem* sistema) {
@@ -162,14 +223,17 @@ void imprimir_estado_executor(TradingSystem* sistema) {
 
 void imprimir_ordens(TradingSystem* sistema) {
     printf("\n=== ORDENS NO SISTEMA ===\n");
-    for (int i = 0; i < sistema->num_ordens; i++) {
-        Ordem* ordem = &sistema->ordens[i];
+    int limite = pool_ordens_limite(&sistema->ordens);
+    for (int i = 0; i < limite; i++) {
+        Ordem* ordem = pool_ordens_slot(&sistema->ordens, i);
+        if (!ordem) continue;
         char status_str[20];
         
         switch (ordem->status) {
             case 0: strcpy(status_str, "PENDENTE"); break;
             case 1: strcpy(status_str, "EXECUTADA"); break;
             case 2: strcpy(status_str, "CANCELADA"); break;
+            case 3: strcpy(status_str, "EM REPOUSO"); break;
             default: strcpy(status_str, "DESCONHECIDO"); break;
         }
         
@@ -177,7 +241,7 @@ void imprimir_ordens(TradingSystem* sistema) {
                ordem->id, ordem->trader_id, 
                (ordem->tipo == 'C' ? "COMPRA" : "VENDA"), 
                ordem->quantidade, sistema->acoes[ordem->acao_id].nome, 
-               ordem->preco, status_str);
+               PRECO_EM_REAIS(ordem->preco), status_str);
     }
     printf("\n");
 }
@@ -186,16 +250,16 @@ void imprimir_ordens(TradingSystem* sistema) {
 int verificar_oportunidades_execucao(TradingSystem* sistema) {
     int oportunidades = 0;
     
-    for (int i = 0; i < sistema->num_ordens; i++) {
-        Ordem* ordem = &sistema->ordens[i];
+    int limite = pool_ordens_limite(&sistema->ordens);
+    for (int i = 0; i < limite; i++) {
+        Ordem* ordem = pool_ordens_slot(&sistema->ordens, i);
         
-        if (ordem->status == 0) { // Ordem pendente
+        if (ordem && ordem->status == 0) { // Ordem pendente
             Acao* acao = &sistema->acoes[ordem->acao_id];
-            double diferenca_preco = fabs(ordem->preco - acao->preco_atual);
-            double percentual_diferenca = diferenca_preco / acao->preco_atual;
+            preco_t diferenca_preco = llabs(ordem->preco - acao->preco_atual);
             
             // Se preço está próximo (diferença menor que 2%), é uma oportunidade
-            if (percentual_diferenca <= 0.02) {
+            if (diferenca_preco * 50 <= acao->preco_atual) {
                 oportunidades++;
             }
         }
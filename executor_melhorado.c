@@ -8,9 +8,22 @@ static int ordens_aceitas = 0;
 static int ordens_rejeitadas = 0;
 static int ordens_timeout = 0;
 
+// Livros de ofertas (um por ação; pertencem ao executor)
+static LivroTicks livros_ordens[MAX_ACOES];
+static int num_livros_ordens = 0;
+
+// Última ordem de cada trader em repouso em cada ação (status 3; zerada: nenhuma)
+// Uma nova ordem do trader na ação substitui a anterior, que é cancelada
+static Ordem ordens_em_repouso[MAX_TRADERS][MAX_ACOES];
+
+// Função para sortear tempo de processamento (50-200ms), sem esperar
+int sortear_tempo_processamento() {
+    return TEMPO_PROCESSAMENTO_MIN + (aleatorio_proximo() % (TEMPO_PROCESSAMENTO_MAX - TEMPO_PROCESSAMENTO_MIN + 1));
+}
+
 // Função para simular tempo de processamento (50-200ms)
 int simular_tempo_processamento() {
-    int tempo = TEMPO_PROCESSAMENTO_MIN + (rand() % (TEMPO_PROCESSAMENTO_MAX - TEMPO_PROCESSAMENTO_MIN + 1));
+    int tempo = sortear_tempo_processamento();
     usleep(tempo * 1000); // Converter para microssegundos
     return tempo;
 }
@@ -23,8 +36,16 @@ double calcular_volatilidade_acao(TradingSystem* sistema, int acao_id) {
     
     Acao* acao = &sistema->acoes[acao_id];
     
-    // Calcular volatilidade baseada na variação percentual
-    double volatilidade = fabs(acao->variacao);
+    // Volatilidade recente (desvio padrão dos últimos preços / média);
+    // sem histórico suficiente, usar a variação do último preço
+    pthread_mutex_lock(&acao->mutex);
+    double volatilidade = estatisticas_janela_volatilidade(&acao->estatisticas);
+    pthread_mutex_unlock(&acao->mutex);
+    if (volatilidade == 0.0) {
+        InstantaneoPreco instantaneo;
+        ler_preco_acao(acao, &instantaneo);
+        volatilidade = fabs(instantaneo.variacao);
+    }
     
     // Adicionar componente baseado no volume
     double componente_volume = (double)acao->volume_negociado / 1000.0;
@@ -42,60 +63,64 @@ int verificar_criterios_avancados(TradingSystem* sistema, Ordem* ordem) {
     }
     
     Acao* acao = &sistema->acoes[ordem->acao_id];
+    InstantaneoPreco instantaneo;
+    ler_preco_acao(acao, &instantaneo);
     
     // 1. Verificar volatilidade da ação
     double volatilidade = calcular_volatilidade_acao(sistema, ordem->acao_id);
     if (volatilidade > MAX_VOLATILIDADE_ACEITA) {
-        printf("EXECUTOR: Ordem rejeitada - Volatilidade muito alta (%.2f%% > %.2f%%)\n", 
+        LOG_DEBUG("EXECUTOR: Ordem rejeitada - Volatilidade muito alta (%.2f%% > %.2f%%)\n", 
                volatilidade * 100, MAX_VOLATILIDADE_ACEITA * 100);
         return 0;
     }
     
     // 2. Verificar volume da ordem
     if (ordem->quantidade < MIN_VOLUME_ACEITO) {
-        printf("EXECUTOR: Ordem rejeitada - Volume muito baixo (%d < %d)\n", 
+        LOG_DEBUG("EXECUTOR: Ordem rejeitada - Volume muito baixo (%d < %d)\n", 
                ordem->quantidade, MIN_VOLUME_ACEITO);
         return 0;
     }
     
     if (ordem->quantidade > MAX_VOLUME_ACEITO) {
-        printf("EXECUTOR: Ordem rejeitada - Volume muito alto (%d > %d)\n", 
+        LOG_DEBUG("EXECUTOR: Ordem rejeitada - Volume muito alto (%d > %d)\n", 
                ordem->quantidade, MAX_VOLUME_ACEITO);
         return 0;
     }
     
     // 3. Verificar diferença de preço
-    double diferenca_preco = fabs(ordem->preco - acao->preco_atual);
-    double percentual_diferenca = diferenca_preco / acao->preco_atual;
+    preco_t diferenca_preco = llabs(ordem->preco - instantaneo.preco_atual);
     
-    if (percentual_diferenca > 0.05) { // 5% de diferença
-        printf("EXECUTOR: Ordem rejeitada - Diferença de preço muito alta (%.2f%%)\n", 
-               percentual_diferenca * 100);
+    if (diferenca_preco * 20 > instantaneo.preco_atual) { // 5% de diferença (diferença * 20 > preço)
+        LOG_DEBUG("EXECUTOR: Ordem rejeitada - Diferença de preço muito alta (%.2f%%)\n", 
+               (double)diferenca_preco / instantaneo.preco_atual * 100);
         return 0;
     }
     
-    // 4. Verificar se o trader tem saldo/ações suficientes
+    // 4. Verificar se o trader tem saldo/ações suficientes, descontadas as reservas
+    // das suas outras ordens (a reserva definitiva é feita ao aceitar)
     Trader* trader = &sistema->traders[ordem->trader_id];
     
     if (ordem->tipo == 'C') { // Compra
-        double custo_total = ordem->preco * ordem->quantidade;
-        if (trader->saldo < custo_total) {
-            printf("EXECUTOR: Ordem rejeitada - Saldo insuficiente (R$ %.2f < R$ %.2f)\n", 
-                   trader->saldo, custo_total);
+        preco_t custo_total = ordem->preco * ordem->quantidade;
+        preco_t saldo_disponivel = trader->saldo - trader->saldo_reservado;
+        if (saldo_disponivel < custo_total) {
+            LOG_DEBUG("EXECUTOR: Ordem rejeitada - Saldo insuficiente (R$ %.2f < R$ %.2f)\n", 
+                   PRECO_EM_REAIS(saldo_disponivel), PRECO_EM_REAIS(custo_total));
             return 0;
         }
     } else if (ordem->tipo == 'V') { // Venda
-        if (trader->acoes_possuidas[ordem->acao_id] < ordem->quantidade) {
-            printf("EXECUTOR: Ordem rejeitada - Ações insuficientes (%d < %d)\n", 
-                   trader->acoes_possuidas[ordem->acao_id], ordem->quantidade);
+        int acoes_disponiveis = trader->acoes_possuidas[ordem->acao_id] - trader->acoes_reservadas[ordem->acao_id];
+        if (acoes_disponiveis < ordem->quantidade) {
+            LOG_DEBUG("EXECUTOR: Ordem rejeitada - Ações insuficientes (%d < %d)\n", 
+                   acoes_disponiveis, ordem->quantidade);
             return 0;
         }
     }
     
     // 5. Verificar se a ação está muito volátil no momento
-    if (fabs(acao->variacao) > 0.1) { // 10% de variação
-        printf("EXECUTOR: Ordem rejeitada - Ação muito volátil (variação: %.2f%%)\n", 
-               acao->variacao * 100);
+    if (fabs(instantaneo.variacao) > 0.1) { // 10% de variação
+        LOG_DEBUG("EXECUTOR: Ordem rejeitada - Ação muito volátil (variação: %.2f%%)\n", 
+               instantaneo.variacao * 100);
         return 0;
     }
     
@@ -110,15 +135,72 @@ int decidir_aceitar_ordem(TradingSystem* sistema, Ordem* ordem) {
     }
     
     // Simular alguma aleatoriedade na decisão (95% de aceitação se passar pelos critérios)
-    double random = (double)rand() / RAND_MAX;
+    double random = (double)aleatorio_proximo() / ALEATORIO_MAX;
     if (random > 0.95) {
-        printf("EXECUTOR: Ordem rejeitada - Decisão aleatória do sistema\n");
+        LOG_DEBUG("EXECUTOR: Ordem rejeitada - Decisão aleatória do sistema\n");
+        return 0;
+    }
+    
+    // Reservar saldo/ações da ordem (pode falhar se outra ordem do trader reservou antes)
+    if (!reservar_ordem_trader(sistema, ordem)) {
+        LOG_DEBUG("EXECUTOR: Ordem rejeitada - Saldo/ações já reservados por outras ordens\n");
         return 0;
     }
     
     return 1; // Aceitar
 }
 
+// Função para obter o preço reservado por unidade de uma ordem de compra
+// É o preço no tick do livro: a ordem repousa nele e, como agressora, negocia a ele ou melhor
+static preco_t preco_reserva_compra(TradingSystem* sistema, const Ordem* ordem) {
+    preco_t tick = sistema->acoes[ordem->acao_id].tamanho_tick;
+    if (tick <= 0) tick = TAMANHO_TICK_PADRAO;
+    return (ordem->preco + tick / 2) / tick * tick;
+}
+
+// Função para reservar o saldo (compra) ou as ações (venda) de uma ordem aceita
+// Verifica e reserva sob o mutex do trader, então duas ordens não usam os mesmos recursos.
+// Retorna 1 se reservou, 0 se o disponível não cobre a ordem
+int reservar_ordem_trader(TradingSystem* sistema, const Ordem* ordem) {
+    Trader* trader = &sistema->traders[ordem->trader_id];
+    int reservada = 0;
+    
+    pthread_mutex_lock(&trader->mutex);
+    if (ordem->tipo == 'C') {
+        preco_t custo = preco_reserva_compra(sistema, ordem) * ordem->quantidade;
+        if (trader->saldo - trader->saldo_reservado >= custo) {
+            trader->saldo_reservado += custo;
+            reservada = 1;
+        }
+    } else if (ordem->tipo == 'V') {
+        int acao_id = ordem->acao_id;
+        if (trader->acoes_possuidas[acao_id] - trader->acoes_reservadas[acao_id] >= ordem->quantidade) {
+            trader->acoes_reservadas[acao_id] += ordem->quantidade;
+            reservada = 1;
+        }
+    }
+    pthread_mutex_unlock(&trader->mutex);
+    
+    return reservada;
+}
+
+// Função para liberar a reserva de parte de uma ordem que não vai mais negociar
+// (rejeitada pelo livro ou cancelada); negócios liberam a sua parte em liquidar_negocio
+void liberar_reserva_ordem(TradingSystem* sistema, const Ordem* ordem, int quantidade) {
+    if (quantidade <= 0) {
+        return;
+    }
+    Trader* trader = &sistema->traders[ordem->trader_id];
+    
+    pthread_mutex_lock(&trader->mutex);
+    if (ordem->tipo == 'C') {
+        trader->saldo_reservado -= preco_reserva_compra(sistema, ordem) * quantidade;
+    } else if (ordem->tipo == 'V') {
+        trader->acoes_reservadas[ordem->acao_id] -= quantidade;
+    }
+    pthread_mutex_unlock(&trader->mutex);
+}
+
 // Função para ler ordem do pipe com timeout usando poll()
 int ler_ordem_pipe(int pipe_read, Ordem* ordem) {
     struct pollfd pfd;
@@ -150,25 +232,51 @@ int enviar_resultado_price_updater(int pipe_write, Ordem* ordem, int resultado)
     msg.origem_id = 1; // Executor
     msg.destino_id = 2; // Price Updater
     msg.dados_ordem = resultado; // 1: aceita, 0: rejeita
-    msg.valor = ordem->preco;
+    msg.preco = ordem->preco;
+    msg.valor = PRECO_EM_REAIS(ordem->preco);
     msg.timestamp = time(NULL);
     
     return enviar_mensagem_pipe(pipe_write, &msg);
 }
 
+// Função para enviar negócio para o price updater
+int enviar_negocio_price_updater(int pipe_write, const Negocio* negocio) {
+    MensagemPipe msg;
+    memset(&msg, 0, sizeof(MensagemPipe));
+    msg.tipo_mensagem = 2; // Resultado de execução
+    msg.origem_id = 1; // Executor
+    msg.destino_id = 2; // Price Updater
+    msg.dados_ordem = negocio->acao_id;
+    msg.preco = negocio->preco;
+    msg.valor = PRECO_EM_REAIS(negocio->preco);
+    msg.quantidade = negocio->quantidade;
+    msg.timestamp = time(NULL);
+    
+    return enviar_mensagem_pipe(pipe_write, &msg);
+}
+
+// Callback de negócio da versão processos: liquidação já feita, avisar price updater
+static void callback_negocio_pipe(const Negocio* negocio, void* contexto) {
+    int pipe_write = *(int*)contexto;
+    enviar_negocio_price_updater(pipe_write, negocio);
+}
+
 // Função para log detalhado da execução
 void log_execucao_ordem(Ordem* ordem, int resultado, double tempo_processamento) {
-    time_t agora = time(NULL);
+    if (!LOG_HABILITADO(NIVEL_LOG_DEBUG)) {
+        return; // Sem formatar o horário à toa
+    }
+    time_t agora = relogio_mercado();
     char timestamp[64];
     strftime(timestamp, sizeof(timestamp), "%H:%M:%S", localtime(&agora));
     
-    printf("[%s] EXECUTOR: %s ordem do Trader %d (%s %d ações a R$ %.2f) em %.0fms\n", 
+    LOG_DEBUG("[%s] EXECUTOR: %s ordem do Trader %d (%s %d ações a R$ %.2f) em %.0fms\n", 
            timestamp, 
            resultado ? "ACEITOU" : "REJEITOU",
            ordem->trader_id,
            ordem->tipo == 'C' ? "COMPRA" : "VENDA",
            ordem->quantidade,
-           ordem->preco,
+           PRECO_EM_REAIS(ordem->preco),
            tempo_processamento);
 }
 
@@ -190,9 +298,82 @@ void atualizar_contadores_executor(TradingSystem* sistema, int resultado) {
     pthread_mutex_unlock(&sistema->executor.mutex);
 }
 
+// Função para cancelar a ordem anterior do trader que ainda repousa na ação
+// A nova ordem a substitui: o trader não acumula ordens velhas prendendo reservas
+static void substituir_ordem_em_repouso(TradingSystem* sistema, const Ordem* ordem) {
+    if (ordem->trader_id < 0 || ordem->trader_id >= MAX_TRADERS ||
+        ordem->acao_id < 0 || ordem->acao_id >= MAX_ACOES) {
+        return;
+    }
+    Ordem* anterior = &ordens_em_repouso[ordem->trader_id][ordem->acao_id];
+    if (anterior->status == 3) {
+        if (cancelar_ordem_no_livro(sistema, anterior) > 0) {
+            LOG_DEBUG("EXECUTOR: Ordem %d do Trader %d substituída pela ordem %d\n",
+                   anterior->id, ordem->trader_id, ordem->id);
+        }
+        anterior->status = 0;
+    }
+}
+
+// Função para lembrar a ordem que ficou em repouso (para substituí-la depois)
+static void registrar_ordem_em_repouso(const Ordem* ordem) {
+    if (ordem->status == 3 && ordem->trader_id >= 0 && ordem->trader_id < MAX_TRADERS &&
+        ordem->acao_id >= 0 && ordem->acao_id < MAX_ACOES) {
+        ordens_em_repouso[ordem->trader_id][ordem->acao_id] = *ordem;
+    }
+}
+
+// Função para processar uma ordem no executor: aceitar/rejeitar, contar e casar no livro
+// (usada pelas threads executoras e pela simulação com relógio virtual)
+// Retorna 1 se a ordem foi aceita
+int processar_ordem_executor(TradingSystem* sistema, Ordem* ordem, int tempo_processamento,
+                             CallbackNegocio callback, void* contexto) {
+    LOG_DEBUG("EXECUTOR: Processando ordem do Trader %d\n", ordem->trader_id);
+    
+    // A ordem anterior do trader nesta ação sai do livro e devolve a sua reserva
+    substituir_ordem_em_repouso(sistema, ordem);
+    
+    // Decidir se aceita ou rejeita a ordem
+    int resultado = decidir_aceitar_ordem(sistema, ordem);
+    
+    // Log da execução
+    log_execucao_ordem(ordem, resultado, tempo_processamento);
+    
+    // Atualizar contadores
+    atualizar_contadores_executor(sistema, resultado);
+    
+    // Se aceitou, casar no livro da ação; cada negócio vai para o callback
+    if (resultado) {
+        executar_ordem_no_livro(sistema, ordem, callback, contexto);
+        registrar_ordem_em_repouso(ordem);
+    }
+    return resultado;
+}
+
+// Função para levar ao livro as ordens pendentes que os traders criaram no pool
+// (na versão processos, decidir_acao_trader cria as ordens na memória compartilhada)
+// Cada ordem sai do pool ao ser retirada; dali em diante quem cuida dela é o
+// livro da ação. Retorna o número de ordens retiradas
+static int drenar_ordens_do_pool(TradingSystem* sistema, SistemaPipes* pipes) {
+    int retiradas = 0;
+    int limite = pool_ordens_limite(&sistema->ordens);
+    for (int i = 0; i < limite && sistema->sistema_ativo; i++) {
+        Ordem* pendente = pool_ordens_slot(&sistema->ordens, i);
+        Ordem ordem;
+        if (!pendente || pendente->status != 0 ||
+            !pool_ordens_retirar(&sistema->ordens, pool_ordens_handle(&sistema->ordens, i), &ordem)) {
+            continue;
+        }
+        processar_ordem_executor(sistema, &ordem, simular_tempo_processamento(), callback_negocio_pipe,
+                                 &pipes->executor_to_price_updater[1]);
+        retiradas++;
+    }
+    return retiradas;
+}
+
 // Função principal do processo executor melhorado
 void processo_executor_melhorado() {
-    printf("=== PROCESSO EXECUTOR MELHORADO INICIADO (PID: %d) ===\n", getpid());
+    LOG_INFO("=== PROCESSO EXECUTOR MELHORADO INICIADO (PID: %d) ===\n", getpid());
     
     // Anexar memória compartilhada
     TradingSystem* sistema = (TradingSystem*)shmat(shm_id, NULL, 0);
@@ -209,11 +390,14 @@ void processo_executor_melhorado() {
         exit(1);
     }
     
-    printf("Executor melhorado iniciado com configurações:\n");
-    printf("- Tempo de processamento: %d-%dms\n", TEMPO_PROCESSAMENTO_MIN, TEMPO_PROCESSAMENTO_MAX);
-    printf("- Timeout de leitura: %dms\n", TIMEOUT_PIPE_READ);
-    printf("- Volatilidade máxima aceita: %.1f%%\n", MAX_VOLATILIDADE_ACEITA * 100);
-    printf("- Volume aceito: %d-%d ações\n", MIN_VOLUME_ACEITO, MAX_VOLUME_ACEITO);
+    LOG_INFO("Executor melhorado iniciado com configurações:\n");
+    LOG_INFO("- Tempo de processamento: %d-%dms\n", TEMPO_PROCESSAMENTO_MIN, TEMPO_PROCESSAMENTO_MAX);
+    LOG_INFO("- Timeout de leitura: %dms\n", TIMEOUT_PIPE_READ);
+    LOG_INFO("- Volatilidade máxima aceita: %.1f%%\n", MAX_VOLATILIDADE_ACEITA * 100);
+    LOG_INFO("- Volume aceito: %d-%d ações\n", MIN_VOLUME_ACEITO, MAX_VOLUME_ACEITO);
+    
+    // Livros de ofertas ficam na memória privada do processo executor
+    inicializar_livros_ordens(sistema);
     
     // Configurar poll para leitura de pipes
     struct pollfd pfd;
@@ -231,11 +415,14 @@ void processo_executor_melhorado() {
             
             if (resultado_leitura == 1) {
                 // Ordem lida com sucesso
-                printf("EXECUTOR: Nova ordem recebida do Trader %d\n", ordem.trader_id);
+                LOG_DEBUG("EXECUTOR: Nova ordem recebida do Trader %d\n", ordem.trader_id);
                 
                 // Simular tempo de processamento
                 double tempo_processamento = simular_tempo_processamento();
                 
+                // A ordem anterior do trader nesta ação sai do livro e devolve a sua reserva
+                substituir_ordem_em_repouso(sistema, &ordem);
+                
                 // Decidir se aceita ou rejeita a ordem
                 int resultado = decidir_aceitar_ordem(sistema, &ordem);
                 
@@ -245,14 +432,14 @@ void processo_executor_melhorado() {
                 // Atualizar contadores
                 atualizar_contadores_executor(sistema, resultado);
                 
-                // Enviar resultado para o price updater
-                if (enviar_resultado_price_updater(pipes->executor_to_price_updater[1], &ordem, resultado) > 0) {
-                    printf("EXECUTOR: Resultado enviado para Price Updater\n");
-                }
-                
-                // Se aceitou, executar a ordem
+                // Se aceitou, casar no livro e enviar cada negócio para o price updater
                 if (resultado) {
-                    executar_ordem_aceita(sistema, &ordem);
+                    int executada = executar_ordem_no_livro(sistema, &ordem, callback_negocio_pipe,
+                                                            &pipes->executor_to_price_updater[1]);
+                    if (executada > 0) {
+                        LOG_DEBUG("EXECUTOR: %d ações negociadas, negócios enviados para Price Updater\n", executada);
+                    }
+                    registrar_ordem_em_repouso(&ordem);
                 }
                 
             } else if (resultado_leitura == 0) {
@@ -260,14 +447,19 @@ void processo_executor_melhorado() {
                 // Continuar loop
             } else {
                 // Erro na leitura
-                printf("EXECUTOR: Erro ao ler ordem do pipe\n");
+                LOG_ERRO("EXECUTOR: Erro ao ler ordem do pipe\n");
             }
         } else if (poll_result == 0) {
             // Timeout - nenhuma ordem disponível
             // Continuar loop
         } else {
             // Erro no poll
-            printf("EXECUTOR: Erro no poll()\n");
+            LOG_ERRO("EXECUTOR: Erro no poll()\n");
+        }
+        
+        // Ordens que os traders deixaram no pool compartilhado
+        if (drenar_ordens_do_pool(sistema, pipes) > 0) {
+            LOG_DEBUG("EXECUTOR: Ordens pendentes do pool enviadas ao livro\n");
         }
         
         // Pequena pausa para não sobrecarregar
@@ -275,13 +467,15 @@ void processo_executor_melhorado() {
     }
     
     // Estatísticas finais
-    printf("=== EXECUTOR MELHORADO FINALIZADO ===\n");
-    printf("Total de ordens processadas: %d\n", total_ordens_processadas);
-    printf("Ordens aceitas: %d (%.1f%%)\n", ordens_aceitas, 
+    LOG_INFO("=== EXECUTOR MELHORADO FINALIZADO ===\n");
+    LOG_INFO("Total de ordens processadas: %d\n", total_ordens_processadas);
+    LOG_INFO("Ordens aceitas: %d (%.1f%%)\n", ordens_aceitas, 
            total_ordens_processadas > 0 ? (double)ordens_aceitas / total_ordens_processadas * 100 : 0);
-    printf("Ordens rejeitadas: %d (%.1f%%)\n", ordens_rejeitadas,
+    LOG_INFO("Ordens rejeitadas: %d (%.1f%%)\n", ordens_rejeitadas,
            total_ordens_processadas > 0 ? (double)ordens_rejeitadas / total_ordens_processadas * 100 : 0);
-    printf("Timeouts de leitura: %d\n", ordens_timeout);
+    LOG_INFO("Timeouts de leitura: %d\n", ordens_timeout);
+    imprimir_livros_ordens(sistema);
+    liberar_livros_ordens();
     
     // Desanexar memória compartilhada
     shmdt(sistema);
@@ -290,38 +484,166 @@ void processo_executor_melhorado() {
     exit(0);
 }
 
-// Função para executar ordem aceita
-void executar_ordem_aceita(TradingSystem* sistema, Ordem* ordem) {
-    if (!ordem || ordem->trader_id < 0 || ordem->trader_id >= MAX_TRADERS ||
-        ordem->acao_id < 0 || ordem->acao_id >= sistema->num_acoes) {
-        return;
+// Função para inicializar os livros de ofertas do executor
+// A faixa contígua de cada livro é centrada no preço atual da ação
+void inicializar_livros_ordens(TradingSystem* sistema) {
+    int num_acoes = sistema ? sistema->num_acoes : MAX_ACOES;
+    if (num_acoes > MAX_ACOES) num_acoes = MAX_ACOES;
+    num_livros_ordens = 0;
+    memset(ordens_em_repouso, 0, sizeof(ordens_em_repouso));
+    // Livros novos não têm ordens em repouso, então nenhuma reserva continua valendo
+    for (int t = 0; sistema && t < MAX_TRADERS; t++) {
+        Trader* trader = &sistema->traders[t];
+        pthread_mutex_lock(&trader->mutex);
+        trader->saldo_reservado = 0;
+        memset(trader->acoes_reservadas, 0, sizeof(trader->acoes_reservadas));
+        pthread_mutex_unlock(&trader->mutex);
     }
+    for (int i = 0; i < num_acoes; i++) {
+        preco_t preco_referencia = sistema ? sistema->acoes[i].preco_atual : MIN_PRECO_ACAO;
+        preco_t tamanho_tick = sistema ? sistema->acoes[i].tamanho_tick : TAMANHO_TICK_PADRAO;
+        if (!livro_ticks_inicializar(&livros_ordens[i], i, preco_referencia, tamanho_tick)) {
+            break;
+        }
+        num_livros_ordens++;
+    }
+    LOG_INFO("✓ %d livros de ofertas inicializados (tick padrão R$ %.2f, %d níveis por livro)\n",
+           num_livros_ordens, PRECO_EM_REAIS(TAMANHO_TICK_PADRAO), NIVEIS_LIVRO_TICKS);
+}
+
+// Função para liberar os livros de ofertas
+void liberar_livros_ordens() {
+    for (int i = 0; i < num_livros_ordens; i++) {
+        livro_ticks_liberar(&livros_ordens[i]);
+    }
+    num_livros_ordens = 0;
+}
+
+// Função para obter o livro de ofertas de uma ação
+LivroTicks* obter_livro_ordens(int acao_id) {
+    if (acao_id < 0 || acao_id >= num_livros_ordens) {
+        return NULL;
+    }
+    return &livros_ordens[acao_id];
+}
+
+// Função para liquidar negócio entre comprador e vendedor
+// Consome as reservas dos dois lados; agressora é a ordem que chegou ao livro
+// (se ela é a compra, reservou ao seu preço limite, que pode ser pior que o do negócio)
+void liquidar_negocio(TradingSystem* sistema, const Negocio* negocio, const Ordem* agressora) {
+    preco_t valor = negocio->preco * negocio->quantidade;
+    preco_t preco_reservado = agressora->tipo == 'C' ? preco_reserva_compra(sistema, agressora) : negocio->preco;
+    Trader* comprador = &sistema->traders[negocio->comprador_id];
+    Trader* vendedor = &sistema->traders[negocio->vendedor_id];
+    Acao* acao = &sistema->acoes[negocio->acao_id];
+    
+    // Um trader por vez: nunca segura dois mutexes de trader ao mesmo tempo
+    pthread_mutex_lock(&comprador->mutex);
+    comprador->saldo -= valor;
+    comprador->saldo_reservado -= preco_reservado * negocio->quantidade;
+    comprador->acoes_possuidas[negocio->acao_id] += negocio->quantidade;
+    pthread_mutex_unlock(&comprador->mutex);
+    
+    pthread_mutex_lock(&vendedor->mutex);
+    vendedor->saldo += valor;
+    vendedor->acoes_possuidas[negocio->acao_id] -= negocio->quantidade;
+    vendedor->acoes_reservadas[negocio->acao_id] -= negocio->quantidade;
+    pthread_mutex_unlock(&vendedor->mutex);
     
-    Trader* trader = &sistema->traders[ordem->trader_id];
-    Acao* acao = &sistema->acoes[ordem->acao_id];
-    
-    pthread_mutex_lock(&trader->mutex);
     pthread_mutex_lock(&acao->mutex);
+    acao->volume_negociado += negocio->quantidade;
+    pthread_mutex_unlock(&acao->mutex);
     
-    if (ordem->tipo == 'C') { // Ordem de compra
-        double custo_total = ordem->preco * ordem->quantidade;
-        trader->saldo -= custo_total;
-        trader->acoes_possuidas[ordem->acao_id] += ordem->quantidade;
-        acao->volume_negociado += ordem->quantidade;
-        
-        printf("EXECUTADA: Trader %d comprou %d ações de %s a R$ %.2f\n", 
-               ordem->trader_id, ordem->quantidade, acao->nome, ordem->preco);
-        
-    } else if (ordem->tipo == 'V') { // Ordem de venda
-        double valor_recebido = ordem->preco * ordem->quantidade;
-        trader->saldo += valor_recebido;
-        trader->acoes_possuidas[ordem->acao_id] -= ordem->quantidade;
-        acao->volume_negociado += ordem->quantidade;
-        
-        printf("EXECUTADA: Trader %d vendeu %d ações de %s a R$ %.2f\n", 
-               ordem->trader_id, ordem->quantidade, acao->nome, ordem->preco);
+    barras_registrar_negocio(negocio->acao_id, negocio->preco, negocio->quantidade);
+    
+    // Roda com o mutex do livro seguro: só copia o registro, a formatação fica com o logger
+    if (LOG_HABILITADO(NIVEL_LOG_INFO)) {
+        log_registrar_negocio(negocio, acao->nome);
+    }
+}
+
+// Contexto para liquidar e repassar negócios ao chamador
+typedef struct {
+    TradingSystem* sistema;
+    const Ordem* ordem; // Ordem agressora
+    CallbackNegocio callback;
+    void* contexto;
+} ContextoNegocio;
+
+static void liquidar_e_repassar(const Negocio* negocio, void* contexto) {
+    ContextoNegocio* ctx = (ContextoNegocio*)contexto;
+    liquidar_negocio(ctx->sistema, negocio, ctx->ordem);
+    if (ctx->callback) {
+        ctx->callback(negocio, ctx->contexto);
+    }
+}
+
+// Função para executar ordem aceita (já reservada) no livro de ofertas da ação
+// Liquida cada negócio e repassa ao callback (opcional); o restante fica em repouso
+// com a sua reserva. Ordem que cruzaria com o próprio trader é cancelada.
+// Retorna a quantidade executada imediatamente
+int executar_ordem_no_livro(TradingSystem* sistema, Ordem* ordem, CallbackNegocio callback, void* contexto) {
+    if (ordem->trader_id < 0 || ordem->trader_id >= MAX_TRADERS) {
+        return 0;
     }
     
-    pthread_mutex_unlock(&acao->mutex);
-    pthread_mutex_unlock(&trader->mutex);
-} 
\ No newline at end of file
+    LivroTicks* livro = obter_livro_ordens(ordem->acao_id);
+    int executada = -1;
+    if (livro) {
+        ContextoNegocio ctx = {sistema, ordem, callback, contexto};
+        executada = livro_ticks_submeter_ordem(livro, ordem, liquidar_e_repassar, &ctx);
+    }
+    if (executada < 0) {
+        liberar_reserva_ordem(sistema, ordem, ordem->quantidade);
+        ordem->status = 2; // Cancelada
+        return 0;
+    }
+    
+    ordem->status = executada == ordem->quantidade ? 1 : 3; // 1: executada, 3: em repouso no livro
+    return executada;
+}
+
+// Função para cancelar o restante de uma ordem em repouso no livro da ação
+// Libera a reserva do que foi retirado (o que já negociou liberou a sua parte)
+// Retorna a quantidade cancelada (0 se a ordem não está mais no livro)
+int cancelar_ordem_no_livro(TradingSystem* sistema, const Ordem* ordem) {
+    LivroTicks* livro = obter_livro_ordens(ordem->acao_id);
+    if (!livro || ordem->trader_id < 0 || ordem->trader_id >= MAX_TRADERS) {
+        return 0;
+    }
+    
+    int cancelada = livro_ticks_cancelar_ordem(livro, ordem->id);
+    liberar_reserva_ordem(sistema, ordem, cancelada);
+    return cancelada;
+}
+
+// Função para modificar a quantidade em repouso de uma ordem no livro da ação
+// A nova quantidade é reservada inteira antes (um aumento nunca fica descoberto)
+// e depois sai a reserva do restante anterior.
+// Retorna 1 se modificou, 0 se a ordem não está mais no livro, -1 sem saldo/ações
+int modificar_ordem_no_livro(TradingSystem* sistema, const Ordem* ordem, int nova_quantidade) {
+    if (nova_quantidade <= 0) {
+        return cancelar_ordem_no_livro(sistema, ordem) > 0;
+    }
+    LivroTicks* livro = obter_livro_ordens(ordem->acao_id);
+    if (!livro || ordem->trader_id < 0 || ordem->trader_id >= MAX_TRADERS) {
+        return 0;
+    }
+    
+    Ordem nova = *ordem;
+    nova.quantidade = nova_quantidade;
+    if (!reservar_ordem_trader(sistema, &nova)) {
+        return -1;
+    }
+    int anterior = livro_ticks_modificar_ordem(livro, ordem->id, nova_quantidade);
+    liberar_reserva_ordem(sistema, ordem, anterior > 0 ? anterior : nova_quantidade);
+    return anterior > 0;
+}
+
+// Função para imprimir resumo dos livros de ofertas
+void imprimir_livros_ordens(TradingSystem* sistema) {
+    printf("\n=== LIVROS DE OFERTAS ===\n");
+    for (int i = 0; i < num_livros_ordens; i++) {
+        livro_ticks_imprimir(&livros_ordens[i], sistema->acoes[i].nome, 3);
+    }
+}
@@ -0,0 +1,65 @@
+#include "trading_system.h"
+
+// Exporta um histórico binário de ticks para CSV
+// Uso: ./exportar_ticks [historico_ticks.bin] [saida.csv]
+// Sem arquivo de saída o CSV vai para a saída padrão. Os preços saem com as
+// quatro casas da escala de ponto fixo, sem arredondamento.
+
+// Função para escrever um preço em ponto fixo como decimal exato
+static void escrever_preco(FILE* saida, preco_t preco) {
+    if (preco < 0) {
+        fputc('-', saida);
+        preco = -preco;
+    }
+    fprintf(saida, "%lld.%04lld", preco / ESCALA_PRECO, preco % ESCALA_PRECO);
+}
+
+int main(int argc, char* argv[]) {
+    const char* caminho = argc > 1 ? argv[1] : ARQUIVO_TICKS;
+
+    LeitorTicks leitor;
+    if (!leitor_ticks_abrir(&leitor, caminho)) {
+        fprintf(stderr, "Erro: %s não existe ou não é um histórico de ticks\n", caminho);
+        return 1;
+    }
+
+    FILE* saida = stdout;
+    if (argc > 2) {
+        saida = fopen(argv[2], "w");
+        if (!saida) {
+            perror("Erro ao criar arquivo CSV");
+            leitor_ticks_fechar(&leitor);
+            return 1;
+        }
+    }
+
+    fprintf(saida, "instante_ns,data_hora,acao_id,simbolo,preco_anterior,preco_novo,variacao_pct,motivo\n");
+
+    RegistroTick registro;
+    char data_hora[32];
+    while (leitor_ticks_proximo(&leitor, &registro)) {
+        time_t segundos = (time_t)(registro.instante_ns / 1000000000LL);
+        strftime(data_hora, sizeof(data_hora), "%Y-%m-%d %H:%M:%S", localtime(&segundos));
+        double variacao = registro.preco_anterior > 0 ?
+            (double)(registro.preco_novo - registro.preco_anterior) / registro.preco_anterior * 100 : 0.0;
+
+        fprintf(saida, "%lld,%s.%06lld,%d,%.*s,", registro.instante_ns, data_hora,
+                registro.instante_ns % 1000000000LL / 1000, registro.acao_id,
+                TAMANHO_SIMBOLO_TICK, registro.simbolo);
+        escrever_preco(saida, registro.preco_anterior);
+        fputc(',', saida);
+        escrever_preco(saida, registro.preco_novo);
+        fprintf(saida, ",%.4f,%s\n", variacao, nome_motivo_tick(registro.motivo));
+    }
+
+    fprintf(stderr, "%lld ticks exportados de %s\n", leitor.lidos, caminho);
+    if (leitor.lidos < leitor.total) {
+        fprintf(stderr, "Aviso: %lld registros não lidos\n", leitor.total - leitor.lidos);
+    }
+
+    leitor_ticks_fechar(&leitor);
+    if (saida != stdout) {
+        fclose(saida);
+    }
+    return 0;
+}
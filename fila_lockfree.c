@@ -0,0 +1,104 @@
+#include "trading_system.h"
+
+// Fila MPSC limitada baseada em slots com número de sequência.
+// Cada slot guarda a posição em que pode ser escrito (sequencia == pos) ou
+// lido (sequencia == pos + 1). Produtores disputam apenas o índice fim via
+// CAS; o único consumidor avança inicio sem operações atômicas de escrita.
+
+#define MASCARA_FILA_LOCKFREE (CAPACIDADE_FILA_LOCKFREE - 1)
+
+// Função para inicializar a fila lock-free
+void fila_lockfree_inicializar(FilaOrdensLockFree* fila) {
+    for (unsigned long i = 0; i < CAPACIDADE_FILA_LOCKFREE; i++) {
+        __atomic_store_n(&fila->slots[i].sequencia, i, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&fila->fim, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&fila->inicio, 0, __ATOMIC_RELEASE);
+}
+
+// Função para enfileirar ordem (seguro para múltiplos produtores)
+// Retorna 1 se a ordem foi enfileirada, 0 se a fila está cheia
+int fila_lockfree_enfileirar(FilaOrdensLockFree* fila, const Ordem* ordem) {
+    unsigned long pos = __atomic_load_n(&fila->fim, __ATOMIC_RELAXED);
+    SlotFilaOrdens* slot;
+
+    for (;;) {
+        slot = &fila->slots[pos & MASCARA_FILA_LOCKFREE];
+        unsigned long seq = __atomic_load_n(&slot->sequencia, __ATOMIC_ACQUIRE);
+        long diferenca = (long)seq - (long)pos;
+
+        if (diferenca == 0) {
+            // Slot livre: tentar reservar a posição
+            if (__atomic_compare_exchange_n(&fila->fim, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+            // CAS falhou: pos já foi recarregado com o valor atual
+        } else if (diferenca < 0) {
+            // Slot ainda não consumido uma volta atrás: fila cheia
+            return 0;
+        } else {
+            // Outro produtor reservou esta posição
+            pos = __atomic_load_n(&fila->fim, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->ordem = *ordem;
+
+    // Publicar o slot para o consumidor
+    __atomic_store_n(&slot->sequencia, pos + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+// Função para desenfileirar ordem (apenas um consumidor)
+// Retorna 1 se uma ordem foi removida, 0 se a fila está vazia
+int fila_lockfree_desenfileirar(FilaOrdensLockFree* fila, Ordem* ordem) {
+    unsigned long pos = __atomic_load_n(&fila->inicio, __ATOMIC_RELAXED);
+    SlotFilaOrdens* slot = &fila->slots[pos & MASCARA_FILA_LOCKFREE];
+    unsigned long seq = __atomic_load_n(&slot->sequencia, __ATOMIC_ACQUIRE);
+
+    if (seq != pos + 1) {
+        return 0; // Vazia (ou produtor ainda escrevendo o slot)
+    }
+
+    *ordem = slot->ordem;
+
+    // Liberar o slot para a próxima volta dos produtores
+    __atomic_store_n(&slot->sequencia, pos + CAPACIDADE_FILA_LOCKFREE, __ATOMIC_RELEASE);
+    __atomic_store_n(&fila->inicio, pos + 1, __ATOMIC_RELAXED);
+    return 1;
+}
+
+// Função para desenfileirar um lote de ordens (apenas um consumidor)
+// Copia até max ordens consecutivas já publicadas e avança inicio uma única vez.
+// Retorna o número de ordens removidas (0 se a fila está vazia)
+int fila_lockfree_desenfileirar_lote(FilaOrdensLockFree* fila, Ordem* ordens, int max) {
+    unsigned long pos = __atomic_load_n(&fila->inicio, __ATOMIC_RELAXED);
+    int removidas = 0;
+
+    while (removidas < max) {
+        SlotFilaOrdens* slot = &fila->slots[(pos + removidas) & MASCARA_FILA_LOCKFREE];
+        unsigned long seq = __atomic_load_n(&slot->sequencia, __ATOMIC_ACQUIRE);
+
+        if (seq != pos + removidas + 1) {
+            break; // Próximo slot ainda não publicado
+        }
+
+        ordens[removidas] = slot->ordem;
+        __atomic_store_n(&slot->sequencia, pos + removidas + CAPACIDADE_FILA_LOCKFREE,
+                         __ATOMIC_RELEASE);
+        removidas++;
+    }
+
+    if (removidas > 0) {
+        __atomic_store_n(&fila->inicio, pos + removidas, __ATOMIC_RELAXED);
+    }
+    return removidas;
+}
+
+// Função para obter tamanho aproximado da fila
+int fila_lockfree_tamanho(FilaOrdensLockFree* fila) {
+    unsigned long fim = __atomic_load_n(&fila->fim, __ATOMIC_RELAXED);
+    unsigned long inicio = __atomic_load_n(&fila->inicio, __ATOMIC_RELAXED);
+    return fim > inicio ? (int)(fim - inicio) : 0;
+}
@@ -0,0 +1,270 @@
+#define _POSIX_C_SOURCE 200809L
+#include "trading_system.h"
+#include <errno.h>
+#include <sys/stat.h>
+
+// Histórico binário de ticks
+// Substitui os snapshots em texto de historico_precos.txt (o arquivo era
+// aberto, recebia um fprintf por ação e era fechado a cada 10 rodadas, e as
+// mudanças de preço entre os snapshots só apareciam no log). Agora cada
+// mudança de preço entra como um RegistroTick de 40 bytes num buffer em
+// memória; o buffer vai para o arquivo num único write() quando enche,
+// periodicamente pelo price updater e ao final.
+// O arquivo é só de acréscimo: cabeçalho (mágica, versão, tamanho do
+// registro) seguido dos registros. Abrir um arquivo existente continua
+// depois do último registro completo.
+
+static const char* NOMES_MOTIVOS_TICK[NUM_MOTIVOS_TICK] = {
+    "execucao", "variacao", "noticia", "arbitragem", "abertura"
+};
+
+// Histórico do sistema (um por processo; na versão processos todos
+// acrescentam ao mesmo arquivo)
+static GravadorTicks gravador_sistema;
+static int historico_ativo = 0;
+static int handlers_registrados = 0;
+
+// Função para escrever o buffer no arquivo (chamador segura o mutex)
+// Retorna 1 em sucesso; em erro os registros do buffer são descartados
+static int escrever_buffer(GravadorTicks* gravador) {
+    if (gravador->usados == 0) {
+        return 1;
+    }
+
+    const char* dados = (const char*)gravador->buffer;
+    size_t restante = sizeof(RegistroTick) * gravador->usados;
+    int ok = 1;
+    while (restante > 0) {
+        ssize_t escritos = write(gravador->fd, dados, restante);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            perror("Erro ao gravar histórico de ticks");
+            ok = 0;
+            break;
+        }
+        dados += escritos;
+        restante -= escritos;
+    }
+
+    if (ok) {
+        gravador->gravados += gravador->usados;
+    }
+    gravador->usados = 0;
+    return ok;
+}
+
+// Função para conferir mágica, versão e tamanho de registro do cabeçalho
+int cabecalho_ticks_valido(const CabecalhoHistoricoTicks* cabecalho) {
+    return memcmp(cabecalho->magica, MAGICA_HISTORICO_TICKS, sizeof(MAGICA_HISTORICO_TICKS)) == 0 &&
+           cabecalho->versao == VERSAO_HISTORICO_TICKS &&
+           cabecalho->tamanho_registro == sizeof(RegistroTick);
+}
+
+// Função para abrir (ou criar) o arquivo de ticks para acréscimo
+// Retorna 1 em sucesso, 0 se o arquivo não abre ou não é um histórico de ticks
+int gravador_ticks_abrir(GravadorTicks* gravador, const char* caminho) {
+    memset(gravador, 0, sizeof(GravadorTicks));
+    gravador->fd = open(caminho, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (gravador->fd < 0) {
+        perror("Erro ao abrir histórico de ticks");
+        return 0;
+    }
+
+    struct stat info;
+    if (fstat(gravador->fd, &info) < 0) {
+        perror("Erro ao consultar histórico de ticks");
+        close(gravador->fd);
+        return 0;
+    }
+
+    CabecalhoHistoricoTicks cabecalho;
+    if (info.st_size == 0) {
+        memset(&cabecalho, 0, sizeof(cabecalho));
+        memcpy(cabecalho.magica, MAGICA_HISTORICO_TICKS, sizeof(MAGICA_HISTORICO_TICKS));
+        cabecalho.versao = VERSAO_HISTORICO_TICKS;
+        cabecalho.tamanho_registro = sizeof(RegistroTick);
+        cabecalho.criado_em_ns = relogio_mercado_ns();
+        if (write(gravador->fd, &cabecalho, sizeof(cabecalho)) != (ssize_t)sizeof(cabecalho)) {
+            perror("Erro ao gravar cabeçalho do histórico de ticks");
+            close(gravador->fd);
+            return 0;
+        }
+    } else {
+        if (pread(gravador->fd, &cabecalho, sizeof(cabecalho), 0) != (ssize_t)sizeof(cabecalho) ||
+            !cabecalho_ticks_valido(&cabecalho)) {
+            printf("Erro: %s não é um histórico de ticks compatível\n", caminho);
+            close(gravador->fd);
+            return 0;
+        }
+
+        // Descartar um registro incompleto no fim (gravação interrompida)
+        long long registros = (info.st_size - (long long)sizeof(cabecalho)) / (long long)sizeof(RegistroTick);
+        off_t tamanho_valido = sizeof(cabecalho) + registros * sizeof(RegistroTick);
+        if (tamanho_valido != info.st_size && ftruncate(gravador->fd, tamanho_valido) < 0) {
+            perror("Erro ao descartar registro incompleto do histórico de ticks");
+        }
+        gravador->gravados = registros;
+    }
+
+    pthread_mutex_init(&gravador->mutex, NULL);
+    return 1;
+}
+
+// Função para acrescentar um registro (vai para o arquivo quando o buffer enche)
+void gravador_ticks_registrar(GravadorTicks* gravador, const RegistroTick* registro) {
+    pthread_mutex_lock(&gravador->mutex);
+    gravador->buffer[gravador->usados++] = *registro;
+    if (gravador->usados == CAPACIDADE_BUFFER_TICKS) {
+        escrever_buffer(gravador);
+    }
+    pthread_mutex_unlock(&gravador->mutex);
+}
+
+// Função para escrever no arquivo os registros pendentes do buffer
+int gravador_ticks_descarregar(GravadorTicks* gravador) {
+    pthread_mutex_lock(&gravador->mutex);
+    int ok = escrever_buffer(gravador);
+    pthread_mutex_unlock(&gravador->mutex);
+    return ok;
+}
+
+// Função para descarregar o buffer e fechar o arquivo
+void gravador_ticks_fechar(GravadorTicks* gravador) {
+    gravador_ticks_descarregar(gravador);
+    close(gravador->fd);
+    gravador->fd = -1;
+    pthread_mutex_destroy(&gravador->mutex);
+}
+
+// Função para abrir um histórico de ticks para leitura sequencial
+// Retorna 1 em sucesso, 0 se o arquivo não abre ou não é um histórico de ticks
+int leitor_ticks_abrir(LeitorTicks* leitor, const char* caminho) {
+    memset(leitor, 0, sizeof(LeitorTicks));
+    leitor->arquivo = fopen(caminho, "rb");
+    if (!leitor->arquivo) {
+        return 0;
+    }
+
+    CabecalhoHistoricoTicks* cabecalho = &leitor->cabecalho;
+    struct stat info;
+    if (fread(cabecalho, sizeof(CabecalhoHistoricoTicks), 1, leitor->arquivo) != 1 ||
+        !cabecalho_ticks_valido(cabecalho) ||
+        fstat(fileno(leitor->arquivo), &info) < 0) {
+        fclose(leitor->arquivo);
+        leitor->arquivo = NULL;
+        return 0;
+    }
+
+    leitor->total = (info.st_size - (long long)sizeof(CabecalhoHistoricoTicks)) / (long long)sizeof(RegistroTick);
+    return 1;
+}
+
+// Função para ler o próximo registro
+// Retorna 1 se leu, 0 no fim do arquivo (ou em registro incompleto)
+int leitor_ticks_proximo(LeitorTicks* leitor, RegistroTick* registro) {
+    if (fread(registro, sizeof(RegistroTick), 1, leitor->arquivo) != 1) {
+        return 0;
+    }
+    leitor->lidos++;
+    return 1;
+}
+
+void leitor_ticks_fechar(LeitorTicks* leitor) {
+    if (leitor->arquivo) {
+        fclose(leitor->arquivo);
+        leitor->arquivo = NULL;
+    }
+}
+
+const char* nome_motivo_tick(int motivo) {
+    if (motivo < 0 || motivo >= NUM_MOTIVOS_TICK) {
+        return "desconhecido";
+    }
+    return NOMES_MOTIVOS_TICK[motivo];
+}
+
+// Antes do fork o processo pai escreve o que tem no buffer: senão os
+// registros pendentes seriam escritos também por cada filho
+static void preparar_fork() {
+    if (historico_ativo) {
+        pthread_mutex_lock(&gravador_sistema.mutex);
+        escrever_buffer(&gravador_sistema);
+    }
+}
+
+static void concluir_fork() {
+    if (historico_ativo) {
+        pthread_mutex_unlock(&gravador_sistema.mutex);
+    }
+}
+
+// Função para iniciar o histórico de ticks do sistema
+// Retorna 1 em sucesso; o buffer é descarregado também na saída do processo
+int historico_ticks_iniciar(const char* caminho) {
+    if (historico_ativo) {
+        return 1;
+    }
+    if (!gravador_ticks_abrir(&gravador_sistema, caminho)) {
+        return 0;
+    }
+    historico_ativo = 1;
+
+    if (!handlers_registrados) {
+        pthread_atfork(preparar_fork, concluir_fork, concluir_fork);
+        atexit(historico_ticks_finalizar);
+        handlers_registrados = 1;
+    }
+    return 1;
+}
+
+// Função para iniciar o histórico no arquivo de TRADING_HISTORICO_TICKS
+// (ARQUIVO_TICKS se ausente; vazio ou "0" desativa)
+// Retorna o caminho do arquivo, ou NULL se o histórico ficou desativado
+const char* historico_ticks_iniciar_do_ambiente() {
+    const char* caminho = getenv("TRADING_HISTORICO_TICKS");
+    if (!caminho) {
+        caminho = ARQUIVO_TICKS;
+    }
+    if (caminho[0] == '\0' || strcmp(caminho, "0") == 0) {
+        return NULL;
+    }
+    return historico_ticks_iniciar(caminho) ? caminho : NULL;
+}
+
+int historico_ticks_ativo() {
+    return historico_ativo;
+}
+
+// Função para registrar uma mudança de preço no histórico do sistema
+// Sem histórico iniciado (testes, simulação) não faz nada
+void historico_ticks_registrar(const Acao* acao, int acao_id, preco_t preco_anterior, preco_t preco_novo, int motivo) {
+    if (!historico_ativo) {
+        return;
+    }
+
+    RegistroTick registro;
+    memset(&registro, 0, sizeof(registro));
+    registro.instante_ns = relogio_mercado_ns();
+    registro.preco_anterior = preco_anterior;
+    registro.preco_novo = preco_novo;
+    memcpy(registro.simbolo, acao->nome, strnlen(acao->nome, TAMANHO_SIMBOLO_TICK - 1));
+    registro.acao_id = (unsigned short)acao_id;
+    registro.motivo = (unsigned char)motivo;
+    gravador_ticks_registrar(&gravador_sistema, &registro);
+}
+
+// Função para escrever os ticks pendentes (snapshots periódicos do price updater)
+void historico_ticks_descarregar() {
+    if (historico_ativo) {
+        gravador_ticks_descarregar(&gravador_sistema);
+    }
+}
+
+// Função para descarregar e fechar o histórico do sistema
+void historico_ticks_finalizar() {
+    if (!historico_ativo) {
+        return;
+    }
+    historico_ativo = 0;
+    gravador_ticks_fechar(&gravador_sistema);
+}
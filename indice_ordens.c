@@ -0,0 +1,175 @@
+#include "trading_system.h"
+
+// Índice de ordens por id (hash com endereçamento aberto).
+// Mapeia o id da ordem para o slot dela no pool do livro. As entradas ficam
+// em um único array contíguo com sondagem linear; a remoção desloca para trás
+// as entradas seguintes do mesmo agrupamento (sem lápides), então o custo de
+// busca não degrada com o volume de cancelamentos. O array dobra quando a
+// ocupação passa de metade da capacidade.
+
+#define ID_ORDEM_VAZIO -1
+
+// Função para calcular a posição inicial do id na tabela
+// Os ids vêm de gerar_id_ordem() (sequenciais): usar os bits baixos mantém
+// ordens criadas em sequência em entradas vizinhas (mesmas linhas de cache)
+// e sem colisões; os bits altos entram para espalhar ids de outras origens.
+static inline unsigned int posicao_inicial(const IndiceOrdens* indice, int ordem_id) {
+    unsigned int hash = (unsigned int)ordem_id;
+    hash ^= hash >> 16;
+    return hash & (unsigned int)(indice->capacidade - 1);
+}
+
+// Função para arredondar capacidade para potência de dois
+static int potencia_de_dois(int valor) {
+    int capacidade = CAPACIDADE_MINIMA_INDICE_ORDENS;
+    while (capacidade < valor) {
+        capacidade <<= 1;
+    }
+    return capacidade;
+}
+
+// Função para alocar a tabela com todas as entradas vazias
+static EntradaIndiceOrdens* alocar_entradas(int capacidade) {
+    EntradaIndiceOrdens* entradas = malloc(capacidade * sizeof(EntradaIndiceOrdens));
+    if (entradas) {
+        for (int i = 0; i < capacidade; i++) {
+            entradas[i].ordem_id = ID_ORDEM_VAZIO;
+            entradas[i].slot = -1;
+        }
+    }
+    return entradas;
+}
+
+// Função para inicializar índice de ordens
+// Retorna 1 em sucesso, 0 em falha de alocação
+int indice_ordens_inicializar(IndiceOrdens* indice, int capacidade_inicial) {
+    indice->capacidade = potencia_de_dois(capacidade_inicial);
+    indice->quantidade = 0;
+    indice->entradas = alocar_entradas(indice->capacidade);
+    if (!indice->entradas) {
+        printf("ERRO: Falha ao alocar índice de ordens (%d entradas)\n", indice->capacidade);
+        indice->capacidade = 0;
+        return 0;
+    }
+    return 1;
+}
+
+// Função para liberar índice de ordens
+void indice_ordens_liberar(IndiceOrdens* indice) {
+    free(indice->entradas);
+    indice->entradas = NULL;
+    indice->capacidade = 0;
+    indice->quantidade = 0;
+}
+
+// Função para dobrar a tabela e reinserir as entradas
+static int crescer_indice(IndiceOrdens* indice) {
+    int nova_capacidade = indice->capacidade * 2;
+    EntradaIndiceOrdens* novas = alocar_entradas(nova_capacidade);
+    if (!novas) {
+        printf("ERRO: Falha ao aumentar índice de ordens para %d entradas\n", nova_capacidade);
+        return 0;
+    }
+
+    EntradaIndiceOrdens* antigas = indice->entradas;
+    int capacidade_antiga = indice->capacidade;
+    indice->entradas = novas;
+    indice->capacidade = nova_capacidade;
+
+    for (int i = 0; i < capacidade_antiga; i++) {
+        if (antigas[i].ordem_id == ID_ORDEM_VAZIO) continue;
+        unsigned int posicao = posicao_inicial(indice, antigas[i].ordem_id);
+        while (novas[posicao].ordem_id != ID_ORDEM_VAZIO) {
+            posicao = (posicao + 1) & (nova_capacidade - 1);
+        }
+        novas[posicao] = antigas[i];
+    }
+    free(antigas);
+    return 1;
+}
+
+// Função para garantir espaço para mais uma entrada (a próxima inserção não aloca)
+// Retorna 1 se há espaço, 0 se falhou a alocação
+int indice_ordens_reservar(IndiceOrdens* indice) {
+    if ((indice->quantidade + 1) * 2 > indice->capacidade) {
+        return crescer_indice(indice);
+    }
+    return 1;
+}
+
+// Função para inserir ordem no índice
+// Retorna 1 se inseriu, 0 se o id já está no índice, é inválido ou falhou a alocação
+int indice_ordens_inserir(IndiceOrdens* indice, int ordem_id, int slot) {
+    if (ordem_id < 0) {
+        return 0;
+    }
+    if ((indice->quantidade + 1) * 2 > indice->capacidade && !crescer_indice(indice)) {
+        return 0;
+    }
+
+    unsigned int mascara = indice->capacidade - 1;
+    unsigned int posicao = posicao_inicial(indice, ordem_id);
+    while (indice->entradas[posicao].ordem_id != ID_ORDEM_VAZIO) {
+        if (indice->entradas[posicao].ordem_id == ordem_id) {
+            return 0;
+        }
+        posicao = (posicao + 1) & mascara;
+    }
+
+    indice->entradas[posicao].ordem_id = ordem_id;
+    indice->entradas[posicao].slot = slot;
+    indice->quantidade++;
+    return 1;
+}
+
+// Função para buscar o slot de uma ordem (-1 se não está no índice)
+int indice_ordens_buscar(const IndiceOrdens* indice, int ordem_id) {
+    if (ordem_id < 0 || indice->capacidade == 0) {
+        return -1;
+    }
+
+    unsigned int mascara = indice->capacidade - 1;
+    unsigned int posicao = posicao_inicial(indice, ordem_id);
+    while (indice->entradas[posicao].ordem_id != ID_ORDEM_VAZIO) {
+        if (indice->entradas[posicao].ordem_id == ordem_id) {
+            return indice->entradas[posicao].slot;
+        }
+        posicao = (posicao + 1) & mascara;
+    }
+    return -1;
+}
+
+// Função para remover ordem do índice
+// Retorna o slot removido (-1 se não estava no índice)
+int indice_ordens_remover(IndiceOrdens* indice, int ordem_id) {
+    if (ordem_id < 0 || indice->capacidade == 0) {
+        return -1;
+    }
+
+    unsigned int mascara = indice->capacidade - 1;
+    unsigned int posicao = posicao_inicial(indice, ordem_id);
+    while (indice->entradas[posicao].ordem_id != ordem_id) {
+        if (indice->entradas[posicao].ordem_id == ID_ORDEM_VAZIO) {
+            return -1;
+        }
+        posicao = (posicao + 1) & mascara;
+    }
+    int slot = indice->entradas[posicao].slot;
+
+    // Deslocar para trás as entradas que ficariam inalcançáveis com o buraco
+    unsigned int buraco = posicao;
+    unsigned int seguinte = (posicao + 1) & mascara;
+    while (indice->entradas[seguinte].ordem_id != ID_ORDEM_VAZIO) {
+        unsigned int ideal = posicao_inicial(indice, indice->entradas[seguinte].ordem_id);
+        // A entrada pode ocupar o buraco se o buraco está entre sua posição ideal e a atual
+        if (((seguinte - ideal) & mascara) >= ((seguinte - buraco) & mascara)) {
+            indice->entradas[buraco] = indice->entradas[seguinte];
+            buraco = seguinte;
+        }
+        seguinte = (seguinte + 1) & mascara;
+    }
+    indice->entradas[buraco].ordem_id = ID_ORDEM_VAZIO;
+    indice->entradas[buraco].slot = -1;
+    indice->quantidade--;
+    return slot;
+}
@@ -0,0 +1,193 @@
+#include "trading_system.h"
+#include <limits.h>
+
+// Índice de adjacência ação -> pares (monitor de arbitragem)
+// monitorar_arbitragem() comparava todos os pares de ações a cada ciclo:
+// n(n-1)/2 comparações, 78 com as 13 ações do sistema e ~50 milhões num
+// universo de 10.000. Aqui os pares monitorados são só os de ações do mesmo
+// grupo (setor) e os pares relacionados configurados, e cada ação aponta
+// para os pares de que participa. Uma rodada compara o preço de cada ação
+// com o da rodada anterior (O(n)) e reavalia só os pares das ações que
+// mudaram, cada par uma vez (marcas por época).
+
+typedef struct {
+    int grupo;
+    int acao;
+} AcaoGrupo;
+
+static int comparar_acoes_grupo(const void* a, const void* b) {
+    const AcaoGrupo* x = (const AcaoGrupo*)a;
+    const AcaoGrupo* y = (const AcaoGrupo*)b;
+    if (x->grupo != y->grupo) return x->grupo < y->grupo ? -1 : 1;
+    return (x->acao > y->acao) - (x->acao < y->acao);
+}
+
+static int comparar_pares(const void* a, const void* b) {
+    const ParAcoes* x = (const ParAcoes*)a;
+    const ParAcoes* y = (const ParAcoes*)b;
+    if (x->acao1 != y->acao1) return x->acao1 < y->acao1 ? -1 : 1;
+    return (x->acao2 > y->acao2) - (x->acao2 < y->acao2);
+}
+
+// Função para construir o índice
+// grupos[i]: grupo da ação i (< 0: sem grupo; NULL: nenhum grupo);
+// extras: pares relacionados configurados (inválidos são ignorados)
+// Retorna 1 em sucesso, 0 se faltar memória
+int indice_pares_construir(IndicePares* indice, int num_acoes, const int* grupos,
+                           const ParAcoes* extras, int num_extras) {
+    memset(indice, 0, sizeof(IndicePares));
+    if (num_acoes <= 0) {
+        return 0;
+    }
+
+    // Ações ordenadas por grupo: os pares de cada grupo saem de uma sequência
+    AcaoGrupo* ordem = malloc(sizeof(AcaoGrupo) * num_acoes);
+    if (!ordem) {
+        return 0;
+    }
+    int agrupadas = 0;
+    for (int i = 0; i < num_acoes; i++) {
+        if (grupos && grupos[i] >= 0) {
+            ordem[agrupadas].grupo = grupos[i];
+            ordem[agrupadas].acao = i;
+            agrupadas++;
+        }
+    }
+    qsort(ordem, agrupadas, sizeof(AcaoGrupo), comparar_acoes_grupo);
+
+    long long total = num_extras > 0 ? num_extras : 0;
+    for (int inicio = 0, fim; inicio < agrupadas; inicio = fim) {
+        for (fim = inicio + 1; fim < agrupadas && ordem[fim].grupo == ordem[inicio].grupo; fim++);
+        total += (long long)(fim - inicio) * (fim - inicio - 1) / 2;
+    }
+    if (total > INT_MAX / 2) {
+        free(ordem);
+        return 0;
+    }
+
+    ParAcoes* pares = malloc(sizeof(ParAcoes) * (total + 1));
+    if (!pares) {
+        free(ordem);
+        return 0;
+    }
+    int num_pares = 0;
+    for (int inicio = 0, fim; inicio < agrupadas; inicio = fim) {
+        for (fim = inicio + 1; fim < agrupadas && ordem[fim].grupo == ordem[inicio].grupo; fim++);
+        for (int a = inicio; a < fim; a++) {
+            for (int b = a + 1; b < fim; b++) {
+                pares[num_pares].acao1 = ordem[a].acao;
+                pares[num_pares].acao2 = ordem[b].acao;
+                num_pares++;
+            }
+        }
+    }
+    free(ordem);
+
+    for (int e = 0; e < num_extras; e++) {
+        int a = extras[e].acao1 < extras[e].acao2 ? extras[e].acao1 : extras[e].acao2;
+        int b = extras[e].acao1 < extras[e].acao2 ? extras[e].acao2 : extras[e].acao1;
+        if (a < 0 || b >= num_acoes || a == b) {
+            continue;
+        }
+        pares[num_pares].acao1 = a;
+        pares[num_pares].acao2 = b;
+        num_pares++;
+    }
+
+    // Pares configurados que já estão num grupo aparecem uma vez só
+    qsort(pares, num_pares, sizeof(ParAcoes), comparar_pares);
+    int unicos = 0;
+    for (int p = 0; p < num_pares; p++) {
+        if (unicos == 0 || comparar_pares(&pares[p], &pares[unicos - 1]) != 0) {
+            pares[unicos++] = pares[p];
+        }
+    }
+
+    indice->num_acoes = num_acoes;
+    indice->num_pares = unicos;
+    indice->pares = pares;
+    indice->inicio_adjacencia = calloc(num_acoes + 1, sizeof(int));
+    indice->adjacencia = malloc(sizeof(int) * (2 * (size_t)unicos + 1));
+    indice->ultimos_precos = calloc(num_acoes, sizeof(preco_t));
+    indice->marcas = calloc(unicos + 1, sizeof(unsigned int));
+    indice->alterados = malloc(sizeof(int) * ((size_t)unicos + 1));
+    if (!indice->inicio_adjacencia || !indice->adjacencia || !indice->ultimos_precos ||
+        !indice->marcas || !indice->alterados) {
+        indice_pares_liberar(indice);
+        return 0;
+    }
+
+    // Listas de adjacência contíguas: contar o grau, acumular, preencher
+    int* inicio = indice->inicio_adjacencia;
+    for (int p = 0; p < unicos; p++) {
+        inicio[pares[p].acao1 + 1]++;
+        inicio[pares[p].acao2 + 1]++;
+    }
+    for (int i = 0; i < num_acoes; i++) {
+        inicio[i + 1] += inicio[i];
+    }
+    int* cursor = malloc(sizeof(int) * num_acoes);
+    if (!cursor) {
+        indice_pares_liberar(indice);
+        return 0;
+    }
+    memcpy(cursor, inicio, sizeof(int) * num_acoes);
+    for (int p = 0; p < unicos; p++) {
+        indice->adjacencia[cursor[pares[p].acao1]++] = p;
+        indice->adjacencia[cursor[pares[p].acao2]++] = p;
+    }
+    free(cursor);
+    return 1;
+}
+
+void indice_pares_liberar(IndicePares* indice) {
+    free(indice->pares);
+    free(indice->inicio_adjacencia);
+    free(indice->adjacencia);
+    free(indice->ultimos_precos);
+    free(indice->marcas);
+    free(indice->alterados);
+    memset(indice, 0, sizeof(IndicePares));
+}
+
+// Função para obter os pares de que a ação participa (índices em indice->pares)
+// Retorna o número de pares
+int indice_pares_da_acao(const IndicePares* indice, int acao_id, const int** pares) {
+    if (acao_id < 0 || acao_id >= indice->num_acoes) {
+        *pares = NULL;
+        return 0;
+    }
+    *pares = &indice->adjacencia[indice->inicio_adjacencia[acao_id]];
+    return indice->inicio_adjacencia[acao_id + 1] - indice->inicio_adjacencia[acao_id];
+}
+
+// Função para listar os pares a reavaliar: os das ações cujo preço mudou
+// desde a chamada anterior (na primeira, todos os pares de ações com preço)
+// precos: um por ação. Em *pares fica a lista (válida até a próxima chamada)
+// Retorna o número de pares
+int indice_pares_alterados(IndicePares* indice, const preco_t* precos, const int** pares) {
+    indice->epoca++;
+    if (indice->epoca == 0) {
+        memset(indice->marcas, 0, sizeof(unsigned int) * indice->num_pares);
+        indice->epoca = 1;
+    }
+
+    int quantidade = 0;
+    for (int i = 0; i < indice->num_acoes; i++) {
+        if (precos[i] == indice->ultimos_precos[i]) {
+            continue;
+        }
+        indice->ultimos_precos[i] = precos[i];
+
+        for (int k = indice->inicio_adjacencia[i]; k < indice->inicio_adjacencia[i + 1]; k++) {
+            int par = indice->adjacencia[k];
+            if (indice->marcas[par] != indice->epoca) {
+                indice->marcas[par] = indice->epoca;
+                indice->alterados[quantidade++] = par;
+            }
+        }
+    }
+
+    *pares = indice->alterados;
+    return quantidade;
+}
@@ -0,0 +1,361 @@
+#include "trading_system.h"
+
+// Livro de ofertas por ação com prioridade preço-tempo.
+// Cada lado é uma lista de níveis de preço ordenada do melhor para o pior
+// (compras em ordem decrescente, vendas em ordem crescente) e cada nível
+// guarda suas ordens em FIFO. Uma ordem que cruza o lado oposto negocia ao
+// preço da ordem em repouso, nível a nível, até esgotar sua quantidade ou
+// deixar de cruzar; o restante fica em repouso no livro.
+
+// Função para arredondar preço ao tick mais próximo da ação
+static preco_t arredondar_preco_tick(preco_t preco, preco_t tick) {
+    return (preco + tick / 2) / tick * tick;
+}
+
+// Função para liberar as ordens e níveis de um lado do livro
+static void liberar_lado(NivelPreco* nivel) {
+    while (nivel) {
+        OrdemLivro* ordem = nivel->primeira;
+        while (ordem) {
+            OrdemLivro* proxima = ordem->proxima;
+            free(ordem);
+            ordem = proxima;
+        }
+        NivelPreco* proximo = nivel->proximo;
+        free(nivel);
+        nivel = proximo;
+    }
+}
+
+// Função para inicializar livro de ofertas
+void livro_inicializar(LivroOrdens* livro, int acao_id, preco_t tamanho_tick) {
+    memset(livro, 0, sizeof(LivroOrdens));
+    livro->acao_id = acao_id;
+    livro->tamanho_tick = tamanho_tick > 0 ? tamanho_tick : TAMANHO_TICK_PADRAO;
+    pthread_mutex_init(&livro->mutex, NULL);
+}
+
+// Função para liberar livro de ofertas
+void livro_liberar(LivroOrdens* livro) {
+    pthread_mutex_lock(&livro->mutex);
+    liberar_lado(livro->compras);
+    liberar_lado(livro->vendas);
+    livro->compras = NULL;
+    livro->vendas = NULL;
+    livro->ordens_em_repouso = 0;
+    pthread_mutex_unlock(&livro->mutex);
+    pthread_mutex_destroy(&livro->mutex);
+}
+
+// Função para verificar se o preço de uma ordem cruza o nível oposto
+static int preco_cruza(char tipo, preco_t preco, preco_t preco_nivel) {
+    return tipo == 'C' ? preco_nivel <= preco : preco_nivel >= preco;
+}
+
+// Função para negociar ordem contra o lado oposto do livro
+// Retorna a quantidade que ainda resta na ordem
+static int negociar_contra_livro(LivroOrdens* livro, const Ordem* ordem, preco_t preco, int quantidade,
+                                 CallbackNegocio callback, void* contexto) {
+    NivelPreco** lado_oposto = ordem->tipo == 'C' ? &livro->vendas : &livro->compras;
+
+    while (quantidade > 0 && *lado_oposto && preco_cruza(ordem->tipo, preco, (*lado_oposto)->preco)) {
+        NivelPreco* nivel = *lado_oposto;
+
+        while (quantidade > 0 && nivel->primeira) {
+            OrdemLivro* repouso = nivel->primeira;
+            int quantidade_negocio = quantidade < repouso->quantidade ? quantidade : repouso->quantidade;
+
+            Negocio negocio;
+            negocio.acao_id = livro->acao_id;
+            negocio.preco = nivel->preco;
+            negocio.quantidade = quantidade_negocio;
+            if (ordem->tipo == 'C') {
+                negocio.ordem_compra_id = ordem->id;
+                negocio.comprador_id = ordem->trader_id;
+                negocio.ordem_venda_id = repouso->ordem_id;
+                negocio.vendedor_id = repouso->trader_id;
+            } else {
+                negocio.ordem_compra_id = repouso->ordem_id;
+                negocio.comprador_id = repouso->trader_id;
+                negocio.ordem_venda_id = ordem->id;
+                negocio.vendedor_id = ordem->trader_id;
+            }
+
+            quantidade -= quantidade_negocio;
+            repouso->quantidade -= quantidade_negocio;
+            nivel->quantidade_total -= quantidade_negocio;
+            livro->negocios_realizados++;
+            livro->quantidade_negociada += quantidade_negocio;
+
+            // Ordem em repouso totalmente executada sai do início da fila
+            if (repouso->quantidade == 0) {
+                nivel->primeira = repouso->proxima;
+                if (!nivel->primeira) {
+                    nivel->ultima = NULL;
+                }
+                nivel->num_ordens--;
+                livro->ordens_em_repouso--;
+                free(repouso);
+            }
+
+            if (callback) {
+                callback(&negocio, contexto);
+            }
+        }
+
+        // Nível esgotado sai do livro
+        if (!nivel->primeira) {
+            *lado_oposto = nivel->proximo;
+            free(nivel);
+        }
+    }
+
+    return quantidade;
+}
+
+// Função para colocar o restante de uma ordem em repouso no livro
+static int inserir_em_repouso(LivroOrdens* livro, const Ordem* ordem, preco_t preco, int quantidade) {
+    NivelPreco** lado = ordem->tipo == 'C' ? &livro->compras : &livro->vendas;
+
+    // Procurar o nível (lista ordenada do melhor para o pior preço)
+    NivelPreco** posicao = lado;
+    while (*posicao) {
+        preco_t preco_nivel = (*posicao)->preco;
+        if (preco_nivel == preco) break;
+        if (ordem->tipo == 'C' ? preco_nivel < preco : preco_nivel > preco) break;
+        posicao = &(*posicao)->proximo;
+    }
+
+    NivelPreco* nivel = *posicao;
+    if (!nivel || nivel->preco != preco) {
+        nivel = calloc(1, sizeof(NivelPreco));
+        if (!nivel) {
+            printf("ERRO: Falha ao alocar nível de preço no livro da ação %d\n", livro->acao_id);
+            return 0;
+        }
+        nivel->preco = preco;
+        nivel->proximo = *posicao;
+        *posicao = nivel;
+    }
+
+    OrdemLivro* repouso = malloc(sizeof(OrdemLivro));
+    if (!repouso) {
+        printf("ERRO: Falha ao alocar ordem no livro da ação %d\n", livro->acao_id);
+        if (!nivel->primeira) {
+            *posicao = nivel->proximo;
+            free(nivel);
+        }
+        return 0;
+    }
+    repouso->ordem_id = ordem->id;
+    repouso->trader_id = ordem->trader_id;
+    repouso->tipo = ordem->tipo;
+    repouso->preco = preco;
+    repouso->quantidade = quantidade;
+    repouso->proxima = NULL;
+
+    // Fim da fila do nível (prioridade de tempo)
+    if (nivel->ultima) {
+        nivel->ultima->proxima = repouso;
+    } else {
+        nivel->primeira = repouso;
+    }
+    nivel->ultima = repouso;
+    nivel->quantidade_total += quantidade;
+    nivel->num_ordens++;
+    livro->ordens_em_repouso++;
+    return 1;
+}
+
+// Função para verificar, com o mutex do livro já travado, se a ordem chegaria a
+// uma ordem em repouso de trader_id antes de esgotar *quantidade
+// Percorre só as ordens que negociariam, na ordem de prioridade preço-tempo
+static int cruza_mesmo_trader(LivroOrdens* livro, char tipo, preco_t preco_limite, int trader_id, int* quantidade) {
+    NivelPreco* nivel = tipo == 'C' ? livro->vendas : livro->compras;
+    for (; nivel && *quantidade > 0 && preco_cruza(tipo, preco_limite, nivel->preco); nivel = nivel->proximo) {
+        for (OrdemLivro* ordem = nivel->primeira; ordem && *quantidade > 0; ordem = ordem->proxima) {
+            if (ordem->trader_id == trader_id) {
+                return 1;
+            }
+            *quantidade -= ordem->quantidade;
+        }
+    }
+    return 0;
+}
+
+// Função para submeter ordem limitada ao livro
+// Chama callback para cada negócio gerado; o restante fica em repouso.
+// Ordem que cruzaria com ordem em repouso do mesmo trader é rejeitada inteira,
+// como no livro por ticks.
+// Retorna a quantidade executada imediatamente (-1 se a ordem é inválida ou rejeitada)
+int livro_submeter_ordem(LivroOrdens* livro, const Ordem* ordem, CallbackNegocio callback, void* contexto) {
+    if (!ordem || ordem->quantidade <= 0 || (ordem->tipo != 'C' && ordem->tipo != 'V')) {
+        return -1;
+    }
+
+    preco_t preco = arredondar_preco_tick(ordem->preco, livro->tamanho_tick);
+
+    pthread_mutex_lock(&livro->mutex);
+    int quantidade = ordem->quantidade;
+    if (cruza_mesmo_trader(livro, ordem->tipo, preco, ordem->trader_id, &quantidade)) {
+        pthread_mutex_unlock(&livro->mutex);
+        return -1;
+    }
+    int restante = negociar_contra_livro(livro, ordem, preco, ordem->quantidade, callback, contexto);
+    if (restante > 0) {
+        inserir_em_repouso(livro, ordem, preco, restante);
+    }
+    pthread_mutex_unlock(&livro->mutex);
+
+    return ordem->quantidade - restante;
+}
+
+// Função para negociar ordem contra o livro sem deixar restante em repouso
+// (usada pelo livro por ticks para preços fora da faixa contígua)
+// Retorna a quantidade que ainda resta na ordem
+int livro_negociar_ordem(LivroOrdens* livro, const Ordem* ordem, preco_t preco_limite, int quantidade,
+                         CallbackNegocio callback, void* contexto) {
+    pthread_mutex_lock(&livro->mutex);
+    int restante = negociar_contra_livro(livro, ordem, preco_limite, quantidade, callback, contexto);
+    pthread_mutex_unlock(&livro->mutex);
+    return restante;
+}
+
+// Função para verificar se uma ordem cruzaria com ordem em repouso do mesmo trader
+// (usada pelo livro por ticks para a prevenção de autonegociação na reserva)
+// *quantidade é o que a ordem ainda negociaria e sai descontada do que as ordens
+// percorridas absorveriam. Retorna 1 se a ordem chegaria a uma ordem de trader_id
+int livro_cruza_trader(LivroOrdens* livro, char tipo, preco_t preco_limite, int trader_id, int* quantidade) {
+    pthread_mutex_lock(&livro->mutex);
+    int cruza = cruza_mesmo_trader(livro, tipo, preco_limite, trader_id, quantidade);
+    pthread_mutex_unlock(&livro->mutex);
+
+    return cruza;
+}
+
+// Função para cancelar ordem em repouso pelo id
+// Retorna a quantidade cancelada (0 se a ordem não está no livro)
+int livro_cancelar_ordem(LivroOrdens* livro, int ordem_id) {
+    int cancelada = 0;
+    NivelPreco** lados[2] = {&livro->compras, &livro->vendas};
+
+    pthread_mutex_lock(&livro->mutex);
+    for (int l = 0; l < 2 && !cancelada; l++) {
+        NivelPreco** posicao = lados[l];
+        for (; *posicao && !cancelada; posicao = cancelada ? posicao : &(*posicao)->proximo) {
+            NivelPreco* nivel = *posicao;
+            OrdemLivro* anterior = NULL;
+
+            for (OrdemLivro* ordem = nivel->primeira; ordem; anterior = ordem, ordem = ordem->proxima) {
+                if (ordem->ordem_id != ordem_id) continue;
+
+                if (anterior) {
+                    anterior->proxima = ordem->proxima;
+                } else {
+                    nivel->primeira = ordem->proxima;
+                }
+                if (nivel->ultima == ordem) {
+                    nivel->ultima = anterior;
+                }
+                nivel->quantidade_total -= ordem->quantidade;
+                nivel->num_ordens--;
+                livro->ordens_em_repouso--;
+                cancelada = ordem->quantidade;
+                free(ordem);
+
+                if (!nivel->primeira) {
+                    *posicao = nivel->proximo;
+                    free(nivel);
+                }
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock(&livro->mutex);
+
+    return cancelada;
+}
+
+// Função para modificar a quantidade de uma ordem em repouso pelo id
+// Reduzir mantém a prioridade de tempo; aumentar leva a ordem para o fim da fila
+// Retorna a quantidade anterior da ordem (0 se a ordem não está no livro)
+int livro_modificar_ordem(LivroOrdens* livro, int ordem_id, int nova_quantidade) {
+    if (nova_quantidade <= 0) {
+        return livro_cancelar_ordem(livro, ordem_id);
+    }
+
+    int anterior_quantidade = 0;
+    NivelPreco* lados[2] = {livro->compras, livro->vendas};
+
+    pthread_mutex_lock(&livro->mutex);
+    for (int l = 0; l < 2 && !anterior_quantidade; l++) {
+        for (NivelPreco* nivel = lados[l]; nivel && !anterior_quantidade; nivel = nivel->proximo) {
+            OrdemLivro* anterior = NULL;
+
+            for (OrdemLivro* ordem = nivel->primeira; ordem; anterior = ordem, ordem = ordem->proxima) {
+                if (ordem->ordem_id != ordem_id) continue;
+
+                anterior_quantidade = ordem->quantidade;
+                if (nova_quantidade > ordem->quantidade && ordem->proxima) {
+                    // Aumento perde a prioridade: sai da posição atual e vai para o fim da fila
+                    if (anterior) {
+                        anterior->proxima = ordem->proxima;
+                    } else {
+                        nivel->primeira = ordem->proxima;
+                    }
+                    ordem->proxima = NULL;
+                    nivel->ultima->proxima = ordem;
+                    nivel->ultima = ordem;
+                }
+                nivel->quantidade_total += nova_quantidade - ordem->quantidade;
+                ordem->quantidade = nova_quantidade;
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock(&livro->mutex);
+
+    return anterior_quantidade;
+}
+
+// Função para obter melhor oferta de um lado do livro ('C' ou 'V')
+// Retorna 1 se existe oferta, 0 se o lado está vazio
+int livro_melhor_oferta(LivroOrdens* livro, char tipo, preco_t* preco, int* quantidade) {
+    int existe = 0;
+
+    pthread_mutex_lock(&livro->mutex);
+    NivelPreco* nivel = tipo == 'C' ? livro->compras : livro->vendas;
+    if (nivel) {
+        if (preco) *preco = nivel->preco;
+        if (quantidade) *quantidade = nivel->quantidade_total;
+        existe = 1;
+    }
+    pthread_mutex_unlock(&livro->mutex);
+
+    return existe;
+}
+
+// Função para imprimir os melhores níveis do livro
+void livro_imprimir(LivroOrdens* livro, const char* nome_acao, int max_niveis) {
+    pthread_mutex_lock(&livro->mutex);
+    printf("--- Livro %s: %d ordens em repouso, %ld negócios, %ld ações negociadas ---\n",
+           nome_acao, livro->ordens_em_repouso, livro->negocios_realizados, livro->quantidade_negociada);
+
+    NivelPreco* compra = livro->compras;
+    NivelPreco* venda = livro->vendas;
+    for (int i = 0; i < max_niveis && (compra || venda); i++) {
+        if (compra) {
+            printf("   %6d @ %8.2f (%2d) |", compra->quantidade_total, PRECO_EM_REAIS(compra->preco), compra->num_ordens);
+            compra = compra->proximo;
+        } else {
+            printf("   %6s   %8s  %3s  |", "", "", "");
+        }
+        if (venda) {
+            printf(" %8.2f x %-6d (%2d)\n", PRECO_EM_REAIS(venda->preco), venda->quantidade_total, venda->num_ordens);
+            venda = venda->proximo;
+        } else {
+            printf("\n");
+        }
+    }
+    pthread_mutex_unlock(&livro->mutex);
+}
@@ -0,0 +1,587 @@
+#include "trading_system.h"
+
+// Livro de ofertas por ticks.
+// Os níveis de preço são um array contíguo indexado pelo deslocamento em ticks
+// a partir de um preço de referência (NIVEIS_LIVRO_TICKS níveis centrados nele).
+// Cada lado tem um bitmap de níveis não vazios com uma palavra de resumo, então
+// o melhor preço sai de duas instruções de contagem de zeros. As ordens ficam
+// em um pool contíguo e cada nível encadeia suas ordens em FIFO por índice.
+// Preços fora da faixa vão para um livro em lista (LivroOrdens) de reserva.
+// Um índice hash (id -> slot) dá cancelamento e modificação em O(1): o slot
+// guarda o nível e os vizinhos na fila, então a ordem sai sem varrer nada.
+//
+// Um nível nunca tem compras e vendas ao mesmo tempo: a ordem que chega casa
+// com tudo o que cruza antes de repousar, então os dois lados compartilham o
+// mesmo array de níveis.
+//
+// Prevenção de autonegociação: a ordem que cruzaria com uma ordem em repouso
+// do mesmo trader é rejeitada inteira, antes de qualquer negócio.
+
+#if PALAVRAS_BITMAP_TICKS > 64
+#error "O resumo do bitmap tem 64 bits: NIVEIS_LIVRO_TICKS deve ser no máximo 4096"
+#endif
+
+#define NIVEL_CENTRAL_TICKS (NIVEIS_LIVRO_TICKS / 2)
+
+// Função para arredondar preço ao tick mais próximo (mesma regra do livro em lista)
+static inline preco_t arredondar_preco_tick(preco_t preco, preco_t tick) {
+    return (preco + tick / 2) / tick * tick;
+}
+
+// Função para converter índice de nível em preço
+static inline preco_t preco_do_nivel(LivroTicks* livro, long nivel) {
+    return livro->preco_base + nivel * livro->tamanho_tick;
+}
+
+// Função para marcar nível não vazio no bitmap do lado
+static inline void marcar_nivel(unsigned long long* bitmap, unsigned long long* resumo, int nivel) {
+    bitmap[nivel >> 6] |= 1ULL << (nivel & 63);
+    *resumo |= 1ULL << (nivel >> 6);
+}
+
+// Função para desmarcar nível esvaziado no bitmap do lado
+static inline void desmarcar_nivel(unsigned long long* bitmap, unsigned long long* resumo, int nivel) {
+    bitmap[nivel >> 6] &= ~(1ULL << (nivel & 63));
+    if (!bitmap[nivel >> 6]) {
+        *resumo &= ~(1ULL << (nivel >> 6));
+    }
+}
+
+// Função para obter o maior nível marcado (melhor compra); -1 se vazio
+static inline int maior_nivel(const unsigned long long* bitmap, unsigned long long resumo) {
+    if (!resumo) return -1;
+    int palavra = 63 - __builtin_clzll(resumo);
+    return palavra * 64 + 63 - __builtin_clzll(bitmap[palavra]);
+}
+
+// Função para obter o menor nível marcado (melhor venda); -1 se vazio
+static inline int menor_nivel(const unsigned long long* bitmap, unsigned long long resumo) {
+    if (!resumo) return -1;
+    int palavra = __builtin_ctzll(resumo);
+    return palavra * 64 + __builtin_ctzll(bitmap[palavra]);
+}
+
+// Função para obter o menor nível marcado a partir de nivel (inclusive); -1 se nenhum
+static inline int menor_nivel_desde(const unsigned long long* bitmap, unsigned long long resumo, int nivel) {
+    if (nivel >= NIVEIS_LIVRO_TICKS) return -1;
+    int palavra = nivel >> 6;
+    unsigned long long bits = bitmap[palavra] & (~0ULL << (nivel & 63));
+    if (bits) return palavra * 64 + __builtin_ctzll(bits);
+    unsigned long long acima = palavra < 63 ? resumo & (~0ULL << (palavra + 1)) : 0;
+    if (!acima) return -1;
+    palavra = __builtin_ctzll(acima);
+    return palavra * 64 + __builtin_ctzll(bitmap[palavra]);
+}
+
+// Função para obter o maior nível marcado até nivel (inclusive); -1 se nenhum
+static inline int maior_nivel_ate(const unsigned long long* bitmap, unsigned long long resumo, int nivel) {
+    if (nivel < 0) return -1;
+    int palavra = nivel >> 6;
+    unsigned long long bits = bitmap[palavra] & (~0ULL >> (63 - (nivel & 63)));
+    if (bits) return palavra * 64 + 63 - __builtin_clzll(bits);
+    unsigned long long abaixo = resumo & ((1ULL << palavra) - 1);
+    if (!abaixo) return -1;
+    palavra = 63 - __builtin_clzll(abaixo);
+    return palavra * 64 + 63 - __builtin_clzll(bitmap[palavra]);
+}
+
+// Função para encadear os slots [inicio, fim) do pool na lista livre
+static void encadear_livres(LivroTicks* livro, int inicio, int fim) {
+    for (int i = inicio; i < fim; i++) {
+        livro->ordens[i].nivel = -1;
+        livro->ordens[i].proxima = i + 1 < fim ? i + 1 : livro->livre;
+    }
+    livro->livre = inicio;
+}
+
+// Função para garantir um slot livre no pool (dobra a capacidade quando cheio)
+// Retorna 1 se há slot livre, 0 em falha de alocação
+static int garantir_ordem_livre(LivroTicks* livro) {
+    if (livro->livre < 0) {
+        int nova_capacidade = livro->capacidade_ordens * 2;
+        OrdemTicks* novas = realloc(livro->ordens, nova_capacidade * sizeof(OrdemTicks));
+        if (!novas) {
+            printf("ERRO: Falha ao aumentar pool de ordens do livro da ação %d\n", livro->acao_id);
+            return 0;
+        }
+        livro->ordens = novas;
+        encadear_livres(livro, livro->capacidade_ordens, nova_capacidade);
+        livro->capacidade_ordens = nova_capacidade;
+    }
+    return 1;
+}
+
+// Função para alocar slot de ordem em repouso (-1 se faltou memória)
+static int alocar_ordem(LivroTicks* livro) {
+    if (!garantir_ordem_livre(livro)) {
+        return -1;
+    }
+
+    int indice = livro->livre;
+    livro->livre = livro->ordens[indice].proxima;
+    return indice;
+}
+
+// Função para devolver slot ao pool
+static void liberar_ordem(LivroTicks* livro, int indice) {
+    livro->ordens[indice].nivel = -1;
+    livro->ordens[indice].proxima = livro->livre;
+    livro->livre = indice;
+}
+
+// Função para inicializar livro de ofertas por ticks
+// Retorna 1 em sucesso, 0 em falha de alocação
+int livro_ticks_inicializar(LivroTicks* livro, int acao_id, preco_t preco_referencia, preco_t tamanho_tick) {
+    memset(livro, 0, sizeof(LivroTicks));
+    livro->acao_id = acao_id;
+    livro->tamanho_tick = tamanho_tick > 0 ? tamanho_tick : TAMANHO_TICK_PADRAO;
+    livro->preco_base = arredondar_preco_tick(preco_referencia, livro->tamanho_tick) -
+                        (preco_t)NIVEL_CENTRAL_TICKS * livro->tamanho_tick;
+    livro->livre = -1;
+    for (int i = 0; i < NIVEIS_LIVRO_TICKS; i++) {
+        livro->niveis[i].primeira = -1;
+        livro->niveis[i].ultima = -1;
+    }
+
+    livro->ordens = malloc(CAPACIDADE_INICIAL_ORDENS_TICKS * sizeof(OrdemTicks));
+    if (!livro->ordens) {
+        printf("ERRO: Falha ao alocar pool de ordens do livro da ação %d\n", acao_id);
+        return 0;
+    }
+    livro->capacidade_ordens = CAPACIDADE_INICIAL_ORDENS_TICKS;
+    encadear_livres(livro, 0, CAPACIDADE_INICIAL_ORDENS_TICKS);
+
+    if (!indice_ordens_inicializar(&livro->indice, CAPACIDADE_INICIAL_ORDENS_TICKS * 2)) {
+        free(livro->ordens);
+        livro->ordens = NULL;
+        return 0;
+    }
+
+    livro_inicializar(&livro->fora_da_faixa, acao_id, livro->tamanho_tick);
+    pthread_mutex_init(&livro->mutex, NULL);
+    return 1;
+}
+
+// Função para liberar livro de ofertas por ticks
+void livro_ticks_liberar(LivroTicks* livro) {
+    pthread_mutex_lock(&livro->mutex);
+    free(livro->ordens);
+    livro->ordens = NULL;
+    indice_ordens_liberar(&livro->indice);
+    livro->capacidade_ordens = 0;
+    livro->livre = -1;
+    livro->ordens_em_repouso = 0;
+    pthread_mutex_unlock(&livro->mutex);
+
+    livro_liberar(&livro->fora_da_faixa);
+    pthread_mutex_destroy(&livro->mutex);
+}
+
+// Função para consumir ordens de um nível do lado oposto em FIFO
+// Retorna a quantidade que ainda resta na ordem
+static int negociar_nivel(LivroTicks* livro, const Ordem* ordem, int nivel_indice, int quantidade,
+                          CallbackNegocio callback, void* contexto) {
+    NivelTicks* nivel = &livro->niveis[nivel_indice];
+    preco_t preco_nivel = preco_do_nivel(livro, nivel_indice);
+
+    while (quantidade > 0 && nivel->primeira >= 0) {
+        int indice = nivel->primeira;
+        OrdemTicks* repouso = &livro->ordens[indice];
+        int quantidade_negocio = quantidade < repouso->quantidade ? quantidade : repouso->quantidade;
+
+        Negocio negocio;
+        negocio.acao_id = livro->acao_id;
+        negocio.preco = preco_nivel;
+        negocio.quantidade = quantidade_negocio;
+        if (ordem->tipo == 'C') {
+            negocio.ordem_compra_id = ordem->id;
+            negocio.comprador_id = ordem->trader_id;
+            negocio.ordem_venda_id = repouso->ordem_id;
+            negocio.vendedor_id = repouso->trader_id;
+        } else {
+            negocio.ordem_compra_id = repouso->ordem_id;
+            negocio.comprador_id = repouso->trader_id;
+            negocio.ordem_venda_id = ordem->id;
+            negocio.vendedor_id = ordem->trader_id;
+        }
+
+        quantidade -= quantidade_negocio;
+        repouso->quantidade -= quantidade_negocio;
+        nivel->quantidade_total -= quantidade_negocio;
+        livro->negocios_realizados++;
+        livro->quantidade_negociada += quantidade_negocio;
+
+        // Ordem em repouso totalmente executada sai do início da fila
+        if (repouso->quantidade == 0) {
+            nivel->primeira = repouso->proxima;
+            if (nivel->primeira >= 0) {
+                livro->ordens[nivel->primeira].anterior = -1;
+            } else {
+                nivel->ultima = -1;
+            }
+            nivel->num_ordens--;
+            livro->ordens_em_repouso--;
+            indice_ordens_remover(&livro->indice, repouso->ordem_id);
+            liberar_ordem(livro, indice);
+        }
+
+        if (callback) {
+            callback(&negocio, contexto);
+        }
+    }
+
+    return quantidade;
+}
+
+// Função para negociar ordem contra os níveis do array até o nível limite
+// Retorna a quantidade que ainda resta na ordem
+static int negociar_faixa(LivroTicks* livro, const Ordem* ordem, long nivel_limite, int quantidade,
+                          CallbackNegocio callback, void* contexto) {
+    if (ordem->tipo == 'C') {
+        while (quantidade > 0) {
+            int nivel = menor_nivel(livro->bitmap_vendas, livro->resumo_vendas);
+            if (nivel < 0 || nivel > nivel_limite) break;
+            quantidade = negociar_nivel(livro, ordem, nivel, quantidade, callback, contexto);
+            if (livro->niveis[nivel].primeira < 0) {
+                desmarcar_nivel(livro->bitmap_vendas, &livro->resumo_vendas, nivel);
+            }
+        }
+    } else {
+        while (quantidade > 0) {
+            int nivel = maior_nivel(livro->bitmap_compras, livro->resumo_compras);
+            if (nivel < 0 || nivel < nivel_limite) break;
+            quantidade = negociar_nivel(livro, ordem, nivel, quantidade, callback, contexto);
+            if (livro->niveis[nivel].primeira < 0) {
+                desmarcar_nivel(livro->bitmap_compras, &livro->resumo_compras, nivel);
+            }
+        }
+    }
+    return quantidade;
+}
+
+// Função para colocar o restante de uma ordem em repouso no array
+static int inserir_em_repouso_faixa(LivroTicks* livro, const Ordem* ordem, int nivel_indice, int quantidade) {
+    int indice = alocar_ordem(livro);
+    if (indice < 0) {
+        return 0;
+    }
+
+    NivelTicks* nivel = &livro->niveis[nivel_indice];
+    OrdemTicks* repouso = &livro->ordens[indice];
+    repouso->ordem_id = ordem->id;
+    repouso->trader_id = ordem->trader_id;
+    repouso->tipo = ordem->tipo;
+    repouso->quantidade = quantidade;
+    repouso->nivel = nivel_indice;
+    repouso->anterior = nivel->ultima;
+    repouso->proxima = -1;
+
+    // Fim da fila do nível (prioridade de tempo)
+    if (nivel->ultima >= 0) {
+        livro->ordens[nivel->ultima].proxima = indice;
+    } else {
+        nivel->primeira = indice;
+        if (ordem->tipo == 'C') {
+            marcar_nivel(livro->bitmap_compras, &livro->resumo_compras, nivel_indice);
+        } else {
+            marcar_nivel(livro->bitmap_vendas, &livro->resumo_vendas, nivel_indice);
+        }
+    }
+    nivel->ultima = indice;
+    nivel->quantidade_total += quantidade;
+    nivel->num_ordens++;
+    livro->ordens_em_repouso++;
+
+    // Id único e espaço no índice já garantidos por livro_ticks_submeter_ordem
+    indice_ordens_inserir(&livro->indice, ordem->id, indice);
+    return 1;
+}
+
+// Função para verificar se a ordem cruzaria com ordem em repouso do mesmo trader
+// Percorre só as ordens que a ordem consumiria, na mesma ordem da negociação
+// (reserva antes da faixa, faixa, reserva depois da faixa), até esgotar a quantidade
+static int cruza_mesmo_trader(LivroTicks* livro, const Ordem* ordem, long nivel_limite, preco_t preco) {
+    LivroOrdens* fora = &livro->fora_da_faixa;
+    int restante = ordem->quantidade;
+    int antes_da_faixa;
+
+    if (ordem->tipo == 'C') {
+        if (fora->vendas) {
+            preco_t limite = preco < livro->preco_base ? preco : livro->preco_base - livro->tamanho_tick;
+            if (livro_cruza_trader(fora, 'C', limite, ordem->trader_id, &restante)) return 1;
+        }
+        antes_da_faixa = restante;
+        for (int nivel = menor_nivel(livro->bitmap_vendas, livro->resumo_vendas);
+             nivel >= 0 && nivel <= nivel_limite && restante > 0;
+             nivel = menor_nivel_desde(livro->bitmap_vendas, livro->resumo_vendas, nivel + 1)) {
+            for (int i = livro->niveis[nivel].primeira; i >= 0 && restante > 0; i = livro->ordens[i].proxima) {
+                if (livro->ordens[i].trader_id == ordem->trader_id) return 1;
+                restante -= livro->ordens[i].quantidade;
+            }
+        }
+        if (restante <= 0 || nivel_limite < NIVEIS_LIVRO_TICKS || !fora->vendas) return 0;
+    } else {
+        if (fora->compras) {
+            preco_t topo = preco_do_nivel(livro, NIVEIS_LIVRO_TICKS - 1);
+            preco_t limite = preco > topo ? preco : topo + livro->tamanho_tick;
+            if (livro_cruza_trader(fora, 'V', limite, ordem->trader_id, &restante)) return 1;
+        }
+        antes_da_faixa = restante;
+        for (int nivel = maior_nivel(livro->bitmap_compras, livro->resumo_compras);
+             nivel >= 0 && nivel >= nivel_limite && restante > 0;
+             nivel = maior_nivel_ate(livro->bitmap_compras, livro->resumo_compras, nivel - 1)) {
+            for (int i = livro->niveis[nivel].primeira; i >= 0 && restante > 0; i = livro->ordens[i].proxima) {
+                if (livro->ordens[i].trader_id == ordem->trader_id) return 1;
+                restante -= livro->ordens[i].quantidade;
+            }
+        }
+        if (restante <= 0 || nivel_limite >= 0 || !fora->compras) return 0;
+    }
+
+    // A reserva do outro extremo vem depois da já percorrida na mesma lista:
+    // percorre de novo desde o início, devolvendo o que a primeira parte absorveu
+    restante += ordem->quantidade - antes_da_faixa;
+    return livro_cruza_trader(fora, ordem->tipo, preco, ordem->trader_id, &restante);
+}
+
+// Função para submeter ordem limitada ao livro por ticks
+// Mesma semântica de livro_submeter_ordem: callback por negócio, restante em repouso.
+// Retorna a quantidade executada imediatamente (-1 se a ordem é inválida, tem o
+// id de outra ordem em repouso, não caberia no livro ou cruzaria com ordem em
+// repouso do mesmo trader; nesse caso nada negocia)
+int livro_ticks_submeter_ordem(LivroTicks* livro, const Ordem* ordem, CallbackNegocio callback, void* contexto) {
+    if (!ordem || ordem->quantidade <= 0 || (ordem->tipo != 'C' && ordem->tipo != 'V')) {
+        return -1;
+    }
+
+    preco_t tick = livro->tamanho_tick;
+    preco_t preco = arredondar_preco_tick(ordem->preco, tick);
+    long nivel = (long)((preco - livro->preco_base) / tick); // Exato: base e preço estão no grid
+    preco_t preco_base = livro->preco_base;
+    preco_t preco_topo = preco_do_nivel(livro, NIVEIS_LIVRO_TICKS - 1);
+    LivroOrdens* fora = &livro->fora_da_faixa;
+    int restante = ordem->quantidade;
+
+    pthread_mutex_lock(&livro->mutex);
+
+    if (cruza_mesmo_trader(livro, ordem, nivel, preco)) {
+        livro->autonegociacoes_evitadas++;
+        pthread_mutex_unlock(&livro->mutex);
+        return -1;
+    }
+
+    // O restante precisa poder ficar em repouso antes de qualquer negócio: um id
+    // repetido não seria endereçável (e a execução dele tiraria do índice a outra
+    // ordem), e faltar memória depois de negociar deixaria a ordem pela metade
+    if (indice_ordens_buscar(&livro->indice, ordem->id) >= 0 ||
+        !garantir_ordem_livre(livro) || !indice_ordens_reservar(&livro->indice)) {
+        pthread_mutex_unlock(&livro->mutex);
+        return -1;
+    }
+
+    // Ordem de preço: reserva abaixo/acima da faixa, faixa, reserva do outro extremo
+    if (ordem->tipo == 'C') {
+        if (fora->vendas) {
+            preco_t limite = preco < preco_base ? preco : preco_base - tick;
+            restante = livro_negociar_ordem(fora, ordem, limite, restante, callback, contexto);
+        }
+        if (restante > 0 && nivel >= 0) {
+            restante = negociar_faixa(livro, ordem, nivel, restante, callback, contexto);
+        }
+        if (restante > 0 && nivel >= NIVEIS_LIVRO_TICKS && fora->vendas) {
+            restante = livro_negociar_ordem(fora, ordem, preco, restante, callback, contexto);
+        }
+    } else {
+        if (fora->compras) {
+            preco_t limite = preco > preco_topo ? preco : preco_topo + tick;
+            restante = livro_negociar_ordem(fora, ordem, limite, restante, callback, contexto);
+        }
+        if (restante > 0 && nivel < NIVEIS_LIVRO_TICKS) {
+            restante = negociar_faixa(livro, ordem, nivel, restante, callback, contexto);
+        }
+        if (restante > 0 && nivel < 0 && fora->compras) {
+            restante = livro_negociar_ordem(fora, ordem, preco, restante, callback, contexto);
+        }
+    }
+
+    if (restante > 0) {
+        if (nivel >= 0 && nivel < NIVEIS_LIVRO_TICKS) {
+            inserir_em_repouso_faixa(livro, ordem, (int)nivel, restante);
+        } else {
+            // Nada mais cruza: a reserva só guarda o restante em repouso
+            Ordem restante_ordem = *ordem;
+            restante_ordem.quantidade = restante;
+            livro_submeter_ordem(fora, &restante_ordem, NULL, NULL);
+        }
+    }
+
+    pthread_mutex_unlock(&livro->mutex);
+
+    return ordem->quantidade - restante;
+}
+
+// Função para retirar ordem da fila do seu nível (O(1) pelos vizinhos)
+static void desencadear_ordem(LivroTicks* livro, int indice) {
+    OrdemTicks* ordem = &livro->ordens[indice];
+    NivelTicks* nivel = &livro->niveis[ordem->nivel];
+
+    if (ordem->anterior >= 0) {
+        livro->ordens[ordem->anterior].proxima = ordem->proxima;
+    } else {
+        nivel->primeira = ordem->proxima;
+    }
+    if (ordem->proxima >= 0) {
+        livro->ordens[ordem->proxima].anterior = ordem->anterior;
+    } else {
+        nivel->ultima = ordem->anterior;
+    }
+    nivel->quantidade_total -= ordem->quantidade;
+    nivel->num_ordens--;
+
+    if (nivel->primeira < 0) {
+        if (ordem->tipo == 'C') {
+            desmarcar_nivel(livro->bitmap_compras, &livro->resumo_compras, ordem->nivel);
+        } else {
+            desmarcar_nivel(livro->bitmap_vendas, &livro->resumo_vendas, ordem->nivel);
+        }
+    }
+}
+
+// Função para cancelar ordem em repouso pelo id
+// Retorna a quantidade cancelada (0 se a ordem não está no livro)
+int livro_ticks_cancelar_ordem(LivroTicks* livro, int ordem_id) {
+    int cancelada = 0;
+
+    pthread_mutex_lock(&livro->mutex);
+    int indice = indice_ordens_remover(&livro->indice, ordem_id);
+    if (indice >= 0) {
+        cancelada = livro->ordens[indice].quantidade;
+        desencadear_ordem(livro, indice);
+        livro->ordens_em_repouso--;
+        liberar_ordem(livro, indice);
+    } else if (livro->fora_da_faixa.ordens_em_repouso > 0) {
+        // Reserva fora da faixa não é indexada (poucas ordens, busca linear)
+        cancelada = livro_cancelar_ordem(&livro->fora_da_faixa, ordem_id);
+    }
+    pthread_mutex_unlock(&livro->mutex);
+
+    return cancelada;
+}
+
+// Função para modificar a quantidade de uma ordem em repouso
+// Reduzir mantém a prioridade de tempo; aumentar leva a ordem para o fim da fila;
+// quantidade <= 0 cancela. Mudança de preço é cancelar e submeter de novo.
+// Retorna a quantidade anterior da ordem (0 se a ordem não está no livro)
+int livro_ticks_modificar_ordem(LivroTicks* livro, int ordem_id, int nova_quantidade) {
+    if (nova_quantidade <= 0) {
+        return livro_ticks_cancelar_ordem(livro, ordem_id);
+    }
+
+    pthread_mutex_lock(&livro->mutex);
+    int indice = indice_ordens_buscar(&livro->indice, ordem_id);
+    if (indice < 0) {
+        // Reserva fora da faixa não é indexada (poucas ordens, busca linear)
+        int anterior = livro->fora_da_faixa.ordens_em_repouso > 0
+            ? livro_modificar_ordem(&livro->fora_da_faixa, ordem_id, nova_quantidade) : 0;
+        pthread_mutex_unlock(&livro->mutex);
+        return anterior;
+    }
+
+    OrdemTicks* ordem = &livro->ordens[indice];
+    NivelTicks* nivel = &livro->niveis[ordem->nivel];
+    int anterior = ordem->quantidade;
+    if (nova_quantidade > ordem->quantidade && ordem->proxima >= 0) {
+        // Aumento perde a prioridade: sai da posição atual e vai para o fim da fila
+        int nivel_indice = ordem->nivel;
+        desencadear_ordem(livro, indice);
+        ordem->nivel = nivel_indice;
+        ordem->anterior = nivel->ultima;
+        ordem->proxima = -1;
+        livro->ordens[nivel->ultima].proxima = indice;
+        nivel->ultima = indice;
+        nivel->quantidade_total += ordem->quantidade;
+        nivel->num_ordens++;
+    }
+    nivel->quantidade_total += nova_quantidade - ordem->quantidade;
+    ordem->quantidade = nova_quantidade;
+    pthread_mutex_unlock(&livro->mutex);
+
+    return anterior;
+}
+
+// Função para obter melhor oferta de um lado do livro ('C' ou 'V')
+// Retorna 1 se existe oferta, 0 se o lado está vazio
+int livro_ticks_melhor_oferta(LivroTicks* livro, char tipo, preco_t* preco, int* quantidade) {
+    preco_t melhor_preco = 0;
+    int melhor_quantidade = 0;
+    int existe = 0;
+
+    pthread_mutex_lock(&livro->mutex);
+    int nivel = tipo == 'C' ? maior_nivel(livro->bitmap_compras, livro->resumo_compras)
+                            : menor_nivel(livro->bitmap_vendas, livro->resumo_vendas);
+    if (nivel >= 0) {
+        melhor_preco = preco_do_nivel(livro, nivel);
+        melhor_quantidade = livro->niveis[nivel].quantidade_total;
+        existe = 1;
+    }
+
+    // A reserva pode ter preço melhor que a faixa (acima para compras, abaixo para vendas)
+    preco_t preco_fora;
+    int quantidade_fora;
+    if (livro_melhor_oferta(&livro->fora_da_faixa, tipo, &preco_fora, &quantidade_fora) &&
+        (!existe || (tipo == 'C' ? preco_fora > melhor_preco : preco_fora < melhor_preco))) {
+        melhor_preco = preco_fora;
+        melhor_quantidade = quantidade_fora;
+        existe = 1;
+    }
+    pthread_mutex_unlock(&livro->mutex);
+
+    if (existe) {
+        if (preco) *preco = melhor_preco;
+        if (quantidade) *quantidade = melhor_quantidade;
+    }
+    return existe;
+}
+
+// Função para imprimir os melhores níveis da faixa contígua e o resumo da reserva
+void livro_ticks_imprimir(LivroTicks* livro, const char* nome_acao, int max_niveis) {
+    pthread_mutex_lock(&livro->mutex);
+    LivroOrdens* fora = &livro->fora_da_faixa;
+    printf("--- Livro %s: %d ordens em repouso, %ld negócios, %ld ações negociadas ---\n",
+           nome_acao, livro->ordens_em_repouso + fora->ordens_em_repouso,
+           livro->negocios_realizados + fora->negocios_realizados,
+           livro->quantidade_negociada + fora->quantidade_negociada);
+
+    int compra = maior_nivel(livro->bitmap_compras, livro->resumo_compras);
+    int venda = menor_nivel(livro->bitmap_vendas, livro->resumo_vendas);
+    for (int i = 0; i < max_niveis && (compra >= 0 || venda >= 0); i++) {
+        if (compra >= 0) {
+            NivelTicks* nivel = &livro->niveis[compra];
+            printf("   %6d @ %8.2f (%2d) |", nivel->quantidade_total, PRECO_EM_REAIS(preco_do_nivel(livro, compra)), nivel->num_ordens);
+            do {
+                compra--;
+            } while (compra >= 0 && !(livro->bitmap_compras[compra >> 6] & (1ULL << (compra & 63))));
+        } else {
+            printf("   %6s   %8s  %3s  |", "", "", "");
+        }
+        if (venda >= 0) {
+            NivelTicks* nivel = &livro->niveis[venda];
+            printf(" %8.2f x %-6d (%2d)\n", PRECO_EM_REAIS(preco_do_nivel(livro, venda)), nivel->quantidade_total, nivel->num_ordens);
+            do {
+                venda++;
+            } while (venda < NIVEIS_LIVRO_TICKS && !(livro->bitmap_vendas[venda >> 6] & (1ULL << (venda & 63))));
+            if (venda >= NIVEIS_LIVRO_TICKS) venda = -1;
+        } else {
+            printf("\n");
+        }
+    }
+    if (livro->autonegociacoes_evitadas > 0) {
+        printf("   (%ld ordens rejeitadas por autonegociação)\n", livro->autonegociacoes_evitadas);
+    }
+    if (fora->ordens_em_repouso > 0) {
+        printf("   (%d ordens fora da faixa R$ %.2f - R$ %.2f)\n", fora->ordens_em_repouso,
+               PRECO_EM_REAIS(preco_do_nivel(livro, 0)),
+               PRECO_EM_REAIS(preco_do_nivel(livro, NIVEIS_LIVRO_TICKS - 1)));
+    }
+    pthread_mutex_unlock(&livro->mutex);
+}
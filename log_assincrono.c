@@ -0,0 +1,348 @@
+#define _POSIX_C_SOURCE 200809L
+#include "trading_system.h"
+
+// Logger assíncrono com anéis SPSC por thread.
+// Cada thread produtora ganha, no primeiro registro, um anel próprio: escrever
+// é copiar 128 bytes e publicar o índice fim, sem lock, sem printf e sem
+// ctime() no caminho quente. Uma thread de fundo percorre os anéis, formata
+// os registros e escreve no destino. Com o anel cheio o registro é descartado
+// e contado (o produtor nunca espera pelo logger).
+//
+// Com o logger parado os registros são formatados e escritos na hora, com o
+// mesmo texto; assim programas de teste e demos não precisam iniciá-lo. Não
+// há ordem global entre anéis de threads diferentes: cada linha traz o
+// instante em que foi registrada.
+
+#define MASCARA_ANEL_LOG (CAPACIDADE_ANEL_LOG - 1)
+#define INTERVALO_LOGGER_NS 1000000L // Pausa da thread de fundo sem registros (1 ms)
+
+static AnelLog* aneis[MAX_ANEIS_LOG];
+static int num_aneis = 0;
+static __thread AnelLog* anel_thread = NULL;
+
+static int logger_ativo = 0;
+static pthread_t thread_logger;
+static FILE* destino_log = NULL;      // NULL com destino_definido: descartar tudo
+static int destino_definido = 0;
+static unsigned long descartados = 0;
+static int atfork_registrado = 0;
+
+static FILE* obter_destino() {
+    return destino_definido ? destino_log : stdout;
+}
+
+// Processo filho não herda a thread de fundo: volta ao modo síncrono
+static void desativar_no_filho() {
+    logger_ativo = 0;
+}
+
+// Função para obter (ou criar) o anel da thread atual
+static AnelLog* obter_anel() {
+    if (anel_thread) {
+        return anel_thread;
+    }
+
+    int indice = __atomic_load_n(&num_aneis, __ATOMIC_RELAXED);
+    do {
+        if (indice >= MAX_ANEIS_LOG) {
+            return NULL;
+        }
+    } while (!__atomic_compare_exchange_n(&num_aneis, &indice, indice + 1, 1,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    AnelLog* anel = NULL;
+    if (posix_memalign((void**)&anel, TAMANHO_CACHE_LINE, sizeof(AnelLog)) != 0) {
+        anel = NULL;
+    } else {
+        anel->inicio = 0;
+        anel->fim = 0;
+    }
+    // Publicado mesmo se NULL: a thread de fundo ignora a posição
+    __atomic_store_n(&aneis[indice], anel, __ATOMIC_RELEASE);
+    anel_thread = anel;
+    return anel;
+}
+
+// Função para formatar um registro no texto que seria impresso na hora
+void formatar_registro_log(const RegistroLog* registro, char* buffer, size_t tamanho) {
+    switch (registro->tipo) {
+        case REGISTRO_LOG_EVENTO: {
+            // Mesmo formato de ctime(), sem a quebra de linha
+            char instante[32];
+            struct tm partes;
+            time_t segundos = (time_t)(registro->timestamp_ns / 1000000000LL);
+            localtime_r(&segundos, &partes);
+            strftime(instante, sizeof(instante), "%a %b %e %H:%M:%S %Y", &partes);
+            snprintf(buffer, tamanho, "[%s] %s\n", instante, registro->texto);
+            break;
+        }
+        case REGISTRO_LOG_ORDEM_FILA:
+            snprintf(buffer, tamanho, "✓ Ordem adicionada na fila %d (Trader %d, Ação %d, Tipo: %c, Preço: %.2f, Qtd: %d)\n",
+                     registro->extra, registro->trader_id, registro->acao_id, registro->lado,
+                     PRECO_EM_REAIS(registro->preco), registro->quantidade);
+            break;
+        case REGISTRO_LOG_EXECUTADA:
+            snprintf(buffer, tamanho, "EXECUTADA: Trader %d %s %d ações de %s a R$ %.2f\n",
+                     registro->trader_id, registro->lado == 'C' ? "comprou" : "vendeu",
+                     registro->quantidade, registro->texto, PRECO_EM_REAIS(registro->preco));
+            break;
+        case REGISTRO_LOG_SEM_SALDO:
+            snprintf(buffer, tamanho, "CANCELADA: Trader %d não tem saldo suficiente para comprar %d ações de %s\n",
+                     registro->trader_id, registro->quantidade, registro->texto);
+            break;
+        case REGISTRO_LOG_SEM_ACOES:
+            snprintf(buffer, tamanho, "CANCELADA: Trader %d não possui ações suficientes para vender %d ações de %s\n",
+                     registro->trader_id, registro->quantidade, registro->texto);
+            break;
+        case REGISTRO_LOG_CANCELADA:
+            snprintf(buffer, tamanho, "CANCELADA: Ordem %d do trader %d foi cancelada\n",
+                     registro->ordem_id, registro->trader_id);
+            break;
+        case REGISTRO_LOG_NEGOCIO:
+            snprintf(buffer, tamanho, "NEGÓCIO: %s %d ações a R$ %.2f (comprador Trader %d, vendedor Trader %d)\n",
+                     registro->texto, registro->quantidade, PRECO_EM_REAIS(registro->preco),
+                     registro->trader_id, registro->extra);
+            break;
+        default:
+            snprintf(buffer, tamanho, "LOG: registro de tipo desconhecido %d\n", registro->tipo);
+            break;
+    }
+}
+
+static void escrever_registro(const RegistroLog* registro) {
+    FILE* destino = obter_destino();
+    if (!destino) {
+        return;
+    }
+    char linha[256];
+    formatar_registro_log(registro, linha, sizeof(linha));
+    fputs(linha, destino);
+}
+
+// Função para esvaziar todos os anéis (apenas a thread de fundo ou após o join)
+// Retorna o número de registros escritos
+static int drenar_aneis() {
+    int escritos = 0;
+    int total = __atomic_load_n(&num_aneis, __ATOMIC_ACQUIRE);
+
+    for (int i = 0; i < total; i++) {
+        AnelLog* anel = __atomic_load_n(&aneis[i], __ATOMIC_ACQUIRE);
+        if (!anel) {
+            continue; // Posição reservada e ainda não publicada (ou sem memória)
+        }
+        unsigned long inicio = anel->inicio;
+        unsigned long fim = __atomic_load_n(&anel->fim, __ATOMIC_ACQUIRE);
+        while (inicio != fim) {
+            escrever_registro(&anel->registros[inicio & MASCARA_ANEL_LOG]);
+            inicio++;
+            escritos++;
+        }
+        __atomic_store_n(&anel->inicio, inicio, __ATOMIC_RELEASE);
+    }
+    return escritos;
+}
+
+// Thread de fundo: formata e escreve, dorme quando não há registros
+static void* thread_logger_func(void* arg) {
+    (void)arg;
+    struct timespec pausa = {0, INTERVALO_LOGGER_NS};
+
+    while (__atomic_load_n(&logger_ativo, __ATOMIC_ACQUIRE)) {
+        if (drenar_aneis() == 0) {
+            FILE* destino = obter_destino();
+            if (destino) fflush(destino);
+            nanosleep(&pausa, NULL);
+        }
+    }
+    return NULL;
+}
+
+// Função para definir o destino do log (stdout por padrão; NULL descarta)
+// Chamar com o logger parado
+void log_definir_destino(FILE* destino) {
+    destino_log = destino;
+    destino_definido = 1;
+}
+
+// Função para iniciar o logger assíncrono
+// destino: arquivo de saída (NULL mantém o destino atual)
+// Retorna 1 em sucesso, 0 em falha
+int log_assincrono_iniciar(FILE* destino) {
+    if (logger_ativo) {
+        return 1;
+    }
+    if (destino) {
+        log_definir_destino(destino);
+    }
+    if (!atfork_registrado) {
+        pthread_atfork(NULL, NULL, desativar_no_filho);
+        atfork_registrado = 1;
+    }
+
+    __atomic_store_n(&logger_ativo, 1, __ATOMIC_RELEASE);
+    if (pthread_create(&thread_logger, NULL, thread_logger_func, NULL) != 0) {
+        __atomic_store_n(&logger_ativo, 0, __ATOMIC_RELEASE);
+        printf("ERRO: Falha ao criar thread do logger assíncrono\n");
+        return 0;
+    }
+    return 1;
+}
+
+// Função para parar o logger: escreve os registros pendentes e volta ao modo síncrono
+void log_assincrono_parar() {
+    if (!logger_ativo) {
+        return;
+    }
+    __atomic_store_n(&logger_ativo, 0, __ATOMIC_RELEASE);
+    pthread_join(thread_logger, NULL);
+    drenar_aneis();
+
+    FILE* destino = obter_destino();
+    if (destino) fflush(destino);
+
+    unsigned long perdidos = log_registros_descartados();
+    if (perdidos > 0) {
+        printf("AVISO: Logger assíncrono descartou %lu registros (anel cheio)\n", perdidos);
+    }
+}
+
+// Função para verificar se o logger assíncrono está ativo
+int log_assincrono_ativo() {
+    return __atomic_load_n(&logger_ativo, __ATOMIC_ACQUIRE);
+}
+
+// Função para aguardar a thread de fundo esvaziar os anéis
+void log_assincrono_aguardar() {
+    struct timespec pausa = {0, INTERVALO_LOGGER_NS};
+    for (;;) {
+        int pendentes = 0;
+        int total = __atomic_load_n(&num_aneis, __ATOMIC_ACQUIRE);
+        for (int i = 0; i < total && !pendentes; i++) {
+            AnelLog* anel = __atomic_load_n(&aneis[i], __ATOMIC_ACQUIRE);
+            pendentes = anel && __atomic_load_n(&anel->inicio, __ATOMIC_ACQUIRE) !=
+                                __atomic_load_n(&anel->fim, __ATOMIC_ACQUIRE);
+        }
+        if (!pendentes || !log_assincrono_ativo()) {
+            return;
+        }
+        nanosleep(&pausa, NULL);
+    }
+}
+
+// Função para obter o número de registros descartados por anel cheio
+unsigned long log_registros_descartados() {
+    return __atomic_load_n(&descartados, __ATOMIC_RELAXED);
+}
+
+// Função para registrar (preenche o instante e enfileira ou escreve na hora)
+void log_registrar(RegistroLog* registro) {
+    struct timespec agora;
+    clock_gettime(CLOCK_REALTIME, &agora);
+    registro->timestamp_ns = (long long)agora.tv_sec * 1000000000LL + agora.tv_nsec;
+
+    AnelLog* anel = log_assincrono_ativo() ? obter_anel() : NULL;
+    if (!anel) {
+        escrever_registro(registro); // fputs já serializa o FILE entre threads
+        return;
+    }
+
+    unsigned long fim = anel->fim;
+    if (fim - __atomic_load_n(&anel->inicio, __ATOMIC_ACQUIRE) >= CAPACIDADE_ANEL_LOG) {
+        __atomic_add_fetch(&descartados, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    anel->registros[fim & MASCARA_ANEL_LOG] = *registro;
+    __atomic_store_n(&anel->fim, fim + 1, __ATOMIC_RELEASE);
+}
+
+// Função para registrar uma mensagem livre (usada por log_evento)
+void log_registrar_evento(const char* mensagem) {
+    RegistroLog registro;
+    registro.tipo = REGISTRO_LOG_EVENTO;
+    strncpy(registro.texto, mensagem, TAMANHO_TEXTO_LOG - 1);
+    registro.texto[TAMANHO_TEXTO_LOG - 1] = '\0';
+    log_registrar(&registro);
+}
+
+// Função para registrar um evento de ordem (tipo REGISTRO_LOG_*)
+// texto: nome da ação quando o formato usa (pode ser NULL)
+void log_registrar_ordem(int tipo, const Ordem* ordem, int extra, const char* texto) {
+    RegistroLog registro;
+    registro.tipo = tipo;
+    registro.preco = ordem->preco;
+    registro.ordem_id = ordem->id;
+    registro.trader_id = ordem->trader_id;
+    registro.acao_id = ordem->acao_id;
+    registro.quantidade = ordem->quantidade;
+    registro.extra = extra;
+    registro.lado = ordem->tipo;
+    if (texto) {
+        strncpy(registro.texto, texto, TAMANHO_TEXTO_LOG - 1);
+        registro.texto[TAMANHO_TEXTO_LOG - 1] = '\0';
+    } else {
+        registro.texto[0] = '\0';
+    }
+    log_registrar(&registro);
+}
+
+// Função para registrar um negócio do livro de ofertas (formatado pela thread de fundo)
+void log_registrar_negocio(const Negocio* negocio, const char* nome_acao) {
+    RegistroLog registro;
+    registro.tipo = REGISTRO_LOG_NEGOCIO;
+    registro.preco = negocio->preco;
+    registro.ordem_id = negocio->ordem_compra_id;
+    registro.trader_id = negocio->comprador_id;
+    registro.acao_id = negocio->acao_id;
+    registro.quantidade = negocio->quantidade;
+    registro.extra = negocio->vendedor_id;
+    registro.lado = 'C';
+    strncpy(registro.texto, nome_acao, TAMANHO_TEXTO_LOG - 1);
+    registro.texto[TAMANHO_TEXTO_LOG - 1] = '\0';
+    log_registrar(&registro);
+}
+
+// Nível de log em tempo de execução (LOG_ERRO ... LOG_DEBUG)
+int nivel_log_atual = NIVEL_LOG_INFO;
+
+// Função para configurar o nível de log (limitado ao nível compilado)
+void configurar_nivel_log(int nivel) {
+    if (nivel < NIVEL_LOG_ERRO) nivel = NIVEL_LOG_ERRO;
+    if (nivel > NIVEL_LOG_COMPILADO) nivel = NIVEL_LOG_COMPILADO;
+    nivel_log_atual = nivel;
+}
+
+// Função para converter nome em nível (erro, aviso, info, debug)
+// Retorna -1 se o nome é inválido
+int nivel_log_por_nome(const char* nome) {
+    if (strcmp(nome, "erro") == 0) return NIVEL_LOG_ERRO;
+    if (strcmp(nome, "aviso") == 0) return NIVEL_LOG_AVISO;
+    if (strcmp(nome, "info") == 0) return NIVEL_LOG_INFO;
+    if (strcmp(nome, "debug") == 0) return NIVEL_LOG_DEBUG;
+    return -1;
+}
+
+// Função para obter o nome de um nível de log
+const char* nome_nivel_log(int nivel) {
+    switch (nivel) {
+        case NIVEL_LOG_ERRO: return "erro";
+        case NIVEL_LOG_AVISO: return "aviso";
+        case NIVEL_LOG_INFO: return "info";
+        case NIVEL_LOG_DEBUG: return "debug";
+        default: return "desconhecido";
+    }
+}
+
+// Função para configurar o nível de log pela variável TRADING_LOG_NIVEL
+void configurar_nivel_log_do_ambiente() {
+    const char* env_nivel = getenv("TRADING_LOG_NIVEL");
+    if (env_nivel) {
+        int nivel = nivel_log_por_nome(env_nivel);
+        if (nivel < 0) {
+            printf("AVISO: Nível de log '%s' inválido (use erro, aviso, info ou debug)\n", env_nivel);
+        } else {
+            configurar_nivel_log(nivel);
+        }
+    }
+    printf("Nível de log: %s (compilado até %s)\n", nome_nivel_log(nivel_log_atual),
+           nome_nivel_log(NIVEL_LOG_COMPILADO));
+}
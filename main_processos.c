@@ -40,18 +40,15 @@ static TradingSystem* sistema_compartilhado = NULL;
 
 // Funções de utilidade
 double gerar_preco_aleatorio(double min, double max) {
-    return min + (rand() / (double)RAND_MAX) * (max - min);
+    return min + (aleatorio_proximo() / (double)ALEATORIO_MAX) * (max - min);
 }
 
 int gerar_id_aleatorio() {
-    return rand() % 10000;
+    return aleatorio_proximo() % 10000;
 }
 
 void log_evento(const char* mensagem) {
-    time_t agora = time(NULL);
-    char* timestamp = ctime(&agora);
-    timestamp[strlen(timestamp) - 1] = '\0'; // Remover \n
-    printf("[%s] %s\n", timestamp, mensagem);
+    log_registrar_evento(mensagem);
 }
 
 void limpar_tela() {
@@ -78,8 +75,8 @@ TradingSystem* criar_memoria_compartilhada() {
     memset(sistema_compartilhado, 0, sizeof(TradingSystem));
     sistema_compartilhado->num_acoes = 0;
     sistema_compartilhado->num_traders = 0;
-    sistema_compartilhado->num_ordens = 0;
     sistema_compartilhado->sistema_ativo = 1;
+    pool_ordens_inicializar(&sistema_compartilhado->ordens, 1); // Blocos em segmentos compartilhados
     
     // Inicializar mutex e semáforo
     pthread_mutex_init(&sistema_compartilhado->mutex_geral, NULL);
@@ -109,6 +106,7 @@ void limpar_memoria_compartilhada() {
         pthread_mutex_destroy(&sistema_compartilhado->executor.mutex);
         pthread_mutex_destroy(&sistema_compartilhado->mutex_geral);
         sem_destroy(&sistema_compartilhado->sem_ordens);
+        pool_ordens_liberar(&sistema_compartilhado->ordens);
         
         // Desanexar memória compartilhada
         shmdt(sistema_compartilhado);
@@ -149,13 +147,14 @@ void processo_arbitrage_monitor_func() {
         perror("Erro ao anexar memória compartilhada no processo arbitrage monitor");
         exit(1);
     }
+    registrar_pares_relacionados_monitor();
     
     while (sistema->sistema_ativo) {
         monitorar_arbitragem(sistema);
         detectar_padroes_preco(sistema);
         
         // Simular eventos de mercado ocasionalmente
-        if (rand() % 100 < 5) { // 5% de chance
+        if (aleatorio_proximo() % 100 < 5) { // 5% de chance
             simular_evento_mercado(sistema);
         }
         
@@ -176,9 +175,6 @@ void iniciar_processos() {
     // Inicializar métricas de performance
     inicializar_metricas_performance();
     
-    // Inicializar seed do rand
-    srand(time(NULL));
-    
     // Iniciar medição de tempo de criação
     iniciar_medicao_criacao(1); // 1 = processos
     
@@ -215,6 +211,7 @@ void iniciar_processos() {
         close(descritores[8]); // Control RD
         close(descritores[9]); // Control WR
         
+        aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_PRICE_UPDATER); // Fluxo próprio: o filho herdaria o do pai
         processo_price_updater_func();
         exit(0);
     } else if (pid_price > 0) {
@@ -240,6 +237,7 @@ void iniciar_processos() {
         close(descritores[8]); // Control RD
         close(descritores[9]); // Control WR
         
+        aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_EXECUTOR); // Fluxo próprio: o filho herdaria o do pai
         processo_executor_func();
         exit(0);
     } else if (pid_executor > 0) {
@@ -265,6 +263,7 @@ void iniciar_processos() {
         close(descritores[8]); // Control RD
         close(descritores[9]); // Control WR
         
+        aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_ARBITRAGEM); // Fluxo próprio: o filho herdaria o do pai
         processo_arbitrage_monitor_func();
         exit(0);
     } else if (pid_arbitrage > 0) {
@@ -293,6 +292,7 @@ void iniciar_processos() {
             close(descritores[8]); // Control RD
             close(descritores[9]); // Control WR
             
+            aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_TRADER + i); // Fluxo próprio: o filho herdaria o do pai
             processo_trader(i);
             exit(0);
         } else if (pid_trader > 0) {
@@ -407,11 +407,19 @@ int main() {
     // Configurar handler para SIGINT
     signal(SIGINT, signal_handler);
     
+    // Nível das mensagens dos módulos (TRADING_LOG_NIVEL)
+    configurar_nivel_log_do_ambiente();
+    
     // Inicializar métricas de performance
     inicializar_metricas_performance();
     
-    // Inicializar seed do rand
-    srand(time(NULL));
+    // Semente mestre do gerador aleatório (TRADING_SEED repete os sorteios)
+    unsigned long long semente = aleatorio_configurar_semente_do_ambiente();
+    printf("Semente aleatória: %llu\n", semente);
+    
+    // Histórico binário de ticks (TRADING_HISTORICO_TICKS escolhe o arquivo)
+    const char* arquivo_ticks = historico_ticks_iniciar_do_ambiente();
+    printf("Histórico de ticks: %s\n", arquivo_ticks ? arquivo_ticks : "desativado");
     
     // Inicializar perfis de trader
     inicializar_perfis_trader();
@@ -442,6 +450,7 @@ int main() {
     
     // Aguardar processos terminarem
     parar_processos();
+    historico_ticks_finalizar();
     
     // Exibir estatísticas finais
     printf("\n=== ESTATÍSTICAS FINAIS ===\n");
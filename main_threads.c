@@ -1,3 +1,4 @@
+#define _POSIX_C_SOURCE 200809L
 #include "trading_system.h"
 #include <math.h>
 
@@ -34,18 +35,15 @@ static ThreadArbitrageMonitor thread_arbitrage_monitor;
 
 // Funções de utilidade
 double gerar_preco_aleatorio(double min, double max) {
-    return min + (rand() / (double)RAND_MAX) * (max - min);
+    return min + (aleatorio_proximo() / (double)ALEATORIO_MAX) * (max - min);
 }
 
 int gerar_id_aleatorio() {
-    return rand() % 10000;
+    return aleatorio_proximo() % 10000;
 }
 
 void log_evento(const char* mensagem) {
-    time_t agora = time(NULL);
-    char* timestamp = ctime(&agora);
-    timestamp[strlen(timestamp) - 1] = '\0'; // Remover \n
-    printf("[%s] %s\n", timestamp, mensagem);
+    log_registrar_evento(mensagem);
 }
 
 void limpar_tela() {
@@ -54,8 +52,9 @@ void limpar_tela() {
 
 // Função principal do sistema
 TradingSystem* inicializar_sistema() {
-    TradingSystem* sistema = (TradingSystem*)malloc(sizeof(TradingSystem));
-    if (!sistema) {
+    // Alinhado a uma linha de cache, como as ações que contém (malloc garante só 16 bytes)
+    TradingSystem* sistema = NULL;
+    if (posix_memalign((void**)&sistema, TAMANHO_CACHE_LINE, sizeof(TradingSystem)) != 0) {
         printf("Erro: Falha ao alocar memória para o sistema\n");
         return NULL;
     }
@@ -63,8 +62,8 @@ TradingSystem* inicializar_sistema() {
     // Inicializar variáveis do sistema
     sistema->num_acoes = 0;
     sistema->num_traders = 0;
-    sistema->num_ordens = 0;
     sistema->sistema_ativo = 1;
+    pool_ordens_inicializar(&sistema->ordens, 0);
     
     // Inicializar mutex e semáforo
     pthread_mutex_init(&sistema->mutex_geral, NULL);
@@ -113,6 +112,8 @@ void limpar_sistema(TradingSystem* sistema) {
     pthread_mutex_destroy(&sistema->executor.mutex);
     pthread_mutex_destroy(&sistema->mutex_geral);
     sem_destroy(&sistema->sem_ordens);
+    pool_ordens_liberar(&sistema->ordens);
+    liberar_correlacao_sistema();
     
     free(sistema);
     printf("✓ Sistema de trading finalizado\n");
@@ -127,15 +128,51 @@ void iniciar_threads(TradingSystem* sistema) {
     // Definir sistema global
     sistema_global = sistema;
     
+    // Configurar número de executores (shards de ações)
+    const char* env_executores = getenv("TRADING_EXECUTORES");
+    if (env_executores) {
+        configurar_num_executores(atoi(env_executores));
+    }
+    const char* env_escalonador = getenv("TRADING_ESCALONADOR");
+    if (env_escalonador && strcmp(env_escalonador, "roubo") == 0) {
+        configurar_modo_escalonador(MODO_ESCALONADOR_ROUBO);
+    }
+    const char* env_notificacao = getenv("TRADING_NOTIFICACAO");
+    if (env_notificacao && strcmp(env_notificacao, "polling") == 0) {
+        configurar_notificacao_polling(1);
+    }
+    configurar_nivel_log_do_ambiente();
+    int estrategia_espera = ESTRATEGIA_ESPERA_SPIN_PARK;
+    const char* env_espera = getenv("TRADING_ESPERA");
+    if (env_espera) {
+        int estrategia = estrategia_espera_por_nome(env_espera);
+        if (estrategia < 0) {
+            printf("AVISO: Estratégia de espera '%s' inválida (use bloqueio, spin ou spin_park)\n", env_espera);
+        } else {
+            estrategia_espera = estrategia;
+        }
+    }
+    configurar_estrategia_espera(estrategia_espera);
+    printf("Estratégia de espera: %s\n", nome_estrategia_espera(obter_estrategia_espera()));
+    
+    // Logger assíncrono: eventos de ordens saem do caminho quente
+    const char* env_log = getenv("TRADING_LOG_ARQUIVO");
+    FILE* arquivo_log = env_log ? fopen(env_log, "w") : NULL;
+    if (env_log && !arquivo_log) {
+        printf("AVISO: Não foi possível abrir '%s', log assíncrono na saída padrão\n", env_log);
+    }
+    if (log_assincrono_iniciar(arquivo_log)) {
+        printf("Logger assíncrono ativo (%s)\n", arquivo_log ? env_log : "saída padrão");
+    }
+    printf("Executores configurados: %d (escalonador %s)\n", obter_num_executores(),
+           obter_modo_escalonador() == MODO_ESCALONADOR_ROUBO ? "com roubo de trabalho" : "estático");
+    
     // Inicializar estruturas globais
     inicializar_estruturas_globais();
     
     // Inicializar métricas de performance
     inicializar_metricas_performance();
     
-    // Inicializar seed do rand
-    srand(time(NULL));
-    
     // Inicializar perfis de trader
     inicializar_perfis_trader();
     
@@ -186,6 +223,7 @@ void exibir_estatisticas_tempo_real(TradingSystem* sistema) {
         printf("\n");
         
         imprimir_estado_acoes(sistema);
+        imprimir_barras_ohlcv(sistema, PERIODO_BARRA_1MIN);
         imprimir_estado_traders(sistema);
         imprimir_estado_executor(sistema);
         imprimir_oportunidades_arbitragem();
@@ -196,12 +234,77 @@ void exibir_estatisticas_tempo_real(TradingSystem* sistema) {
     }
 }
 
+// Função para executar a sessão no relógio virtual (sem threads nem sleeps)
+// TRADING_SIM_DURACAO: segundos virtuais (padrão 300); TRADING_SEED: semente (padrão 42)
+int executar_modo_simulacao() {
+    int duracao = DURACAO_SESSAO_SIMULADA;
+    unsigned long long semente = SEMENTE_SIMULACAO_PADRAO;
+    
+    // Backtest: com TRADING_REPLAY os preços vêm do histórico de ticks, e a
+    // sessão vai até o último tick gravado
+    FonteReplay* replay = replay_iniciar_do_ambiente();
+    if (replay) {
+        duracao = 0;
+        printf("Replay: %s (%lld ticks)\n", getenv("TRADING_REPLAY"), replay->total);
+    }
+    
+    const char* env_duracao = getenv("TRADING_SIM_DURACAO");
+    if (env_duracao && atoi(env_duracao) > 0) {
+        duracao = atoi(env_duracao);
+    }
+    const char* env_semente = getenv("TRADING_SEED");
+    if (env_semente) {
+        semente = strtoull(env_semente, NULL, 10);
+    }
+    
+    // Sem TRADING_LOG_NIVEL, só avisos e erros (o log por negócio domina o tempo)
+    if (getenv("TRADING_LOG_NIVEL")) {
+        configurar_nivel_log_do_ambiente();
+    } else {
+        configurar_nivel_log(NIVEL_LOG_AVISO);
+    }
+    
+    if (duracao > 0) {
+        printf("Simulando %d s de pregão (semente %llu)...\n", duracao, semente);
+    } else {
+        printf("Simulando até o último tick gravado (semente %llu)...\n", semente);
+    }
+    TradingSystem* sistema = inicializar_sistema();
+    if (!sistema) {
+        printf("Erro: Falha ao inicializar sistema\n");
+        replay_finalizar_sistema();
+        return 1;
+    }
+    
+    ResultadoSimulacao resultado;
+    if (!executar_simulacao_replay(sistema, semente, duracao, replay, &resultado)) {
+        printf("Erro: Falha ao executar simulação\n");
+        replay_finalizar_sistema();
+        limpar_sistema(sistema);
+        return 1;
+    }
+    
+    imprimir_resultado_simulacao(&resultado);
+    if (replay) {
+        imprimir_resultado_replay(replay);
+        replay_finalizar_sistema();
+    }
+    imprimir_estado_acoes(sistema);
+    imprimir_barras_ohlcv(sistema, PERIODO_BARRA_5MIN);
+    imprimir_estado_traders(sistema);
+    imprimir_estado_executor(sistema);
+    
+    limpar_sistema(sistema);
+    return 0;
+}
+
 int main() {
     printf("=== SISTEMA DE TRADING - VERSÃO THREADS ===\n");
     printf("Escolha uma opção:\n");
     printf("1. Executar sistema normal\n");
     printf("2. Executar demo de race conditions\n");
-    printf("Digite sua escolha (1 ou 2): ");
+    printf("3. Executar simulação com relógio virtual\n");
+    printf("Digite sua escolha (1, 2 ou 3): ");
     
     int escolha;
     scanf("%d", &escolha);
@@ -212,11 +315,28 @@ int main() {
         return 0;
     }
     
+    if (escolha == 3) {
+        // Executar sessão simulada
+        return executar_modo_simulacao();
+    }
+    
     // Executar sistema normal
     printf("Iniciando sistema normal...\n\n");
     
-    // Inicializar seed do rand
-    srand(time(NULL));
+    // Semente mestre do gerador aleatório (TRADING_SEED repete os sorteios)
+    unsigned long long semente = aleatorio_configurar_semente_do_ambiente();
+    printf("Semente aleatória: %llu\n", semente);
+    
+    // Replay de ticks gravados no lugar da variação aleatória (TRADING_REPLAY)
+    FonteReplay* replay = replay_iniciar_do_ambiente();
+    if (replay) {
+        printf("Replay: %s (%lld ticks)\n", getenv("TRADING_REPLAY"), replay->total);
+    }
+    
+    // Histórico binário de ticks (TRADING_HISTORICO_TICKS escolhe o arquivo);
+    // desligado durante o replay, que pode estar lendo o mesmo arquivo
+    const char* arquivo_ticks = replay ? NULL : historico_ticks_iniciar_do_ambiente();
+    printf("Histórico de ticks: %s\n", arquivo_ticks ? arquivo_ticks : "desativado");
     
     // Inicializar sistema
     TradingSystem* sistema = inicializar_sistema();
@@ -262,9 +382,18 @@ int main() {
         pthread_join(thread_arbitrage_monitor.thread, NULL);
     }
     
+    // Escrever registros pendentes do logger antes das estatísticas
+    log_assincrono_parar();
+    historico_ticks_finalizar();
+    if (replay) {
+        imprimir_resultado_replay(replay);
+        replay_finalizar_sistema();
+    }
+    
     // Exibir estatísticas finais
     printf("\n=== ESTATÍSTICAS FINAIS ===\n");
     imprimir_estado_acoes(sistema);
+    imprimir_barras_ohlcv(sistema, PERIODO_BARRA_5MIN);
     imprimir_estado_traders(sistema);
     imprimir_estado_executor(sistema);
     imprimir_ordens(sistema);
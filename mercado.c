@@ -1,6 +1,7 @@
 #include "trading_system.h"
 #include <math.h>
 #include <unistd.h>
+#include <sched.h>
 
 // Estrutura para dados do mercado
 typedef struct {
@@ -14,6 +15,9 @@ typedef struct {
 
 static DadosMercado dados_mercado_global;
 
+// Relógio virtual da simulação de eventos discretos (-1: relógio real)
+static long long relogio_virtual_ns = -1;
+
 // Preços iniciais realistas das ações brasileiras (baseados em dados reais)
 static const double PRECOS_INICIAIS[] = {
     25.50,  // PETR4 - Petrobras
@@ -49,6 +53,80 @@ static const double VOLATILIDADES[] = {
     0.018, 0.032, 0.040, 0.050, 0.038, 0.042, 0.045
 };
 
+// Função para ativar (instante >= 0) ou desativar (-1) o relógio virtual
+void definir_relogio_virtual(long long instante_ns) {
+    __atomic_store_n(&relogio_virtual_ns, instante_ns, __ATOMIC_RELAXED);
+}
+
+// Função para verificar se o relógio virtual está ativo
+int relogio_virtual_ativo() {
+    return __atomic_load_n(&relogio_virtual_ns, __ATOMIC_RELAXED) >= 0;
+}
+
+// Função para obter o horário do mercado: o relógio virtual da simulação,
+// contado a partir da abertura do pregão simulado, ou o relógio real
+time_t relogio_mercado() {
+    long long instante_ns = __atomic_load_n(&relogio_virtual_ns, __ATOMIC_RELAXED);
+    if (instante_ns >= 0) {
+        return (time_t)(INICIO_PREGAO_SIMULADO + instante_ns / 1000000000LL);
+    }
+    return time(NULL);
+}
+
+// Função para obter o horário do mercado em nanossegundos (mesmo relógio)
+long long relogio_mercado_ns() {
+    long long instante_ns = __atomic_load_n(&relogio_virtual_ns, __ATOMIC_RELAXED);
+    if (instante_ns >= 0) {
+        return INICIO_PREGAO_SIMULADO * 1000000000LL + instante_ns;
+    }
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Tentativas de leitura do seqlock antes de ceder a CPU ao escritor
+#define TENTATIVAS_LEITURA_PRECO 64
+
+// Função para publicar o preço de uma ação (escritor do seqlock)
+// O chamador serializa os escritores com o mutex da ação; os leitores de
+// ler_preco_acao não esperam por ele. Vale entre processos: a ação (com a
+// sequência) fica na memória compartilhada.
+void publicar_preco_acao(Acao* acao, preco_t preco_atual, preco_t preco_anterior, double variacao) {
+    unsigned int sequencia = __atomic_load_n(&acao->sequencia_preco, __ATOMIC_RELAXED);
+    __atomic_store_n(&acao->sequencia_preco, sequencia + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&acao->preco_atual, preco_atual, __ATOMIC_RELAXED);
+    __atomic_store_n(&acao->preco_anterior, preco_anterior, __ATOMIC_RELAXED);
+    __atomic_store(&acao->variacao, &variacao, __ATOMIC_RELAXED);
+    __atomic_store_n(&acao->sequencia_preco, sequencia + 2, __ATOMIC_RELEASE);
+}
+
+// Função para ler preço atual, anterior e variação de forma consistente
+// Repete a leitura se um escritor publicou no meio dela (sequência mudou)
+void ler_preco_acao(const Acao* acao, InstantaneoPreco* instantaneo) {
+    for (int tentativa = 1; ; tentativa++) {
+        unsigned int antes = __atomic_load_n(&acao->sequencia_preco, __ATOMIC_ACQUIRE);
+        if ((antes & 1) == 0) {
+            instantaneo->preco_atual = __atomic_load_n(&acao->preco_atual, __ATOMIC_RELAXED);
+            instantaneo->preco_anterior = __atomic_load_n(&acao->preco_anterior, __ATOMIC_RELAXED);
+            __atomic_load(&acao->variacao, &instantaneo->variacao, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&acao->sequencia_preco, __ATOMIC_RELAXED) == antes) {
+                return;
+            }
+        }
+        // Escritor interrompido no meio da publicação: ceder a CPU a ele
+        if (tentativa % TENTATIVAS_LEITURA_PRECO == 0) {
+            sched_yield();
+        }
+    }
+}
+
+// Função para ler só o preço atual (um campo: basta a leitura atômica)
+preco_t ler_preco_atual(const Acao* acao) {
+    return __atomic_load_n(&acao->preco_atual, __ATOMIC_RELAXED);
+}
+
 // Função para inicializar dados do mercado
 void inicializar_dados_mercado() {
     // Configurar horário de abertura (9:00) e fechamento (17:00)
@@ -101,15 +179,19 @@ void inicializar_acoes_mercado(TradingSystem* sistema) {
         acao->setor[MAX_NOME - 1] = '\0';
         
         // Configurar preços
-        acao->preco_atual = PRECOS_INICIAIS[i];
-        acao->preco_anterior = PRECOS_INICIAIS[i];
-        acao->preco_maximo = PRECOS_INICIAIS[i];
-        acao->preco_minimo = PRECOS_INICIAIS[i];
+        acao->preco_atual = PRECO_DE_REAIS(PRECOS_INICIAIS[i]);
+        acao->preco_anterior = acao->preco_atual;
+        acao->preco_maximo = acao->preco_atual;
+        acao->preco_minimo = acao->preco_atual;
+        acao->tamanho_tick = TAMANHO_TICK_PADRAO;
+        acao->sequencia_preco = 0;
         
         // Configurar volatilidade
         acao->volatilidade = VOLATILIDADES[i];
         
         // Inicializar estatísticas
+        acao->variacao = 0.0;
+        acao->volume_negociado = 0;
         acao->volume_diario = 0;
         acao->volume_total = 0;
         acao->num_operacoes = 0;
@@ -117,16 +199,14 @@ void inicializar_acoes_mercado(TradingSystem* sistema) {
         acao->variacao_semanal = 0.0;
         acao->variacao_mensal = 0.0;
         
-        // Inicializar histórico de preços
-        for (int j = 0; j < 30; j++) {
-            acao->historico_precos[j] = PRECOS_INICIAIS[i];
-        }
-        acao->indice_historico = 0;
+        // Inicializar histórico de preços com o preço de abertura
+        estatisticas_janela_inicializar(&acao->estatisticas, PERIODO_MEDIA_EXPONENCIAL);
+        estatisticas_janela_adicionar(&acao->estatisticas, PRECOS_INICIAIS[i]);
         
         // Inicializar mutex
         pthread_mutex_init(&acao->mutex, NULL);
         
-        printf("✓ %s (%s) - R$ %.2f\n", acao->nome, acao->setor, acao->preco_atual);
+        printf("✓ %s (%s) - R$ %.2f\n", acao->nome, acao->setor, PRECO_EM_REAIS(acao->preco_atual));
     }
     
     printf("=== %d AÇÕES INICIALIZADAS ===\n\n", sistema->num_acoes);
@@ -191,7 +271,7 @@ void imprimir_estado_mercado(TradingSystem* sistema) {
     
     for (int i = 0; i < sistema->num_acoes; i++) {
         Acao* acao = &sistema->acoes[i];
-        double variacao = ((acao->preco_atual - acao->preco_anterior) / acao->preco_anterior) * 100;
+        double variacao = ((double)(acao->preco_atual - acao->preco_anterior) / acao->preco_anterior) * 100;
         char variacao_str[10];
         
         if (variacao > 0) {
@@ -203,8 +283,8 @@ void imprimir_estado_mercado(TradingSystem* sistema) {
         }
         
         printf("%-8s %-12s R$ %-6.2f %-8s %-8d R$ %-6.2f R$ %-6.2f\n",
-               acao->nome, acao->setor, acao->preco_atual, variacao_str,
-               acao->volume_diario, acao->preco_maximo, acao->preco_minimo);
+               acao->nome, acao->setor, PRECO_EM_REAIS(acao->preco_atual), variacao_str,
+               acao->volume_diario, PRECO_EM_REAIS(acao->preco_maximo), PRECO_EM_REAIS(acao->preco_minimo));
     }
     
     // Top 5 ações por volume
@@ -228,16 +308,16 @@ void imprimir_estado_mercado(TradingSystem* sistema) {
     for (int i = 0; i < 5 && i < sistema->num_acoes; i++) {
         Acao* acao = &sistema->acoes[indices[i]];
         printf("  %d. %s - %d ações - R$ %.2f\n", 
-               i + 1, acao->nome, acao->volume_diario, acao->preco_atual);
+               i + 1, acao->nome, acao->volume_diario, PRECO_EM_REAIS(acao->preco_atual));
     }
     
     // Top 5 ações por variação
     printf("\n📊 TOP 5 POR VARIAÇÃO:\n");
     for (int i = 0; i < sistema->num_acoes - 1; i++) {
         for (int j = 0; j < sistema->num_acoes - i - 1; j++) {
-            double var1 = ((sistema->acoes[indices[j]].preco_atual - sistema->acoes[indices[j]].preco_anterior) / 
+            double var1 = ((double)(sistema->acoes[indices[j]].preco_atual - sistema->acoes[indices[j]].preco_anterior) / 
                           sistema->acoes[indices[j]].preco_anterior) * 100;
-            double var2 = ((sistema->acoes[indices[j + 1]].preco_atual - sistema->acoes[indices[j + 1]].preco_anterior) / 
+            double var2 = ((double)(sistema->acoes[indices[j + 1]].preco_atual - sistema->acoes[indices[j + 1]].preco_anterior) / 
                           sistema->acoes[indices[j + 1]].preco_anterior) * 100;
             
             if (var1 < var2) {
@@ -250,9 +330,9 @@ void imprimir_estado_mercado(TradingSystem* sistema) {
     
     for (int i = 0; i < 5 && i < sistema->num_acoes; i++) {
         Acao* acao = &sistema->acoes[indices[i]];
-        double variacao = ((acao->preco_atual - acao->preco_anterior) / acao->preco_anterior) * 100;
+        double variacao = ((double)(acao->preco_atual - acao->preco_anterior) / acao->preco_anterior) * 100;
         printf("  %d. %s - %+.2f%% - R$ %.2f\n", 
-               i + 1, acao->nome, variacao, acao->preco_atual);
+               i + 1, acao->nome, variacao, PRECO_EM_REAIS(acao->preco_atual));
     }
     
     // Estatísticas por setor
@@ -284,7 +364,7 @@ void imprimir_estado_mercado(TradingSystem* sistema) {
         for (int i = 0; i < sistema->num_acoes; i++) {
             if (strcmp(sistema->acoes[i].setor, setores_unicos[s]) == 0) {
                 num_acoes_setor++;
-                preco_medio += sistema->acoes[i].preco_atual;
+                preco_medio += PRECO_EM_REAIS(sistema->acoes[i].preco_atual);
                 volume_total += sistema->acoes[i].volume_diario;
             }
         }
@@ -304,7 +384,7 @@ void atualizar_estatisticas_mercado(TradingSystem* sistema, Ordem* ordem) {
     if (!sistema || !ordem) return;
     
     dados_mercado_global.volume_total += ordem->quantidade;
-    dados_mercado_global.valor_total_negociado += ordem->preco * ordem->quantidade;
+    dados_mercado_global.valor_total_negociado += PRECO_EM_REAIS(ordem->preco) * ordem->quantidade;
     dados_mercado_global.num_operacoes++;
     
     // Atualizar estatísticas da ação
@@ -357,9 +437,14 @@ void simular_abertura_mercado(TradingSystem* sistema) {
         Acao* acao = &sistema->acoes[i];
         
         // Variação aleatória de ±2%
-        double variacao = (rand() % 400 - 200) / 10000.0;
-        acao->preco_atual = PRECOS_INICIAIS[i] * (1.0 + variacao);
-        acao->preco_anterior = acao->preco_atual;
+        double variacao = (aleatorio_proximo() % 400 - 200) / 10000.0;
+        preco_t preco_abertura = PRECO_DE_REAIS(PRECOS_INICIAIS[i] * (1.0 + variacao));
+        pthread_mutex_lock(&acao->mutex);
+        preco_t preco_fechamento = acao->preco_atual;
+        publicar_preco_acao(acao, preco_abertura, preco_abertura, acao->variacao);
+        pthread_mutex_unlock(&acao->mutex);
+        historico_ticks_registrar(acao, i, preco_fechamento, preco_abertura, MOTIVO_TICK_ABERTURA);
+        barras_registrar_preco(i, preco_abertura);
         acao->preco_maximo = acao->preco_atual;
         acao->preco_minimo = acao->preco_atual;
     }
@@ -375,7 +460,7 @@ void simular_fechamento_mercado(TradingSystem* sistema) {
     // Calcular variações finais
     for (int i = 0; i < sistema->num_acoes; i++) {
         Acao* acao = &sistema->acoes[i];
-        acao->variacao_diaria = ((acao->preco_atual - acao->preco_anterior) / acao->preco_anterior) * 100;
+        acao->variacao_diaria = ((double)(acao->preco_atual - acao->preco_anterior) / acao->preco_anterior) * 100;
     }
     
     printf("📊 RESUMO DO DIA:\n");
@@ -0,0 +1,223 @@
+#define _GNU_SOURCE
+#include "trading_system.h"
+#include <limits.h>
+#include <errno.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+// Eventos de notificação entre estágios do pipeline.
+// O evento é um contador de sequência: o consumidor observa o valor, verifica
+// se há trabalho e, se não houver, espera enquanto o valor não mudar.
+// A forma de esperar é escolhida na inicialização (estratégia de espera):
+//   bloqueio   - pthread_cond (dorme no kernel, menor uso de CPU)
+//   spin       - laço ocupado com pause (menor latência, um núcleo por consumidor)
+//   spin+park  - spin limitado e depois futex (padrão)
+// O produtor incrementa o contador e só faz syscall se alguém estiver dormindo.
+
+#define LIMITE_SPIN_ESPERA 2000        // Iterações de spin antes do futex (spin+park)
+#define ITERACOES_ENTRE_RELOGIO 1024   // Iterações de spin entre consultas ao relógio
+
+static int estrategia_espera = ESTRATEGIA_ESPERA_SPIN_PARK;
+static int limite_spin = LIMITE_SPIN_ESPERA;
+
+static long futex(unsigned int* endereco, int operacao, unsigned int valor,
+                  const struct timespec* timeout) {
+    return syscall(SYS_futex, endereco, operacao, valor, timeout, NULL, 0);
+}
+
+// Dica de spin para a CPU (libera recursos do núcleo para o irmão SMT)
+static inline void pausa_cpu() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Função para configurar a estratégia de espera (antes de criar as threads)
+void configurar_estrategia_espera(int estrategia) {
+    if (estrategia < ESTRATEGIA_ESPERA_BLOQUEIO || estrategia > ESTRATEGIA_ESPERA_SPIN_PARK) {
+        estrategia = ESTRATEGIA_ESPERA_SPIN_PARK;
+    }
+    estrategia_espera = estrategia;
+
+    // Com um único núcleo o produtor não roda enquanto o consumidor gira
+    limite_spin = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? LIMITE_SPIN_ESPERA : 0;
+}
+
+// Função para obter a estratégia de espera configurada
+int obter_estrategia_espera() {
+    return estrategia_espera;
+}
+
+// Função para obter o nome de uma estratégia de espera
+const char* nome_estrategia_espera(int estrategia) {
+    switch (estrategia) {
+        case ESTRATEGIA_ESPERA_BLOQUEIO: return "bloqueio";
+        case ESTRATEGIA_ESPERA_SPIN: return "spin";
+        case ESTRATEGIA_ESPERA_SPIN_PARK: return "spin+park";
+        default: return "desconhecida";
+    }
+}
+
+// Função para converter nome em estratégia de espera (-1 se inválido)
+int estrategia_espera_por_nome(const char* nome) {
+    if (!nome) return -1;
+    if (strcmp(nome, "bloqueio") == 0) return ESTRATEGIA_ESPERA_BLOQUEIO;
+    if (strcmp(nome, "spin") == 0) return ESTRATEGIA_ESPERA_SPIN;
+    if (strcmp(nome, "spin_park") == 0 || strcmp(nome, "spin+park") == 0) return ESTRATEGIA_ESPERA_SPIN_PARK;
+    return -1;
+}
+
+// Função para inicializar evento
+void evento_inicializar(EventoNotificacao* evento) {
+    pthread_condattr_t atributos;
+
+    __atomic_store_n(&evento->sequencia, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&evento->esperando, 0, __ATOMIC_RELEASE);
+
+    pthread_mutex_init(&evento->mutex, NULL);
+    pthread_condattr_init(&atributos);
+    pthread_condattr_setclock(&atributos, CLOCK_MONOTONIC);
+    pthread_cond_init(&evento->cond, &atributos);
+    pthread_condattr_destroy(&atributos);
+}
+
+// Função para observar o evento antes de verificar se há trabalho
+unsigned int evento_observar(EventoNotificacao* evento) {
+    return __atomic_load_n(&evento->sequencia, __ATOMIC_ACQUIRE);
+}
+
+// Função para calcular o instante limite de uma espera
+static void calcular_limite(struct timespec* limite, int timeout_ms) {
+    clock_gettime(CLOCK_MONOTONIC, limite);
+    limite->tv_sec += timeout_ms / 1000;
+    limite->tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (limite->tv_nsec >= 1000000000L) {
+        limite->tv_sec++;
+        limite->tv_nsec -= 1000000000L;
+    }
+}
+
+// Função para verificar se o instante limite já passou
+static int limite_expirado(const struct timespec* limite) {
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return agora.tv_sec > limite->tv_sec ||
+           (agora.tv_sec == limite->tv_sec && agora.tv_nsec >= limite->tv_nsec);
+}
+
+// Função para girar até a sequência mudar ou esgotar as iterações/tempo
+// Retorna 1 se a sequência mudou
+static int girar_ate_mudar(EventoNotificacao* evento, unsigned int observado,
+                           long max_iteracoes, const struct timespec* limite) {
+    for (long i = 0; max_iteracoes < 0 || i < max_iteracoes; i++) {
+        if (__atomic_load_n(&evento->sequencia, __ATOMIC_ACQUIRE) != observado) {
+            return 1;
+        }
+        if (limite && (i % ITERACOES_ENTRE_RELOGIO) == ITERACOES_ENTRE_RELOGIO - 1 &&
+            limite_expirado(limite)) {
+            return 0;
+        }
+        pausa_cpu();
+    }
+    return 0;
+}
+
+// Espera com pthread_cond
+static int aguardar_bloqueio(EventoNotificacao* evento, unsigned int observado,
+                             const struct timespec* limite) {
+    int resultado = 0;
+
+    pthread_mutex_lock(&evento->mutex);
+    __atomic_add_fetch(&evento->esperando, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&evento->sequencia, __ATOMIC_SEQ_CST) == observado && resultado != ETIMEDOUT) {
+        if (limite) {
+            resultado = pthread_cond_timedwait(&evento->cond, &evento->mutex, limite);
+        } else {
+            pthread_cond_wait(&evento->cond, &evento->mutex);
+        }
+    }
+    __atomic_sub_fetch(&evento->esperando, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&evento->mutex);
+
+    return __atomic_load_n(&evento->sequencia, __ATOMIC_ACQUIRE) != observado;
+}
+
+// Espera no futex (o kernel só bloqueia se a sequência ainda for a observada)
+static int aguardar_futex(EventoNotificacao* evento, unsigned int observado, int timeout_ms) {
+    struct timespec timeout;
+    struct timespec* ptr_timeout = NULL;
+
+    if (timeout_ms >= 0) {
+        timeout.tv_sec = timeout_ms / 1000;
+        timeout.tv_nsec = (long)(timeout_ms % 1000) * 1000000L;
+        ptr_timeout = &timeout;
+    }
+
+    __atomic_add_fetch(&evento->esperando, 1, __ATOMIC_SEQ_CST);
+    long resultado = 0;
+    if (__atomic_load_n(&evento->sequencia, __ATOMIC_SEQ_CST) == observado) {
+        resultado = futex(&evento->sequencia, FUTEX_WAIT_PRIVATE, observado, ptr_timeout);
+    }
+    __atomic_sub_fetch(&evento->esperando, 1, __ATOMIC_SEQ_CST);
+
+    if (resultado == -1 && errno == ETIMEDOUT) {
+        return 0;
+    }
+    return __atomic_load_n(&evento->sequencia, __ATOMIC_ACQUIRE) != observado;
+}
+
+// Função para aguardar notificação posterior à observação
+// Retorna 1 se houve notificação, 0 em timeout (timeout_ms < 0 espera sem limite)
+int evento_aguardar(EventoNotificacao* evento, unsigned int observado, int timeout_ms) {
+    struct timespec limite;
+    struct timespec* ptr_limite = NULL;
+
+    if (timeout_ms >= 0) {
+        calcular_limite(&limite, timeout_ms);
+        ptr_limite = &limite;
+    }
+
+    switch (estrategia_espera) {
+        case ESTRATEGIA_ESPERA_BLOQUEIO:
+            return aguardar_bloqueio(evento, observado, ptr_limite);
+        case ESTRATEGIA_ESPERA_SPIN:
+            return girar_ate_mudar(evento, observado, -1, ptr_limite);
+        default:
+            if (limite_spin > 0 && girar_ate_mudar(evento, observado, limite_spin, NULL)) {
+                return 1;
+            }
+            return aguardar_futex(evento, observado, timeout_ms);
+    }
+}
+
+// Função para acordar esperas bloqueadas (uma ou todas)
+static void acordar_esperas(EventoNotificacao* evento, int todas) {
+    __atomic_add_fetch(&evento->sequencia, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&evento->esperando, __ATOMIC_SEQ_CST) == 0) {
+        return; // Ninguém dormindo (ou apenas threads em spin)
+    }
+
+    if (estrategia_espera == ESTRATEGIA_ESPERA_BLOQUEIO) {
+        pthread_mutex_lock(&evento->mutex);
+        if (todas) {
+            pthread_cond_broadcast(&evento->cond);
+        } else {
+            pthread_cond_signal(&evento->cond);
+        }
+        pthread_mutex_unlock(&evento->mutex);
+    } else {
+        futex(&evento->sequencia, FUTEX_WAKE_PRIVATE, todas ? INT_MAX : 1, NULL);
+    }
+}
+
+// Função para notificar uma thread esperando no evento
+void evento_notificar(EventoNotificacao* evento) {
+    acordar_esperas(evento, 0);
+}
+
+// Função para notificar todas as threads esperando no evento
+void evento_notificar_todos(EventoNotificacao* evento) {
+    acordar_esperas(evento, 1);
+}
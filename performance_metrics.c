@@ -40,16 +40,43 @@ typedef struct {
     double latency_min_ms;
     double latency_max_ms;
     double latency_std_ms;
+    int lotes_processados;
+    long ordens_em_lotes;
+    int lote_maximo;
+    int histograma_lotes[NUM_FAIXAS_LOTE]; // 1, 2-3, 4-7, ... até TAMANHO_MAX_LOTE_EXECUTOR
+    double total_time_seconds;
     pthread_mutex_t mutex;
 } PerformanceMetrics;
 
+// Estrutura para métricas por shard do executor (versão threads)
+typedef struct {
+    int ordens_processadas;
+    int lotes_processados;
+    double tempo_ocupado_ms;
+} ShardMetrics;
+
+// Estrutura para latência de um salto do pipeline (versão threads)
+typedef struct {
+    int amostras;
+    double soma_ms;
+    double maximo_ms;
+} LatenciaSalto;
+
+// Estrutura para latência do pipeline execução -> preço -> arbitragem
+typedef struct {
+    LatenciaSalto execucao_preco;
+    LatenciaSalto preco_arbitragem;
+    LatenciaSalto total;
+    LatenciaSalto preco_deteccao; // Mudança de preço -> pares reavaliados pelo detector
+} PipelineMetrics;
+
 // Estrutura para métricas de mercado
 typedef struct {
-    double volatility;
+    double volatility;          // Média das volatilidades recentes (janela) das ações
     double avg_spread;
     double max_spread;
     double min_spread;
-    double price_change_rate;
+    double price_change_rate;   // Amplitude média da janela recente (%)
     double volume_change_rate;
     int total_transactions;
     double total_volume;
@@ -62,6 +89,8 @@ typedef struct {
 static PerformanceMetrics process_metrics;
 static PerformanceMetrics thread_metrics;
 static MarketMetrics market_metrics;
+static ShardMetrics shard_metrics[MAX_EXECUTORES];
+static PipelineMetrics pipeline_metrics;
 static int metrics_initialized = 0;
 
 // Função para obter timestamp monotônico
@@ -114,6 +143,12 @@ void inicializar_metricas_performance() {
     // Inicializar métricas de mercado
     memset(&market_metrics, 0, sizeof(MarketMetrics));
     
+    // Inicializar métricas por shard do executor
+    memset(shard_metrics, 0, sizeof(shard_metrics));
+    
+    // Inicializar latências do pipeline
+    memset(&pipeline_metrics, 0, sizeof(PipelineMetrics));
+    
     metrics_initialized = 1;
     printf("✓ Métricas de performance inicializadas\n");
 }
@@ -205,6 +240,84 @@ void finalizar_medicao_resposta_end_to_end(int is_process) {
     pthread_mutex_unlock(&metrics->mutex);
 }
 
+// Função para registrar o tamanho de um lote retirado da fila pelo executor
+void registrar_tamanho_lote(int is_process, int tamanho) {
+    if (tamanho <= 0) return;
+    
+    PerformanceMetrics* metrics = is_process ? &process_metrics : &thread_metrics;
+    
+    // Faixa = log2(tamanho), limitada à última faixa
+    int faixa = 0;
+    while ((tamanho >> (faixa + 1)) > 0 && faixa < NUM_FAIXAS_LOTE - 1) {
+        faixa++;
+    }
+    
+    pthread_mutex_lock(&metrics->mutex);
+    metrics->lotes_processados++;
+    metrics->ordens_em_lotes += tamanho;
+    if (tamanho > metrics->lote_maximo) {
+        metrics->lote_maximo = tamanho;
+    }
+    metrics->histograma_lotes[faixa]++;
+    pthread_mutex_unlock(&metrics->mutex);
+}
+
+// Função para registrar ordens processadas por um shard do executor
+void registrar_ordens_shard(int shard, int ordens, double tempo_ocupado_ms) {
+    if (shard < 0 || shard >= MAX_EXECUTORES) return;
+    
+    pthread_mutex_lock(&thread_metrics.mutex);
+    shard_metrics[shard].ordens_processadas += ordens;
+    shard_metrics[shard].lotes_processados++;
+    shard_metrics[shard].tempo_ocupado_ms += tempo_ocupado_ms;
+    pthread_mutex_unlock(&thread_metrics.mutex);
+}
+
+// Função para acumular uma amostra de latência
+static void acumular_latencia(LatenciaSalto* salto, double latencia_ms) {
+    salto->amostras++;
+    salto->soma_ms += latencia_ms;
+    if (latencia_ms > salto->maximo_ms) {
+        salto->maximo_ms = latencia_ms;
+    }
+}
+
+// Função para registrar latência entre execução de ordem e atualização de preço
+void registrar_latencia_execucao_preco(double latencia_ms) {
+    pthread_mutex_lock(&thread_metrics.mutex);
+    acumular_latencia(&pipeline_metrics.execucao_preco, latencia_ms);
+    pthread_mutex_unlock(&thread_metrics.mutex);
+}
+
+// Função para registrar latência entre atualização de preço e monitor de arbitragem
+// latencia_total_ms < 0 indica preço sem execução de origem (variação de mercado)
+void registrar_latencia_preco_arbitragem(double latencia_ms, double latencia_total_ms) {
+    pthread_mutex_lock(&thread_metrics.mutex);
+    acumular_latencia(&pipeline_metrics.preco_arbitragem, latencia_ms);
+    if (latencia_total_ms >= 0) {
+        acumular_latencia(&pipeline_metrics.total, latencia_total_ms);
+    }
+    pthread_mutex_unlock(&thread_metrics.mutex);
+}
+
+// Função para registrar latência entre mudança de preço e reavaliação dos
+// pares pelo detector de arbitragem
+void registrar_latencia_preco_deteccao(double latencia_ms) {
+    pthread_mutex_lock(&thread_metrics.mutex);
+    acumular_latencia(&pipeline_metrics.preco_deteccao, latencia_ms);
+    pthread_mutex_unlock(&thread_metrics.mutex);
+}
+
+// Função para exibir latência de um salto do pipeline
+static void exibir_latencia_salto(const char* nome, LatenciaSalto* salto) {
+    if (salto->amostras == 0) {
+        printf("   %-22s sem amostras\n", nome);
+        return;
+    }
+    printf("   %-22s média %.3f ms, máxima %.3f ms (%d amostras)\n", nome,
+           salto->soma_ms / salto->amostras, salto->maximo_ms, salto->amostras);
+}
+
 // Função para coletar estatísticas de recursos
 void coletar_estatisticas_recursos(int is_process) {
     PerformanceMetrics* metrics = is_process ? &process_metrics : &thread_metrics;
@@ -219,6 +332,7 @@ void calcular_throughput(int is_process, double total_time_seconds) {
     pthread_mutex_lock(&metrics->mutex);
     if (total_time_seconds > 0) {
         metrics->throughput_ops_per_sec = (double)metrics->orders_processed / total_time_seconds;
+        metrics->total_time_seconds = total_time_seconds;
     }
     pthread_mutex_unlock(&metrics->mutex);
 }
@@ -240,19 +354,20 @@ void calcular_metricas_mercado(TradingSystem* sistema) {
     for (int i = 0; i < sistema->num_acoes; i++) {
         Acao* acao = &sistema->acoes[i];
         total_volume += acao->volume_total;
-        total_price += acao->preco_atual;
+        double preco_atual = PRECO_EM_REAIS(acao->preco_atual);
+        total_price += preco_atual;
         
-        if (acao->preco_atual > max_price) {
-            max_price = acao->preco_atual;
+        if (preco_atual > max_price) {
+            max_price = preco_atual;
         }
-        if (acao->preco_atual < min_price) {
-            min_price = acao->preco_atual;
+        if (preco_atual < min_price) {
+            min_price = preco_atual;
         }
         
         // Calcular spreads entre ações relacionadas
         for (int j = i + 1; j < sistema->num_acoes; j++) {
             Acao* acao2 = &sistema->acoes[j];
-            double spread = fabs(acao->preco_atual - acao2->preco_atual) / acao->preco_atual * 100.0;
+            double spread = (double)llabs(acao->preco_atual - acao2->preco_atual) / acao->preco_atual * 100.0;
             total_spread += spread;
             spread_count++;
             
@@ -274,16 +389,25 @@ void calcular_metricas_mercado(TradingSystem* sistema) {
     market_metrics.max_spread = max_spread;
     market_metrics.min_spread = min_spread;
     
-    // Calcular volatilidade (desvio padrão dos preços)
-    double variance = 0;
+    // Calcular volatilidade e faixa de preço recentes a partir das janelas de
+    // cada ação (já mantidas a cada atualização de preço, sem varrer histórico)
+    double total_volatility = 0;
+    double total_range = 0;
     for (int i = 0; i < sistema->num_acoes; i++) {
-        double diff = sistema->acoes[i].preco_atual - market_metrics.avg_price;
-        variance += diff * diff;
+        Acao* acao = &sistema->acoes[i];
+        pthread_mutex_lock(&acao->mutex);
+        EstatisticasJanela* estatisticas = &acao->estatisticas;
+        total_volatility += estatisticas_janela_volatilidade(estatisticas);
+        double media = estatisticas_janela_media(estatisticas);
+        if (media > 0) {
+            total_range += (estatisticas_janela_maximo(estatisticas) - estatisticas_janela_minimo(estatisticas)) / media;
+        }
+        pthread_mutex_unlock(&acao->mutex);
     }
-    market_metrics.volatility = sqrt(variance / sistema->num_acoes);
+    market_metrics.volatility = total_volatility / sistema->num_acoes;
     
-    // Calcular taxas de mudança (simplificado)
-    market_metrics.price_change_rate = (market_metrics.max_price - market_metrics.min_price) / market_metrics.avg_price * 100.0;
+    // Taxa de mudança: amplitude média (máximo - mínimo) da janela recente
+    market_metrics.price_change_rate = total_range / sistema->num_acoes * 100.0;
     market_metrics.volume_change_rate = total_volume > 0 ? (total_volume / sistema->num_acoes) / 1000.0 : 0;
 }
 
@@ -335,6 +459,54 @@ void exibir_metricas_performance(int is_process) {
     printf("🚀 THROUGHPUT:\n");
     printf("   Ordens por segundo: %.2f ops/sec\n", metrics->throughput_ops_per_sec);
     
+    // Throughput por shard do executor (apenas threads)
+    if (!is_process) {
+        printf("🧩 THROUGHPUT POR SHARD DO EXECUTOR:\n");
+        for (int i = 0; i < MAX_EXECUTORES; i++) {
+            ShardMetrics* shard = &shard_metrics[i];
+            if (shard->lotes_processados == 0) continue;
+            printf("   Shard %d: %d ordens em %d lotes, %.2f ops/sec (sessão), %.2f ops/sec (ocupado %.1f ms)\n",
+                   i, shard->ordens_processadas, shard->lotes_processados,
+                   metrics->total_time_seconds > 0 ? 
+                   shard->ordens_processadas / metrics->total_time_seconds : 0.0,
+                   shard->tempo_ocupado_ms > 0 ? 
+                   shard->ordens_processadas / (shard->tempo_ocupado_ms / 1000.0) : 0.0,
+                   shard->tempo_ocupado_ms);
+        }
+    }
+    
+    // Latência do pipeline execução -> preço -> arbitragem (apenas threads)
+    if (!is_process) {
+        printf("⏱️ LATÊNCIA DO PIPELINE (%s):\n",
+               obter_notificacao_polling() ? "polling por timer" :
+               nome_estrategia_espera(obter_estrategia_espera()));
+        exibir_latencia_salto("Execução -> preço:", &pipeline_metrics.execucao_preco);
+        exibir_latencia_salto("Preço -> arbitragem:", &pipeline_metrics.preco_arbitragem);
+        exibir_latencia_salto("Execução -> arbitragem:", &pipeline_metrics.total);
+        exibir_latencia_salto("Preço -> detector:", &pipeline_metrics.preco_deteccao);
+    }
+    
+    // Distribuição do tamanho de lote do executor
+    printf("📦 LOTES DO EXECUTOR:\n");
+    printf("   Lotes processados: %d\n", metrics->lotes_processados);
+    printf("   Tamanho médio: %.2f ordens\n", 
+           metrics->lotes_processados > 0 ? 
+           (double)metrics->ordens_em_lotes / metrics->lotes_processados : 0.0);
+    printf("   Tamanho máximo: %d ordens\n", metrics->lote_maximo);
+    for (int i = 0; i < NUM_FAIXAS_LOTE; i++) {
+        int limite_inferior = 1 << i;
+        int limite_superior = (1 << (i + 1)) - 1;
+        // A última faixa termina no maior lote que o executor consegue retirar
+        if (limite_superior > TAMANHO_MAX_LOTE_EXECUTOR) {
+            limite_superior = TAMANHO_MAX_LOTE_EXECUTOR;
+        }
+        if (limite_inferior == limite_superior) {
+            printf("   %3d     : %d lotes\n", limite_inferior, metrics->histograma_lotes[i]);
+        } else {
+            printf("   %3d-%-3d : %d lotes\n", limite_inferior, limite_superior, metrics->histograma_lotes[i]);
+        }
+    }
+    
     // Tempo de resposta end-to-end
     printf("🔄 TEMPO DE RESPOSTA END-TO-END:\n");
     printf("   Duração: %.3f ms (%.0f μs)\n", 
@@ -431,6 +603,12 @@ void salvar_metricas_arquivo(const char* filename) {
     fprintf(file, "Ordens processadas: %d\n", thread_metrics.orders_processed);
     fprintf(file, "Throughput: %.2f ops/sec\n", thread_metrics.throughput_ops_per_sec);
     fprintf(file, "Latência média: %.2f ms\n", thread_metrics.latency_avg_ms);
+    fprintf(file, "Tamanho médio de lote: %.2f ordens\n", 
+            thread_metrics.lotes_processados > 0 ? 
+            (double)thread_metrics.ordens_em_lotes / thread_metrics.lotes_processados : 0.0);
+    fprintf(file, "Latência execução -> arbitragem: %.3f ms\n",
+            pipeline_metrics.total.amostras > 0 ? 
+            pipeline_metrics.total.soma_ms / pipeline_metrics.total.amostras : 0.0);
     fprintf(file, "Memória máxima: %ld KB\n", thread_metrics.resource_usage.max_rss_kb);
     
     // Métricas de mercado
@@ -237,39 +237,41 @@ void imprimir_status_pipes() {
 }
 
 // Função para criar mensagem de ordem
-MensagemPipe criar_mensagem_ordem(int trader_id, int acao_id, char tipo, double preco, int quantidade) {
+MensagemPipe criar_mensagem_ordem(int trader_id, int acao_id, char tipo, preco_t preco, int quantidade) {
     MensagemPipe mensagem;
     memset(&mensagem, 0, sizeof(MensagemPipe));
     
     mensagem.tipo_mensagem = 1; // Ordem
     mensagem.origem_id = trader_id;
     mensagem.destino_id = 0; // Executor
-    mensagem.valor = preco;
+    mensagem.preco = preco;
+    mensagem.valor = PRECO_EM_REAIS(preco);
     mensagem.dados_ordem = (acao_id << 16) | (tipo << 8) | quantidade;
     mensagem.timestamp = time(NULL);
     
     snprintf(mensagem.dados_extras, sizeof(mensagem.dados_extras), 
-             "Ordem: %c %d ações de %d a R$ %.2f", tipo, quantidade, acao_id, preco);
+             "Ordem: %c %d ações de %d a R$ %.2f", tipo, quantidade, acao_id, PRECO_EM_REAIS(preco));
     
     return mensagem;
 }
 
 // Função para criar mensagem de atualização de preço
-MensagemPipe criar_mensagem_atualizacao_preco(int acao_id, double preco_anterior, double preco_novo) {
+MensagemPipe criar_mensagem_atualizacao_preco(int acao_id, preco_t preco_anterior, preco_t preco_novo) {
     MensagemPipe mensagem;
     memset(&mensagem, 0, sizeof(MensagemPipe));
     
     mensagem.tipo_mensagem = 2; // Atualização de preço
     mensagem.origem_id = 1; // Executor
     mensagem.destino_id = 2; // Price Updater
-    mensagem.valor = preco_novo;
+    mensagem.preco = preco_novo;
+    mensagem.valor = PRECO_EM_REAIS(preco_novo);
     mensagem.dados_ordem = acao_id;
     mensagem.timestamp = time(NULL);
     
     snprintf(mensagem.dados_extras, sizeof(mensagem.dados_extras), 
              "Preço %d: R$ %.2f -> R$ %.2f (variação: %.2f%%)", 
-             acao_id, preco_anterior, preco_novo, 
-             ((preco_novo - preco_anterior) / preco_anterior) * 100);
+             acao_id, PRECO_EM_REAIS(preco_anterior), PRECO_EM_REAIS(preco_novo), 
+             ((double)(preco_novo - preco_anterior) / preco_anterior) * 100);
     
     return mensagem;
 }
@@ -348,14 +350,14 @@ void testar_pipes_sistema() {
     printf("Testando envio de mensagens...\n");
     
     // Mensagem de ordem
-    MensagemPipe ordem = criar_mensagem_ordem(0, 1, 'C', 25.50, 100);
+    MensagemPipe ordem = criar_mensagem_ordem(0, 1, 'C', PRECO_DE_REAIS(25.50), 100);
     if (enviar_mensagem_pipe(sistema_pipes.traders_to_executor[1], &ordem) > 0) {
         printf("✓ Mensagem de ordem enviada\n");
         imprimir_mensagem(&ordem);
     }
     
     // Mensagem de atualização
-    MensagemPipe atualizacao = criar_mensagem_atualizacao_preco(1, 25.50, 26.00);
+    MensagemPipe atualizacao = criar_mensagem_atualizacao_preco(1, PRECO_DE_REAIS(25.50), PRECO_DE_REAIS(26.00));
     if (enviar_mensagem_pipe(sistema_pipes.executor_to_price_updater[1], &atualizacao) > 0) {
         printf("✓ Mensagem de atualização enviada\n");
         imprimir_mensagem(&atualizacao);
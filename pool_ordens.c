@@ -0,0 +1,254 @@
+#include "trading_system.h"
+
+// Pool de ordens em blocos (slabs) com lista livre e handles com geração.
+// Substitui o array fixo de MAX_ORDENS: cada bloco traz ORDENS_POR_SLAB
+// slots e só é criado quando a lista livre esvazia. O índice global de um
+// slot é (bloco * ORDENS_POR_SLAB + posição); o handle junta esse índice à
+// geração do slot, que avança a cada liberação.
+//
+// Modo local (threads): blocos alocados com malloc, endereços no próprio pool.
+// Modo compartilhado (processos): cada bloco é um segmento shmget criado por
+// quem precisou dele; os ids ficam no pool (que está na memória
+// compartilhada) e cada processo mantém seu próprio mapa de endereços,
+// anexando sob demanda os blocos criados por outros processos.
+
+#define SLOT_ORDEM_OCUPADO -2
+
+// Endereços dos blocos compartilhados neste processo (um pool compartilhado por processo)
+static SlotOrdem* slabs_anexados[MAX_SLABS_ORDENS];
+
+// Função para obter o endereço de um bloco (anexa o segmento se preciso)
+static SlotOrdem* obter_slab(PoolOrdens* pool, int slab) {
+    if (!pool->compartilhado) {
+        return __atomic_load_n(&pool->slabs[slab], __ATOMIC_ACQUIRE);
+    }
+
+    SlotOrdem* endereco = __atomic_load_n(&slabs_anexados[slab], __ATOMIC_ACQUIRE);
+    if (endereco) {
+        return endereco;
+    }
+
+    int shm_slab = __atomic_load_n(&pool->slab_shm_ids[slab], __ATOMIC_ACQUIRE);
+    void* anexado = shmat(shm_slab, NULL, 0);
+    if (anexado == (void*)-1) {
+        perror("Erro ao anexar bloco do pool de ordens");
+        return NULL;
+    }
+
+    // Outra thread do processo pode ter anexado o mesmo bloco ao mesmo tempo
+    SlotOrdem* esperado = NULL;
+    if (!__atomic_compare_exchange_n(&slabs_anexados[slab], &esperado, (SlotOrdem*)anexado,
+                                     0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        shmdt(anexado);
+        return esperado;
+    }
+    return (SlotOrdem*)anexado;
+}
+
+// Função para criar um novo bloco e encadear seus slots na lista livre
+// Chamada com o mutex do pool travado. Retorna 1 em sucesso, 0 em falha
+static int criar_slab(PoolOrdens* pool) {
+    if (pool->num_slabs >= MAX_SLABS_ORDENS) {
+        printf("ERRO: Pool de ordens cheio (%d ordens)\n", MAX_ORDENS);
+        return 0;
+    }
+
+    int slab = pool->num_slabs;
+    size_t tamanho = ORDENS_POR_SLAB * sizeof(SlotOrdem);
+    SlotOrdem* slots;
+
+    if (pool->compartilhado) {
+        int shm_slab = shmget(IPC_PRIVATE, tamanho, IPC_CREAT | 0666);
+        if (shm_slab == -1) {
+            perror("Erro ao criar bloco do pool de ordens");
+            return 0;
+        }
+        slots = (SlotOrdem*)shmat(shm_slab, NULL, 0);
+        if (slots == (void*)-1) {
+            perror("Erro ao anexar bloco do pool de ordens");
+            shmctl(shm_slab, IPC_RMID, NULL);
+            return 0;
+        }
+        __atomic_store_n(&pool->slab_shm_ids[slab], shm_slab, __ATOMIC_RELEASE);
+        __atomic_store_n(&slabs_anexados[slab], slots, __ATOMIC_RELEASE);
+    } else {
+        slots = malloc(tamanho);
+        if (!slots) {
+            printf("ERRO: Falha ao alocar bloco do pool de ordens\n");
+            return 0;
+        }
+        __atomic_store_n(&pool->slabs[slab], slots, __ATOMIC_RELEASE);
+    }
+
+    // Slots em ordem crescente na lista livre (índices baixos saem primeiro)
+    int base = slab * ORDENS_POR_SLAB;
+    for (int i = 0; i < ORDENS_POR_SLAB; i++) {
+        memset(&slots[i].ordem, 0, sizeof(Ordem));
+        slots[i].geracao = 1;
+        slots[i].proxima_livre = i + 1 < ORDENS_POR_SLAB ? base + i + 1 : pool->livre;
+    }
+    pool->livre = base;
+    pool->num_slabs++;
+    return 1;
+}
+
+static inline SlotOrdem* slot_do_indice(PoolOrdens* pool, int indice) {
+    SlotOrdem* slots = obter_slab(pool, indice / ORDENS_POR_SLAB);
+    return slots ? &slots[indice % ORDENS_POR_SLAB] : NULL;
+}
+
+// Função para inicializar pool de ordens (sem blocos; o primeiro nasce na primeira ordem)
+// compartilhado: 1 se o pool está em memória compartilhada entre processos
+// Retorna 1 em sucesso, 0 em falha
+int pool_ordens_inicializar(PoolOrdens* pool, int compartilhado) {
+    memset(pool, 0, sizeof(PoolOrdens));
+    pool->compartilhado = compartilhado;
+    pool->livre = -1;
+
+    pthread_mutexattr_t atributos;
+    pthread_mutexattr_init(&atributos);
+    if (compartilhado) {
+        pthread_mutexattr_setpshared(&atributos, PTHREAD_PROCESS_SHARED);
+        memset(slabs_anexados, 0, sizeof(slabs_anexados));
+    }
+    int resultado = pthread_mutex_init(&pool->mutex, &atributos);
+    pthread_mutexattr_destroy(&atributos);
+    return resultado == 0;
+}
+
+// Função para liberar pool de ordens (blocos locais ou segmentos compartilhados)
+void pool_ordens_liberar(PoolOrdens* pool) {
+    for (int slab = 0; slab < pool->num_slabs; slab++) {
+        if (pool->compartilhado) {
+            if (slabs_anexados[slab]) {
+                shmdt(slabs_anexados[slab]);
+                slabs_anexados[slab] = NULL;
+            }
+            shmctl(pool->slab_shm_ids[slab], IPC_RMID, NULL);
+        } else {
+            free(pool->slabs[slab]);
+            pool->slabs[slab] = NULL;
+        }
+    }
+    pool->num_slabs = 0;
+    pool->limite = 0;
+    pool->vivas = 0;
+    pool->livre = -1;
+    pthread_mutex_destroy(&pool->mutex);
+}
+
+// Função para alocar uma ordem no pool (copia *ordem para o slot)
+// Se indice não for NULL, recebe o índice global do slot
+// Retorna o handle da ordem ou HANDLE_ORDEM_INVALIDO se o pool está cheio
+HandleOrdem pool_ordens_alocar(PoolOrdens* pool, const Ordem* ordem, int* indice) {
+    pthread_mutex_lock(&pool->mutex);
+
+    if (pool->livre < 0 && !criar_slab(pool)) {
+        pthread_mutex_unlock(&pool->mutex);
+        return HANDLE_ORDEM_INVALIDO;
+    }
+
+    int posicao = pool->livre;
+    SlotOrdem* slot = slot_do_indice(pool, posicao);
+    if (!slot) {
+        pthread_mutex_unlock(&pool->mutex);
+        return HANDLE_ORDEM_INVALIDO;
+    }
+    pool->livre = slot->proxima_livre;
+    slot->ordem = *ordem;
+    slot->proxima_livre = SLOT_ORDEM_OCUPADO;
+    __atomic_add_fetch(&pool->vivas, 1, __ATOMIC_RELAXED);
+    if (posicao >= pool->limite) {
+        __atomic_store_n(&pool->limite, posicao + 1, __ATOMIC_RELEASE);
+    }
+    HandleOrdem handle = ((HandleOrdem)slot->geracao << 32) | (unsigned int)posicao;
+
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (indice) *indice = posicao;
+    return handle;
+}
+
+// Função para devolver uma ordem ao pool
+// Retorna 1 se liberou, 0 se o handle é inválido ou obsoleto
+int pool_ordens_liberar_ordem(PoolOrdens* pool, HandleOrdem handle) {
+    return pool_ordens_retirar(pool, handle, NULL);
+}
+
+// Função para retirar uma ordem do pool: copia para *ordem (se não for NULL) e
+// libera o slot no mesmo passo, então só quem retirou fica com a ordem
+// Retorna 1 se retirou, 0 se o handle é inválido ou obsoleto
+int pool_ordens_retirar(PoolOrdens* pool, HandleOrdem handle, Ordem* ordem) {
+    int posicao = (int)(handle & 0xFFFFFFFFu);
+    unsigned int geracao = (unsigned int)(handle >> 32);
+
+    pthread_mutex_lock(&pool->mutex);
+    if (handle == HANDLE_ORDEM_INVALIDO || posicao < 0 || posicao >= pool->limite) {
+        pthread_mutex_unlock(&pool->mutex);
+        return 0;
+    }
+    SlotOrdem* slot = slot_do_indice(pool, posicao);
+    if (!slot || slot->geracao != geracao || slot->proxima_livre != SLOT_ORDEM_OCUPADO) {
+        pthread_mutex_unlock(&pool->mutex);
+        return 0;
+    }
+
+    if (ordem) *ordem = slot->ordem;
+    slot->geracao++;
+    if (slot->geracao == 0) slot->geracao = 1; // Geração 0 reservada ao handle inválido
+    slot->proxima_livre = pool->livre;
+    pool->livre = posicao;
+    __atomic_sub_fetch(&pool->vivas, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&pool->mutex);
+    return 1;
+}
+
+// Função para obter a ordem de um handle (NULL se obsoleto ou inválido)
+Ordem* pool_ordens_obter(PoolOrdens* pool, HandleOrdem handle) {
+    int posicao = (int)(handle & 0xFFFFFFFFu);
+    if (handle == HANDLE_ORDEM_INVALIDO || posicao < 0 ||
+        posicao >= __atomic_load_n(&pool->limite, __ATOMIC_ACQUIRE)) {
+        return NULL;
+    }
+    SlotOrdem* slot = slot_do_indice(pool, posicao);
+    if (!slot || slot->geracao != (unsigned int)(handle >> 32) ||
+        slot->proxima_livre != SLOT_ORDEM_OCUPADO) {
+        return NULL;
+    }
+    return &slot->ordem;
+}
+
+// Função para obter a ordem de um índice global (NULL se o slot está livre)
+// Para percorrer o pool: for (i = 0; i < pool_ordens_limite(pool); i++)
+Ordem* pool_ordens_slot(PoolOrdens* pool, int indice) {
+    if (indice < 0 || indice >= __atomic_load_n(&pool->limite, __ATOMIC_ACQUIRE)) {
+        return NULL;
+    }
+    SlotOrdem* slot = slot_do_indice(pool, indice);
+    if (!slot || slot->proxima_livre != SLOT_ORDEM_OCUPADO) {
+        return NULL;
+    }
+    return &slot->ordem;
+}
+
+// Função para obter o handle atual de um slot ocupado (HANDLE_ORDEM_INVALIDO se livre)
+HandleOrdem pool_ordens_handle(PoolOrdens* pool, int indice) {
+    if (indice < 0 || indice >= __atomic_load_n(&pool->limite, __ATOMIC_ACQUIRE)) {
+        return HANDLE_ORDEM_INVALIDO;
+    }
+    SlotOrdem* slot = slot_do_indice(pool, indice);
+    if (!slot || slot->proxima_livre != SLOT_ORDEM_OCUPADO) {
+        return HANDLE_ORDEM_INVALIDO;
+    }
+    return ((HandleOrdem)slot->geracao << 32) | (unsigned int)indice;
+}
+
+// Função para obter o limite de iteração (slots já usados alguma vez)
+int pool_ordens_limite(const PoolOrdens* pool) {
+    return __atomic_load_n(&pool->limite, __ATOMIC_ACQUIRE);
+}
+
+// Função para obter o número de ordens alocadas no momento
+int pool_ordens_vivas(const PoolOrdens* pool) {
+    return __atomic_load_n(&pool->vivas, __ATOMIC_RELAXED);
+}
@@ -8,19 +8,6 @@ static int atualizacoes_validas = 0;
 static int atualizacoes_rejeitadas = 0;
 static int notificacoes_recebidas = 0;
 
-// Função para inicializar arquivo de histórico
-void inicializar_arquivo_historico() {
-    FILE* arquivo = fopen(ARQUIVO_HISTORICO, "w");
-    if (arquivo) {
-        fprintf(arquivo, "=== HISTÓRICO DE PREÇOS ===\n");
-        fprintf(arquivo, "Timestamp,Ação,Preço_Anterior,Preço_Novo,Variação,Motivo\n");
-        fclose(arquivo);
-        printf("PRICE UPDATER: Arquivo de histórico inicializado: %s\n", ARQUIVO_HISTORICO);
-    } else {
-        printf("PRICE UPDATER: Erro ao criar arquivo de histórico\n");
-    }
-}
-
 // Função para receber notificação de transação via pipe
 int receber_notificacao_transacao(int pipe_read, Ordem* ordem, int* resultado) {
     struct pollfd pfd;
@@ -36,12 +23,13 @@ int receber_notificacao_transacao(int pipe_read, Ordem* ordem, int* resultado) {
         ssize_t bytes_lidos = read(pipe_read, &msg, sizeof(MensagemPipe));
         
         if (bytes_lidos == sizeof(MensagemPipe) && msg.tipo_mensagem == 2) {
-            // Converter mensagem para ordem
+            // Converter mensagem de negócio para ordem executada
             ordem->trader_id = msg.origem_id;
             ordem->acao_id = msg.dados_ordem;
-            ordem->preco = msg.valor;
+            ordem->preco = msg.preco;
+            ordem->quantidade = msg.quantidade;
             ordem->timestamp = msg.timestamp;
-            *resultado = msg.dados_ordem; // 1: aceita, 0: rejeita
+            *resultado = 1; // O executor só envia negócios realizados
             
             notificacoes_recebidas++;
             return 1; // Notificação recebida com sucesso
@@ -52,43 +40,46 @@ int receber_notificacao_transacao(int pipe_read, Ordem* ordem, int* resultado) {
 }
 
 // Função para calcular preço usando média ponderada
-double calcular_preco_media_ponderada(double preco_atual, double preco_transacao, int volume) {
-    // Calcular peso baseado no volume (volume maior = mais peso)
-    double peso_volume = (double)volume / 1000.0; // Normalizar volume
-    if (peso_volume > 1.0) peso_volume = 1.0; // Limitar a 100%
+// Pesos inteiros (escala 1/20000) para a média sair exata em ponto fixo
+preco_t calcular_preco_media_ponderada(preco_t preco_atual, preco_t preco_transacao, int volume) {
+    // Calcular peso baseado no volume (volume maior = mais peso), em milésimos
+    long long peso_volume = volume; // Normalizar volume (1000 ações = 100%)
+    if (peso_volume > 1000) peso_volume = 1000; // Limitar a 100%
+    if (peso_volume < 0) peso_volume = 0;
     
-    // Ajustar pesos baseado no volume
-    double peso_transacao = PESO_ULTIMA_TRANSACAO * (0.5 + peso_volume * 0.5);
-    double peso_atual = PESO_PRECO_ATUAL * (1.0 - peso_volume * 0.3);
+    // Ajustar pesos baseado no volume: transação 50%-100%, preço atual 100%-70%
+    long long peso_transacao = PESO_ULTIMA_TRANSACAO * (10000 + 10 * peso_volume);
+    long long peso_atual = PESO_PRECO_ATUAL * (20000 - 6 * peso_volume);
+    long long soma_pesos = peso_transacao + peso_atual;
     
-    // Calcular média ponderada
-    double novo_preco = (preco_transacao * peso_transacao + preco_atual * peso_atual) / (peso_transacao + peso_atual);
+    // Calcular média ponderada (arredondada para o ponto fixo mais próximo)
+    preco_t novo_preco = (preco_transacao * peso_transacao + preco_atual * peso_atual + soma_pesos / 2) / soma_pesos;
     
     return novo_preco;
 }
 
 // Função para validar preço (evitar preços negativos ou muito voláteis)
-int validar_preco(double preco, double preco_anterior) {
+int validar_preco(preco_t preco, preco_t preco_anterior) {
     // Verificar preço mínimo
     if (preco < MIN_PRECO_ACAO) {
-        printf("PRICE UPDATER: Preço rejeitado - Muito baixo (R$ %.2f < R$ %.2f)\n", 
-               preco, MIN_PRECO_ACAO);
+        LOG_DEBUG("PRICE UPDATER: Preço rejeitado - Muito baixo (R$ %.2f < R$ %.2f)\n", 
+               PRECO_EM_REAIS(preco), PRECO_EM_REAIS(MIN_PRECO_ACAO));
         return 0;
     }
     
     // Verificar preço máximo
     if (preco > MAX_PRECO_ACAO) {
-        printf("PRICE UPDATER: Preço rejeitado - Muito alto (R$ %.2f > R$ %.2f)\n", 
-               preco, MAX_PRECO_ACAO);
+        LOG_DEBUG("PRICE UPDATER: Preço rejeitado - Muito alto (R$ %.2f > R$ %.2f)\n", 
+               PRECO_EM_REAIS(preco), PRECO_EM_REAIS(MAX_PRECO_ACAO));
         return 0;
     }
     
-    // Verificar variação máxima
+    // Verificar variação máxima (diferença * 100 > anterior * MAX_VARIACAO_PRECO)
     if (preco_anterior > 0) {
-        double variacao = fabs(preco - preco_anterior) / preco_anterior;
-        if (variacao > MAX_VARIACAO_PRECO) {
-            printf("PRICE UPDATER: Preço rejeitado - Variação muito alta (%.2f%% > %.2f%%)\n", 
-                   variacao * 100, MAX_VARIACAO_PRECO * 100);
+        preco_t diferenca = llabs(preco - preco_anterior);
+        if (diferenca * 100 > preco_anterior * MAX_VARIACAO_PRECO) {
+            LOG_DEBUG("PRICE UPDATER: Preço rejeitado - Variação muito alta (%.2f%% > %d%%)\n", 
+                   (double)diferenca / preco_anterior * 100, MAX_VARIACAO_PRECO);
             return 0;
         }
     }
@@ -97,7 +88,7 @@ int validar_preco(double preco, double preco_anterior) {
 }
 
 // Função para atualizar estatísticas da ação
-void atualizar_estatisticas_acao(TradingSystem* sistema, int acao_id, double novo_preco) {
+void atualizar_estatisticas_acao(TradingSystem* sistema, int acao_id, preco_t novo_preco) {
     if (acao_id < 0 || acao_id >= sistema->num_acoes) {
         return;
     }
@@ -106,10 +97,10 @@ void atualizar_estatisticas_acao(TradingSystem* sistema, int acao_id, double nov
     
     pthread_mutex_lock(&acao->mutex);
     
-    // Atualizar preços
-    acao->preco_anterior = acao->preco_atual;
-    acao->preco_atual = novo_preco;
-    acao->variacao = (novo_preco - acao->preco_anterior) / acao->preco_anterior;
+    // Atualizar preços (publicados juntos para os leitores sem lock)
+    preco_t preco_anterior = acao->preco_atual;
+    publicar_preco_acao(acao, novo_preco, preco_anterior,
+                        (double)(novo_preco - preco_anterior) / preco_anterior);
     
     // Atualizar estatísticas
     if (novo_preco > acao->preco_maximo) {
@@ -118,81 +109,61 @@ void atualizar_estatisticas_acao(TradingSystem* sistema, int acao_id, double nov
     if (novo_preco < acao->preco_minimo || acao->preco_minimo == 0) {
         acao->preco_minimo = novo_preco;
     }
+    estatisticas_janela_adicionar(&acao->estatisticas, PRECO_EM_REAIS(novo_preco));
     
     // Atualizar volume negociado (simulado)
-    acao->volume_negociado += rand() % 100 + 50; // 50-150 ações
+    acao->volume_negociado += aleatorio_proximo() % 100 + 50; // 50-150 ações
     
     // Atualizar número de operações
     acao->num_operacoes++;
     
     // Atualizar variação diária
-    acao->variacao_diaria = (novo_preco - acao->preco_anterior) / acao->preco_anterior;
+    acao->variacao_diaria = (double)(novo_preco - acao->preco_anterior) / acao->preco_anterior;
     
     pthread_mutex_unlock(&acao->mutex);
 }
 
 // Função para enviar atualização para monitor de arbitragem
-void enviar_atualizacao_arbitragem(int pipe_write, int acao_id, double preco_anterior, double novo_preco) {
+void enviar_atualizacao_arbitragem(int pipe_write, int acao_id, preco_t preco_anterior, preco_t novo_preco) {
     (void)preco_anterior; // Evitar warning de parâmetro não utilizado
     MensagemPipe msg;
     msg.tipo_mensagem = 3; // Atualização de preço
     msg.origem_id = 2; // Price Updater
     msg.destino_id = 3; // Arbitrage Monitor
     msg.dados_ordem = acao_id;
-    msg.valor = novo_preco;
+    msg.preco = novo_preco;
+    msg.valor = PRECO_EM_REAIS(novo_preco);
     msg.timestamp = time(NULL);
     
     if (enviar_mensagem_pipe(pipe_write, &msg) > 0) {
-        printf("PRICE UPDATER: Atualização enviada para Arbitrage Monitor (Ação %d)\n", acao_id);
+        LOG_DEBUG("PRICE UPDATER: Atualização enviada para Arbitrage Monitor (Ação %d)\n", acao_id);
     }
 }
 
-// Função para salvar histórico de preços em arquivo
-void salvar_historico_precos(TradingSystem* sistema) {
-    FILE* arquivo = fopen(ARQUIVO_HISTORICO, "a");
-    if (!arquivo) {
-        printf("PRICE UPDATER: Erro ao abrir arquivo de histórico\n");
-        return;
-    }
-    
-    time_t agora = time(NULL);
-    char timestamp[64];
-    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", localtime(&agora));
-    
-    fprintf(arquivo, "=== SNAPSHOT %s ===\n", timestamp);
-    fprintf(arquivo, "Ação,Preço_Atual,Variação,Volume,Max_Dia,Min_Dia,Operações\n");
-    
-    for (int i = 0; i < sistema->num_acoes; i++) {
-        Acao* acao = &sistema->acoes[i];
-        fprintf(arquivo, "%s,%.2f,%.2f%%,%d,%.2f,%.2f,%d\n",
-                acao->nome,
-                acao->preco_atual,
-                acao->variacao * 100,
-                acao->volume_negociado,
-                acao->preco_maximo,
-                acao->preco_minimo,
-                acao->num_operacoes);
+// Função para registrar uma atualização de preço: tick no histórico binário,
+// barras OHLCV, sinal ao detector de arbitragem e, no nível debug, uma linha
+// de log
+void log_atualizacao_preco(TradingSystem* sistema, int acao_id, preco_t preco_anterior, preco_t novo_preco, int motivo) {
+    historico_ticks_registrar(&sistema->acoes[acao_id], acao_id, preco_anterior, novo_preco, motivo);
+    barras_registrar_preco(acao_id, novo_preco);
+    sinalizar_preco_arbitragem(acao_id);
+    
+    if (!LOG_HABILITADO(NIVEL_LOG_DEBUG)) {
+        return; // Sem formatar o horário à toa
     }
-    
-    fprintf(arquivo, "\n");
-    fclose(arquivo);
-}
-
-// Função para log detalhado de atualização de preço
-void log_atualizacao_preco(int acao_id, double preco_anterior, double novo_preco, const char* motivo) {
     time_t agora = time(NULL);
     char timestamp[64];
     strftime(timestamp, sizeof(timestamp), "%H:%M:%S", localtime(&agora));
     
-    double variacao = (novo_preco - preco_anterior) / preco_anterior * 100;
+    double variacao = (double)(novo_preco - preco_anterior) / preco_anterior * 100;
     
-    printf("[%s] PRICE UPDATER: Ação %d - R$ %.2f → R$ %.2f (%.2f%%) - %s\n", 
-           timestamp, acao_id, preco_anterior, novo_preco, variacao, motivo);
+    LOG_DEBUG("[%s] PRICE UPDATER: Ação %d - R$ %.2f → R$ %.2f (%.2f%%) - %s\n", 
+           timestamp, acao_id, PRECO_EM_REAIS(preco_anterior), PRECO_EM_REAIS(novo_preco), variacao, nome_motivo_tick(motivo));
 }
 
 // Função principal do processo price updater melhorado
 void processo_price_updater_melhorado() {
-    printf("=== PROCESSO PRICE UPDATER MELHORADO INICIADO (PID: %d) ===\n", getpid());
+    LOG_INFO("=== PROCESSO PRICE UPDATER MELHORADO INICIADO (PID: %d) ===\n", getpid());
     
     // Anexar memória compartilhada
     TradingSystem* sistema = (TradingSystem*)shmat(shm_id, NULL, 0);
@@ -209,24 +180,19 @@ void processo_price_updater_melhorado() {
         exit(1);
     }
     
-    // Inicializar arquivo de histórico
-    inicializar_arquivo_historico();
-    
-    printf("Price Updater melhorado iniciado com configurações:\n");
-    printf("- Variação máxima: %.1f%%\n", MAX_VARIACAO_PRECO * 100);
-    printf("- Preço mínimo: R$ %.2f\n", MIN_PRECO_ACAO);
-    printf("- Preço máximo: R$ %.2f\n", MAX_PRECO_ACAO);
-    printf("- Peso transação: %.1f%%\n", PESO_ULTIMA_TRANSACAO * 100);
-    printf("- Peso preço atual: %.1f%%\n", PESO_PRECO_ATUAL * 100);
-    printf("- Arquivo histórico: %s\n", ARQUIVO_HISTORICO);
+    LOG_INFO("Price Updater melhorado iniciado com configurações:\n");
+    LOG_INFO("- Variação máxima: %d%%\n", MAX_VARIACAO_PRECO);
+    LOG_INFO("- Preço mínimo: R$ %.2f\n", PRECO_EM_REAIS(MIN_PRECO_ACAO));
+    LOG_INFO("- Preço máximo: R$ %.2f\n", PRECO_EM_REAIS(MAX_PRECO_ACAO));
+    LOG_INFO("- Peso transação: %d%%\n", PESO_ULTIMA_TRANSACAO);
+    LOG_INFO("- Peso preço atual: %d%%\n", PESO_PRECO_ATUAL);
+    LOG_INFO("- Histórico de ticks: %s\n", historico_ticks_ativo() ? "ativo" : "desativado");
     
     // Configurar poll para leitura de pipes
     struct pollfd pfd;
     pfd.fd = pipes->executor_to_price_updater[0]; // Pipe de leitura do executor
     pfd.events = POLLIN;
     
-    int contador_snapshot = 0;
-    
     while (sistema->sistema_ativo) {
         // Verificar se há notificações de transações
         int poll_result = poll(&pfd, 1, 100); // 100ms timeout
@@ -238,17 +204,17 @@ void processo_price_updater_melhorado() {
             int notificacao_recebida = receber_notificacao_transacao(pipes->executor_to_price_updater[0], &ordem, &resultado);
             
             if (notificacao_recebida) {
-                printf("PRICE UPDATER: Notificação recebida - Trader %d, Ação %d, Resultado: %s\n", 
+                LOG_DEBUG("PRICE UPDATER: Notificação recebida - Trader %d, Ação %d, Resultado: %s\n", 
                        ordem.trader_id, ordem.acao_id, resultado ? "ACEITA" : "REJEITADA");
                 
                 if (resultado) { // Ordem aceita
                     // Calcular novo preço usando média ponderada
                     Acao* acao = &sistema->acoes[ordem.acao_id];
-                    double preco_anterior = acao->preco_atual;
-                    double preco_transacao = ordem.preco;
+                    preco_t preco_anterior = acao->preco_atual;
+                    preco_t preco_transacao = ordem.preco;
                     int volume = ordem.quantidade;
                     
-                    double novo_preco = calcular_preco_media_ponderada(preco_anterior, preco_transacao, volume);
+                    preco_t novo_preco = calcular_preco_media_ponderada(preco_anterior, preco_transacao, volume);
                     
                     // Validar preço
                     if (validar_preco(novo_preco, preco_anterior)) {
@@ -256,7 +222,7 @@ void processo_price_updater_melhorado() {
                         atualizar_estatisticas_acao(sistema, ordem.acao_id, novo_preco);
                         
                         // Log da atualização
-                        log_atualizacao_preco(ordem.acao_id, preco_anterior, novo_preco, "Transação executada");
+                        log_atualizacao_preco(sistema, ordem.acao_id, preco_anterior, novo_preco, MOTIVO_TICK_EXECUCAO);
                         
                         // Enviar atualização para arbitrage monitor
                         enviar_atualizacao_arbitragem(pipes->price_updater_to_arbitrage[1], 
@@ -265,7 +231,7 @@ void processo_price_updater_melhorado() {
                         atualizacoes_validas++;
                     } else {
                         // Manter preço anterior se inválido
-                        printf("PRICE UPDATER: Preço inválido, mantendo preço anterior\n");
+                        LOG_DEBUG("PRICE UPDATER: Preço inválido, mantendo preço anterior\n");
                         atualizacoes_rejeitadas++;
                     }
                     
@@ -284,15 +250,15 @@ void processo_price_updater_melhorado() {
             // Atualizar preços de todas as ações
             for (int i = 0; i < sistema->num_acoes; i++) {
                 Acao* acao = &sistema->acoes[i];
-                double preco_anterior = acao->preco_atual;
+                preco_t preco_anterior = acao->preco_atual;
                 
-                // Simular variação de mercado
-                double variacao = (rand() % 200 - 100) / 10000.0; // ±1%
-                double novo_preco = preco_anterior * (1.0 + variacao);
+                // Simular variação de mercado (em centésimos de ponto percentual)
+                int variacao = aleatorio_proximo() % 200 - 100; // ±1%
+                preco_t novo_preco = preco_anterior + preco_anterior * variacao / 10000;
                 
                 if (validar_preco(novo_preco, preco_anterior)) {
                     atualizar_estatisticas_acao(sistema, i, novo_preco);
-                    log_atualizacao_preco(i, preco_anterior, novo_preco, "Variação de mercado");
+                    log_atualizacao_preco(sistema, i, preco_anterior, novo_preco, MOTIVO_TICK_VARIACAO);
                     atualizacoes_validas++;
                 } else {
                     atualizacoes_rejeitadas++;
@@ -300,14 +266,11 @@ void processo_price_updater_melhorado() {
                 
                 total_atualizacoes++;
             }
+            registrar_amostra_correlacao(sistema);
             
-            // Salvar snapshot a cada 10 atualizações periódicas
-            contador_snapshot++;
-            if (contador_snapshot >= 10) {
-                salvar_historico_precos(sistema);
-                contador_snapshot = 0;
-                printf("PRICE UPDATER: Snapshot salvo no arquivo de histórico\n");
-            }
+            // Gravar os ticks pendentes a cada atualização periódica: o
+            // processo é encerrado com SIGTERM e perderia o que está no buffer
+            historico_ticks_descarregar();
         }
         
         // Pequena pausa para não sobrecarregar
@@ -315,17 +278,17 @@ void processo_price_updater_melhorado() {
     }
     
     // Estatísticas finais
-    printf("=== PRICE UPDATER MELHORADO FINALIZADO ===\n");
-    printf("Total de atualizações: %d\n", total_atualizacoes);
-    printf("Atualizações válidas: %d (%.1f%%)\n", atualizacoes_validas,
+    LOG_INFO("=== PRICE UPDATER MELHORADO FINALIZADO ===\n");
+    LOG_INFO("Total de atualizações: %d\n", total_atualizacoes);
+    LOG_INFO("Atualizações válidas: %d (%.1f%%)\n", atualizacoes_validas,
            total_atualizacoes > 0 ? (double)atualizacoes_validas / total_atualizacoes * 100 : 0);
-    printf("Atualizações rejeitadas: %d (%.1f%%)\n", atualizacoes_rejeitadas,
+    LOG_INFO("Atualizações rejeitadas: %d (%.1f%%)\n", atualizacoes_rejeitadas,
            total_atualizacoes > 0 ? (double)atualizacoes_rejeitadas / total_atualizacoes * 100 : 0);
-    printf("Notificações recebidas: %d\n", notificacoes_recebidas);
+    LOG_INFO("Notificações recebidas: %d\n", notificacoes_recebidas);
     
-    // Salvar snapshot final
-    salvar_historico_precos(sistema);
-    printf("PRICE UPDATER: Snapshot final salvo\n");
+    // Gravar os ticks pendentes
+    historico_ticks_descarregar();
+    LOG_INFO("PRICE UPDATER: Histórico de ticks gravado\n");
     
     // Desanexar memória compartilhada
     shmdt(sistema);
@@ -217,8 +217,8 @@ EstadoComparacao* comparar_estados_esperados_observados(TradingSystem* sistema,
         Acao* acao = &sistema->acoes[i];
         
         // Calcular preço esperado baseado em operações anteriores
-        double preco_esperado = acao->preco_atual; // Simplificado
-        double preco_observado = acao->preco_atual;
+        double preco_esperado = PRECO_EM_REAIS(acao->preco_atual); // Simplificado
+        double preco_observado = PRECO_EM_REAIS(acao->preco_atual);
         
         // Calcular volume esperado
         int volume_esperado = acao->volume_total;
@@ -0,0 +1,235 @@
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#include "trading_system.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Replay de ticks gravados (backtest)
+// A única fonte de preços do sistema era a variação aleatória do price
+// updater. Aqui um histórico gravado por historico_ticks.c volta a entrar no
+// sistema: os ticks são aplicados aos preços pelo price updater (ou pela
+// simulação, no relógio virtual) no lugar da variação aleatória, e os
+// traders reagem a eles como a preços vivos; as ordens seguem o caminho
+// normal até os executores e as execuções continuam mexendo nos preços.
+// O arquivo não é copiado: os registros são lidos direto do mapeamento.
+
+// Replay do sistema (versão threads, TRADING_REPLAY)
+static FonteReplay fonte_sistema;
+static int replay_sistema_ativo = 0;
+
+static long long tempo_monotonico_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Função para mapear um histórico de ticks para replay
+// velocidade: 1 = ritmo gravado, 10 = dez vezes mais rápido, 0 = sem espera
+// Retorna 1 em sucesso, 0 se o arquivo não abre ou não é um histórico de ticks
+int replay_abrir(FonteReplay* replay, const char* caminho, double velocidade) {
+    memset(replay, 0, sizeof(FonteReplay));
+    replay->velocidade = velocidade > 0.0 ? velocidade : 0.0;
+    replay->fd = open(caminho, O_RDONLY);
+    if (replay->fd < 0) {
+        perror("Erro ao abrir histórico de ticks para replay");
+        return 0;
+    }
+
+    struct stat info;
+    if (fstat(replay->fd, &info) < 0 || info.st_size < (off_t)sizeof(CabecalhoHistoricoTicks)) {
+        printf("Erro: %s não é um histórico de ticks\n", caminho);
+        close(replay->fd);
+        return 0;
+    }
+
+    replay->tamanho_mapa = info.st_size;
+    replay->mapa = mmap(NULL, replay->tamanho_mapa, PROT_READ, MAP_PRIVATE, replay->fd, 0);
+    if (replay->mapa == MAP_FAILED) {
+        perror("Erro ao mapear histórico de ticks");
+        close(replay->fd);
+        return 0;
+    }
+
+    if (!cabecalho_ticks_valido((const CabecalhoHistoricoTicks*)replay->mapa)) {
+        printf("Erro: %s não é um histórico de ticks compatível\n", caminho);
+        munmap(replay->mapa, replay->tamanho_mapa);
+        close(replay->fd);
+        return 0;
+    }
+
+    // Leitura sequencial: o kernel lê adiante e descarta atrás
+    madvise(replay->mapa, replay->tamanho_mapa, MADV_SEQUENTIAL);
+
+    replay->registros = (const RegistroTick*)((const char*)replay->mapa + sizeof(CabecalhoHistoricoTicks));
+    replay->total = (info.st_size - (long long)sizeof(CabecalhoHistoricoTicks)) / (long long)sizeof(RegistroTick);
+    if (replay->total > 0) {
+        replay->primeiro_instante_ns = replay->registros[0].instante_ns;
+    }
+    return 1;
+}
+
+void replay_fechar(FonteReplay* replay) {
+    if (replay->mapa && replay->mapa != MAP_FAILED) {
+        munmap(replay->mapa, replay->tamanho_mapa);
+        close(replay->fd);
+    }
+    replay->mapa = NULL;
+    replay->registros = NULL;
+}
+
+// Função para ver o próximo tick sem consumi-lo (NULL no fim)
+const RegistroTick* replay_espiar(const FonteReplay* replay) {
+    if (replay->proximo >= replay->total) {
+        return NULL;
+    }
+    return &replay->registros[replay->proximo];
+}
+
+// Função para consumir o próximo tick (NULL no fim)
+// A cada DESCARTE_REPLAY_BYTES lidos as páginas anteriores são devolvidas
+const RegistroTick* replay_proximo(FonteReplay* replay) {
+    const RegistroTick* registro = replay_espiar(replay);
+    if (!registro) {
+        return NULL;
+    }
+    replay->proximo++;
+
+    long long consumidos = sizeof(CabecalhoHistoricoTicks) + replay->proximo * (long long)sizeof(RegistroTick);
+    if (consumidos - replay->descartado_ate >= DESCARTE_REPLAY_BYTES) {
+        long long pagina = sysconf(_SC_PAGESIZE);
+        long long ate = consumidos / pagina * pagina;
+        madvise((char*)replay->mapa + replay->descartado_ate, ate - replay->descartado_ate, MADV_DONTNEED);
+        replay->descartado_ate = ate;
+    }
+    return registro;
+}
+
+// Função para obter o intervalo gravado entre o primeiro e o último tick
+long long replay_duracao_ns(const FonteReplay* replay) {
+    if (replay->total == 0) {
+        return 0;
+    }
+    return replay->registros[replay->total - 1].instante_ns - replay->primeiro_instante_ns;
+}
+
+int replay_concluido(const FonteReplay* replay) {
+    return replay->proximo >= replay->total;
+}
+
+// Função para encontrar a ação do tick: pelo id gravado se o símbolo
+// confere, senão pelo símbolo
+static int acao_do_tick(TradingSystem* sistema, const RegistroTick* registro) {
+    int id = registro->acao_id;
+    if (id < sistema->num_acoes &&
+        strncmp(sistema->acoes[id].nome, registro->simbolo, TAMANHO_SIMBOLO_TICK) == 0) {
+        return id;
+    }
+    for (int i = 0; i < sistema->num_acoes; i++) {
+        if (strncmp(sistema->acoes[i].nome, registro->simbolo, TAMANHO_SIMBOLO_TICK) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Função para aplicar um tick ao preço da ação
+// Retorna 1 se o preço foi atualizado
+int replay_aplicar_tick(TradingSystem* sistema, FonteReplay* replay, const RegistroTick* registro) {
+    int acao_id = acao_do_tick(sistema, registro);
+    if (acao_id < 0 || registro->preco_novo <= 0) {
+        replay->ignorados++;
+        return 0;
+    }
+
+    preco_t preco_anterior = ler_preco_atual(&sistema->acoes[acao_id]);
+    atualizar_estatisticas_acao(sistema, acao_id, registro->preco_novo);
+    log_atualizacao_preco(sistema, acao_id, preco_anterior, registro->preco_novo, registro->motivo);
+    replay->aplicados++;
+    return 1;
+}
+
+// Função para aplicar os ticks que já venceram no ritmo do replay
+// (todos, até max_ticks, com velocidade 0). Em ms_ate_proximo fica a espera
+// até o próximo tick (0: já venceu; -1: replay concluído).
+// Retorna o número de preços atualizados
+int replay_avancar(TradingSystem* sistema, FonteReplay* replay, int max_ticks, int* ms_ate_proximo) {
+    long long agora = tempo_monotonico_ns();
+    if (replay->inicio_real_ns == 0) {
+        replay->inicio_real_ns = agora;
+    }
+
+    int atualizadas = 0;
+    int aplicados = 0;
+    *ms_ate_proximo = -1;
+    const RegistroTick* registro;
+    while ((registro = replay_espiar(replay)) != NULL) {
+        if (aplicados == max_ticks) {
+            *ms_ate_proximo = 0;
+            break;
+        }
+        if (replay->velocidade > 0.0) {
+            long long alvo = replay->inicio_real_ns +
+                (long long)((registro->instante_ns - replay->primeiro_instante_ns) / replay->velocidade);
+            if (alvo > agora) {
+                *ms_ate_proximo = (int)((alvo - agora + 999999) / 1000000);
+                break;
+            }
+        }
+        replay_proximo(replay);
+        atualizadas += replay_aplicar_tick(sistema, replay, registro);
+        aplicados++;
+    }
+
+    if (replay_concluido(replay) && replay->fim_real_ns == 0) {
+        replay->fim_real_ns = tempo_monotonico_ns();
+    }
+    return atualizadas;
+}
+
+// Função para imprimir o resumo do replay
+void imprimir_resultado_replay(const FonteReplay* replay) {
+    printf("\n=== REPLAY DE TICKS ===\n");
+    printf("Ticks aplicados: %lld de %lld (%lld ignorados)\n", replay->aplicados, replay->total, replay->ignorados);
+    printf("Intervalo gravado: %.1f s\n", replay_duracao_ns(replay) / 1e9);
+    if (replay->velocidade > 0.0) {
+        printf("Velocidade: %.1fx o ritmo gravado\n", replay->velocidade);
+    } else {
+        printf("Velocidade: máxima\n");
+    }
+    if (replay->fim_real_ns > replay->inicio_real_ns && replay->inicio_real_ns > 0) {
+        double segundos = (replay->fim_real_ns - replay->inicio_real_ns) / 1e9;
+        printf("Tempo real: %.3f s (%.0f ticks/s)\n", segundos, replay->aplicados / segundos);
+    }
+}
+
+// Função para iniciar o replay do arquivo em TRADING_REPLAY
+// (TRADING_REPLAY_VELOCIDADE: 1 = ritmo gravado, padrão; 0 = máxima)
+// Retorna a fonte, ou NULL sem replay
+FonteReplay* replay_iniciar_do_ambiente() {
+    const char* caminho = getenv("TRADING_REPLAY");
+    if (!caminho || caminho[0] == '\0') {
+        return NULL;
+    }
+    double velocidade = 1.0;
+    const char* env_velocidade = getenv("TRADING_REPLAY_VELOCIDADE");
+    if (env_velocidade) {
+        velocidade = atof(env_velocidade);
+    }
+    if (!replay_abrir(&fonte_sistema, caminho, velocidade)) {
+        return NULL;
+    }
+    replay_sistema_ativo = 1;
+    return &fonte_sistema;
+}
+
+// Função para obter o replay do sistema (NULL sem replay)
+FonteReplay* replay_sistema() {
+    return replay_sistema_ativo ? &fonte_sistema : NULL;
+}
+
+void replay_finalizar_sistema() {
+    if (replay_sistema_ativo) {
+        replay_sistema_ativo = 0;
+        replay_fechar(&fonte_sistema);
+    }
+}
@@ -0,0 +1,487 @@
+#include "trading_system.h"
+
+// Simulação de eventos discretos com relógio virtual
+// Os mesmos estágios das threads (traders -> executor -> price updater ->
+// arbitrage monitor, mais o detector de arbitragem) rodam como eventos de uma
+// fila de prioridade. Em vez de sleep/usleep o relógio virtual salta para o
+// próximo evento, então uma sessão de 5 minutos (ou um pregão inteiro) roda em
+// milissegundos e, com a mesma semente, sempre produz o mesmo resultado.
+
+#define NS_POR_MS 1000000LL
+#define NS_POR_S 1000000000LL
+#define INTERVALO_VARIACAO_SIMULADA_MS 3000   // Mesmo período do price updater
+#define INTERVALO_ARBITRAGEM_SIMULADA_MS 5000 // Mesmo período do arbitrage monitor
+#define INTERVALO_DETECTOR_SIMULADO_MS 3000   // Mesmo período do detector de arbitragem
+
+// Sessão de um trader no relógio virtual
+typedef struct {
+    PerfilTrader* perfil;
+    long long inicio_sessao_ns;
+    int ordens_sessao;
+} TraderSimulado;
+
+// Execução ainda não refletida no preço da ação (executor -> price updater)
+typedef struct {
+    int pendente;
+    preco_t preco;
+    int volume;
+    int negocios; // Negócios da ação na sessão (não zera ao refletir no preço)
+} ExecucaoSimulada;
+
+// Estado da sessão simulada (uma simulação por vez)
+static FilaEventosSimulacao fila_eventos;
+static TraderSimulado traders_simulados[MAX_TRADERS];
+static Ordem fila_ordens_simulada[CAPACIDADE_FILA_LOCKFREE]; // Fila do executor (anel)
+static int inicio_fila_simulada = 0;
+static int tamanho_fila_simulada = 0;
+static Ordem lote_em_processamento[TAMANHO_MAX_LOTE_EXECUTOR];
+static int tamanho_lote_em_processamento = 0;
+static int tempo_lote_em_processamento = 0;
+static int executor_ocupado = 0;
+static ExecucaoSimulada execucoes_simuladas[MAX_ACOES];
+static int evento_preco_agendado = 0;
+static int evento_arbitragem_agendado = 0;
+static ResultadoSimulacao* resultado_atual = NULL;
+static FonteReplay* replay_atual = NULL;
+
+// Função para comparar eventos (instante, depois ordem de agendamento)
+static int evento_anterior(const EventoSimulacao* a, const EventoSimulacao* b) {
+    if (a->instante_ns != b->instante_ns) {
+        return a->instante_ns < b->instante_ns;
+    }
+    return a->sequencia < b->sequencia;
+}
+
+// Função para inicializar a fila de eventos
+int fila_eventos_inicializar(FilaEventosSimulacao* fila, int capacidade_inicial) {
+    if (capacidade_inicial < 16) capacidade_inicial = 16;
+    fila->eventos = malloc(sizeof(EventoSimulacao) * capacidade_inicial);
+    if (!fila->eventos) {
+        return 0;
+    }
+    fila->tamanho = 0;
+    fila->capacidade = capacidade_inicial;
+    fila->proxima_sequencia = 0;
+    return 1;
+}
+
+// Função para liberar a fila de eventos
+void fila_eventos_liberar(FilaEventosSimulacao* fila) {
+    free(fila->eventos);
+    fila->eventos = NULL;
+    fila->tamanho = 0;
+    fila->capacidade = 0;
+}
+
+// Função para agendar evento (sobe no heap)
+int fila_eventos_agendar(FilaEventosSimulacao* fila, long long instante_ns, int tipo, int id) {
+    if (fila->tamanho == fila->capacidade) {
+        int nova_capacidade = fila->capacidade * 2;
+        EventoSimulacao* eventos = realloc(fila->eventos, sizeof(EventoSimulacao) * nova_capacidade);
+        if (!eventos) {
+            return 0;
+        }
+        fila->eventos = eventos;
+        fila->capacidade = nova_capacidade;
+    }
+
+    EventoSimulacao evento = {instante_ns, fila->proxima_sequencia++, tipo, id};
+    int i = fila->tamanho++;
+    while (i > 0) {
+        int pai = (i - 1) / 2;
+        if (!evento_anterior(&evento, &fila->eventos[pai])) break;
+        fila->eventos[i] = fila->eventos[pai];
+        i = pai;
+    }
+    fila->eventos[i] = evento;
+    return 1;
+}
+
+// Função para retirar o próximo evento (desce no heap)
+// Retorna 0 se a fila estiver vazia
+int fila_eventos_retirar(FilaEventosSimulacao* fila, EventoSimulacao* evento) {
+    if (fila->tamanho == 0) {
+        return 0;
+    }
+    *evento = fila->eventos[0];
+
+    EventoSimulacao ultimo = fila->eventos[--fila->tamanho];
+    int i = 0;
+    for (;;) {
+        int filho = 2 * i + 1;
+        if (filho >= fila->tamanho) break;
+        if (filho + 1 < fila->tamanho && evento_anterior(&fila->eventos[filho + 1], &fila->eventos[filho])) {
+            filho++;
+        }
+        if (!evento_anterior(&fila->eventos[filho], &ultimo)) break;
+        fila->eventos[i] = fila->eventos[filho];
+        i = filho;
+    }
+    if (fila->tamanho > 0) {
+        fila->eventos[i] = ultimo;
+    }
+    return 1;
+}
+
+// Callback do livro: acumula o negócio para o price updater simulado
+static void registrar_execucao_simulada(const Negocio* negocio, void* contexto) {
+    (void)contexto;
+    ExecucaoSimulada* execucao = &execucoes_simuladas[negocio->acao_id];
+    if (!execucao->pendente) {
+        execucao->pendente = 1;
+        execucao->volume = 0;
+    }
+    execucao->preco = negocio->preco;
+    execucao->volume += negocio->quantidade;
+    execucao->negocios++;
+    resultado_atual->negocios++;
+}
+
+// Função para agendar o arbitrage monitor após preços novos
+static void publicar_preco_simulado(long long agora) {
+    if (!evento_arbitragem_agendado) {
+        evento_arbitragem_agendado = 1;
+        fila_eventos_agendar(&fila_eventos, agora, EVENTO_SIM_ARBITRAGEM, 1);
+    }
+}
+
+// Função para retirar o próximo lote da fila do executor e agendar seu término
+static void iniciar_lote_simulado(long long agora) {
+    tamanho_lote_em_processamento = 0;
+    while (tamanho_fila_simulada > 0 && tamanho_lote_em_processamento < TAMANHO_MAX_LOTE_EXECUTOR) {
+        lote_em_processamento[tamanho_lote_em_processamento++] = fila_ordens_simulada[inicio_fila_simulada];
+        inicio_fila_simulada = (inicio_fila_simulada + 1) % CAPACIDADE_FILA_LOCKFREE;
+        tamanho_fila_simulada--;
+    }
+    if (tamanho_lote_em_processamento == 0) {
+        executor_ocupado = 0;
+        return;
+    }
+
+    // O tempo de processamento avança o relógio virtual em vez de usleep
+    executor_ocupado = 1;
+    tempo_lote_em_processamento = sortear_tempo_processamento();
+    fila_eventos_agendar(&fila_eventos, agora + tempo_lote_em_processamento * NS_POR_MS, EVENTO_SIM_EXECUTOR, 0);
+}
+
+// Evento do trader: mesma decisão da thread trader, sem sleep entre ordens
+static void processar_evento_trader(TradingSystem* sistema, int trader_id, long long agora) {
+    TraderSimulado* trader = &traders_simulados[trader_id];
+    PerfilTrader* perfil = trader->perfil;
+
+    // Sessão esgotada (tempo ou ordens): o trader abre uma nova sessão
+    if (agora - trader->inicio_sessao_ns > perfil->tempo_limite_sessao * NS_POR_S ||
+        trader->ordens_sessao >= perfil->max_ordens_por_sessao) {
+        trader->inicio_sessao_ns = agora;
+        trader->ordens_sessao = 0;
+        resultado_atual->sessoes_traders++;
+    }
+
+    Ordem ordem;
+    if (montar_ordem_trader(sistema, trader_id, perfil, &ordem) &&
+        tamanho_fila_simulada < CAPACIDADE_FILA_LOCKFREE) {
+        int posicao = (inicio_fila_simulada + tamanho_fila_simulada) % CAPACIDADE_FILA_LOCKFREE;
+        fila_ordens_simulada[posicao] = ordem;
+        tamanho_fila_simulada++;
+        trader->ordens_sessao++;
+        resultado_atual->ordens_enviadas++;
+
+        if (!executor_ocupado) {
+            iniciar_lote_simulado(agora);
+        }
+    }
+
+    int intervalo = gerar_intervalo_aleatorio(perfil->intervalo_min_ordens, perfil->intervalo_max_ordens);
+    fila_eventos_agendar(&fila_eventos, agora + intervalo * NS_POR_S, EVENTO_SIM_TRADER, trader_id);
+}
+
+// Evento do executor: processa o lote que terminou e retira o próximo
+static void processar_evento_executor(TradingSystem* sistema, long long agora) {
+    registrar_tamanho_lote(0, tamanho_lote_em_processamento); // 0 = threads
+    int negocios_antes = resultado_atual->negocios;
+
+    for (int i = 0; i < tamanho_lote_em_processamento; i++) {
+        if (processar_ordem_executor(sistema, &lote_em_processamento[i], tempo_lote_em_processamento,
+                                     registrar_execucao_simulada, NULL)) {
+            resultado_atual->ordens_aceitas++;
+        } else {
+            resultado_atual->ordens_rejeitadas++;
+        }
+    }
+
+    if (resultado_atual->negocios > negocios_antes && !evento_preco_agendado) {
+        evento_preco_agendado = 1;
+        fila_eventos_agendar(&fila_eventos, agora, EVENTO_SIM_PRECO, 0);
+    }
+
+    iniciar_lote_simulado(agora);
+}
+
+// Evento do price updater: reflete as execuções pendentes nos preços
+static void processar_evento_preco(TradingSystem* sistema, long long agora) {
+    evento_preco_agendado = 0;
+
+    int atualizadas = 0;
+    for (int i = 0; i < sistema->num_acoes && i < MAX_ACOES; i++) {
+        ExecucaoSimulada* execucao = &execucoes_simuladas[i];
+        if (!execucao->pendente) continue;
+        execucao->pendente = 0;
+        atualizadas += aplicar_execucao_preco(sistema, i, execucao->preco, execucao->volume);
+    }
+
+    resultado_atual->atualizacoes_preco += atualizadas;
+    if (atualizadas > 0) {
+        publicar_preco_simulado(agora);
+    }
+}
+
+// Função para obter o instante virtual de um tick gravado (o primeiro é o zero)
+static long long instante_virtual_tick(const RegistroTick* registro) {
+    return registro->instante_ns - replay_atual->primeiro_instante_ns;
+}
+
+// Evento do replay: aplica os ticks gravados que vencem até agora e agenda o
+// próximo (ticks fora de ordem no arquivo entram no instante atual)
+static void processar_evento_replay(TradingSystem* sistema, long long agora) {
+    int atualizadas = 0;
+    const RegistroTick* registro;
+    while ((registro = replay_espiar(replay_atual)) != NULL && instante_virtual_tick(registro) <= agora) {
+        replay_proximo(replay_atual);
+        atualizadas += replay_aplicar_tick(sistema, replay_atual, registro);
+    }
+
+    resultado_atual->atualizacoes_preco += atualizadas;
+    if (atualizadas > 0) {
+        publicar_preco_simulado(agora);
+    }
+    if (registro) {
+        fila_eventos_agendar(&fila_eventos, instante_virtual_tick(registro), EVENTO_SIM_REPLAY, 0);
+    }
+}
+
+// Função para processar um evento da fila
+// Retorna 0 no fim da sessão
+static int processar_evento_simulacao(TradingSystem* sistema, const EventoSimulacao* evento) {
+    long long agora = evento->instante_ns;
+
+    switch (evento->tipo) {
+        case EVENTO_SIM_TRADER:
+            processar_evento_trader(sistema, evento->id, agora);
+            break;
+
+        case EVENTO_SIM_EXECUTOR:
+            processar_evento_executor(sistema, agora);
+            break;
+
+        case EVENTO_SIM_PRECO:
+            processar_evento_preco(sistema, agora);
+            break;
+
+        case EVENTO_SIM_VARIACAO: {
+            int atualizadas = aplicar_variacao_mercado(sistema);
+            resultado_atual->atualizacoes_preco += atualizadas;
+            if (atualizadas > 0) {
+                publicar_preco_simulado(agora);
+            }
+            fila_eventos_agendar(&fila_eventos, agora + INTERVALO_VARIACAO_SIMULADA_MS * NS_POR_MS,
+                                 EVENTO_SIM_VARIACAO, 0);
+            break;
+        }
+
+        case EVENTO_SIM_ARBITRAGEM:
+            monitorar_arbitragem(sistema);
+            detectar_padroes_preco(sistema);
+            resultado_atual->ciclos_arbitragem++;
+
+            if (evento->id == 1) {
+                evento_arbitragem_agendado = 0;
+            } else {
+                // Ciclo periódico: simular eventos de mercado ocasionalmente
+                if (aleatorio_proximo() % 100 < 5) { // 5% de chance
+                    simular_evento_mercado(sistema);
+                }
+                fila_eventos_agendar(&fila_eventos, agora + INTERVALO_ARBITRAGEM_SIMULADA_MS * NS_POR_MS,
+                                     EVENTO_SIM_ARBITRAGEM, 0);
+            }
+            break;
+
+        case EVENTO_SIM_DETECTOR:
+            detectar_oportunidades_arbitragem(sistema);
+            processar_oportunidades_pendentes(sistema);
+            fila_eventos_agendar(&fila_eventos, agora + INTERVALO_DETECTOR_SIMULADO_MS * NS_POR_MS,
+                                 EVENTO_SIM_DETECTOR, 0);
+            break;
+
+        case EVENTO_SIM_REPLAY:
+            processar_evento_replay(sistema, agora);
+            break;
+
+        case EVENTO_SIM_FIM:
+            return 0;
+    }
+    return 1;
+}
+
+// Função para executar uma sessão simulada de duracao_s segundos virtuais
+// O sistema deve vir de inicializar_sistema(); livros, perfis e estatísticas
+// de arbitragem são inicializados aqui. Retorna 1 em caso de sucesso
+int executar_simulacao(TradingSystem* sistema, unsigned long long semente, int duracao_s, ResultadoSimulacao* resultado) {
+    return executar_simulacao_replay(sistema, semente, duracao_s, NULL, resultado);
+}
+
+// Função para contar saldos e carteiras negativos (ou menores que o reservado)
+// As reservas garantem que nenhum negócio gaste o que o trader não tem
+static int contar_posicoes_negativas(TradingSystem* sistema) {
+    int negativas = 0;
+    for (int i = 0; i < sistema->num_traders && i < MAX_TRADERS; i++) {
+        Trader* trader = &sistema->traders[i];
+        negativas += trader->saldo < 0 || trader->saldo_reservado < 0 ||
+                     trader->saldo < trader->saldo_reservado;
+        for (int j = 0; j < sistema->num_acoes; j++) {
+            negativas += trader->acoes_possuidas[j] < 0 || trader->acoes_reservadas[j] < 0 ||
+                         trader->acoes_possuidas[j] < trader->acoes_reservadas[j];
+        }
+    }
+    return negativas;
+}
+
+// Função para executar uma sessão simulada com os preços de um replay
+// (backtest): os ticks gravados entram no relógio virtual no lugar da
+// variação aleatória, o mais rápido possível. Sem replay é a sessão normal.
+// duracao_s <= 0 com replay: até o último tick gravado
+int executar_simulacao_replay(TradingSystem* sistema, unsigned long long semente, int duracao_s,
+                              FonteReplay* replay, ResultadoSimulacao* resultado) {
+    if (replay && duracao_s <= 0) {
+        duracao_s = (int)(replay_duracao_ns(replay) / NS_POR_S) + 1;
+    }
+    if (!sistema || duracao_s <= 0 || !fila_eventos_inicializar(&fila_eventos, 64)) {
+        return 0;
+    }
+
+    struct timespec inicio_real, fim_real;
+    get_monotonic_time(&inicio_real);
+
+    memset(resultado, 0, sizeof(ResultadoSimulacao));
+    resultado->duracao_virtual_s = duracao_s;
+    resultado_atual = resultado;
+    replay_atual = replay;
+    long long aplicados_antes = 0;
+    if (replay) {
+        aplicados_antes = replay->aplicados;
+        replay->velocidade = 0.0; // O relógio virtual não espera pelos ticks
+    }
+
+    aleatorio_configurar_semente(semente);
+    definir_relogio_virtual(0);
+    inicializar_livros_ordens(sistema);
+    inicializar_perfis_trader();
+    inicializar_estatisticas_arbitragem();
+    barras_reiniciar();
+
+    inicio_fila_simulada = 0;
+    tamanho_fila_simulada = 0;
+    tamanho_lote_em_processamento = 0;
+    executor_ocupado = 0;
+    evento_preco_agendado = 0;
+    evento_arbitragem_agendado = 0;
+    memset(execucoes_simuladas, 0, sizeof(execucoes_simuladas));
+
+    // Mesma distribuição de perfis de iniciar_threads()
+    for (int i = 0; i < sistema->num_traders && i < MAX_TRADERS; i++) {
+        traders_simulados[i].perfil = obter_perfil_trader(i % 3);
+        traders_simulados[i].inicio_sessao_ns = 0;
+        traders_simulados[i].ordens_sessao = 0;
+        resultado->sessoes_traders++;
+        fila_eventos_agendar(&fila_eventos, 0, EVENTO_SIM_TRADER, i);
+    }
+    if (replay) {
+        const RegistroTick* primeiro = replay_espiar(replay);
+        if (primeiro) {
+            fila_eventos_agendar(&fila_eventos, instante_virtual_tick(primeiro), EVENTO_SIM_REPLAY, 0);
+        }
+    } else {
+        fila_eventos_agendar(&fila_eventos, INTERVALO_VARIACAO_SIMULADA_MS * NS_POR_MS, EVENTO_SIM_VARIACAO, 0);
+    }
+    fila_eventos_agendar(&fila_eventos, 0, EVENTO_SIM_ARBITRAGEM, 0);
+    fila_eventos_agendar(&fila_eventos, 0, EVENTO_SIM_DETECTOR, 0);
+    fila_eventos_agendar(&fila_eventos, duracao_s * NS_POR_S, EVENTO_SIM_FIM, 0);
+
+    EventoSimulacao evento;
+    while (fila_eventos_retirar(&fila_eventos, &evento)) {
+        definir_relogio_virtual(evento.instante_ns);
+        resultado->eventos_processados++;
+        if (!processar_evento_simulacao(sistema, &evento)) {
+            break;
+        }
+    }
+
+    definir_relogio_virtual(-1);
+    resultado->posicoes_negativas = contar_posicoes_negativas(sistema);
+    for (int i = 0; i < MAX_ACOES; i++) {
+        resultado->acoes_negociadas += execucoes_simuladas[i].negocios > 0;
+    }
+    liberar_livros_ordens();
+    fila_eventos_liberar(&fila_eventos);
+    resultado_atual = NULL;
+    replay_atual = NULL;
+
+    get_monotonic_time(&fim_real);
+    resultado->tempo_real_ms = calculate_time_diff_ms(inicio_real, fim_real);
+    resultado->assinatura = assinatura_estado_sistema(sistema);
+    if (replay) {
+        resultado->ticks_replay = replay->aplicados - aplicados_antes;
+        replay->inicio_real_ns = (long long)inicio_real.tv_sec * NS_POR_S + inicio_real.tv_nsec;
+        replay->fim_real_ns = (long long)fim_real.tv_sec * NS_POR_S + fim_real.tv_nsec;
+    }
+    return 1;
+}
+
+// Função para misturar um valor no hash FNV-1a de 64 bits
+static unsigned long long misturar_assinatura(unsigned long long hash, long long valor) {
+    for (int i = 0; i < 8; i++) {
+        hash ^= (unsigned long long)(valor >> (i * 8)) & 0xFF;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Função para calcular a assinatura do estado do sistema
+// (duas sessões com a mesma semente devem ter a mesma assinatura)
+unsigned long long assinatura_estado_sistema(TradingSystem* sistema) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (int i = 0; i < sistema->num_acoes; i++) {
+        hash = misturar_assinatura(hash, sistema->acoes[i].preco_atual);
+        hash = misturar_assinatura(hash, sistema->acoes[i].volume_negociado);
+    }
+    for (int i = 0; i < sistema->num_traders; i++) {
+        hash = misturar_assinatura(hash, sistema->traders[i].saldo);
+        for (int j = 0; j < sistema->num_acoes; j++) {
+            hash = misturar_assinatura(hash, sistema->traders[i].acoes_possuidas[j]);
+        }
+    }
+    hash = misturar_assinatura(hash, sistema->executor.ordens_executadas);
+    hash = misturar_assinatura(hash, sistema->executor.ordens_canceladas);
+    return hash;
+}
+
+// Função para imprimir o resultado de uma sessão simulada
+void imprimir_resultado_simulacao(const ResultadoSimulacao* resultado) {
+    printf("\n=== RESULTADO DA SIMULAÇÃO ===\n");
+    printf("Tempo virtual: %d s (%.1f min) em %.1f ms de tempo real (%.0fx)\n",
+           resultado->duracao_virtual_s, resultado->duracao_virtual_s / 60.0, resultado->tempo_real_ms,
+           resultado->tempo_real_ms > 0 ? resultado->duracao_virtual_s * 1000.0 / resultado->tempo_real_ms : 0.0);
+    printf("Eventos processados: %lld\n", resultado->eventos_processados);
+    printf("Ordens: %d enviadas, %d aceitas, %d rejeitadas\n",
+           resultado->ordens_enviadas, resultado->ordens_aceitas, resultado->ordens_rejeitadas);
+    printf("Negócios: %d em %d ações\n", resultado->negocios, resultado->acoes_negociadas);
+    printf("Atualizações de preço: %d\n", resultado->atualizacoes_preco);
+    printf("Ciclos de arbitragem: %d\n", resultado->ciclos_arbitragem);
+    printf("Sessões de traders: %d\n", resultado->sessoes_traders);
+    if (resultado->ticks_replay > 0) {
+        printf("Ticks do replay aplicados: %lld\n", resultado->ticks_replay);
+    }
+    if (resultado->posicoes_negativas > 0) {
+        printf("Posições negativas ao fim: %d\n", resultado->posicoes_negativas);
+    }
+    printf("Assinatura do estado final: %016llx\n", resultado->assinatura);
+}
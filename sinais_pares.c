@@ -0,0 +1,158 @@
+#include "trading_system.h"
+#include <math.h>
+
+// Sinais estatísticos de pares
+// O detector de arbitragem comparava o nível dos preços (calcular_spread:
+// diferença sobre a média), o que não diz nada entre ações de preços
+// diferentes: PETR4 a R$ 30 e VALE3 a R$ 70 ficam sempre acima de 2% e o
+// par sinalizava a cada ciclo. Aqui cada par tem um hedge ratio deslizante
+// (regressão dos log-preços na janela) e o z-score do resíduo, atualizados
+// a cada amostra em O(1) pelas somas da janela; sinal só quando o z-score
+// cruza os limiares de entrada ou saída.
+
+// Função para recalcular as somas varrendo as amostras da janela
+static void recalcular_somas_par(ParZscore* par) {
+    par->sx = par->sy = par->sxx = par->syy = par->sxy = 0.0;
+    for (int k = 0; k < par->tamanho; k++) {
+        double x = par->x[k];
+        double y = par->y[k];
+        par->sx += x;
+        par->sy += y;
+        par->sxx += x * x;
+        par->syy += y * y;
+        par->sxy += x * y;
+    }
+}
+
+// Função para calcular hedge ratio, spread e z-score da amostra (x, y)
+// Retorna 0 se a janela não tem amostras suficientes ou variância
+static int calcular_zscore(ParZscore* par, double x, double y) {
+    int n = par->tamanho;
+    if (n < MIN_AMOSTRAS_ZSCORE) {
+        return 0;
+    }
+
+    // Somas centradas: n·variância e n·covariância da janela
+    double cxx = par->sxx - par->sx * par->sx / n;
+    double cyy = par->syy - par->sy * par->sy / n;
+    double cxy = par->sxy - par->sx * par->sy / n;
+    if (cyy <= 1e-14) {
+        return 0;
+    }
+
+    double hedge = cxy / cyy;
+    double alfa = (par->sx - hedge * par->sy) / n;
+    double residuos = cxx - hedge * cxy; // Soma dos quadrados dos resíduos
+    if (residuos <= 1e-14) {
+        return 0;
+    }
+
+    par->hedge = hedge;
+    par->spread = x - alfa - hedge * y;
+    par->zscore = par->spread / sqrt(residuos / n);
+    return 1;
+}
+
+// Função para decidir a posição depois do z-score novo
+static int proxima_posicao(int posicao, double z, double entrada, double saida) {
+    if (z > entrada) return SINAL_PAR_VENDER_SPREAD;
+    if (z < -entrada) return SINAL_PAR_COMPRAR_SPREAD;
+    if (posicao == SINAL_PAR_VENDER_SPREAD && z < saida) return SINAL_PAR_NEUTRO;
+    if (posicao == SINAL_PAR_COMPRAR_SPREAD && z > -saida) return SINAL_PAR_NEUTRO;
+    return posicao;
+}
+
+// Função para preparar um motor sem pares
+// entrada/saida: limiares de |z-score| (saida < entrada)
+void motor_pares_inicializar(MotorPares* motor, double entrada, double saida) {
+    motor->num_pares = 0;
+    motor->entrada = entrada;
+    motor->saida = saida < entrada ? saida : entrada;
+}
+
+// Função para adicionar um par ao motor
+// Retorna o índice do par, ou -1 se o motor está cheio
+int motor_pares_adicionar(MotorPares* motor, int acao1, int acao2) {
+    if (motor->num_pares >= MAX_PARES_ZSCORE) {
+        return -1;
+    }
+    ParZscore* par = &motor->pares[motor->num_pares];
+    memset(par, 0, sizeof(ParZscore));
+    par->acao1 = acao1;
+    par->acao2 = acao2;
+    return motor->num_pares++;
+}
+
+// Função para inserir uma amostra de preços do par (um tick)
+// Se o z-score cruzou um limiar, preenche 'sinal' e retorna 1
+int motor_pares_atualizar(MotorPares* motor, int par_id, preco_t preco1, preco_t preco2, SinalPar* sinal) {
+    if (par_id < 0 || par_id >= motor->num_pares || preco1 <= 0 || preco2 <= 0) {
+        return 0;
+    }
+    ParZscore* par = &motor->pares[par_id];
+
+    double log1 = log(PRECO_EM_REAIS(preco1));
+    double log2 = log(PRECO_EM_REAIS(preco2));
+    if (par->total_amostras == 0) {
+        par->base1 = log1;
+        par->base2 = log2;
+    }
+    double x = log1 - par->base1;
+    double y = log2 - par->base2;
+
+    // O slot da amostra nova é o da mais antiga (que sai com a janela cheia)
+    int slot = (int)(par->total_amostras % JANELA_PARES_ZSCORE);
+    if (par->tamanho == JANELA_PARES_ZSCORE) {
+        double xa = par->x[slot];
+        double ya = par->y[slot];
+        par->sx -= xa;
+        par->sy -= ya;
+        par->sxx -= xa * xa;
+        par->syy -= ya * ya;
+        par->sxy -= xa * ya;
+    } else {
+        par->tamanho++;
+    }
+    par->x[slot] = x;
+    par->y[slot] = y;
+    par->sx += x;
+    par->sy += y;
+    par->sxx += x * x;
+    par->syy += y * y;
+    par->sxy += x * y;
+    par->total_amostras++;
+
+    // Evitar acúmulo de erro de arredondamento nas subtrações
+    if (par->total_amostras % RECALCULO_ZSCORE == 0) {
+        recalcular_somas_par(par);
+    }
+
+    if (!calcular_zscore(par, x, y)) {
+        return 0;
+    }
+
+    int anterior = par->posicao;
+    par->posicao = proxima_posicao(anterior, par->zscore, motor->entrada, motor->saida);
+    if (par->posicao == anterior) {
+        return 0;
+    }
+
+    if (sinal) {
+        sinal->par = par_id;
+        sinal->tipo = par->posicao;
+        sinal->anterior = anterior;
+        sinal->zscore = par->zscore;
+        sinal->hedge = par->hedge;
+        sinal->spread = par->spread;
+    }
+    return 1;
+}
+
+const char* nome_sinal_par(int tipo) {
+    switch (tipo) {
+        case SINAL_PAR_VENDER_SPREAD: return "vender spread";
+        case SINAL_PAR_COMPRAR_SPREAD: return "comprar spread";
+        case SINAL_PAR_NEUTRO: return "neutro";
+        default: return "desconhecido";
+    }
+}
@@ -1,21 +1,19 @@
+#define _POSIX_C_SOURCE 200809L
 #include "trading_system.h"
 #include <math.h>
 #include <unistd.h>
 
 // Funções de utilidade
 double gerar_preco_aleatorio(double min, double max) {
-    return min + (rand() / (double)RAND_MAX) * (max - min);
+    return min + (aleatorio_proximo() / (double)ALEATORIO_MAX) * (max - min);
 }
 
 int gerar_id_aleatorio() {
-    return rand() % 10000;
+    return aleatorio_proximo() % 10000;
 }
 
 void log_evento(const char* mensagem) {
-    time_t agora = time(NULL);
-    char* timestamp = ctime(&agora);
-    timestamp[strlen(timestamp) - 1] = '\0'; // Remover \n
-    printf("[%s] %s\n", timestamp, mensagem);
+    log_registrar_evento(mensagem);
 }
 
 void limpar_tela() {
@@ -24,8 +22,9 @@ void limpar_tela() {
 
 // Função principal do sistema
 TradingSystem* inicializar_sistema() {
-    TradingSystem* sistema = (TradingSystem*)malloc(sizeof(TradingSystem));
-    if (!sistema) {
+    // Alinhado a uma linha de cache, como as ações que contém (malloc garante só 16 bytes)
+    TradingSystem* sistema = NULL;
+    if (posix_memalign((void**)&sistema, TAMANHO_CACHE_LINE, sizeof(TradingSystem)) != 0) {
         printf("Erro: Falha ao alocar memória para o sistema\n");
         return NULL;
     }
@@ -33,8 +32,8 @@ TradingSystem* inicializar_sistema() {
     // Inicializar variáveis do sistema
     sistema->num_acoes = 0;
     sistema->num_traders = 0;
-    sistema->num_ordens = 0;
     sistema->sistema_ativo = 1;
+    pool_ordens_inicializar(&sistema->ordens, 0);
     
     // Inicializar mutex e semáforo
     pthread_mutex_init(&sistema->mutex_geral, NULL);
@@ -67,6 +66,8 @@ void limpar_sistema(TradingSystem* sistema) {
     pthread_mutex_destroy(&sistema->executor.mutex);
     pthread_mutex_destroy(&sistema->mutex_geral);
     sem_destroy(&sistema->sem_ordens);
+    pool_ordens_liberar(&sistema->ordens);
+    liberar_correlacao_sistema();
     
     free(sistema);
     log_evento("Sistema de trading finalizado");
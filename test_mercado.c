@@ -6,8 +6,8 @@ int main() {
     printf("=== TESTE DO MÓDULO MERCADO ===\n");
     printf("Sistema de Trading - Módulo Mercado\n\n");
     
-    // Inicializar seed do rand
-    srand(time(NULL));
+    // Inicializar semente do gerador aleatório
+    aleatorio_configurar_semente(time(NULL));
     
     // Inicializar sistema
     TradingSystem* sistema = inicializar_sistema();
@@ -45,7 +45,7 @@ int main() {
         
         printf("Operação %d: %s %d ações de %s a R$ %.2f\n", 
                i + 1, (ordem.tipo == 'C') ? "COMPRA" : "VENDA", 
-               ordem.quantidade, sistema->acoes[ordem.acao_id].nome, ordem.preco);
+               ordem.quantidade, sistema->acoes[ordem.acao_id].nome, PRECO_EM_REAIS(ordem.preco));
     }
     
     printf("\n");
@@ -70,13 +70,13 @@ int main() {
         atualizar_estatisticas_mercado(sistema, &ordem);
         
         // Atualizar preço da ação
-        double variacao = (rand() % 200 - 100) / 1000.0; // ±10%
-        double novo_preco = sistema->acoes[ordem.acao_id].preco_atual * (1.0 + variacao);
-        sistema->acoes[ordem.acao_id].preco_atual = novo_preco;
+        double variacao = (aleatorio_proximo() % 200 - 100) / 1000.0; // ±10%
+        double novo_preco = PRECO_EM_REAIS(sistema->acoes[ordem.acao_id].preco_atual) * (1.0 + variacao);
+        sistema->acoes[ordem.acao_id].preco_atual = PRECO_DE_REAIS(novo_preco);
         
         printf("Operação %d: %s %d ações de %s a R$ %.2f (novo preço: R$ %.2f)\n", 
                i + 1, (ordem.tipo == 'C') ? "COMPRA" : "VENDA", 
-               ordem.quantidade, sistema->acoes[ordem.acao_id].nome, ordem.preco, novo_preco);
+               ordem.quantidade, sistema->acoes[ordem.acao_id].nome, PRECO_EM_REAIS(ordem.preco), novo_preco);
     }
     
     printf("\n");
@@ -100,7 +100,7 @@ int main() {
     
     for (int i = 0; i < sistema->num_acoes; i++) {
         Acao* acao = &sistema->acoes[i];
-        printf("%s: R$ %.2f (%s)\n", acao->nome, acao->preco_atual, acao->setor);
+        printf("%s: R$ %.2f (%s)\n", acao->nome, PRECO_EM_REAIS(acao->preco_atual), acao->setor);
     }
     
     // Limpar sistema
@@ -82,7 +82,7 @@ run_test() {
     log "Executando teste: $test_name"
     
     # Executar o sistema com timeout
-    timeout $TIMEOUT_SECONDS ./trading_${version} > "$log_file" 2>&1 &
+    TRADING_EXECUTORES=$executors timeout $TIMEOUT_SECONDS ./trading_${version} > "$log_file" 2>&1 &
     local pid=$!
     
     # Aguardar um pouco para o sistema inicializar
@@ -85,7 +85,7 @@ run_test() {
     rm -f "$log_file" "$metrics_file"
     
     # Executar o sistema com timeout
-    timeout $TIMEOUT_SECONDS ./trading_${version} > "$log_file" 2>&1 &
+    TRADING_EXECUTORES=$executors timeout $TIMEOUT_SECONDS ./trading_${version} > "$log_file" 2>&1 &
     local pid=$!
     
     # Aguardar um pouco para o sistema inicializar
@@ -8,8 +8,8 @@ int main() {
     printf("=== TESTE DO SISTEMA DE PIPES ===\n");
     printf("Sistema de Trading - Comunicação entre Processos\n\n");
     
-    // Inicializar seed do rand
-    srand(time(NULL));
+    // Inicializar semente do gerador aleatório
+    aleatorio_configurar_semente(time(NULL));
     
     // Teste 1: Criar pipes do sistema
     printf("=== TESTE 1: CRIAÇÃO DE PIPES ===\n");
@@ -34,8 +34,8 @@ int main() {
     printf("=== TESTE 3: ENVIO E RECEBIMENTO DE MENSAGENS ===\n");
     
     // Criar mensagens de teste
-    MensagemPipe ordem = criar_mensagem_ordem(0, 1, 'C', 25.50, 100);
-    MensagemPipe atualizacao = criar_mensagem_atualizacao_preco(1, 25.50, 26.00);
+    MensagemPipe ordem = criar_mensagem_ordem(0, 1, 'C', PRECO_DE_REAIS(25.50), 100);
+    MensagemPipe atualizacao = criar_mensagem_atualizacao_preco(1, PRECO_DE_REAIS(25.50), PRECO_DE_REAIS(26.00));
     MensagemPipe arbitragem = criar_mensagem_arbitragem(1, 2, 5.50, 20.0);
     MensagemPipe controle = criar_mensagem_controle(1, 0, 3);
     
@@ -93,12 +93,12 @@ int main() {
     printf("Simulando fluxo: Traders -> Executor -> Price Updater -> Arbitrage Monitor\n");
     
     // Simular ordem de trader
-    MensagemPipe ordem_trader = criar_mensagem_ordem(0, 1, 'C', 25.50, 100);
+    MensagemPipe ordem_trader = criar_mensagem_ordem(0, 1, 'C', PRECO_DE_REAIS(25.50), 100);
     printf("1. Trader envia ordem:\n");
     imprimir_mensagem(&ordem_trader);
     
     // Simular execução pelo executor
-    MensagemPipe execucao = criar_mensagem_atualizacao_preco(1, 25.50, 25.75);
+    MensagemPipe execucao = criar_mensagem_atualizacao_preco(1, PRECO_DE_REAIS(25.50), PRECO_DE_REAIS(25.75));
     printf("2. Executor processa e envia atualização:\n");
     imprimir_mensagem(&execucao);
     
@@ -134,7 +134,7 @@ int main() {
     
     for (int i = 0; i < 5; i++) {
         MensagemPipe msg = criar_mensagem_ordem(i % 3, i % 5, (i % 2) ? 'C' : 'V', 
-                                               25.0 + i, 100 + i * 50);
+                                               PRECO_DE_REAIS(25.0 + i), 100 + i * 50);
         if (enviar_mensagem_pipe(descritores[1], &msg) > 0) {
             printf("✓ Mensagem %d enviada\n", i + 1);
         }
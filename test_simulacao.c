@@ -0,0 +1,361 @@
+#include "trading_system.h"
+#include <sys/wait.h>
+
+// Teste da simulação com relógio virtual
+// Cada sessão roda num processo filho (os módulos guardam estado estático,
+// como os livros e as oportunidades de arbitragem) e devolve o resultado ao
+// pai por um pipe. A mesma semente deve reproduzir exatamente o mesmo estado.
+
+#define TICKS_REPLAY_TESTE 1200     // Dois ticks por segundo: 10 minutos gravados
+#define TICKS_DESCONHECIDOS_TESTE 10 // Símbolo que não existe no sistema
+
+// Função para executar uma sessão simulada num processo filho
+// (com arquivo_replay, os preços vêm do histórico de ticks)
+static int simular_em_processo_filho(unsigned long long semente, int duracao_s, const char* arquivo_replay,
+                                     ResultadoSimulacao* resultado) {
+    int canal[2];
+    if (pipe(canal) == -1) {
+        perror("pipe");
+        return 0;
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(canal[0]);
+        TradingSystem* sistema = inicializar_sistema();
+        ResultadoSimulacao local;
+        FonteReplay replay;
+        int ok;
+        if (arquivo_replay) {
+            ok = sistema && replay_abrir(&replay, arquivo_replay, 0.0) &&
+                 executar_simulacao_replay(sistema, semente, duracao_s, &replay, &local);
+            replay_fechar(&replay);
+        } else {
+            ok = sistema && executar_simulacao(sistema, semente, duracao_s, &local);
+        }
+        if (ok && write(canal[1], &local, sizeof(local)) != (ssize_t)sizeof(local)) {
+            ok = 0;
+        }
+        if (sistema) {
+            limpar_sistema(sistema);
+        }
+        close(canal[1]);
+        _exit(ok ? 0 : 1);
+    }
+
+    close(canal[1]);
+    ssize_t lidos = read(canal[0], resultado, sizeof(ResultadoSimulacao));
+    close(canal[0]);
+
+    int status = 1;
+    waitpid(pid, &status, 0);
+    return lidos == (ssize_t)sizeof(ResultadoSimulacao) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// A fila de eventos deve sair em ordem de instante e, no mesmo instante, de agendamento
+static int testar_fila_eventos() {
+    FilaEventosSimulacao fila;
+    if (!fila_eventos_inicializar(&fila, 4)) {
+        return 0;
+    }
+
+    aleatorio_configurar_semente(7);
+    for (int i = 0; i < 1000; i++) {
+        fila_eventos_agendar(&fila, (aleatorio_proximo() % 50) * 1000LL, EVENTO_SIM_TRADER, i);
+    }
+
+    int ok = 1;
+    EventoSimulacao anterior, evento;
+    fila_eventos_retirar(&fila, &anterior);
+    int retirados = 1;
+    while (fila_eventos_retirar(&fila, &evento)) {
+        ok &= evento.instante_ns > anterior.instante_ns ||
+              (evento.instante_ns == anterior.instante_ns && evento.id > anterior.id);
+        anterior = evento;
+        retirados++;
+    }
+    ok &= retirados == 1000;
+
+    fila_eventos_liberar(&fila);
+    return ok;
+}
+
+// Ordem cancelada pelo id sai do livro: não negocia mais e devolve a reserva
+static int testar_cancelamento_no_livro() {
+    TradingSystem* sistema = inicializar_sistema();
+    if (!sistema) {
+        return 0;
+    }
+    inicializar_livros_ordens(sistema);
+
+    preco_t preco = sistema->acoes[0].preco_atual;
+    Trader* vendedor = &sistema->traders[0];
+    Trader* comprador = &sistema->traders[1];
+    preco_t tick = sistema->acoes[0].tamanho_tick;
+    int ok = 1;
+
+    // Compra do trader 2 montada como nas threads (id do gerador, fora do pool):
+    // nenhuma ordem do pool pode ter o mesmo id e tirá-la do livro
+    Ordem externa;
+    memset(&externa, 0, sizeof(Ordem));
+    externa.id = gerar_id_ordem(sistema);
+    externa.trader_id = 2;
+    externa.acao_id = 0;
+    externa.tipo = 'C';
+    externa.preco = preco - 10 * tick;
+    externa.quantidade = 100;
+    ok &= reservar_ordem_trader(sistema, &externa);
+    ok &= ok && executar_ordem_no_livro(sistema, &externa, NULL, NULL) == 0 && externa.status == 3;
+
+    // Venda do trader 0 fica em repouso com as ações reservadas
+    HandleOrdem venda_handle = criar_ordem(sistema, 0, 0, 'V', preco, 100);
+    Ordem* venda = pool_ordens_obter(&sistema->ordens, venda_handle);
+    ok &= venda && venda->id != externa.id;
+    ok &= venda && reservar_ordem_trader(sistema, venda);
+    ok &= ok && executar_ordem_no_livro(sistema, venda, NULL, NULL) == 0 && venda->status == 3;
+    ok &= vendedor->acoes_reservadas[0] == 100;
+
+    // Reduzir mantém a ordem no livro e devolve parte da reserva
+    ok &= modificar_ordem(sistema, venda_handle, 60) && vendedor->acoes_reservadas[0] == 60;
+
+    // Cancelada: sai do livro, a reserva volta e a ordem é devolvida ao pool
+    int vivas = pool_ordens_vivas(&sistema->ordens);
+    ok &= cancelar_ordem(sistema, venda_handle) == 60 && !pool_ordens_obter(&sistema->ordens, venda_handle);
+    ok &= pool_ordens_vivas(&sistema->ordens) == vivas - 1 && cancelar_ordem(sistema, venda_handle) == 0;
+    ok &= vendedor->acoes_reservadas[0] == 0;
+    ok &= !livro_ticks_melhor_oferta(obter_livro_ordens(0), 'V', NULL, NULL);
+
+    // Compra que cruzaria com a venda cancelada não negocia e fica em repouso
+    HandleOrdem compra_handle = criar_ordem(sistema, 1, 0, 'C', preco, 100);
+    Ordem* compra = pool_ordens_obter(&sistema->ordens, compra_handle);
+    ok &= compra && reservar_ordem_trader(sistema, compra);
+    ok &= ok && executar_ordem_no_livro(sistema, compra, NULL, NULL) == 0 && compra->status == 3;
+    ok &= vendedor->acoes_possuidas[0] == POSICAO_INICIAL_ACOES;
+    ok &= comprador->acoes_possuidas[0] == POSICAO_INICIAL_ACOES && comprador->saldo_reservado == preco * 100;
+
+    // Ordem que cruzaria com a compra em repouso do mesmo trader é rejeitada inteira
+    Ordem propria = *compra;
+    propria.id = gerar_id_ordem(sistema);
+    propria.tipo = 'V';
+    ok &= reservar_ordem_trader(sistema, &propria);
+    ok &= executar_ordem_no_livro(sistema, &propria, NULL, NULL) == 0 && propria.status == 2;
+    ok &= comprador->acoes_reservadas[0] == 0 && comprador->acoes_possuidas[0] == POSICAO_INICIAL_ACOES;
+
+    // Cancelar a compra do pool tira só ela do livro: a compra externa continua
+    preco_t melhor_compra = 0;
+    ok &= cancelar_ordem(sistema, compra_handle) == 100 && comprador->saldo_reservado == 0;
+    ok &= livro_ticks_melhor_oferta(obter_livro_ordens(0), 'C', &melhor_compra, NULL) &&
+          melhor_compra == externa.preco && sistema->traders[2].saldo_reservado == externa.preco * 100;
+
+    // Ordem com o id de outra em repouso é recusada (a reserva volta) e a outra continua cancelável
+    Ordem repetida = externa;
+    repetida.trader_id = 3;
+    repetida.preco = preco - 20 * tick;
+    repetida.status = 0;
+    ok &= reservar_ordem_trader(sistema, &repetida);
+    ok &= executar_ordem_no_livro(sistema, &repetida, NULL, NULL) == 0 && repetida.status == 2;
+    ok &= sistema->traders[3].saldo_reservado == 0;
+    ok &= livro_ticks_cancelar_ordem(obter_livro_ordens(0), externa.id) == 100;
+
+    // Venda fora da faixa contígua (livro em lista de reserva) também é modificável
+    HandleOrdem distante_handle = criar_ordem(sistema, 4, 0, 'V', preco + (NIVEIS_LIVRO_TICKS + 100) * tick, 100);
+    Ordem* distante = pool_ordens_obter(&sistema->ordens, distante_handle);
+    ok &= distante && reservar_ordem_trader(sistema, distante);
+    ok &= ok && executar_ordem_no_livro(sistema, distante, NULL, NULL) == 0 && distante->status == 3;
+    ok &= ok && modificar_ordem(sistema, distante_handle, 40) && distante->status == 3;
+    ok &= sistema->traders[4].acoes_reservadas[0] == 40;
+    ok &= cancelar_ordem(sistema, distante_handle) == 40 && sistema->traders[4].acoes_reservadas[0] == 0;
+
+    liberar_livros_ordens();
+    limpar_sistema(sistema);
+    return ok;
+}
+
+// Ordens do pool executadas ou canceladas pelo executor voltam ao pool:
+// rodadas seguidas reaproveitam os mesmos slots em vez de acumular ordens
+static int testar_pool_sem_ordens_encerradas() {
+    TradingSystem* sistema = inicializar_sistema();
+    if (!sistema) {
+        return 0;
+    }
+
+    int ok = 1;
+    int limite = 0;
+    for (int rodada = 0; rodada < 20; rodada++) {
+        for (int t = 0; t < sistema->num_traders; t++) {
+            Acao* acao = &sistema->acoes[t % sistema->num_acoes];
+            criar_ordem(sistema, t, t % sistema->num_acoes, (t & 1) ? 'V' : 'C', acao->preco_atual, 10);
+        }
+        // Longe do preço atual: o executor cancela
+        criar_ordem(sistema, 0, 0, 'C', sistema->acoes[0].preco_atual / 2, 10);
+        executar_ordens_pendentes(sistema);
+
+        ok &= pool_ordens_vivas(&sistema->ordens) == 0;
+        if (rodada == 0) {
+            limite = pool_ordens_limite(&sistema->ordens);
+        }
+    }
+    ok &= pool_ordens_limite(&sistema->ordens) == limite;
+    ok &= sistema->executor.ordens_executadas > 0 && sistema->executor.ordens_canceladas >= 20;
+
+    limpar_sistema(sistema);
+    return ok;
+}
+
+// Função para gravar um histórico de ticks de teste: passeio aleatório de
+// três ações conhecidas e alguns ticks de um símbolo desconhecido
+static int gravar_historico_teste(const char* caminho) {
+    static const char* SIMBOLOS[] = {"PETR4", "VALE3", "ITUB4"};
+    preco_t precos[] = {PRECO_DE_REAIS(25.50), PRECO_DE_REAIS(68.30), PRECO_DE_REAIS(32.15)};
+
+    remove(caminho);
+    static GravadorTicks gravador;
+    if (!gravador_ticks_abrir(&gravador, caminho)) {
+        return 0;
+    }
+
+    aleatorio_configurar_semente(11);
+    long long instante = INICIO_PREGAO_SIMULADO * 1000000000LL;
+    for (int i = 0; i < TICKS_REPLAY_TESTE + TICKS_DESCONHECIDOS_TESTE; i++) {
+        RegistroTick registro;
+        memset(&registro, 0, sizeof(registro));
+        int s = i % 3;
+        registro.instante_ns = instante;
+        registro.preco_anterior = precos[s];
+        precos[s] += ((long long)(aleatorio_proximo() % 41) - 20) * TAMANHO_TICK_PADRAO;
+        registro.preco_novo = precos[s];
+        registro.acao_id = (unsigned short)s;
+        registro.motivo = MOTIVO_TICK_VARIACAO;
+        strcpy(registro.simbolo, i < TICKS_REPLAY_TESTE ? SIMBOLOS[s] : "TESTE9");
+        gravador_ticks_registrar(&gravador, &registro);
+        instante += 500000000LL;
+    }
+    gravador_ticks_fechar(&gravador);
+    return 1;
+}
+
+int main() {
+    printf("=== TESTE DA SIMULAÇÃO COM RELÓGIO VIRTUAL ===\n\n");
+
+    // Silenciar o log por evento (negócios, oportunidades) durante as sessões
+    configurar_nivel_log(NIVEL_LOG_ERRO);
+
+    printf("=== TESTE 1: FILA DE EVENTOS ===\n");
+    if (!testar_fila_eventos()) {
+        printf("✗ Eventos fora de ordem\n");
+        return 1;
+    }
+    printf("✓ 1000 eventos retirados em ordem de instante e agendamento\n\n");
+
+    printf("=== TESTE 2: SESSÃO DE 5 MINUTOS ===\n");
+    ResultadoSimulacao primeira, segunda;
+    if (!simular_em_processo_filho(SEMENTE_SIMULACAO_PADRAO, DURACAO_SESSAO_SIMULADA, NULL, &primeira)) {
+        printf("✗ Falha ao executar a simulação\n");
+        return 1;
+    }
+    imprimir_resultado_simulacao(&primeira);
+    if (primeira.ordens_enviadas == 0 || primeira.negocios == 0) {
+        printf("✗ Sessão simulada sem ordens ou sem negócios\n");
+        return 1;
+    }
+    printf("✓ %d ordens e %d negócios em %.1f ms\n",
+           primeira.ordens_enviadas, primeira.negocios, primeira.tempo_real_ms);
+    if (primeira.posicoes_negativas > 0) {
+        printf("✗ %d saldos/carteiras negativos ao fim da sessão\n", primeira.posicoes_negativas);
+        return 1;
+    }
+    printf("✓ Nenhum saldo ou carteira negativo (reservas das ordens em repouso)\n\n");
+
+    printf("=== TESTE 3: DETERMINISMO ===\n");
+    if (!simular_em_processo_filho(SEMENTE_SIMULACAO_PADRAO, DURACAO_SESSAO_SIMULADA, NULL, &segunda)) {
+        printf("✗ Falha ao executar a simulação\n");
+        return 1;
+    }
+    if (segunda.assinatura != primeira.assinatura ||
+        segunda.eventos_processados != primeira.eventos_processados ||
+        segunda.negocios != primeira.negocios) {
+        printf("✗ Mesma semente, resultados diferentes (%016llx vs %016llx)\n",
+               primeira.assinatura, segunda.assinatura);
+        return 1;
+    }
+    printf("✓ Mesma semente, mesma assinatura (%016llx)\n", primeira.assinatura);
+
+    ResultadoSimulacao outra;
+    if (!simular_em_processo_filho(SEMENTE_SIMULACAO_PADRAO + 1, DURACAO_SESSAO_SIMULADA, NULL, &outra)) {
+        printf("✗ Falha ao executar a simulação\n");
+        return 1;
+    }
+    if (outra.assinatura == primeira.assinatura) {
+        printf("✗ Sementes diferentes produziram o mesmo estado\n");
+        return 1;
+    }
+    printf("✓ Semente diferente, assinatura diferente (%016llx)\n\n", outra.assinatura);
+
+    printf("=== TESTE 4: PREGÃO COMPLETO ===\n");
+    ResultadoSimulacao pregao;
+    if (!simular_em_processo_filho(SEMENTE_SIMULACAO_PADRAO, DURACAO_PREGAO_SIMULADO, NULL, &pregao)) {
+        printf("✗ Falha ao executar a simulação\n");
+        return 1;
+    }
+    imprimir_resultado_simulacao(&pregao);
+    if (pregao.posicoes_negativas > 0) {
+        printf("✗ %d saldos/carteiras negativos ao fim do pregão\n", pregao.posicoes_negativas);
+        return 1;
+    }
+    // As ordens se espalham pelas ações preferidas dos traders (não só 0 e 1)
+    if (pregao.acoes_negociadas <= 2) {
+        printf("✗ Negócios em apenas %d ações\n", pregao.acoes_negociadas);
+        return 1;
+    }
+    printf("✓ Pregão de %d h simulado em %.1f ms\n\n", DURACAO_PREGAO_SIMULADO / 3600, pregao.tempo_real_ms);
+
+    printf("=== TESTE 5: CANCELAMENTO NO LIVRO ===\n");
+    if (!testar_cancelamento_no_livro()) {
+        printf("✗ Ordem cancelada continuou no livro ou a reserva não voltou\n");
+        return 1;
+    }
+    printf("✓ Ordem cancelada pelo id sai do livro e não negocia mais\n");
+    printf("✓ Ordem que cruzaria com o próprio trader é rejeitada\n");
+    printf("✓ Ordens do pool e das threads têm ids distintos no livro\n");
+    printf("✓ Ordem fora da faixa contígua é modificada sem sair do livro\n");
+
+    if (!testar_pool_sem_ordens_encerradas()) {
+        printf("✗ Ordens encerradas continuaram ocupando o pool\n");
+        return 1;
+    }
+    printf("✓ Ordens executadas e canceladas voltam ao pool\n\n");
+
+    printf("=== TESTE 6: REPLAY DE TICKS (BACKTEST) ===\n");
+    char arquivo_replay[64];
+    snprintf(arquivo_replay, sizeof(arquivo_replay), "/tmp/test_replay_%d.bin", (int)getpid());
+    if (!gravar_historico_teste(arquivo_replay)) {
+        printf("✗ Falha ao gravar o histórico de teste\n");
+        return 1;
+    }
+    ResultadoSimulacao replay1, replay2;
+    int ok_replay = simular_em_processo_filho(SEMENTE_SIMULACAO_PADRAO, 0, arquivo_replay, &replay1) &&
+                    simular_em_processo_filho(SEMENTE_SIMULACAO_PADRAO, 0, arquivo_replay, &replay2);
+    remove(arquivo_replay);
+    if (!ok_replay) {
+        printf("✗ Falha ao executar a simulação com replay\n");
+        return 1;
+    }
+    imprimir_resultado_simulacao(&replay1);
+    int duracao_esperada = (TICKS_REPLAY_TESTE + TICKS_DESCONHECIDOS_TESTE - 1) / 2 + 1;
+    if (replay1.ticks_replay != TICKS_REPLAY_TESTE || replay1.duracao_virtual_s != duracao_esperada) {
+        printf("✗ Replay aplicou %lld de %d ticks em %d s (esperado %d s)\n",
+               replay1.ticks_replay, TICKS_REPLAY_TESTE, replay1.duracao_virtual_s, duracao_esperada);
+        return 1;
+    }
+    printf("✓ %d ticks aplicados, %d de símbolo desconhecido ignorados, sessão de %d s\n",
+           TICKS_REPLAY_TESTE, TICKS_DESCONHECIDOS_TESTE, replay1.duracao_virtual_s);
+    if (replay2.assinatura != replay1.assinatura || replay1.ordens_enviadas == 0) {
+        printf("✗ Replay não reproduziu o mesmo estado (%016llx vs %016llx)\n",
+               replay1.assinatura, replay2.assinatura);
+        return 1;
+    }
+    printf("✓ Mesmo histórico e semente, mesma assinatura (%016llx)\n", replay1.assinatura);
+
+    printf("\n✓ Todos os testes da simulação passaram\n");
+    return 0;
+}
@@ -6,8 +6,8 @@ int main() {
     printf("=== TESTE DAS FUNÇÕES UTILITÁRIAS ===\n");
     printf("Sistema de Trading - Módulo Utils\n\n");
     
-    // Inicializar seed do rand
-    srand(time(NULL));
+    // Inicializar semente do gerador aleatório
+    aleatorio_configurar_semente(time(NULL));
     
     // Inicializar sistema
     TradingSystem* sistema = inicializar_sistema();
@@ -45,7 +45,7 @@ int main() {
     
     // Ordem inválida - preço muito alto
     Ordem ordem_invalida = ordem_valida;
-    ordem_invalida.preco = 500.0;
+    ordem_invalida.preco = PRECO_DE_REAIS(500.0);
     printf("Testando ordem com preço muito alto (R$ 500.00):\n");
     validar_ordem(sistema, &ordem_invalida);
     printf("\n");
@@ -87,8 +87,8 @@ int main() {
     
     printf("Calculando novos preços baseados em oferta/demanda:\n");
     for (int i = 0; i < sistema->num_acoes; i++) {
-        double preco_atual = sistema->acoes[i].preco_atual;
-        double novo_preco = calcular_preco_oferta_demanda(sistema, i);
+        double preco_atual = PRECO_EM_REAIS(sistema->acoes[i].preco_atual);
+        double novo_preco = PRECO_EM_REAIS(calcular_preco_oferta_demanda(sistema, i));
         double variacao = ((novo_preco - preco_atual) / preco_atual) * 100;
         
         printf("%s: R$ %.2f → R$ %.2f (variação: %.2f%%)\n", 
@@ -1,21 +1,54 @@
 #include "trading_system.h"
 #include <pthread.h>
 #include <time.h>
+#include <sched.h>
+
+// Intervalos dos estágios do pipeline
+#define INTERVALO_POLLING_EXECUTOR_MS 1         // Modo polling: pausa do executor sem ordens
+#define INTERVALO_POLLING_PRICE_UPDATER_MS 100  // Modo polling: pausa do price updater
+#define INTERVALO_POLLING_ARBITRAGEM_MS 5000    // Modo polling: pausa do arbitrage monitor
+#define INTERVALO_VARIACAO_MERCADO_MS 3000      // Variação periódica de preços
+#define INTERVALO_CICLO_ARBITRAGEM_MS 5000      // Varredura periódica de arbitragem
+#define TIMEOUT_ESPERA_EXECUTOR_MS 100          // Limite de espera do executor por evento
+
+// Execução ainda não refletida no preço da ação (executor -> price updater)
+typedef struct {
+    int pendente;
+    preco_t preco;
+    int volume;
+    struct timespec instante; // Primeira execução ainda não consumida
+} ExecucaoPendente;
 
 // Estruturas globais compartilhadas
-static FilaOrdens fila_ordens;
+static FilaOrdensLockFree filas_executores[MAX_EXECUTORES]; // Uma fila por shard de ações
+static int num_executores = 1;
+static int modo_escalonador = MODO_ESCALONADOR_ESTATICO;
 static EstadoMercado estado_mercado;
 TradingSystem* sistema_global = NULL;
 
+// Eventos do pipeline: traders -> executor -> price updater -> arbitrage monitor
+static EventoNotificacao eventos_ordens[MAX_EXECUTORES];
+static EventoNotificacao evento_execucoes;
+static EventoNotificacao evento_precos;
+static int notificacao_polling = 0;
+
+// Dados passados entre estágios (protegidos por mutex_pipeline)
+static ExecucaoPendente execucoes_pendentes[MAX_ACOES];
+static int precos_pendentes = 0;
+static int origem_execucao_pendente = 0;
+static struct timespec origem_preco_pendente;   // Execução mais antiga por trás dos preços pendentes
+static struct timespec instante_preco_pendente; // Primeiro preço ainda não visto pela arbitragem
+static pthread_mutex_t mutex_pipeline = PTHREAD_MUTEX_INITIALIZER;
+
 // Threads ativas
 static pthread_t threads_traders[MAX_TRADERS];
-static pthread_t thread_executor;
+static pthread_t threads_executores[MAX_EXECUTORES];
 static pthread_t thread_price_updater;
 static pthread_t thread_arbitrage_monitor;
 
 // Status das threads
 static int threads_traders_ativas[MAX_TRADERS] = {0};
-static int thread_executor_ativa = 0;
+static int threads_executores_ativas[MAX_EXECUTORES] = {0};
 static int thread_price_updater_ativa = 0;
 static int thread_arbitrage_monitor_ativa = 0;
 
@@ -27,6 +60,7 @@ typedef struct {
 } ParametrosTrader;
 
 typedef struct {
+    int executor_id;
     TradingSystem* sistema;
 } ParametrosExecutor;
 
@@ -42,13 +76,23 @@ typedef struct {
 void inicializar_estruturas_globais() {
     printf("=== INICIALIZANDO ESTRUTURAS GLOBAIS PARA THREADS ===\n");
     
-    // Inicializar fila de ordens
-    fila_ordens.inicio = 0;
-    fila_ordens.fim = 0;
-    fila_ordens.tamanho = 0;
-    pthread_mutex_init(&fila_ordens.mutex, NULL);
-    pthread_cond_init(&fila_ordens.cond_nao_vazia, NULL);
-    pthread_cond_init(&fila_ordens.cond_nao_cheia, NULL);
+    // Inicializar filas de ordens dos executores (lock-free, sem mutex)
+    for (int i = 0; i < MAX_EXECUTORES; i++) {
+        fila_lockfree_inicializar(&filas_executores[i]);
+    }
+    
+    // Inicializar eventos do pipeline
+    for (int i = 0; i < MAX_EXECUTORES; i++) {
+        evento_inicializar(&eventos_ordens[i]);
+    }
+    evento_inicializar(&evento_execucoes);
+    evento_inicializar(&evento_precos);
+    memset(execucoes_pendentes, 0, sizeof(execucoes_pendentes));
+    precos_pendentes = 0;
+    origem_execucao_pendente = 0;
+    
+    // Inicializar livros de ofertas (um por ação)
+    inicializar_livros_ordens(sistema_global);
     
     // Inicializar estado do mercado
     estado_mercado.sistema_ativo = 1;
@@ -56,7 +100,10 @@ void inicializar_estruturas_globais() {
     estado_mercado.inicio_sessao = time(NULL);
     pthread_mutex_init(&estado_mercado.mutex, NULL);
     
-    printf("✓ Fila de ordens inicializada (capacidade: %d)\n", MAX_FILA_ORDENS);
+    printf("✓ %d fila(s) de ordens lock-free inicializada(s) (capacidade: %d)\n",
+           num_executores, CAPACIDADE_FILA_LOCKFREE);
+    printf("✓ Eventos do pipeline inicializados (%s)\n",
+           notificacao_polling ? "polling por timer" : nome_estrategia_espera(obter_estrategia_espera()));
     printf("✓ Estado do mercado inicializado\n");
     printf("✓ Mutexes e condition variables criados\n");
 }
@@ -65,10 +112,13 @@ void inicializar_estruturas_globais() {
 void limpar_estruturas_globais() {
     printf("=== LIMPANDO ESTRUTURAS GLOBAIS ===\n");
     
-    // Destruir mutexes e condition variables
-    pthread_mutex_destroy(&fila_ordens.mutex);
-    pthread_cond_destroy(&fila_ordens.cond_nao_vazia);
-    pthread_cond_destroy(&fila_ordens.cond_nao_cheia);
+    // Resumo e liberação dos livros de ofertas
+    if (sistema_global) {
+        imprimir_livros_ordens(sistema_global);
+    }
+    liberar_livros_ordens();
+    
+    // Destruir mutexes
     pthread_mutex_destroy(&estado_mercado.mutex);
     
     printf("✓ Estruturas globais limpas\n");
@@ -84,49 +134,167 @@ int verificar_retorno_pthread(int resultado, const char* operacao) {
     return 1;
 }
 
+// Função para configurar o número de executores (antes de criar as threads)
+void configurar_num_executores(int quantidade) {
+    if (quantidade < 1) quantidade = 1;
+    if (quantidade > MAX_EXECUTORES) quantidade = MAX_EXECUTORES;
+    num_executores = quantidade;
+}
+
+// Função para obter o número de executores configurado
+int obter_num_executores() {
+    return num_executores;
+}
+
+// Função para configurar o modo do escalonador (antes de criar as threads)
+void configurar_modo_escalonador(int modo) {
+    modo_escalonador = (modo == MODO_ESCALONADOR_ROUBO) ? MODO_ESCALONADOR_ROUBO : MODO_ESCALONADOR_ESTATICO;
+}
+
+// Função para obter o modo do escalonador configurado
+int obter_modo_escalonador() {
+    return modo_escalonador;
+}
+
+// Função para configurar espera por polling em vez de eventos (comparação de latência)
+void configurar_notificacao_polling(int polling) {
+    notificacao_polling = polling ? 1 : 0;
+}
+
+// Função para saber se os estágios esperam por polling
+int obter_notificacao_polling() {
+    return notificacao_polling;
+}
+
+// Função para um estágio aguardar trabalho novo
+// Com eventos, acorda assim que o evento é notificado (ou no timeout);
+// em modo polling, apenas dorme o intervalo fixo do estágio.
+static void aguardar_estagio(EventoNotificacao* evento, unsigned int observado,
+                             int intervalo_polling_ms, int timeout_ms) {
+    if (notificacao_polling) {
+        usleep(intervalo_polling_ms * 1000);
+        return;
+    }
+    evento_aguardar(evento, observado, timeout_ms);
+}
+
+// Função para obter o shard (executor) responsável por uma ação
+int shard_da_acao(int acao_id) {
+    if (acao_id < 0) return 0;
+    return acao_id % num_executores;
+}
+
 // Função para adicionar ordem na fila
 int adicionar_ordem_fila(Ordem ordem) {
-    pthread_mutex_lock(&fila_ordens.mutex);
-    
-    // Verificar se fila está cheia
-    while (fila_ordens.tamanho >= MAX_FILA_ORDENS) {
-        printf("AVISO: Fila de ordens cheia, aguardando espaço...\n");
-        pthread_cond_wait(&fila_ordens.cond_nao_cheia, &fila_ordens.mutex);
+    int aviso_emitido = 0;
+    int shard = shard_da_acao(ordem.acao_id);
+    
+    // Fila cheia: aguardar o executor do shard liberar slots (sem lock)
+    while (!(modo_escalonador == MODO_ESCALONADOR_ROUBO
+                 ? escalonador_submeter(&ordem)
+                 : fila_lockfree_enfileirar(&filas_executores[shard], &ordem))) {
+        if (!estado_mercado.sistema_ativo) {
+            return 0;
+        }
+        if (!aviso_emitido) {
+            LOG_AVISO("AVISO: Fila de ordens cheia, aguardando espaço...\n");
+            aviso_emitido = 1;
+        }
+        sched_yield();
     }
     
-    // Adicionar ordem
-    fila_ordens.ordens[fila_ordens.fim] = ordem;
-    fila_ordens.fim = (fila_ordens.fim + 1) % MAX_FILA_ORDENS;
-    fila_ordens.tamanho++;
-    
-    printf("✓ Ordem adicionada na fila (Trader %d, Ação %d, Tipo: %c, Preço: %.2f, Qtd: %d)\n",
-           ordem.trader_id, ordem.acao_id, ordem.tipo, ordem.preco, ordem.quantidade);
+    if (modo_escalonador != MODO_ESCALONADOR_ROUBO) {
+        evento_notificar(&eventos_ordens[shard]);
+    }
     
-    // Sinalizar que há ordens disponíveis
-    pthread_cond_signal(&fila_ordens.cond_nao_vazia);
+    log_registrar_ordem(REGISTRO_LOG_ORDEM_FILA, &ordem, shard, NULL);
     
-    pthread_mutex_unlock(&fila_ordens.mutex);
     return 1;
 }
 
-// Função para remover ordem da fila
+// Função para remover ordem da fila (shard 0; com um executor é a fila única)
 int remover_ordem_fila(Ordem* ordem) {
-    pthread_mutex_lock(&fila_ordens.mutex);
-    
-    // Verificar se fila está vazia
-    while (fila_ordens.tamanho == 0) {
-        pthread_cond_wait(&fila_ordens.cond_nao_vazia, &fila_ordens.mutex);
+    // Fila vazia: aguardar novas ordens enquanto o sistema estiver ativo
+    for (;;) {
+        unsigned int observado = evento_observar(&eventos_ordens[0]);
+        if (fila_lockfree_desenfileirar(&filas_executores[0], ordem)) {
+            return 1;
+        }
+        if (!estado_mercado.sistema_ativo) {
+            return 0;
+        }
+        aguardar_estagio(&eventos_ordens[0], observado,
+                         INTERVALO_POLLING_EXECUTOR_MS, TIMEOUT_ESPERA_EXECUTOR_MS);
     }
+}
+
+// Função para remover um lote de ordens da fila de um shard
+// Aguarda até haver ao menos uma ordem e retira até max de uma vez
+int remover_ordens_shard_lote(int shard, Ordem* out, int max) {
+    int removidas;
     
-    // Remover ordem
-    *ordem = fila_ordens.ordens[fila_ordens.inicio];
-    fila_ordens.inicio = (fila_ordens.inicio + 1) % MAX_FILA_ORDENS;
-    fila_ordens.tamanho--;
+    if (shard < 0 || shard >= num_executores) {
+        return 0;
+    }
     
-    // Sinalizar que há espaço disponível
-    pthread_cond_signal(&fila_ordens.cond_nao_cheia);
+    for (;;) {
+        unsigned int observado = evento_observar(&eventos_ordens[shard]);
+        removidas = fila_lockfree_desenfileirar_lote(&filas_executores[shard], out, max);
+        if (removidas > 0) {
+            return removidas;
+        }
+        if (!estado_mercado.sistema_ativo) {
+            return 0;
+        }
+        aguardar_estagio(&eventos_ordens[shard], observado,
+                         INTERVALO_POLLING_EXECUTOR_MS, TIMEOUT_ESPERA_EXECUTOR_MS);
+    }
+}
+
+// Função para remover um lote de ordens da fila (shard 0)
+int remover_ordens_fila_lote(Ordem* out, int max) {
+    return remover_ordens_shard_lote(0, out, max);
+}
+
+// Função para montar a ordem de um trader segundo seu perfil
+// (usada pela thread trader e pela simulação com relógio virtual)
+// Retorna 1 se o trader decidiu operar e a ordem foi montada
+int montar_ordem_trader(TradingSystem* sistema, int trader_id, PerfilTrader* perfil, Ordem* ordem) {
+    // Escolher a ação em que o trader opera (a ordem é montada aqui, fora do pool)
+    int acao_id = escolher_acao_trader(sistema, trader_id, perfil);
+    if (acao_id < 0) {
+        return 0;
+    }
     
-    pthread_mutex_unlock(&fila_ordens.mutex);
+    memset(ordem, 0, sizeof(Ordem));
+    ordem->id = gerar_id_ordem(sistema);
+    ordem->trader_id = trader_id;
+    ordem->acao_id = acao_id;
+    ordem->timestamp = relogio_mercado();
+    ordem->status = 0; // Pendente
+    
+    // Decidir tipo de ordem (compra/venda)
+    double prob_compra = calcular_probabilidade_compra(sistema, acao_id, perfil);
+    double random = (double)aleatorio_proximo() / ALEATORIO_MAX;
+    preco_t preco_atual = ler_preco_atual(&sistema->acoes[acao_id]);
+    
+    if (random < prob_compra) {
+        ordem->tipo = 'C'; // Compra
+        ordem->preco = preco_atual + preco_atual * (aleatorio_proximo() % 100 - 50) / 10000; // ±0,5%
+        ordem->quantidade = (int)(perfil->volume_medio * (0.5 + (double)aleatorio_proximo() / ALEATORIO_MAX));
+        
+        LOG_DEBUG("NOVA ORDEM: Trader %d compra %d ações de %s a R$ %.2f\n",
+               trader_id, ordem->quantidade, sistema->acoes[acao_id].nome, PRECO_EM_REAIS(ordem->preco));
+        log_ordem_trader(trader_id, acao_id, 'C', ordem->preco, ordem->quantidade, "Probabilidade de compra");
+    } else {
+        ordem->tipo = 'V'; // Venda
+        ordem->preco = preco_atual + preco_atual * (aleatorio_proximo() % 100 - 50) / 10000; // ±0,5%
+        ordem->quantidade = (int)(perfil->volume_medio * (0.5 + (double)aleatorio_proximo() / ALEATORIO_MAX));
+        
+        LOG_DEBUG("NOVA ORDEM: Trader %d vende %d ações de %s a R$ %.2f\n",
+               trader_id, ordem->quantidade, sistema->acoes[acao_id].nome, PRECO_EM_REAIS(ordem->preco));
+        log_ordem_trader(trader_id, acao_id, 'V', ordem->preco, ordem->quantidade, "Probabilidade de venda");
+    }
     return 1;
 }
 
@@ -136,6 +304,7 @@ void* thread_trader_func(void* arg) {
     int trader_id = params->trader_id;
     int perfil_id = params->perfil_id;
     TradingSystem* sistema = params->sistema;
+    aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_TRADER + trader_id);
     
     printf("=== THREAD TRADER %d INICIADA (Perfil: %d) ===\n", trader_id, perfil_id);
     
@@ -154,13 +323,13 @@ void* thread_trader_func(void* arg) {
     
     // Variáveis de controle e métricas
     int ordens_enviadas = 0;
-    time_t inicio_sessao = time(NULL);
+    time_t inicio_sessao = relogio_mercado();
     int orders_processed = 0;
     double total_latency = 0.0;
     
     while (estado_mercado.sistema_ativo) {
         // Verificar limites de sessão
-        time_t tempo_atual = time(NULL);
+        time_t tempo_atual = relogio_mercado();
         if (tempo_atual - inicio_sessao > perfil->tempo_limite_sessao) {
             printf("Trader %d: Tempo limite de sessão atingido\n", trader_id);
             break;
@@ -175,39 +344,9 @@ void* thread_trader_func(void* arg) {
         // Iniciar medição de tempo de processamento
         void* processing_time = iniciar_medicao_processamento(0); // 0 = threads
         
-        // Decidir ação do trader
-        int acao_id = decidir_acao_trader(sistema, trader_id, perfil);
-        if (acao_id >= 0) {
-            // Gerar ordem
-            Ordem ordem;
-            ordem.id = gerar_id_aleatorio();
-            ordem.trader_id = trader_id;
-            ordem.acao_id = acao_id;
-            ordem.timestamp = time(NULL);
-            ordem.status = 0; // Pendente
-            
-            // Decidir tipo de ordem (compra/venda)
-            double prob_compra = calcular_probabilidade_compra(sistema, acao_id, perfil);
-            double random = (double)rand() / RAND_MAX;
-            
-            if (random < prob_compra) {
-                ordem.tipo = 'C'; // Compra
-                ordem.preco = sistema->acoes[acao_id].preco_atual * (1.0 + (rand() % 100 - 50) / 10000.0);
-                ordem.quantidade = (int)(perfil->volume_medio * (0.5 + (double)rand() / RAND_MAX));
-                
-                printf("NOVA ORDEM: Trader %d compra %d ações de %s a R$ %.2f\n",
-                       trader_id, ordem.quantidade, sistema->acoes[acao_id].nome, ordem.preco);
-                log_ordem_trader(trader_id, acao_id, 'C', ordem.preco, ordem.quantidade, "Probabilidade de compra");
-            } else {
-                ordem.tipo = 'V'; // Venda
-                ordem.preco = sistema->acoes[acao_id].preco_atual * (1.0 + (rand() % 100 - 50) / 10000.0);
-                ordem.quantidade = (int)(perfil->volume_medio * (0.5 + (double)rand() / RAND_MAX));
-                
-                printf("NOVA ORDEM: Trader %d vende %d ações de %s a R$ %.2f\n",
-                       trader_id, ordem.quantidade, sistema->acoes[acao_id].nome, ordem.preco);
-                log_ordem_trader(trader_id, acao_id, 'V', ordem.preco, ordem.quantidade, "Probabilidade de venda");
-            }
-            
+        // Decidir ação do trader e montar a ordem
+        Ordem ordem;
+        if (montar_ordem_trader(sistema, trader_id, perfil, &ordem)) {
             // Adicionar ordem na fila global
             int order_accepted = adicionar_ordem_fila(ordem);
             
@@ -219,7 +358,7 @@ void* thread_trader_func(void* arg) {
                 orders_processed++;
                 // total_latency será calculado na função finalizar_medicao_processamento
                 
-                printf("Trader %d: Ordem criada (total: %d/%d)\n", 
+                LOG_DEBUG("Trader %d: Ordem criada (total: %d/%d)\n", 
                        trader_id, ordens_enviadas, perfil->max_ordens_por_sessao);
             }
         }
@@ -241,42 +380,161 @@ void* thread_trader_func(void* arg) {
     return NULL;
 }
 
+// Função para registrar negócio pendente para o price updater
+// (callback do livro de ofertas; o negócio já foi liquidado)
+static void registrar_execucao_pendente(const Negocio* negocio, void* contexto) {
+    int* execucoes = (int*)contexto;
+    
+    pthread_mutex_lock(&mutex_pipeline);
+    ExecucaoPendente* execucao = &execucoes_pendentes[negocio->acao_id];
+    if (!execucao->pendente) {
+        execucao->pendente = 1;
+        execucao->volume = 0;
+        get_monotonic_time(&execucao->instante);
+    }
+    execucao->preco = negocio->preco;
+    execucao->volume += negocio->quantidade;
+    pthread_mutex_unlock(&mutex_pipeline);
+    
+    (*execucoes)++;
+}
+
+// Função para publicar preço atualizado para o arbitrage monitor
+// origem_execucao é a execução que originou o preço (NULL para variação de mercado)
+static void publicar_preco_atualizado(const struct timespec* origem_execucao) {
+    pthread_mutex_lock(&mutex_pipeline);
+    if (!precos_pendentes) {
+        precos_pendentes = 1;
+        get_monotonic_time(&instante_preco_pendente);
+    }
+    if (origem_execucao && !origem_execucao_pendente) {
+        origem_execucao_pendente = 1;
+        origem_preco_pendente = *origem_execucao;
+    }
+    pthread_mutex_unlock(&mutex_pipeline);
+    
+    evento_notificar(&evento_precos);
+}
+
+// Função para refletir no preço da ação o preço/volume executado (média ponderada)
+// Retorna 1 se o preço foi atualizado
+int aplicar_execucao_preco(TradingSystem* sistema, int acao_id, preco_t preco, int volume) {
+    preco_t preco_anterior = sistema->acoes[acao_id].preco_atual;
+    preco_t novo_preco = calcular_preco_media_ponderada(preco_anterior, preco, volume);
+    if (!validar_preco(novo_preco, preco_anterior)) {
+        return 0;
+    }
+    
+    atualizar_estatisticas_acao(sistema, acao_id, novo_preco);
+    log_atualizacao_preco(sistema, acao_id, preco_anterior, novo_preco, MOTIVO_TICK_EXECUCAO);
+    return 1;
+}
+
+// Função para aplicar variação periódica de mercado a todas as ações
+// Retorna o número de ações com preço atualizado
+int aplicar_variacao_mercado(TradingSystem* sistema) {
+    int atualizadas = 0;
+    for (int i = 0; i < sistema->num_acoes; i++) {
+        Acao* acao = &sistema->acoes[i];
+        preco_t preco_anterior = acao->preco_atual;
+        
+        // Simular variação de mercado (em centésimos de ponto percentual)
+        int variacao = aleatorio_proximo() % 200 - 100; // ±1%
+        preco_t novo_preco = preco_anterior + preco_anterior * variacao / 10000;
+        
+        if (validar_preco(novo_preco, preco_anterior)) {
+            atualizar_estatisticas_acao(sistema, i, novo_preco);
+            log_atualizacao_preco(sistema, i, preco_anterior, novo_preco, MOTIVO_TICK_VARIACAO);
+            atualizadas++;
+        }
+    }
+    registrar_amostra_correlacao(sistema);
+    return atualizadas;
+}
+
+// Função para aplicar execuções pendentes aos preços (price updater)
+// Retorna o número de ações com preço atualizado
+static int aplicar_execucoes_pendentes(TradingSystem* sistema) {
+    ExecucaoPendente execucoes[MAX_ACOES];
+    
+    pthread_mutex_lock(&mutex_pipeline);
+    memcpy(execucoes, execucoes_pendentes, sizeof(execucoes));
+    for (int i = 0; i < MAX_ACOES; i++) {
+        execucoes_pendentes[i].pendente = 0;
+    }
+    pthread_mutex_unlock(&mutex_pipeline);
+    
+    int atualizadas = 0;
+    for (int i = 0; i < sistema->num_acoes && i < MAX_ACOES; i++) {
+        if (!execucoes[i].pendente) continue;
+        
+        if (!aplicar_execucao_preco(sistema, i, execucoes[i].preco, execucoes[i].volume)) continue;
+        
+        struct timespec agora;
+        get_monotonic_time(&agora);
+        registrar_latencia_execucao_preco(calculate_time_diff_ms(execucoes[i].instante, agora));
+        publicar_preco_atualizado(&execucoes[i].instante);
+        atualizadas++;
+    }
+    
+    return atualizadas;
+}
+
+// Função para processar um lote de ordens de um executor
+// (usada pelas threads de shard fixo e pelo escalonador com roubo de trabalho)
+static void processar_lote_executor(int executor_id, Ordem* lote, int tamanho_lote, void* contexto) {
+    TradingSystem* sistema = (TradingSystem*)contexto;
+    struct timespec inicio_lote, fim_lote;
+    get_monotonic_time(&inicio_lote);
+    
+    // Threads do escalonador com roubo de trabalho não passam por thread_executor_func
+    if (!aleatorio_fluxo_iniciado()) {
+        aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_EXECUTOR + executor_id);
+    }
+    
+    registrar_tamanho_lote(0, tamanho_lote); // 0 = threads
+    LOG_DEBUG("EXECUTOR %d: Processando lote de %d ordens\n", executor_id, tamanho_lote);
+    
+    // Simular tempo de processamento (uma vez por lote)
+    int tempo_processamento = simular_tempo_processamento();
+    int execucoes = 0;
+    
+    // Cada negócio das ordens aceitas vai para o price updater
+    for (int i = 0; i < tamanho_lote; i++) {
+        processar_ordem_executor(sistema, &lote[i], tempo_processamento,
+                                 registrar_execucao_pendente, &execucoes);
+    }
+    
+    if (execucoes > 0) {
+        evento_notificar(&evento_execucoes);
+    }
+    
+    get_monotonic_time(&fim_lote);
+    registrar_ordens_shard(executor_id, tamanho_lote, calculate_time_diff_ms(inicio_lote, fim_lote));
+}
+
 // Função da thread executor
 void* thread_executor_func(void* arg) {
     ParametrosExecutor* params = (ParametrosExecutor*)arg;
     TradingSystem* sistema = params->sistema;
+    int executor_id = params->executor_id;
+    aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_EXECUTOR + executor_id);
     
-    printf("=== THREAD EXECUTOR INICIADA ===\n");
+    printf("=== THREAD EXECUTOR %d INICIADA ===\n", executor_id);
+    
+    Ordem lote[TAMANHO_MAX_LOTE_EXECUTOR];
     
     while (estado_mercado.sistema_ativo) {
-        // Remover ordem da fila
-        Ordem ordem;
-        if (remover_ordem_fila(&ordem)) {
-            printf("EXECUTOR: Processando ordem do Trader %d\n", ordem.trader_id);
-            
-            // Simular tempo de processamento
-            int tempo_processamento = simular_tempo_processamento();
-            
-            // Decidir se aceita ou rejeita a ordem
-            int resultado = decidir_aceitar_ordem(sistema, &ordem);
-            
-            // Log da execução
-            log_execucao_ordem(&ordem, resultado, tempo_processamento);
-            
-            // Atualizar contadores
-            atualizar_contadores_executor(sistema, resultado);
-            
-            // Se aceitou, executar a ordem
-            if (resultado) {
-                executar_ordem_aceita(sistema, &ordem);
-            }
+        // Remover lote de ordens do shard deste executor (bloqueia até haver ordens)
+        int tamanho_lote = remover_ordens_shard_lote(executor_id, lote, TAMANHO_MAX_LOTE_EXECUTOR);
+        if (tamanho_lote == 0) {
+            continue;
         }
         
-        // Pequena pausa
-        usleep(100000); // 100ms
+        processar_lote_executor(executor_id, lote, tamanho_lote, sistema);
     }
     
-    printf("=== THREAD EXECUTOR FINALIZADA ===\n");
+    printf("=== THREAD EXECUTOR %d FINALIZADA ===\n", executor_id);
     
     free(params);
     return NULL;
@@ -286,48 +544,67 @@ void* thread_executor_func(void* arg) {
 void* thread_price_updater_func(void* arg) {
     ParametrosPriceUpdater* params = (ParametrosPriceUpdater*)arg;
     TradingSystem* sistema = params->sistema;
+    aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_PRICE_UPDATER);
     
     printf("=== THREAD PRICE UPDATER INICIADA ===\n");
     
-    // Inicializar arquivo de histórico
-    inicializar_arquivo_historico();
-    
     int contador_snapshot = 0;
+    FonteReplay* replay = replay_sistema();
+    struct timespec proxima_variacao;
+    get_monotonic_time(&proxima_variacao);
+    proxima_variacao.tv_sec += INTERVALO_VARIACAO_MERCADO_MS / 1000;
     
     while (estado_mercado.sistema_ativo) {
-        // Atualização periódica de preços (simulação de mercado)
-        static int contador_periodico = 0;
-        contador_periodico++;
+        unsigned int observado = evento_observar(&evento_execucoes);
+        
+        // Refletir nos preços as execuções feitas pelo executor
+        int atualizadas = aplicar_execucoes_pendentes(sistema);
         
-        if (contador_periodico >= 30) { // A cada 30 iterações (3 segundos)
-            contador_periodico = 0;
+        struct timespec agora;
+        get_monotonic_time(&agora);
+        double ms_ate_variacao = calculate_time_diff_ms(agora, proxima_variacao);
+        
+        if (replay) {
+            // Replay: os ticks gravados substituem a variação aleatória; depois
+            // do último tick os preços só mudam com as execuções
+            int ms_ate_tick = INTERVALO_VARIACAO_MERCADO_MS;
+            if (!replay_concluido(replay)) {
+                int atualizadas_replay = replay_avancar(sistema, replay, LOTE_REPLAY_TICKS, &ms_ate_tick);
+                if (atualizadas_replay > 0) {
+                    atualizadas += atualizadas_replay;
+                    publicar_preco_atualizado(NULL);
+                }
+                if (replay_concluido(replay)) {
+                    LOG_INFO("PRICE UPDATER: Replay concluído (%lld ticks aplicados)\n", replay->aplicados);
+                    ms_ate_tick = INTERVALO_VARIACAO_MERCADO_MS;
+                }
+            }
+            ms_ate_variacao = ms_ate_tick;
+        } else if (ms_ate_variacao <= 0) { // Atualização periódica (simulação de mercado)
+            proxima_variacao = agora;
+            proxima_variacao.tv_sec += INTERVALO_VARIACAO_MERCADO_MS / 1000;
+            ms_ate_variacao = INTERVALO_VARIACAO_MERCADO_MS;
             
             // Atualizar preços de todas as ações
-            for (int i = 0; i < sistema->num_acoes; i++) {
-                Acao* acao = &sistema->acoes[i];
-                double preco_anterior = acao->preco_atual;
-                
-                // Simular variação de mercado
-                double variacao = (rand() % 200 - 100) / 10000.0; // ±1%
-                double novo_preco = preco_anterior * (1.0 + variacao);
-                
-                if (validar_preco(novo_preco, preco_anterior)) {
-                    atualizar_estatisticas_acao(sistema, i, novo_preco);
-                    log_atualizacao_preco(i, preco_anterior, novo_preco, "Variação de mercado");
-                }
+            atualizadas += aplicar_variacao_mercado(sistema);
+            if (atualizadas > 0) {
+                publicar_preco_atualizado(NULL);
             }
             
-            // Salvar snapshot a cada 10 atualizações periódicas
+            // Gravar os ticks pendentes a cada 10 atualizações periódicas
             contador_snapshot++;
             if (contador_snapshot >= 10) {
-                salvar_historico_precos(sistema);
+                historico_ticks_descarregar();
                 contador_snapshot = 0;
-                printf("PRICE UPDATER: Snapshot salvo no arquivo de histórico\n");
+                LOG_DEBUG("PRICE UPDATER: Ticks pendentes gravados no histórico\n");
             }
         }
         
-        // Pequena pausa
-        usleep(100000); // 100ms
+        // Aguardar novas execuções ou a próxima variação periódica
+        if (atualizadas == 0) {
+            aguardar_estagio(&evento_execucoes, observado,
+                             INTERVALO_POLLING_PRICE_UPDATER_MS, (int)ms_ate_variacao + 1);
+        }
     }
     
     printf("=== THREAD PRICE UPDATER FINALIZADA ===\n");
@@ -340,20 +617,56 @@ void* thread_price_updater_func(void* arg) {
 void* thread_arbitrage_monitor_func(void* arg) {
     ParametrosArbitrageMonitor* params = (ParametrosArbitrageMonitor*)arg;
     TradingSystem* sistema = params->sistema;
+    aleatorio_iniciar_fluxo(FLUXO_ALEATORIO_ARBITRAGEM);
     
     printf("=== THREAD ARBITRAGE MONITOR INICIADA ===\n");
     
+    struct timespec proximo_ciclo;
+    get_monotonic_time(&proximo_ciclo);
+    
     while (estado_mercado.sistema_ativo) {
-        // Monitorar arbitragem
-        monitorar_arbitragem(sistema);
-        detectar_padroes_preco(sistema);
+        unsigned int observado = evento_observar(&evento_precos);
+        
+        // Consumir preços publicados pelo price updater
+        pthread_mutex_lock(&mutex_pipeline);
+        int havia_precos = precos_pendentes;
+        int havia_origem = origem_execucao_pendente;
+        struct timespec instante_preco = instante_preco_pendente;
+        struct timespec origem_execucao = origem_preco_pendente;
+        precos_pendentes = 0;
+        origem_execucao_pendente = 0;
+        pthread_mutex_unlock(&mutex_pipeline);
+        
+        struct timespec agora;
+        get_monotonic_time(&agora);
+        int ciclo_periodico = calculate_time_diff_ms(agora, proximo_ciclo) <= 0;
         
-        // Simular eventos de mercado ocasionalmente
-        if (rand() % 100 < 5) { // 5% de chance
-            simular_evento_mercado(sistema);
+        if (havia_precos || ciclo_periodico) {
+            // Monitorar arbitragem
+            monitorar_arbitragem(sistema);
+            detectar_padroes_preco(sistema);
+            
+            if (havia_precos) {
+                get_monotonic_time(&agora);
+                registrar_latencia_preco_arbitragem(
+                    calculate_time_diff_ms(instante_preco, agora),
+                    havia_origem ? calculate_time_diff_ms(origem_execucao, agora) : -1.0);
+            }
+        }
+        
+        if (ciclo_periodico) {
+            // Simular eventos de mercado ocasionalmente
+            if (aleatorio_proximo() % 100 < 5) { // 5% de chance
+                simular_evento_mercado(sistema);
+            }
+            proximo_ciclo = agora;
+            proximo_ciclo.tv_sec += INTERVALO_CICLO_ARBITRAGEM_MS / 1000;
         }
         
-        sleep(5); // Monitorar a cada 5 segundos
+        // Aguardar novos preços ou o próximo ciclo periódico
+        double ms_ate_ciclo = calculate_time_diff_ms(agora, proximo_ciclo);
+        aguardar_estagio(&evento_precos, observado, INTERVALO_POLLING_ARBITRAGEM_MS,
+                         ms_ate_ciclo > 0 ? (int)ms_ate_ciclo + 1 : 0);
     }
     
     printf("=== THREAD ARBITRAGE MONITOR FINALIZADA ===\n");
@@ -399,34 +712,51 @@ int criar_thread_trader(int trader_id, int perfil_id) {
     return 1;
 }
 
-// Função para criar thread executor
+// Função para criar as threads executoras (uma por shard de ações)
 int criar_thread_executor() {
-    if (thread_executor_ativa) {
-        printf("AVISO: Thread executor já está ativa\n");
-        return 0;
-    }
-    
-    // Alocar parâmetros
-    ParametrosExecutor* params = malloc(sizeof(ParametrosExecutor));
-    if (!params) {
-        printf("ERRO: Falha ao alocar memória para parâmetros do executor\n");
-        return 0;
+    int criadas = 0;
+    
+    // Roubo de trabalho: o escalonador cria e gerencia suas próprias threads
+    if (modo_escalonador == MODO_ESCALONADOR_ROUBO) {
+        escalonador_inicializar(num_executores, MODO_ESCALONADOR_ROUBO,
+                                processar_lote_executor, sistema_global);
+        if (!escalonador_iniciar()) {
+            return 0;
+        }
+        printf("✓ Escalonador com roubo de trabalho iniciado (%d executores)\n", num_executores);
+        return 1;
     }
     
-    params->sistema = sistema_global;
-    
-    // Criar thread
-    int resultado = pthread_create(&thread_executor, NULL, thread_executor_func, params);
-    
-    if (!verificar_retorno_pthread(resultado, "pthread_create executor")) {
-        free(params);
-        return 0;
+    for (int i = 0; i < num_executores; i++) {
+        if (threads_executores_ativas[i]) {
+            printf("AVISO: Thread executor %d já está ativa\n", i);
+            continue;
+        }
+        
+        // Alocar parâmetros
+        ParametrosExecutor* params = malloc(sizeof(ParametrosExecutor));
+        if (!params) {
+            printf("ERRO: Falha ao alocar memória para parâmetros do executor %d\n", i);
+            continue;
+        }
+        
+        params->executor_id = i;
+        params->sistema = sistema_global;
+        
+        // Criar thread
+        int resultado = pthread_create(&threads_executores[i], NULL, thread_executor_func, params);
+        
+        if (!verificar_retorno_pthread(resultado, "pthread_create executor")) {
+            free(params);
+            continue;
+        }
+        
+        threads_executores_ativas[i] = 1;
+        criadas++;
+        printf("✓ Thread executor %d criada com sucesso\n", i);
     }
     
-    thread_executor_ativa = 1;
-    printf("✓ Thread executor criada com sucesso\n");
-    
-    return 1;
+    return criadas > 0;
 }
 
 // Função para criar thread price updater
@@ -497,6 +827,14 @@ void parar_todas_threads() {
     estado_mercado.sistema_ativo = 0;
     pthread_mutex_unlock(&estado_mercado.mutex);
     
+    // Acordar estágios bloqueados em eventos para que vejam a parada
+    for (int i = 0; i < MAX_EXECUTORES; i++) {
+        evento_notificar_todos(&eventos_ordens[i]);
+    }
+    evento_notificar_todos(&evento_execucoes);
+    evento_notificar_todos(&evento_precos);
+    parar_detector_arbitragem();
+    
     printf("✓ Sinal de parada enviado para todas as threads\n");
 }
 
@@ -516,13 +854,21 @@ void aguardar_threads_terminarem() {
         }
     }
     
-    // Aguardar thread executor
-    if (thread_executor_ativa) {
-        printf("Aguardando thread executor...\n");
-        int resultado = pthread_join(thread_executor, NULL);
-        if (verificar_retorno_pthread(resultado, "pthread_join executor")) {
-            thread_executor_ativa = 0;
-            printf("✓ Thread executor finalizada\n");
+    // Aguardar threads executoras
+    if (modo_escalonador == MODO_ESCALONADOR_ROUBO) {
+        printf("Aguardando executores do escalonador...\n");
+        escalonador_parar();
+        escalonador_imprimir_estatisticas();
+        printf("✓ Executores do escalonador finalizados\n");
+    }
+    for (int i = 0; i < MAX_EXECUTORES; i++) {
+        if (threads_executores_ativas[i]) {
+            printf("Aguardando thread executor %d...\n", i);
+            int resultado = pthread_join(threads_executores[i], NULL);
+            if (verificar_retorno_pthread(resultado, "pthread_join executor")) {
+                threads_executores_ativas[i] = 0;
+                printf("✓ Thread executor %d finalizada\n", i);
+            }
         }
     }
     
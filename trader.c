@@ -44,12 +44,14 @@ void inicializar_traders(TradingSystem* sistema) {
     for (int i = 0; i < MAX_TRADERS; i++) {
         sistema->traders[i].id = i;
         strcpy(sistema->traders[i].nome, nomes[i]);
-        sistema->traders[i].saldo = 100000.0; // Saldo inicial de 100k
+        sistema->traders[i].saldo = 100000 * ESCALA_PRECO; // Saldo inicial de 100k
         
-        // Inicializar posições em ações
+        // Inicializar posições em ações (carteira inicial para haver vendedores no livro)
         for (int j = 0; j < MAX_ACOES; j++) {
-            sistema->traders[i].acoes_possuidas[j] = 0;
+            sistema->traders[i].acoes_possuidas[j] = POSICAO_INICIAL_ACOES;
+            sistema->traders[i].acoes_reservadas[j] = 0;
         }
+        sistema->traders[i].saldo_reservado = 0;
         
         // Inicializar mutex
         pthread_mutex_init(&sistema->traders[i].mutex, NULL);
@@ -115,22 +117,24 @@ void executar_estrategia_conservadora(TradingSystem* sistema, int trader_id) {
     // Estratégia conservadora: compra quando preço está baixo, vende quando está alto
     for (int i = 0; i < sistema->num_acoes; i++) {
         Acao* acao = &sistema->acoes[i];
-        double preco_atual = acao->preco_atual;
+        InstantaneoPreco instantaneo;
+        ler_preco_acao(acao, &instantaneo);
+        preco_t preco_atual = instantaneo.preco_atual;
         
         // Comprar se preço caiu mais de 5%
-        if (preco_atual < acao->preco_anterior * 0.95 && trader->saldo > preco_atual * 10) {
+        if (preco_atual * 100 < instantaneo.preco_anterior * 95 && trader->saldo > preco_atual * 10) {
             int quantidade = 10;
             criar_ordem(sistema, trader_id, i, 'C', preco_atual, quantidade);
             printf("Trader %d (Conservador): Comprou %d ações de %s a %.2f\n", 
-                   trader_id, quantidade, acao->nome, preco_atual);
+                   trader_id, quantidade, acao->nome, PRECO_EM_REAIS(preco_atual));
         }
         
         // Vender se preço subiu mais de 5% e possui ações
-        if (preco_atual > acao->preco_anterior * 1.05 && trader->acoes_possuidas[i] > 0) {
+        if (preco_atual * 100 > instantaneo.preco_anterior * 105 && trader->acoes_possuidas[i] > 0) {
             int quantidade = trader->acoes_possuidas[i] > 10 ? 10 : trader->acoes_possuidas[i];
             criar_ordem(sistema, trader_id, i, 'V', preco_atual, quantidade);
             printf("Trader %d (Conservador): Vendeu %d ações de %s a %.2f\n", 
-                   trader_id, quantidade, acao->nome, preco_atual);
+                   trader_id, quantidade, acao->nome, PRECO_EM_REAIS(preco_atual));
         }
     }
 }
@@ -141,48 +145,64 @@ void executar_estrategia_agressiva(TradingSystem* sistema, int trader_id) {
     // Estratégia agressiva: opera com volumes maiores e frequência maior
     for (int i = 0; i < sistema->num_acoes; i++) {
         Acao* acao = &sistema->acoes[i];
-        double preco_atual = acao->preco_atual;
+        InstantaneoPreco instantaneo;
+        ler_preco_acao(acao, &instantaneo);
+        preco_t preco_atual = instantaneo.preco_atual;
         
         // Comprar se há tendência de alta
-        if (acao->variacao > 0.02 && trader->saldo > preco_atual * 50) {
+        if (instantaneo.variacao > 0.02 && trader->saldo > preco_atual * 50) {
             int quantidade = 50;
             criar_ordem(sistema, trader_id, i, 'C', preco_atual, quantidade);
             printf("Trader %d (Agressivo): Comprou %d ações de %s a %.2f\n", 
-                   trader_id, quantidade, acao->nome, preco_atual);
+                   trader_id, quantidade, acao->nome, PRECO_EM_REAIS(preco_atual));
         }
         
         // Vender se há tendência de baixa
-        if (acao->variacao < -0.02 && trader->acoes_possuidas[i] > 0) {
+        if (instantaneo.variacao < -0.02 && trader->acoes_possuidas[i] > 0) {
             int quantidade = trader->acoes_possuidas[i] > 50 ? 50 : trader->acoes_possuidas[i];
             criar_ordem(sistema, trader_id, i, 'V', preco_atual, quantidade);
             printf("Trader %d (Agressivo): Vendeu %d ações de %s a %.2f\n", 
-                   trader_id, quantidade, acao->nome, preco_atual);
+                   trader_id, quantidade, acao->nome, PRECO_EM_REAIS(preco_atual));
         }
     }
 }
 
+// Função para medir a tendência pelas barras de 1 minuto: fechamento da
+// barra corrente contra o da anterior (com menos de duas barras, a variação
+// do último preço)
+static double tendencia_barras(int acao_id, double variacao_preco) {
+    BarraOHLCV barras[2];
+    if (barras_recentes(acao_id, PERIODO_BARRA_1MIN, barras, 2) < 2 || barras[1].fechamento <= 0) {
+        return variacao_preco;
+    }
+    return (double)(barras[0].fechamento - barras[1].fechamento) / barras[1].fechamento;
+}
+
 void executar_estrategia_momentum(TradingSystem* sistema, int trader_id) {
     Trader* trader = &sistema->traders[trader_id];
     
-    // Estratégia momentum: segue a tendência
+    // Estratégia momentum: segue a tendência das barras de 1 minuto
     for (int i = 0; i < sistema->num_acoes; i++) {
         Acao* acao = &sistema->acoes[i];
-        double preco_atual = acao->preco_atual;
+        InstantaneoPreco instantaneo;
+        ler_preco_acao(acao, &instantaneo);
+        preco_t preco_atual = instantaneo.preco_atual;
+        double tendencia = tendencia_barras(i, instantaneo.variacao);
         
         // Comprar se momentum é positivo
-        if (acao->variacao > 0.01 && trader->saldo > preco_atual * 20) {
+        if (tendencia > 0.01 && trader->saldo > preco_atual * 20) {
             int quantidade = 20;
             criar_ordem(sistema, trader_id, i, 'C', preco_atual, quantidade);
             printf("Trader %d (Momentum): Comprou %d ações de %s a %.2f\n", 
-                   trader_id, quantidade, acao->nome, preco_atual);
+                   trader_id, quantidade, acao->nome, PRECO_EM_REAIS(preco_atual));
         }
         
         // Vender se momentum é negativo
-        if (acao->variacao < -0.01 && trader->acoes_possuidas[i] > 0) {
+        if (tendencia < -0.01 && trader->acoes_possuidas[i] > 0) {
             int quantidade = trader->acoes_possuidas[i] > 20 ? 20 : trader->acoes_possuidas[i];
             criar_ordem(sistema, trader_id, i, 'V', preco_atual, quantidade);
             printf("Trader %d (Momentum): Vendeu %d ações de %s a %.2f\n", 
-                   trader_id, quantidade, acao->nome, preco_atual);
+                   trader_id, quantidade, acao->nome, PRECO_EM_REAIS(preco_atual));
         }
     }
 }
@@ -193,22 +213,24 @@ void executar_estrategia_mean_reversion(TradingSystem* sistema, int trader_id) {
     // Estratégia mean reversion: acredita que preços voltam à média
     for (int i = 0; i < sistema->num_acoes; i++) {
         Acao* acao = &sistema->acoes[i];
-        double preco_atual = acao->preco_atual;
+        InstantaneoPreco instantaneo;
+        ler_preco_acao(acao, &instantaneo);
+        preco_t preco_atual = instantaneo.preco_atual;
         
         // Comprar se preço está muito baixo (reversão esperada)
-        if (preco_atual < acao->preco_anterior * 0.90 && trader->saldo > preco_atual * 15) {
+        if (preco_atual * 100 < instantaneo.preco_anterior * 90 && trader->saldo > preco_atual * 15) {
             int quantidade = 15;
             criar_ordem(sistema, trader_id, i, 'C', preco_atual, quantidade);
             printf("Trader %d (Mean Reversion): Comprou %d ações de %s a %.2f\n", 
-                   trader_id, quantidade, acao->nome, preco_atual);
+                   trader_id, quantidade, acao->nome, PRECO_EM_REAIS(preco_atual));
         }
         
         // Vender se preço está muito alto (reversão esperada)
-        if (preco_atual > acao->preco_anterior * 1.10 && trader->acoes_possuidas[i] > 0) {
+        if (preco_atual * 100 > instantaneo.preco_anterior * 110 && trader->acoes_possuidas[i] > 0) {
             int quantidade = trader->acoes_possuidas[i] > 15 ? 15 : trader->acoes_possuidas[i];
             criar_ordem(sistema, trader_id, i, 'V', preco_atual, quantidade);
             printf("Trader %d (Mean Reversion): Vendeu %d ações de %s a %.2f\n", 
-                   trader_id, quantidade, acao->nome, preco_atual);
+                   trader_id, quantidade, acao->nome, PRECO_EM_REAIS(preco_atual));
         }
     }
 }
@@ -221,18 +243,19 @@ void executar_estrategia_arbitragem(TradingSystem* sistema, int trader_id) {
         for (int j = i + 1; j < sistema->num_acoes; j++) {
             Acao* acao1 = &sistema->acoes[i];
             Acao* acao2 = &sistema->acoes[j];
+            preco_t preco1 = ler_preco_atual(acao1);
+            preco_t preco2 = ler_preco_atual(acao2);
             
-            double diferenca = fabs(acao1->preco_atual - acao2->preco_atual);
-            double media = (acao1->preco_atual + acao2->preco_atual) / 2.0;
-            double percentual_diferenca = diferenca / media;
+            preco_t diferenca = llabs(preco1 - preco2);
+            preco_t soma = preco1 + preco2;
             
-            // Se diferença é maior que 3%, há oportunidade de arbitragem
-            if (percentual_diferenca > 0.03) {
-                if (acao1->preco_atual < acao2->preco_atual && trader->saldo > acao1->preco_atual * 10) {
+            // Se diferença é maior que 3% da média, há oportunidade de arbitragem
+            if (diferenca * 200 > soma * 3) {
+                if (preco1 < preco2 && trader->saldo > preco1 * 10) {
                     // Comprar a mais barata
-                    criar_ordem(sistema, trader_id, i, 'C', acao1->preco_atual, 10);
+                    criar_ordem(sistema, trader_id, i, 'C', preco1, 10);
                     printf("Trader %d (Arbitragem): Comprou %s (mais barata) a %.2f\n", 
-                           trader_id, acao1->nome, acao1->preco_atual);
+                           trader_id, acao1->nome, PRECO_EM_REAIS(preco1));
                 }
             }
         }
@@ -243,24 +266,24 @@ void executar_estrategia_aleatoria(TradingSystem* sistema, int trader_id) {
     Trader* trader = &sistema->traders[trader_id];
     
     // Estratégia aleatória: toma decisões baseadas em probabilidade
-    int acao_aleatoria = rand() % sistema->num_acoes;
+    int acao_aleatoria = aleatorio_proximo() % sistema->num_acoes;
     Acao* acao = &sistema->acoes[acao_aleatoria];
-    double preco_atual = acao->preco_atual;
+    preco_t preco_atual = ler_preco_atual(acao);
     
-    int decisao = rand() % 100;
+    int decisao = aleatorio_proximo() % 100;
     
     if (decisao < 30 && trader->saldo > preco_atual * 5) {
         // 30% de chance de comprar
         int quantidade = 5;
         criar_ordem(sistema, trader_id, acao_aleatoria, 'C', preco_atual, quantidade);
         printf("Trader %d (Aleatório): Comprou %d ações de %s a %.2f\n", 
-               trader_id, quantidade, acao->nome, preco_atual);
+               trader_id, quantidade, acao->nome, PRECO_EM_REAIS(preco_atual));
     } else if (decisao > 70 && trader->acoes_possuidas[acao_aleatoria] > 0) {
         // 30% de chance de vender
         int quantidade = trader->acoes_possuidas[acao_aleatoria] > 5 ? 5 : trader->acoes_possuidas[acao_aleatoria];
         criar_ordem(sistema, trader_id, acao_aleatoria, 'V', preco_atual, quantidade);
         printf("Trader %d (Aleatório): Vendeu %d ações de %s a %.2f\n", 
-               trader_id, quantidade, acao->nome, preco_atual);
+               trader_id, quantidade, acao->nome, PRECO_EM_REAIS(preco_atual));
     }
 }
 
@@ -269,7 +292,7 @@ void imprimir_estado_traders(TradingSystem* sistema) {
     for (int i = 0; i < sistema->num_traders; i++) {
         Trader* trader = &sistema->traders[i];
         printf("Trader %d (%s):\n", trader->id, trader->nome);
-        printf("  Saldo: R$ %.2f\n", trader->saldo);
+        printf("  Saldo: R$ %.2f\n", PRECO_EM_REAIS(trader->saldo));
         printf("  Ações possuídas:\n");
         
         for (int j = 0; j < sistema->num_acoes; j++) {
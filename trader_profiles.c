@@ -8,7 +8,7 @@ static PerfilTrader perfis_trader[3];
 
 // Função para inicializar perfis de trader
 void inicializar_perfis_trader() {
-    printf("=== INICIALIZANDO PERFIS DE TRADER ===\n");
+    LOG_INFO("=== INICIALIZANDO PERFIS DE TRADER ===\n");
     
     // Perfil Conservador
     perfis_trader[PERFIL_CONSERVADOR].perfil_id = PERFIL_CONSERVADOR;
@@ -52,11 +52,11 @@ void inicializar_perfis_trader() {
     perfis_trader[PERFIL_DAY_TRADER].acoes_preferidas[3] = 8; // LREN3
     perfis_trader[PERFIL_DAY_TRADER].num_acoes_preferidas = 4;
     
-    printf("✓ Perfis de trader inicializados:\n");
+    LOG_INFO("✓ Perfis de trader inicializados:\n");
     for (int i = 0; i < 3; i++) {
-        printf("  - %s (ID: %d)\n", perfis_trader[i].nome, perfis_trader[i].perfil_id);
+        LOG_INFO("  - %s (ID: %d)\n", perfis_trader[i].nome, perfis_trader[i].perfil_id);
     }
-    printf("\n");
+    LOG_INFO("\n");
 }
 
 // Função para obter perfil de trader
@@ -70,24 +70,24 @@ PerfilTrader* obter_perfil_trader(int perfil_id) {
 // Função para aplicar perfil a um trader
 void aplicar_perfil_trader(TradingSystem* sistema, int trader_id, int perfil_id) {
     if (trader_id < 0 || trader_id >= MAX_TRADERS) {
-        printf("ERRO: Trader ID inválido: %d\n", trader_id);
+        LOG_ERRO("ERRO: Trader ID inválido: %d\n", trader_id);
         return;
     }
     
     PerfilTrader* perfil = obter_perfil_trader(perfil_id);
     if (!perfil) {
-        printf("ERRO: Perfil inválido: %d\n", perfil_id);
+        LOG_ERRO("ERRO: Perfil inválido: %d\n", perfil_id);
         return;
     }
     
     Trader* trader = &sistema->traders[trader_id];
-    printf("Aplicando perfil '%s' ao trader %d (%s)\n", 
+    LOG_INFO("Aplicando perfil '%s' ao trader %d (%s)\n", 
            perfil->nome, trader_id, trader->nome);
 }
 
 // Função para gerar intervalo aleatório
 int gerar_intervalo_aleatorio(int min, int max) {
-    return min + (rand() % (max - min + 1));
+    return min + (aleatorio_proximo() % (max - min + 1));
 }
 
 // Função para calcular probabilidade de compra baseada no preço
@@ -96,8 +96,9 @@ double calcular_probabilidade_compra(TradingSystem* sistema, int acao_id, Perfil
         return 0.0;
     }
     
-    Acao* acao = &sistema->acoes[acao_id];
-    double variacao = acao->variacao;
+    InstantaneoPreco instantaneo;
+    ler_preco_acao(&sistema->acoes[acao_id], &instantaneo);
+    double variacao = instantaneo.variacao;
     
     // Base: 30% de probabilidade
     double probabilidade = 0.3;
@@ -124,8 +125,9 @@ double calcular_probabilidade_venda(TradingSystem* sistema, int acao_id, PerfilT
         return 0.0;
     }
     
-    Acao* acao = &sistema->acoes[acao_id];
-    double variacao = acao->variacao;
+    InstantaneoPreco instantaneo;
+    ler_preco_acao(&sistema->acoes[acao_id], &instantaneo);
+    double variacao = instantaneo.variacao;
     
     // Base: 20% de probabilidade
     double probabilidade = 0.2;
@@ -146,32 +148,55 @@ double calcular_probabilidade_venda(TradingSystem* sistema, int acao_id, PerfilT
     return probabilidade;
 }
 
-// Função para decidir ação do trader
-int decidir_acao_trader(TradingSystem* sistema, int trader_id, PerfilTrader* perfil) {
+// Sorteia uma das ações preferidas e decide se o trader opera nela
+// Retorna 'C' (compra), 'V' (venda) ou 0 se não opera; a ação vai em *acao_id
+static char sortear_operacao_trader(TradingSystem* sistema, int trader_id, PerfilTrader* perfil, int* acao_id) {
     Trader* trader = &sistema->traders[trader_id];
     
     // Escolher ação aleatória das preferidas
-    int acao_id = perfil->acoes_preferidas[rand() % perfil->num_acoes_preferidas];
-    Acao* acao = &sistema->acoes[acao_id];
+    *acao_id = perfil->acoes_preferidas[aleatorio_proximo() % perfil->num_acoes_preferidas];
+    preco_t preco_atual = ler_preco_atual(&sistema->acoes[*acao_id]);
     
-    double prob_compra = calcular_probabilidade_compra(sistema, acao_id, perfil);
-    double prob_venda = calcular_probabilidade_venda(sistema, acao_id, perfil);
+    double prob_compra = calcular_probabilidade_compra(sistema, *acao_id, perfil);
+    double prob_venda = calcular_probabilidade_venda(sistema, *acao_id, perfil);
     
-    double random = (double)rand() / RAND_MAX;
+    double random = (double)aleatorio_proximo() / ALEATORIO_MAX;
     
     // Decidir ação baseada nas probabilidades
-    if (random < prob_compra && trader->saldo > acao->preco_atual * perfil->volume_medio) {
+    if (random < prob_compra && trader->saldo > preco_atual * (long long)perfil->volume_medio) {
+        return 'C';
+    } else if (random < (prob_compra + prob_venda) && trader->acoes_possuidas[*acao_id] > 0) {
+        return 'V';
+    }
+    return 0;
+}
+
+// Função para escolher a ação em que o trader vai operar (sem criar ordem)
+// Retorna o id da ação ou -1 se o trader não opera nesta rodada
+int escolher_acao_trader(TradingSystem* sistema, int trader_id, PerfilTrader* perfil) {
+    int acao_id;
+    return sortear_operacao_trader(sistema, trader_id, perfil, &acao_id) ? acao_id : -1;
+}
+
+// Função para decidir ação do trader
+int decidir_acao_trader(TradingSystem* sistema, int trader_id, PerfilTrader* perfil) {
+    Trader* trader = &sistema->traders[trader_id];
+    int acao_id;
+    char tipo = sortear_operacao_trader(sistema, trader_id, perfil, &acao_id);
+    preco_t preco_atual = ler_preco_atual(&sistema->acoes[acao_id]);
+    
+    if (tipo == 'C') {
         // Comprar
-        int quantidade = (int)(perfil->volume_medio * (0.8 + 0.4 * ((double)rand() / RAND_MAX)));
-        criar_ordem(sistema, trader_id, acao_id, 'C', acao->preco_atual, quantidade);
-        log_ordem_trader(trader_id, acao_id, 'C', acao->preco_atual, quantidade, "Probabilidade de compra");
+        int quantidade = (int)(perfil->volume_medio * (0.8 + 0.4 * ((double)aleatorio_proximo() / ALEATORIO_MAX)));
+        criar_ordem(sistema, trader_id, acao_id, 'C', preco_atual, quantidade);
+        log_ordem_trader(trader_id, acao_id, 'C', preco_atual, quantidade, "Probabilidade de compra");
         return 1; // Ordem criada
-    } else if (random < (prob_compra + prob_venda) && trader->acoes_possuidas[acao_id] > 0) {
+    } else if (tipo == 'V') {
         // Vender
         int quantidade = trader->acoes_possuidas[acao_id] > perfil->volume_medio ? 
                         (int)perfil->volume_medio : trader->acoes_possuidas[acao_id];
-        criar_ordem(sistema, trader_id, acao_id, 'V', acao->preco_atual, quantidade);
-        log_ordem_trader(trader_id, acao_id, 'V', acao->preco_atual, quantidade, "Probabilidade de venda");
+        criar_ordem(sistema, trader_id, acao_id, 'V', preco_atual, quantidade);
+        log_ordem_trader(trader_id, acao_id, 'V', preco_atual, quantidade, "Probabilidade de venda");
         return 1; // Ordem criada
     }
     
@@ -179,21 +204,24 @@ int decidir_acao_trader(TradingSystem* sistema, int trader_id, PerfilTrader* per
 }
 
 // Função para log detalhado de ordens
-void log_ordem_trader(int trader_id, int acao_id, char tipo, double preco, int quantidade, const char* motivo) {
+void log_ordem_trader(int trader_id, int acao_id, char tipo, preco_t preco, int quantidade, const char* motivo) {
     (void)acao_id; // Evitar warning de parâmetro não utilizado
-    time_t agora = time(NULL);
+    if (!LOG_HABILITADO(NIVEL_LOG_DEBUG)) {
+        return; // Sem formatar o horário à toa
+    }
+    time_t agora = relogio_mercado();
     char timestamp[64];
     strftime(timestamp, sizeof(timestamp), "%H:%M:%S", localtime(&agora));
     
-    printf("[%s] TRADER %d: %s %d ações a R$ %.2f (%s)\n", 
+    LOG_DEBUG("[%s] TRADER %d: %s %d ações a R$ %.2f (%s)\n", 
            timestamp, trader_id, 
            tipo == 'C' ? "COMPRA" : "VENDA", 
-           quantidade, preco, motivo);
+           quantidade, PRECO_EM_REAIS(preco), motivo);
 }
 
 // Função principal do processo trader melhorado
 void processo_trader_melhorado(int trader_id, int perfil_id) {
-    printf("=== PROCESSO TRADER %d INICIADO (PID: %d, Perfil: %d) ===\n", 
+    LOG_INFO("=== PROCESSO TRADER %d INICIADO (PID: %d, Perfil: %d) ===\n", 
            trader_id, getpid(), perfil_id);
     
     // Anexar memória compartilhada
@@ -206,7 +234,7 @@ void processo_trader_melhorado(int trader_id, int perfil_id) {
     // Obter perfil do trader
     PerfilTrader* perfil = obter_perfil_trader(perfil_id);
     if (!perfil) {
-        printf("ERRO: Perfil inválido %d para trader %d\n", perfil_id, trader_id);
+        LOG_ERRO("ERRO: Perfil inválido %d para trader %d\n", perfil_id, trader_id);
         shmdt(sistema);
         exit(1);
     }
@@ -216,8 +244,8 @@ void processo_trader_melhorado(int trader_id, int perfil_id) {
     time_t inicio_sessao = time(NULL);
     time_t ultima_ordem = 0;
     
-    printf("Trader %d iniciado com perfil '%s'\n", trader_id, perfil->nome);
-    printf("Configurações: intervalo %d-%ds, max %d ordens, tempo limite %ds\n",
+    LOG_INFO("Trader %d iniciado com perfil '%s'\n", trader_id, perfil->nome);
+    LOG_INFO("Configurações: intervalo %d-%ds, max %d ordens, tempo limite %ds\n",
            perfil->intervalo_min_ordens, perfil->intervalo_max_ordens,
            perfil->max_ordens_por_sessao, perfil->tempo_limite_sessao);
     
@@ -226,12 +254,12 @@ void processo_trader_melhorado(int trader_id, int perfil_id) {
         
         // Verificar limites de tempo e ordens
         if (agora - inicio_sessao > perfil->tempo_limite_sessao) {
-            printf("Trader %d: Tempo limite atingido (%ds)\n", trader_id, perfil->tempo_limite_sessao);
+            LOG_INFO("Trader %d: Tempo limite atingido (%ds)\n", trader_id, perfil->tempo_limite_sessao);
             break;
         }
         
         if (ordens_enviadas >= perfil->max_ordens_por_sessao) {
-            printf("Trader %d: Limite de ordens atingido (%d)\n", trader_id, perfil->max_ordens_por_sessao);
+            LOG_INFO("Trader %d: Limite de ordens atingido (%d)\n", trader_id, perfil->max_ordens_por_sessao);
             break;
         }
         
@@ -244,7 +272,7 @@ void processo_trader_melhorado(int trader_id, int perfil_id) {
                 ordens_enviadas++;
                 ultima_ordem = agora;
                 
-                printf("Trader %d: Ordem criada (total: %d/%d)\n", 
+                LOG_DEBUG("Trader %d: Ordem criada (total: %d/%d)\n", 
                        trader_id, ordens_enviadas, perfil->max_ordens_por_sessao);
             }
         }
@@ -255,10 +283,10 @@ void processo_trader_melhorado(int trader_id, int perfil_id) {
     
     // Estatísticas finais
     time_t duracao = time(NULL) - inicio_sessao;
-    printf("=== TRADER %d FINALIZADO ===\n", trader_id);
-    printf("Duração: %lds\n", duracao);
-    printf("Ordens enviadas: %d/%d\n", ordens_enviadas, perfil->max_ordens_por_sessao);
-    printf("Perfil: %s\n", perfil->nome);
+    LOG_INFO("=== TRADER %d FINALIZADO ===\n", trader_id);
+    LOG_INFO("Duração: %lds\n", duracao);
+    LOG_INFO("Ordens enviadas: %d/%d\n", ordens_enviadas, perfil->max_ordens_por_sessao);
+    LOG_INFO("Perfil: %s\n", perfil->nome);
     
     // Desanexar memória compartilhada
     shmdt(sistema);
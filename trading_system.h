@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include <pthread.h>
 #include <unistd.h>
 #include <time.h>
@@ -17,12 +18,52 @@
 #include <sys/shm.h>
 #include <poll.h>
 
+// Preço em ponto fixo: inteiro de 64 bits em unidades de R$ 0,0001.
+// Preços de ordens, ações, livros e saldos circulam como preco_t; a conversão
+// para reais (double) só acontece na exibição, em arquivos e em estatísticas.
+typedef long long preco_t;
+#define ESCALA_PRECO 10000LL // Unidades de preco_t por real
+#define PRECO_DE_REAIS(reais) ((preco_t)llround((reais) * ESCALA_PRECO))
+#define PRECO_EM_REAIS(preco) ((double)(preco) / ESCALA_PRECO)
+
+// Níveis de log das mensagens dos módulos
+#define NIVEL_LOG_ERRO 0
+#define NIVEL_LOG_AVISO 1
+#define NIVEL_LOG_INFO 2   // Início/fim de componentes, negócios, resumos
+#define NIVEL_LOG_DEBUG 3  // Mensagens por ordem, por preço e por ciclo
+
+// Maior nível compilado; o alvo release usa NIVEL_LOG_INFO e as chamadas
+// LOG_DEBUG somem do binário. Os níveis compilados são filtrados em tempo de
+// execução por nivel_log_atual (TRADING_LOG_NIVEL), com um único desvio
+#ifndef NIVEL_LOG_COMPILADO
+#define NIVEL_LOG_COMPILADO NIVEL_LOG_DEBUG
+#endif
+
+extern int nivel_log_atual;
+
+#define LOG_HABILITADO(nivel) ((nivel) <= NIVEL_LOG_COMPILADO && (nivel) <= nivel_log_atual)
+
+#define LOG_NIVEL(nivel, ...) \
+    do { \
+        if (LOG_HABILITADO(nivel)) { \
+            printf(__VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_ERRO(...) LOG_NIVEL(NIVEL_LOG_ERRO, __VA_ARGS__)
+#define LOG_AVISO(...) LOG_NIVEL(NIVEL_LOG_AVISO, __VA_ARGS__)
+#define LOG_INFO(...) LOG_NIVEL(NIVEL_LOG_INFO, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_NIVEL(NIVEL_LOG_DEBUG, __VA_ARGS__)
+
 // Constantes do sistema
 #define MAX_ACOES 13
 #define MAX_TRADERS 6
-#define MAX_ORDENS 100
+#define ORDENS_POR_SLAB 4096        // Ordens por bloco do pool (potência de dois)
+#define MAX_SLABS_ORDENS 1024       // Blocos do pool de ordens (até ~4M ordens)
+#define MAX_ORDENS (ORDENS_POR_SLAB * MAX_SLABS_ORDENS)
 #define MAX_NOME 50
 #define MAX_STRATEGY 20
+#define TAMANHO_CACHE_LINE 64
 
 // Constantes para perfis de trader
 #define PERFIL_CONSERVADOR 0
@@ -44,12 +85,14 @@
 #define MIN_VOLUME_ACEITO 10        // Volume mínimo aceito por ordem
 
 // Constantes para price updater
-#define MAX_VARIACAO_PRECO 0.20     // 20% de variação máxima
-#define MIN_PRECO_ACAO 0.50         // Preço mínimo de ação
-#define MAX_PRECO_ACAO 1000.0       // Preço máximo de ação
-#define PESO_ULTIMA_TRANSACAO 0.6   // Peso da última transação (60%)
-#define PESO_PRECO_ATUAL 0.4        // Peso do preço atual (40%)
-#define ARQUIVO_HISTORICO "historico_precos.txt" // Arquivo para salvar histórico
+#define MAX_VARIACAO_PRECO 20       // Variação máxima (%)
+#define MIN_PRECO_ACAO (ESCALA_PRECO / 2)  // Preço mínimo de ação (R$ 0,50)
+#define MAX_PRECO_ACAO (ESCALA_PRECO * 1000) // Preço máximo de ação (R$ 1000,00)
+#define TAMANHO_TICK_PADRAO (ESCALA_PRECO / 100) // Menor variação de preço padrão (R$ 0,01)
+#define POSICAO_INICIAL_ACOES 1000  // Ações de cada papel na carteira inicial do trader
+#define PESO_ULTIMA_TRANSACAO 60    // Peso da última transação (%)
+#define PESO_PRECO_ATUAL 40         // Peso do preço atual (%)
+#define ARQUIVO_TICKS "historico_ticks.bin" // Histórico binário de ticks (TRADING_HISTORICO_TICKS)
 
 // Constantes para threads
 #define MAX_FILA_ORDENS 1000        // Tamanho máximo da fila de ordens
@@ -57,6 +100,171 @@
 #define MAX_TENTATIVAS_THREAD 3     // Máximo de tentativas para criar thread
 #define MAX_OPORTUNIDADES 50        // Máximo de oportunidades de arbitragem
 #define MAX_LOG_ENTRIES 10000       // Máximo de entradas de log
+#define MAX_EXECUTORES 8            // Máximo de threads executoras (shards de ações)
+#define TAMANHO_MAX_LOTE_EXECUTOR 32 // Máximo de ordens retiradas da fila por lote
+// Faixas do histograma de tamanho de lote (1, 2-3, 4-7, ...) = floor(log2(TAMANHO_MAX_LOTE_EXECUTOR)) + 1
+#define NUM_FAIXAS_LOTE (1 + (TAMANHO_MAX_LOTE_EXECUTOR >= 2) + (TAMANHO_MAX_LOTE_EXECUTOR >= 4) + \
+                         (TAMANHO_MAX_LOTE_EXECUTOR >= 8) + (TAMANHO_MAX_LOTE_EXECUTOR >= 16) + \
+                         (TAMANHO_MAX_LOTE_EXECUTOR >= 32) + (TAMANHO_MAX_LOTE_EXECUTOR >= 64) + \
+                         (TAMANHO_MAX_LOTE_EXECUTOR >= 128) + (TAMANHO_MAX_LOTE_EXECUTOR >= 256))
+#define MODO_ESCALONADOR_ESTATICO 0 // Cada executor processa apenas suas ações
+#define MODO_ESCALONADOR_ROUBO 1    // Executores ociosos roubam ações prontas
+
+// Constantes do gerador de números aleatórios (xoshiro256** por thread)
+#define ALEATORIO_MAX 0x7FFFFFFF           // Maior valor de aleatorio_proximo() (igual ao RAND_MAX da glibc)
+#define FLUXO_ALEATORIO_PRINCIPAL 0        // Thread principal de cada processo
+#define FLUXO_ALEATORIO_TRADER 1           // + trader_id
+#define FLUXO_ALEATORIO_EXECUTOR 64        // + executor_id
+#define FLUXO_ALEATORIO_PRICE_UPDATER 128
+#define FLUXO_ALEATORIO_ARBITRAGEM 129
+#define FLUXO_ALEATORIO_DETECTOR 130
+#define FLUXO_ALEATORIO_AUTOMATICO 1024    // Threads sem fluxo próprio: numeradas no primeiro uso
+
+// Constantes para simulação de eventos discretos (relógio virtual)
+#define INICIO_PREGAO_SIMULADO 1704200400LL // 02/01/2024 10:00 (BRT): horário zero do relógio virtual
+#define DURACAO_SESSAO_SIMULADA 300         // 5 minutos, como a sessão com threads
+#define DURACAO_PREGAO_SIMULADO 25200       // Pregão completo (10:00-17:00)
+#define SEMENTE_SIMULACAO_PADRAO 42
+#define EVENTO_SIM_TRADER 0      // Trader decide e envia uma ordem (id = trader)
+#define EVENTO_SIM_EXECUTOR 1    // Executor termina o lote em processamento e retira o próximo
+#define EVENTO_SIM_PRECO 2       // Price updater aplica as execuções pendentes
+#define EVENTO_SIM_VARIACAO 3    // Variação periódica de mercado
+#define EVENTO_SIM_ARBITRAGEM 4  // Arbitrage monitor (id 1: preços novos, 0: ciclo periódico)
+#define EVENTO_SIM_DETECTOR 5    // Ciclo do detector de arbitragem
+#define EVENTO_SIM_FIM 6         // Fim da sessão simulada
+#define EVENTO_SIM_REPLAY 7      // Ticks gravados que vencem no instante (replay)
+
+// Evento agendado no relógio virtual
+typedef struct {
+    long long instante_ns;
+    unsigned long long sequencia; // Desempate: eventos no mesmo instante saem na ordem de agendamento
+    int tipo;
+    int id;
+} EventoSimulacao;
+
+// Fila de prioridade de eventos (heap mínimo por instante e sequência)
+typedef struct {
+    EventoSimulacao* eventos;
+    int tamanho;
+    int capacidade;
+    unsigned long long proxima_sequencia;
+} FilaEventosSimulacao;
+
+// Resultado de uma sessão simulada
+typedef struct {
+    long long eventos_processados;
+    int ordens_enviadas;
+    int ordens_aceitas;
+    int ordens_rejeitadas;
+    int negocios;
+    int acoes_negociadas;          // Ações com ao menos um negócio (livros exercitados)
+    int atualizacoes_preco;
+    int ciclos_arbitragem;
+    int sessoes_traders;
+    long long ticks_replay;        // Ticks gravados aplicados (backtest)
+    int duracao_virtual_s;
+    double tempo_real_ms;
+    unsigned long long assinatura; // Hash do estado final (preços, saldos, carteiras, volumes)
+    int posicoes_negativas;        // Saldos ou carteiras negativos ao fim (deve ser 0)
+} ResultadoSimulacao;
+
+// Estatísticas de janela deslizante (atualização O(1) por valor)
+// Guarda os últimos JANELA_ESTATISTICAS valores num anel e mantém média e
+// variância (Welford com substituição do valor que sai), mínimo e máximo
+// (deques monotônicos de posições) e uma média móvel exponencial.
+#define JANELA_ESTATISTICAS 100          // Valores na janela (como o antigo histórico de 100 preços)
+#define PERIODO_MEDIA_EXPONENCIAL 20     // Período da EMA (alfa = 2 / (período + 1))
+#define RECALCULO_ESTATISTICAS 10000     // Recalcula média e variância do zero a cada N valores
+
+typedef struct {
+    double valores[JANELA_ESTATISTICAS];  // Anel: posição p fica em valores[p % JANELA]
+    long long total;                       // Valores já inseridos (posição do próximo)
+    int tamanho;                           // Valores na janela (até JANELA_ESTATISTICAS)
+    double media;
+    double m2;                             // Soma dos quadrados dos desvios (Welford)
+    double ema;
+    double alfa_ema;
+    long long deque_minimo[JANELA_ESTATISTICAS]; // Posições com valores crescentes
+    long long deque_maximo[JANELA_ESTATISTICAS]; // Posições com valores decrescentes
+    int inicio_minimo, tamanho_minimo;
+    int inicio_maximo, tamanho_maximo;
+} EstatisticasJanela;
+
+// Matriz de correlação deslizante entre ações
+// A cada amostra (um preço de cada ação, tirada no fim de cada rodada de
+// variação de mercado) entra o vetor de retornos desde a amostra anterior e
+// sai o mais antigo da janela; as somas de retornos e de produtos cruzados
+// são atualizadas por linha (laços contíguos, vetorizáveis) em O(n²) por
+// amostra, e a correlação de qualquer par vira uma leitura O(1).
+// Os produtos ficam no triângulo superior (com diagonal) empacotado por linha.
+#define JANELA_CORRELACAO 100        // Amostras na janela
+#define MIN_AMOSTRAS_CORRELACAO 20   // Abaixo disso a correlação é 0 (como antes)
+#define RECALCULO_CORRELACAO 10000   // Recalcula as somas do zero a cada N amostras
+
+typedef struct {
+    int num_ativos;
+    int janela;
+    long long total_amostras;    // Amostras de retorno já inseridas
+    int tamanho;                 // Amostras na janela
+    int tem_precos_anteriores;
+    double* precos_anteriores;   // [num_ativos]: última amostra de preços
+    double* retornos_novos;      // [num_ativos]: amostra em inserção
+    double* retornos;            // [janela][num_ativos]: anel de vetores de retorno
+    double* somas;               // [num_ativos]: soma dos retornos na janela
+    double* produtos;            // Triângulo superior: soma de r_i * r_j (j >= i)
+} MatrizCorrelacao;
+
+// Sinais estatísticos de pares (z-score do spread)
+// Por par, uma janela deslizante de log-preços (x da ação 1, y da ação 2)
+// com as somas Sx, Sy, Sxx, Syy, Sxy mantidas a cada amostra. A regressão
+// x = alfa + hedge·y da janela dá o hedge ratio, e o spread da amostra nova
+// (x - alfa - hedge·y) dividido pelo desvio dos resíduos é o z-score, tudo
+// em O(1) por amostra. O par só sinaliza quando o z-score cruza um limiar:
+// entra acima de +entrada ou abaixo de -entrada, sai quando volta para
+// dentro de ±saída (histerese: não fica entrando e saindo em torno do limiar).
+// Os log-preços são guardados relativos ao primeiro preço do par, o que
+// mantém as somas pequenas e evita cancelamento nas variâncias.
+#define JANELA_PARES_ZSCORE 100      // Amostras na janela de cada par
+#define MIN_AMOSTRAS_ZSCORE 20       // Antes disso o par não sinaliza
+#define RECALCULO_ZSCORE 10000       // Recalcula as somas do zero a cada N amostras
+#define ZSCORE_ENTRADA_PADRAO 2.0
+#define ZSCORE_SAIDA_PADRAO 0.5
+#define MAX_PARES_ZSCORE 32
+
+#define SINAL_PAR_NEUTRO 0           // Sem posição (ou saída da posição)
+#define SINAL_PAR_VENDER_SPREAD 1    // z > +entrada: vender ação 1, comprar ação 2
+#define SINAL_PAR_COMPRAR_SPREAD -1  // z < -entrada: comprar ação 1, vender ação 2
+
+typedef struct {
+    int acao1;
+    int acao2;
+    double base1, base2;         // Log do primeiro preço de cada ação
+    double x[JANELA_PARES_ZSCORE];
+    double y[JANELA_PARES_ZSCORE];
+    int tamanho;                 // Amostras na janela
+    long long total_amostras;
+    double sx, sy, sxx, syy, sxy;
+    double hedge;                // Último hedge ratio (0 antes de MIN_AMOSTRAS_ZSCORE)
+    double spread;               // Último resíduo, em log (~ fração do preço)
+    double zscore;
+    int posicao;                 // SINAL_PAR_*
+} ParZscore;
+
+typedef struct {
+    int num_pares;
+    double entrada;
+    double saida;
+    ParZscore pares[MAX_PARES_ZSCORE];
+} MotorPares;
+
+typedef struct {
+    int par;                     // Índice no motor
+    int tipo;                    // Nova posição (SINAL_PAR_NEUTRO: saída)
+    int anterior;                // Posição antes do cruzamento
+    double zscore;
+    double hedge;
+    double spread;
+} SinalPar;
 
 // Estruturas globais para threads
 typedef struct {
@@ -67,45 +275,236 @@ typedef struct {
 } EstadoMercado;
 
 // Estruturas de dados
+// Ação: os campos lidos a cada ordem, negócio e varredura de preços ficam
+// juntos no início (bloco quente de 60 bytes), seguidos dos nomes, estatísticas
+// e histórico, raramente lidos (bloco frio). A ação é alinhada a uma linha de
+// cache, então o bloco quente ocupa uma única linha.
+// Antes os preços vinham depois dos 100 bytes de nome e setor.
+// O histórico de preços (estatisticas) é atualizado a cada novo preço, com
+// o mutex da ação, e fica na memória compartilhada junto com a ação.
+// Preço atual, anterior e variação são publicados juntos sob um seqlock
+// (publicar_preco_acao, com o mutex da ação); quem só lê usa ler_preco_acao,
+// sem lock, e nunca vê um preço novo com a variação antiga.
 typedef struct {
+    // Bloco quente
+    preco_t preco_atual;
+    preco_t preco_anterior;
+    preco_t preco_maximo;
+    preco_t preco_minimo;
+    preco_t tamanho_tick; // Menor variação de preço da ação no livro
+    double variacao;
+    int volume_negociado;
+    int num_operacoes;
+    unsigned int sequencia_preco; // Seqlock de preco_atual/preco_anterior/variacao (ímpar: em escrita)
+    // Bloco frio
     char nome[MAX_NOME];
     char setor[MAX_NOME];
-    double preco_atual;
-    double preco_anterior;
-    double preco_maximo;
-    double preco_minimo;
-    double variacao;
     double volatilidade;
-    int volume_negociado;
     int volume_diario;
     int volume_total;
-    int num_operacoes;
     double variacao_diaria;
     double variacao_semanal;
     double variacao_mensal;
-    double historico_precos[30];
-    int indice_historico;
+    EstatisticasJanela estatisticas; // Janela dos últimos preços (em reais)
     pthread_mutex_t mutex;
-} Acao;
+} __attribute__((aligned(TAMANHO_CACHE_LINE))) Acao;
+
+// Falha a compilação se o bloco quente da ação passar de uma linha de cache
+typedef char verificar_bloco_quente_acao[(offsetof(Acao, nome) <= TAMANHO_CACHE_LINE) ? 1 : -1];
+
+// Cópia consistente do preço publicado de uma ação
+typedef struct {
+    preco_t preco_atual;
+    preco_t preco_anterior;
+    double variacao;
+} InstantaneoPreco;
 
 typedef struct {
     int id;
     char nome[MAX_NOME];
-    double saldo;
+    preco_t saldo;
     int acoes_possuidas[MAX_ACOES];
+    // Reservas das ordens aceitas que ainda podem negociar (em repouso no livro):
+    // novas ordens só usam saldo - saldo_reservado e acoes_possuidas - acoes_reservadas
+    preco_t saldo_reservado;
+    int acoes_reservadas[MAX_ACOES];
     pthread_mutex_t mutex;
 } Trader;
 
+// Ordem: registro compacto de 32 bytes (duas ordens por linha de cache).
+// Campos em ordem decrescente de tamanho para não haver preenchimento;
+// trader e ação cabem em 16 bits (MAX_TRADERS e MAX_ACOES são pequenos).
 typedef struct {
+    preco_t preco;
+    time_t timestamp;
     int id;
+    int quantidade;
+    short trader_id;
+    short acao_id;
+    char tipo;   // 'C' para compra, 'V' para venda
+    char status; // 0: pendente, 1: executada, 2: cancelada, 3: em repouso no livro
+} Ordem;
+
+// Falha a compilação se o layout da ordem deixar de ter 32 bytes
+typedef char verificar_tamanho_ordem[(sizeof(Ordem) == 32) ? 1 : -1];
+
+// Pool de ordens em blocos (slabs) com lista livre
+// Os blocos são alocados sob demanda (ORDENS_POR_SLAB ordens de uma vez, sem
+// malloc por ordem) e nunca movem, então um Ordem* obtido continua válido.
+// As ordens são endereçadas por índice global e por handle: o handle leva a
+// geração do slot, que muda a cada liberação, e detecta handles obsoletos.
+// Ordens executadas ou canceladas voltam ao pool (o executor retira as
+// pendentes), então percorrer o pool só visita ordens vivas.
+// No modo compartilhado (versão processos) cada bloco é um segmento de
+// memória compartilhada; o pool guarda só os ids dos segmentos e cada
+// processo anexa os blocos que ainda não conhece na primeira consulta.
+typedef unsigned long long HandleOrdem; // Geração (32 bits altos) | índice (32 bits baixos)
+#define HANDLE_ORDEM_INVALIDO 0ULL
+
+typedef struct {
+    Ordem ordem;
+    unsigned int geracao;  // Começa em 1 e avança a cada liberação
+    int proxima_livre;     // Próximo slot livre (-1 no fim, -2 se o slot está ocupado)
+} SlotOrdem;
+
+typedef struct {
+    pthread_mutex_t mutex;             // Protege alocação, liberação e criação de blocos
+    int compartilhado;                 // 1: blocos em memória compartilhada
+    int num_slabs;
+    int limite;                        // Slots já usados alguma vez (limite de iteração)
+    int vivas;                         // Ordens alocadas no momento
+    int livre;                         // Início da lista livre (-1 vazia)
+    int slab_shm_ids[MAX_SLABS_ORDENS];  // Segmentos dos blocos (modo compartilhado)
+    SlotOrdem* slabs[MAX_SLABS_ORDENS];  // Endereços dos blocos (modo local)
+} PoolOrdens;
+
+// Ordem em repouso no livro de ofertas
+typedef struct OrdemLivro {
+    int ordem_id;
     int trader_id;
+    char tipo;
+    preco_t preco;
+    int quantidade; // Quantidade ainda não executada
+    struct OrdemLivro* proxima;
+} OrdemLivro;
+
+// Nível de preço do livro (FIFO de ordens ao mesmo preço)
+typedef struct NivelPreco {
+    preco_t preco;
+    int quantidade_total;
+    int num_ordens;
+    OrdemLivro* primeira;
+    OrdemLivro* ultima;
+    struct NivelPreco* proximo;
+} NivelPreco;
+
+// Livro de ofertas de uma ação (prioridade preço-tempo)
+typedef struct {
+    int acao_id;
+    preco_t tamanho_tick;
+    NivelPreco* compras; // Do maior para o menor preço
+    NivelPreco* vendas;  // Do menor para o maior preço
+    int ordens_em_repouso;
+    long negocios_realizados;
+    long quantidade_negociada;
+    pthread_mutex_t mutex;
+} LivroOrdens;
+
+// Negócio gerado pelo casamento de duas ordens
+typedef struct {
     int acao_id;
-    char tipo; // 'C' para compra, 'V' para venda
-    double preco;
+    int ordem_compra_id;
+    int ordem_venda_id;
+    int comprador_id;
+    int vendedor_id;
+    preco_t preco;
     int quantidade;
-    time_t timestamp;
-    int status; // 0: pendente, 1: executada, 2: cancelada
-} Ordem;
+} Negocio;
+
+typedef void (*CallbackNegocio)(const Negocio* negocio, void* contexto);
+
+// Índice de ordens por id (hash com endereçamento aberto)
+#define CAPACIDADE_MINIMA_INDICE_ORDENS 64
+
+typedef struct {
+    int ordem_id; // -1: entrada vazia
+    int slot;     // Slot da ordem no pool do livro
+} EntradaIndiceOrdens;
+
+typedef struct {
+    EntradaIndiceOrdens* entradas;
+    int capacidade; // Potência de dois
+    int quantidade;
+} IndiceOrdens;
+
+// Índice de adjacência ação -> pares monitorados (monitor de arbitragem)
+// Os pares são os das ações do mesmo grupo (setor) mais os pares
+// relacionados configurados, sem repetição; para cada ação, a lista dos
+// pares de que participa fica contígua (formato CSR). A cada rodada só os
+// pares das ações cujo preço mudou desde a rodada anterior são reavaliados.
+typedef struct {
+    int acao1; // acao1 < acao2
+    int acao2;
+} ParAcoes;
+
+typedef struct {
+    int num_acoes;
+    int num_pares;
+    ParAcoes* pares;           // [num_pares], ordenados por (acao1, acao2)
+    int* inicio_adjacencia;    // [num_acoes + 1]: pares da ação i em adjacencia[inicio[i]..inicio[i+1])
+    int* adjacencia;           // [2 * num_pares]: índices em pares
+    preco_t* ultimos_precos;   // [num_acoes]: preços vistos na rodada anterior
+    unsigned int* marcas;      // [num_pares]: época em que o par entrou na rodada
+    unsigned int epoca;
+    int* alterados;            // [num_pares]: pares a reavaliar na rodada
+} IndicePares;
+
+// Livro de ofertas indexado por tick (níveis contíguos em array)
+#define NIVEIS_LIVRO_TICKS 4096                       // Faixa contígua: ±2048 ticks da referência
+#define PALAVRAS_BITMAP_TICKS (NIVEIS_LIVRO_TICKS / 64) // Uma palavra de 64 bits por 64 níveis
+#define CAPACIDADE_INICIAL_ORDENS_TICKS 1024          // Ordens em repouso antes de crescer o pool
+
+// Ordem em repouso no livro por ticks (FIFO intrusiva por índice no pool)
+typedef struct {
+    int ordem_id;
+    int trader_id;
+    int quantidade;
+    int nivel;    // Índice do nível (-1: slot livre)
+    int anterior; // Ordem anterior no nível (-1: primeira)
+    int proxima;  // Próxima ordem no nível ou no pool livre (-1: fim)
+    char tipo;
+} OrdemTicks;
+
+// Nível de preço do livro por ticks
+typedef struct {
+    int primeira;
+    int ultima;
+    int quantidade_total;
+    int num_ordens;
+} NivelTicks;
+
+typedef struct {
+    int acao_id;
+    preco_t tamanho_tick;
+    preco_t preco_base;      // Preço do nível 0 (a referência fica no nível central)
+    NivelTicks niveis[NIVEIS_LIVRO_TICKS];
+    // Bitmaps de níveis não vazios; o resumo marca as palavras não vazias
+    unsigned long long resumo_compras;
+    unsigned long long resumo_vendas;
+    unsigned long long bitmap_compras[PALAVRAS_BITMAP_TICKS];
+    unsigned long long bitmap_vendas[PALAVRAS_BITMAP_TICKS];
+    OrdemTicks* ordens; // Pool de ordens em repouso
+    int capacidade_ordens;
+    int livre;          // Primeiro slot livre do pool (-1: pool cheio)
+    IndiceOrdens indice;       // Id da ordem -> slot no pool (ordens da faixa contígua)
+    LivroOrdens fora_da_faixa; // Preços fora da faixa contígua
+    // Contadores da faixa contígua (fora_da_faixa mantém os seus)
+    int ordens_em_repouso;
+    long negocios_realizados;
+    long quantidade_negociada;
+    long autonegociacoes_evitadas; // Ordens rejeitadas por cruzar com o próprio trader
+    pthread_mutex_t mutex;
+} LivroTicks;
 
 // Estrutura para fila de ordens (após definição de Ordem)
 typedef struct {
@@ -118,6 +517,175 @@ typedef struct {
     pthread_cond_t cond_nao_cheia;
 } FilaOrdens;
 
+// Fila lock-free MPSC (vários traders produzem, um executor consome)
+#define CAPACIDADE_FILA_LOCKFREE 1024 // Potência de 2 >= MAX_FILA_ORDENS
+
+typedef struct {
+    unsigned long sequencia; // Número de sequência do slot (protocolo de publicação)
+    Ordem ordem;
+} SlotFilaOrdens;
+
+typedef struct {
+    // inicio e fim em cache lines separadas para evitar false sharing
+    unsigned long fim __attribute__((aligned(TAMANHO_CACHE_LINE)));    // Escrito pelos produtores
+    unsigned long inicio __attribute__((aligned(TAMANHO_CACHE_LINE))); // Escrito pelo consumidor
+    SlotFilaOrdens slots[CAPACIDADE_FILA_LOCKFREE] __attribute__((aligned(TAMANHO_CACHE_LINE)));
+} FilaOrdensLockFree;
+
+// Estratégias de espera dos consumidores do pipeline
+#define ESTRATEGIA_ESPERA_BLOQUEIO 0  // pthread_cond
+#define ESTRATEGIA_ESPERA_SPIN 1      // Laço ocupado com pause
+#define ESTRATEGIA_ESPERA_SPIN_PARK 2 // Spin limitado e depois futex
+
+// Evento de notificação entre estágios do pipeline
+typedef struct {
+    unsigned int sequencia; // Palavra do futex: incrementada a cada notificação
+    int esperando;          // Threads bloqueadas no evento (evita syscall sem esperas)
+    pthread_mutex_t mutex;  // Usados apenas pela estratégia de bloqueio
+    pthread_cond_t cond;
+} __attribute__((aligned(TAMANHO_CACHE_LINE))) EventoNotificacao;
+
+// Logger assíncrono: registros binários de tamanho fixo em anéis por thread.
+// Os produtores só copiam o registro; uma thread de fundo formata o texto
+#define CAPACIDADE_ANEL_LOG 16384 // Registros por thread (potência de 2)
+#define MAX_ANEIS_LOG 128         // Threads produtoras distintas
+#define TAMANHO_TEXTO_LOG 87     // Completa o registro em 128 bytes
+
+#define REGISTRO_LOG_EVENTO 0          // texto: mensagem de log_evento()
+#define REGISTRO_LOG_ORDEM_FILA 1      // extra: shard de destino
+#define REGISTRO_LOG_EXECUTADA 2       // texto: nome da ação
+#define REGISTRO_LOG_SEM_SALDO 3       // texto: nome da ação
+#define REGISTRO_LOG_SEM_ACOES 4       // texto: nome da ação
+#define REGISTRO_LOG_CANCELADA 5
+#define REGISTRO_LOG_NEGOCIO 6         // trader_id: comprador, extra: vendedor, texto: nome da ação
+
+typedef struct {
+    long long timestamp_ns; // CLOCK_REALTIME no momento do registro
+    preco_t preco;
+    int tipo;               // REGISTRO_LOG_*
+    int ordem_id;
+    int trader_id;
+    int acao_id;
+    int quantidade;
+    int extra;
+    char lado;              // 'C' ou 'V'
+    char texto[TAMANHO_TEXTO_LOG];
+} RegistroLog; // 128 bytes: duas cache lines
+
+typedef char verificar_tamanho_registro_log[(sizeof(RegistroLog) == 128) ? 1 : -1];
+
+typedef struct {
+    // Produtor (dono do anel) e consumidor (thread de fundo) em cache lines separadas
+    unsigned long fim __attribute__((aligned(TAMANHO_CACHE_LINE)));
+    unsigned long inicio __attribute__((aligned(TAMANHO_CACHE_LINE)));
+    RegistroLog registros[CAPACIDADE_ANEL_LOG] __attribute__((aligned(TAMANHO_CACHE_LINE)));
+} AnelLog;
+
+// Histórico de ticks: cada mudança de preço vira um registro binário de
+// tamanho fixo, acrescentado ao fim do arquivo (cabeçalho + registros).
+// Os registros se acumulam num buffer e vão para o arquivo num único write()
+// com O_APPEND, então processos com o mesmo arquivo não intercalam registros.
+#define CAPACIDADE_BUFFER_TICKS 1024 // Registros por write() (40 KB)
+#define MAGICA_HISTORICO_TICKS "LPTICKS"
+#define VERSAO_HISTORICO_TICKS 1
+#define TAMANHO_SIMBOLO_TICK 8
+
+#define MOTIVO_TICK_EXECUCAO 0   // Média ponderada com o preço executado
+#define MOTIVO_TICK_VARIACAO 1   // Variação periódica de mercado
+#define MOTIVO_TICK_NOTICIA 2    // Notícia de mercado simulada
+#define MOTIVO_TICK_ARBITRAGEM 3 // Impacto de arbitragem executada
+#define MOTIVO_TICK_ABERTURA 4   // Preço de abertura do pregão
+#define NUM_MOTIVOS_TICK 5
+
+typedef struct {
+    long long instante_ns;  // relogio_mercado_ns() (virtual na simulação)
+    preco_t preco_anterior;
+    preco_t preco_novo;
+    char simbolo[TAMANHO_SIMBOLO_TICK];
+    unsigned short acao_id;
+    unsigned char motivo;   // MOTIVO_TICK_*
+    unsigned char reservado[5];
+} RegistroTick; // 40 bytes
+
+typedef char verificar_tamanho_registro_tick[(sizeof(RegistroTick) == 40) ? 1 : -1];
+
+typedef struct {
+    char magica[8];             // MAGICA_HISTORICO_TICKS
+    unsigned int versao;
+    unsigned int tamanho_registro;
+    long long criado_em_ns;
+    long long reservado;
+} CabecalhoHistoricoTicks; // 32 bytes
+
+typedef struct {
+    int fd;
+    int usados;
+    long long gravados;         // Registros já escritos no arquivo
+    pthread_mutex_t mutex;
+    RegistroTick buffer[CAPACIDADE_BUFFER_TICKS];
+} GravadorTicks;
+
+typedef struct {
+    FILE* arquivo;
+    CabecalhoHistoricoTicks cabecalho;
+    long long total;            // Registros completos no arquivo
+    long long lidos;
+} LeitorTicks;
+
+// Replay de um histórico de ticks gravado: o arquivo é mapeado (mmap) e os
+// registros são lidos direto do mapeamento, em sequência; as páginas já
+// consumidas são devolvidas ao sistema, então arquivos maiores que a memória
+// passam em fluxo. Os ticks entram no price updater no lugar da variação
+// aleatória, no ritmo gravado (velocidade 1), acelerados ou o mais rápido
+// possível (velocidade 0); na simulação seguem o relógio virtual.
+#define LOTE_REPLAY_TICKS 256              // Máximo de ticks aplicados por rodada do price updater
+#define DESCARTE_REPLAY_BYTES (16 << 20)   // Devolve as páginas lidas a cada 16 MB
+
+typedef struct {
+    int fd;
+    void* mapa;
+    size_t tamanho_mapa;
+    const RegistroTick* registros; // Logo após o cabeçalho, dentro do mapa
+    long long total;
+    long long proximo;             // Índice do próximo tick
+    long long descartado_ate;      // Bytes do mapa já devolvidos
+    double velocidade;             // 0: máxima velocidade
+    long long primeiro_instante_ns;
+    long long inicio_real_ns;      // Relógio monotônico no primeiro tick aplicado
+    long long fim_real_ns;
+    long long aplicados;
+    long long ignorados;           // Símbolo que não existe no sistema
+} FonteReplay;
+
+// Barras OHLCV por ação, agregadas incrementalmente
+// Cada mudança de preço e cada negócio entra, em O(1), na barra corrente de
+// cada período (1 s, 1 min, 5 min); quando o instante passa do fim da barra
+// abre-se a próxima no anel, e a mais antiga sai. Intervalos sem eventos não
+// geram barras. Os instantes são de relogio_mercado_ns() (virtuais na
+// simulação).
+#define PERIODO_BARRA_1S 0
+#define PERIODO_BARRA_1MIN 1
+#define PERIODO_BARRA_5MIN 2
+#define NUM_PERIODOS_BARRAS 3
+#define BARRAS_RETIDAS 512   // Barras guardadas por ação e período (8,5 min de barras de 1 s)
+
+typedef struct {
+    long long inicio_ns;     // Início do intervalo (múltiplo do período)
+    preco_t abertura;
+    preco_t maxima;
+    preco_t minima;
+    preco_t fechamento;
+    long long volume;        // Ações negociadas no intervalo
+    int negocios;
+    int atualizacoes;        // Mudanças de preço no intervalo
+} BarraOHLCV;
+
+typedef struct {
+    long long periodo_ns;
+    long long total;                    // Barras já abertas (a corrente é a total - 1)
+    BarraOHLCV barras[BARRAS_RETIDAS];  // Anel: barra k fica em barras[k % BARRAS_RETIDAS]
+} SerieBarras;
+
 typedef struct {
     int id;
     char nome[MAX_NOME];
@@ -146,14 +714,14 @@ typedef struct {
 typedef struct {
     Acao acoes[MAX_ACOES];
     Trader traders[MAX_TRADERS];
-    Ordem ordens[MAX_ORDENS];
+    PoolOrdens ordens;
     Executor executor;
     int num_acoes;
     int num_traders;
-    int num_ordens;
     pthread_mutex_t mutex_geral;
     sem_t sem_ordens;
     int sistema_ativo;
+    int proximo_id_ordem; // Gerador de ids únicos (atômico; compartilhado entre processos)
 } TradingSystem;
 
 // Funções do sistema
@@ -162,7 +730,7 @@ void limpar_sistema(TradingSystem* sistema);
 
 // Funções de ações
 void inicializar_acoes(TradingSystem* sistema);
-void atualizar_preco_acao(TradingSystem* sistema, int acao_id, double novo_preco);
+void atualizar_preco_acao(TradingSystem* sistema, int acao_id, preco_t novo_preco, int motivo);
 void imprimir_estado_acoes(TradingSystem* sistema);
 
 // Funções de traders
@@ -171,9 +739,11 @@ void executar_estrategia_trader(TradingSystem* sistema, int trader_id);
 void imprimir_estado_traders(TradingSystem* sistema);
 
 // Funções de ordens
-int criar_ordem(TradingSystem* sistema, int trader_id, int acao_id, char tipo, double preco, int quantidade);
-void processar_ordem(TradingSystem* sistema, int ordem_id);
-void cancelar_ordem(TradingSystem* sistema, int ordem_id);
+HandleOrdem criar_ordem(TradingSystem* sistema, int trader_id, int acao_id, char tipo, preco_t preco, int quantidade);
+void processar_ordem(TradingSystem* sistema, HandleOrdem handle);
+int cancelar_ordem(TradingSystem* sistema, HandleOrdem handle);
+int modificar_ordem(TradingSystem* sistema, HandleOrdem handle, int nova_quantidade);
+int gerar_id_ordem(TradingSystem* sistema);
 void imprimir_ordens(TradingSystem* sistema);
 
 // Funções do executor
@@ -183,6 +753,7 @@ void imprimir_estado_executor(TradingSystem* sistema);
 
 // Funções de monitoramento
 void monitorar_arbitragem(TradingSystem* sistema);
+void registrar_par_monitorado(int acao1_id, int acao2_id);
 void detectar_arbitragem(TradingSystem* sistema);
 void registrar_oportunidade_arbitragem(int acao1_id, int acao2_id, double diferenca, double percentual);
 void verificar_condicoes_mercado(TradingSystem* sistema);
@@ -197,7 +768,7 @@ void calcular_estatisticas_execucao(TradingSystem* sistema);
 // Funções utilitárias para dados financeiros
 Ordem gerar_ordem_aleatoria(TradingSystem* sistema);
 void gerar_ordens_aleatorias(TradingSystem* sistema, int num_ordens);
-double calcular_preco_oferta_demanda(TradingSystem* sistema, int acao_id);
+preco_t calcular_preco_oferta_demanda(TradingSystem* sistema, int acao_id);
 void detectar_arbitragem_relacionadas(TradingSystem* sistema);
 int validar_ordem(TradingSystem* sistema, Ordem* ordem);
 void imprimir_ordem(Ordem* ordem, TradingSystem* sistema);
@@ -216,6 +787,13 @@ void atualizar_estatisticas_mercado(TradingSystem* sistema, Ordem* ordem);
 void resetar_estatisticas_diarias(TradingSystem* sistema);
 void simular_abertura_mercado(TradingSystem* sistema);
 void simular_fechamento_mercado(TradingSystem* sistema);
+void definir_relogio_virtual(long long instante_ns);
+int relogio_virtual_ativo();
+time_t relogio_mercado();
+long long relogio_mercado_ns();
+void publicar_preco_acao(Acao* acao, preco_t preco_atual, preco_t preco_anterior, double variacao);
+void ler_preco_acao(const Acao* acao, InstantaneoPreco* instantaneo);
+preco_t ler_preco_atual(const Acao* acao);
 
 // Estruturas para pipes
 typedef struct {
@@ -234,6 +812,8 @@ typedef struct {
     int destino_id;
     int dados_ordem;
     double valor;
+    preco_t preco;  // Preço (mensagens de ordem, negócio e atualização de preço)
+    int quantidade; // Quantidade negociada (mensagens de negócio)
     char dados_extras[100];
     time_t timestamp;
 } MensagemPipe;
@@ -248,8 +828,8 @@ void imprimir_status_pipes();
 void testar_pipes_sistema();
 
 // Funções para criar mensagens
-MensagemPipe criar_mensagem_ordem(int trader_id, int acao_id, char tipo, double preco, int quantidade);
-MensagemPipe criar_mensagem_atualizacao_preco(int acao_id, double preco_anterior, double preco_novo);
+MensagemPipe criar_mensagem_ordem(int trader_id, int acao_id, char tipo, preco_t preco, int quantidade);
+MensagemPipe criar_mensagem_atualizacao_preco(int acao_id, preco_t preco_anterior, preco_t preco_novo);
 MensagemPipe criar_mensagem_arbitragem(int acao1_id, int acao2_id, double diferenca, double percentual);
 MensagemPipe criar_mensagem_controle(int comando, int origem_id, int destino_id);
 void imprimir_mensagem(MensagemPipe* mensagem);
@@ -266,9 +846,10 @@ void simular_noticia_mercado(TradingSystem* sistema);
 void inicializar_perfis_trader();
 PerfilTrader* obter_perfil_trader(int perfil_id);
 void aplicar_perfil_trader(TradingSystem* sistema, int trader_id, int perfil_id);
-void log_ordem_trader(int trader_id, int acao_id, char tipo, double preco, int quantidade, const char* motivo);
+void log_ordem_trader(int trader_id, int acao_id, char tipo, preco_t preco, int quantidade, const char* motivo);
 void processo_trader_melhorado(int trader_id, int perfil_id);
 int gerar_intervalo_aleatorio(int min, int max);
+int escolher_acao_trader(TradingSystem* sistema, int trader_id, PerfilTrader* perfil);
 int decidir_acao_trader(TradingSystem* sistema, int trader_id, PerfilTrader* perfil);
 double calcular_probabilidade_compra(TradingSystem* sistema, int acao_id, PerfilTrader* perfil);
 double calcular_probabilidade_venda(TradingSystem* sistema, int acao_id, PerfilTrader* perfil);
@@ -277,24 +858,83 @@ double calcular_probabilidade_venda(TradingSystem* sistema, int acao_id, PerfilT
 void processo_executor_melhorado();
 int ler_ordem_pipe(int pipe_read, Ordem* ordem);
 int enviar_resultado_price_updater(int pipe_write, Ordem* ordem, int resultado);
+int sortear_tempo_processamento();
 int simular_tempo_processamento();
+int processar_ordem_executor(TradingSystem* sistema, Ordem* ordem, int tempo_processamento,
+                             CallbackNegocio callback, void* contexto);
 int decidir_aceitar_ordem(TradingSystem* sistema, Ordem* ordem);
+int reservar_ordem_trader(TradingSystem* sistema, const Ordem* ordem);
+void liberar_reserva_ordem(TradingSystem* sistema, const Ordem* ordem, int quantidade);
 double calcular_volatilidade_acao(TradingSystem* sistema, int acao_id);
 int verificar_criterios_avancados(TradingSystem* sistema, Ordem* ordem);
 void log_execucao_ordem(Ordem* ordem, int resultado, double tempo_processamento);
 void atualizar_contadores_executor(TradingSystem* sistema, int resultado);
-void executar_ordem_aceita(TradingSystem* sistema, Ordem* ordem);
+void inicializar_livros_ordens(TradingSystem* sistema);
+void liberar_livros_ordens();
+LivroTicks* obter_livro_ordens(int acao_id);
+int executar_ordem_no_livro(TradingSystem* sistema, Ordem* ordem, CallbackNegocio callback, void* contexto);
+int cancelar_ordem_no_livro(TradingSystem* sistema, const Ordem* ordem);
+int modificar_ordem_no_livro(TradingSystem* sistema, const Ordem* ordem, int nova_quantidade);
+void liquidar_negocio(TradingSystem* sistema, const Negocio* negocio, const Ordem* agressora);
+int enviar_negocio_price_updater(int pipe_write, const Negocio* negocio);
+void imprimir_livros_ordens(TradingSystem* sistema);
+
+// Funções do livro de ofertas
+void livro_inicializar(LivroOrdens* livro, int acao_id, preco_t tamanho_tick);
+void livro_liberar(LivroOrdens* livro);
+int livro_submeter_ordem(LivroOrdens* livro, const Ordem* ordem, CallbackNegocio callback, void* contexto);
+int livro_cancelar_ordem(LivroOrdens* livro, int ordem_id);
+int livro_modificar_ordem(LivroOrdens* livro, int ordem_id, int nova_quantidade);
+int livro_melhor_oferta(LivroOrdens* livro, char tipo, preco_t* preco, int* quantidade);
+void livro_imprimir(LivroOrdens* livro, const char* nome_acao, int max_niveis);
+int livro_negociar_ordem(LivroOrdens* livro, const Ordem* ordem, preco_t preco_limite, int quantidade,
+                         CallbackNegocio callback, void* contexto);
+int livro_cruza_trader(LivroOrdens* livro, char tipo, preco_t preco_limite, int trader_id, int* quantidade);
+
+// Funções do índice de ordens
+int indice_ordens_inicializar(IndiceOrdens* indice, int capacidade_inicial);
+void indice_ordens_liberar(IndiceOrdens* indice);
+int indice_ordens_reservar(IndiceOrdens* indice);
+int indice_ordens_inserir(IndiceOrdens* indice, int ordem_id, int slot);
+int indice_ordens_buscar(const IndiceOrdens* indice, int ordem_id);
+int indice_ordens_remover(IndiceOrdens* indice, int ordem_id);
+
+// Funções do índice de pares do monitor de arbitragem
+int indice_pares_construir(IndicePares* indice, int num_acoes, const int* grupos,
+                           const ParAcoes* extras, int num_extras);
+void indice_pares_liberar(IndicePares* indice);
+int indice_pares_da_acao(const IndicePares* indice, int acao_id, const int** pares);
+int indice_pares_alterados(IndicePares* indice, const preco_t* precos, const int** pares);
+
+// Funções do pool de ordens
+int pool_ordens_inicializar(PoolOrdens* pool, int compartilhado);
+void pool_ordens_liberar(PoolOrdens* pool);
+HandleOrdem pool_ordens_alocar(PoolOrdens* pool, const Ordem* ordem, int* indice);
+int pool_ordens_liberar_ordem(PoolOrdens* pool, HandleOrdem handle);
+int pool_ordens_retirar(PoolOrdens* pool, HandleOrdem handle, Ordem* ordem);
+Ordem* pool_ordens_obter(PoolOrdens* pool, HandleOrdem handle);
+Ordem* pool_ordens_slot(PoolOrdens* pool, int indice);
+HandleOrdem pool_ordens_handle(PoolOrdens* pool, int indice);
+int pool_ordens_limite(const PoolOrdens* pool);
+int pool_ordens_vivas(const PoolOrdens* pool);
+
+// Funções do livro de ofertas por ticks
+int livro_ticks_inicializar(LivroTicks* livro, int acao_id, preco_t preco_referencia, preco_t tamanho_tick);
+void livro_ticks_liberar(LivroTicks* livro);
+int livro_ticks_submeter_ordem(LivroTicks* livro, const Ordem* ordem, CallbackNegocio callback, void* contexto);
+int livro_ticks_cancelar_ordem(LivroTicks* livro, int ordem_id);
+int livro_ticks_modificar_ordem(LivroTicks* livro, int ordem_id, int nova_quantidade);
+int livro_ticks_melhor_oferta(LivroTicks* livro, char tipo, preco_t* preco, int* quantidade);
+void livro_ticks_imprimir(LivroTicks* livro, const char* nome_acao, int max_niveis);
 
 // Funções para price updater melhorado
 void processo_price_updater_melhorado();
 int receber_notificacao_transacao(int pipe_read, Ordem* ordem, int* resultado);
-double calcular_preco_media_ponderada(double preco_atual, double preco_transacao, int volume);
-int validar_preco(double preco, double preco_anterior);
-void atualizar_estatisticas_acao(TradingSystem* sistema, int acao_id, double novo_preco);
-void enviar_atualizacao_arbitragem(int pipe_write, int acao_id, double preco_anterior, double novo_preco);
-void salvar_historico_precos(TradingSystem* sistema);
-void log_atualizacao_preco(int acao_id, double preco_anterior, double novo_preco, const char* motivo);
-void inicializar_arquivo_historico();
+preco_t calcular_preco_media_ponderada(preco_t preco_atual, preco_t preco_transacao, int volume);
+int validar_preco(preco_t preco, preco_t preco_anterior);
+void atualizar_estatisticas_acao(TradingSystem* sistema, int acao_id, preco_t novo_preco);
+void enviar_atualizacao_arbitragem(int pipe_write, int acao_id, preco_t preco_anterior, preco_t novo_preco);
+void log_atualizacao_preco(TradingSystem* sistema, int acao_id, preco_t preco_anterior, preco_t novo_preco, int motivo);
 
 // Funções para threads
 void inicializar_estruturas_globais();
@@ -307,8 +947,156 @@ void* thread_trader_func(void* arg);
 void* thread_executor_func(void* arg);
 void* thread_price_updater_func(void* arg);
 void* thread_arbitrage_monitor_func(void* arg);
+int montar_ordem_trader(TradingSystem* sistema, int trader_id, PerfilTrader* perfil, Ordem* ordem);
+int aplicar_execucao_preco(TradingSystem* sistema, int acao_id, preco_t preco, int volume);
+int aplicar_variacao_mercado(TradingSystem* sistema);
 int adicionar_ordem_fila(Ordem ordem);
 int remover_ordem_fila(Ordem* ordem);
+int remover_ordens_fila_lote(Ordem* out, int max);
+int remover_ordens_shard_lote(int shard, Ordem* out, int max);
+void configurar_num_executores(int quantidade);
+int obter_num_executores();
+int shard_da_acao(int acao_id);
+
+// Funções da simulação de eventos discretos
+int fila_eventos_inicializar(FilaEventosSimulacao* fila, int capacidade_inicial);
+void fila_eventos_liberar(FilaEventosSimulacao* fila);
+int fila_eventos_agendar(FilaEventosSimulacao* fila, long long instante_ns, int tipo, int id);
+int fila_eventos_retirar(FilaEventosSimulacao* fila, EventoSimulacao* evento);
+int executar_simulacao(TradingSystem* sistema, unsigned long long semente, int duracao_s, ResultadoSimulacao* resultado);
+int executar_simulacao_replay(TradingSystem* sistema, unsigned long long semente, int duracao_s,
+                              FonteReplay* replay, ResultadoSimulacao* resultado);
+unsigned long long assinatura_estado_sistema(TradingSystem* sistema);
+void imprimir_resultado_simulacao(const ResultadoSimulacao* resultado);
+
+// Funções da fila lock-free de ordens
+void fila_lockfree_inicializar(FilaOrdensLockFree* fila);
+int fila_lockfree_enfileirar(FilaOrdensLockFree* fila, const Ordem* ordem);
+int fila_lockfree_desenfileirar(FilaOrdensLockFree* fila, Ordem* ordem);
+int fila_lockfree_desenfileirar_lote(FilaOrdensLockFree* fila, Ordem* ordens, int max);
+int fila_lockfree_tamanho(FilaOrdensLockFree* fila);
+
+// Funções do gerador de números aleatórios
+void aleatorio_configurar_semente(unsigned long long semente);
+unsigned long long aleatorio_configurar_semente_do_ambiente();
+unsigned long long aleatorio_obter_semente();
+void aleatorio_iniciar_fluxo(unsigned int fluxo);
+int aleatorio_fluxo_iniciado();
+int aleatorio_proximo();
+
+// Funções de estatísticas de janela deslizante
+void estatisticas_janela_inicializar(EstatisticasJanela* janela, int periodo_ema);
+void estatisticas_janela_adicionar(EstatisticasJanela* janela, double valor);
+int estatisticas_janela_tamanho(const EstatisticasJanela* janela);
+double estatisticas_janela_valor(const EstatisticasJanela* janela, int atras);
+double estatisticas_janela_media(const EstatisticasJanela* janela);
+double estatisticas_janela_variancia(const EstatisticasJanela* janela);
+double estatisticas_janela_desvio(const EstatisticasJanela* janela);
+double estatisticas_janela_volatilidade(const EstatisticasJanela* janela);
+double estatisticas_janela_minimo(const EstatisticasJanela* janela);
+double estatisticas_janela_maximo(const EstatisticasJanela* janela);
+double estatisticas_janela_ema(const EstatisticasJanela* janela);
+
+// Funções da matriz de correlação deslizante
+int matriz_correlacao_inicializar(MatrizCorrelacao* matriz, int num_ativos, int janela);
+void matriz_correlacao_liberar(MatrizCorrelacao* matriz);
+void matriz_correlacao_adicionar_amostra(MatrizCorrelacao* matriz, const double* precos);
+int matriz_correlacao_amostras(const MatrizCorrelacao* matriz);
+double matriz_correlacao_obter(const MatrizCorrelacao* matriz, int ativo1, int ativo2);
+void registrar_amostra_correlacao(TradingSystem* sistema);
+void liberar_correlacao_sistema();
+double calcular_correlacao(TradingSystem* sistema, int acao1, int acao2);
+
+// Funções dos sinais estatísticos de pares
+void motor_pares_inicializar(MotorPares* motor, double entrada, double saida);
+int motor_pares_adicionar(MotorPares* motor, int acao1, int acao2);
+int motor_pares_atualizar(MotorPares* motor, int par, preco_t preco1, preco_t preco2, SinalPar* sinal);
+const char* nome_sinal_par(int tipo);
+
+// Funções do histórico binário de ticks
+int gravador_ticks_abrir(GravadorTicks* gravador, const char* caminho);
+void gravador_ticks_registrar(GravadorTicks* gravador, const RegistroTick* registro);
+int gravador_ticks_descarregar(GravadorTicks* gravador);
+void gravador_ticks_fechar(GravadorTicks* gravador);
+int leitor_ticks_abrir(LeitorTicks* leitor, const char* caminho);
+int leitor_ticks_proximo(LeitorTicks* leitor, RegistroTick* registro);
+void leitor_ticks_fechar(LeitorTicks* leitor);
+const char* nome_motivo_tick(int motivo);
+int historico_ticks_iniciar(const char* caminho);
+const char* historico_ticks_iniciar_do_ambiente();
+int historico_ticks_ativo();
+void historico_ticks_registrar(const Acao* acao, int acao_id, preco_t preco_anterior, preco_t preco_novo, int motivo);
+void historico_ticks_descarregar();
+void historico_ticks_finalizar();
+int cabecalho_ticks_valido(const CabecalhoHistoricoTicks* cabecalho);
+
+// Funções do replay de ticks
+int replay_abrir(FonteReplay* replay, const char* caminho, double velocidade);
+void replay_fechar(FonteReplay* replay);
+const RegistroTick* replay_espiar(const FonteReplay* replay);
+const RegistroTick* replay_proximo(FonteReplay* replay);
+long long replay_duracao_ns(const FonteReplay* replay);
+int replay_aplicar_tick(TradingSystem* sistema, FonteReplay* replay, const RegistroTick* registro);
+int replay_avancar(TradingSystem* sistema, FonteReplay* replay, int max_ticks, int* ms_ate_proximo);
+int replay_concluido(const FonteReplay* replay);
+void imprimir_resultado_replay(const FonteReplay* replay);
+FonteReplay* replay_iniciar_do_ambiente();
+FonteReplay* replay_sistema();
+void replay_finalizar_sistema();
+
+// Funções das barras OHLCV
+void serie_barras_inicializar(SerieBarras* serie, long long periodo_ns);
+void serie_barras_registrar(SerieBarras* serie, long long instante_ns, preco_t preco, int quantidade);
+int serie_barras_quantidade(const SerieBarras* serie);
+int serie_barras_obter(const SerieBarras* serie, int atras, BarraOHLCV* barra);
+void barras_registrar_preco(int acao_id, preco_t preco);
+void barras_registrar_negocio(int acao_id, preco_t preco, int quantidade);
+int barras_obter(int acao_id, int periodo, int atras, BarraOHLCV* barra);
+int barras_recentes(int acao_id, int periodo, BarraOHLCV* barras, int max);
+void barras_reiniciar();
+const char* nome_periodo_barra(int periodo);
+void imprimir_barras_ohlcv(TradingSystem* sistema, int periodo);
+
+// Funções do logger assíncrono
+int log_assincrono_iniciar(FILE* destino);
+void log_assincrono_parar();
+int log_assincrono_ativo();
+void log_assincrono_aguardar();
+void log_definir_destino(FILE* destino);
+void log_registrar(RegistroLog* registro);
+void log_registrar_evento(const char* mensagem);
+void log_registrar_ordem(int tipo, const Ordem* ordem, int extra, const char* texto);
+void log_registrar_negocio(const Negocio* negocio, const char* nome_acao);
+void formatar_registro_log(const RegistroLog* registro, char* buffer, size_t tamanho);
+unsigned long log_registros_descartados();
+void configurar_nivel_log(int nivel);
+int nivel_log_por_nome(const char* nome);
+const char* nome_nivel_log(int nivel);
+void configurar_nivel_log_do_ambiente();
+
+// Funções de eventos de notificação e estratégias de espera
+void configurar_estrategia_espera(int estrategia);
+int obter_estrategia_espera();
+const char* nome_estrategia_espera(int estrategia);
+int estrategia_espera_por_nome(const char* nome);
+void evento_inicializar(EventoNotificacao* evento);
+unsigned int evento_observar(EventoNotificacao* evento);
+int evento_aguardar(EventoNotificacao* evento, unsigned int observado, int timeout_ms);
+void evento_notificar(EventoNotificacao* evento);
+void evento_notificar_todos(EventoNotificacao* evento);
+void configurar_notificacao_polling(int polling);
+int obter_notificacao_polling();
+
+// Funções do escalonador de executores com roubo de trabalho
+typedef void (*ProcessarLoteExecutor)(int executor_id, Ordem* ordens, int quantidade, void* contexto);
+void escalonador_inicializar(int num_executores, int modo, ProcessarLoteExecutor processar, void* contexto);
+int escalonador_iniciar();
+int escalonador_submeter(const Ordem* ordem);
+void escalonador_parar();
+void escalonador_obter_estatisticas(int executor_id, int* ordens, int* lotes, int* roubos);
+void escalonador_imprimir_estatisticas();
+void configurar_modo_escalonador(int modo);
+int obter_modo_escalonador();
 void parar_todas_threads();
 int verificar_retorno_pthread(int resultado, const char* operacao);
 void aguardar_threads_terminarem();
@@ -323,9 +1111,12 @@ void demonstrar_tipos_race_conditions();
 
 // Funções para detector de arbitragem
 void inicializar_estatisticas_arbitragem();
+void registrar_pares_relacionados_monitor();
 double calcular_spread(double preco1, double preco2);
 double calcular_lucro_potencial(double preco_compra, double preco_venda, int volume);
 void detectar_oportunidades_arbitragem(TradingSystem* sistema);
+void sinalizar_preco_arbitragem(int acao_id);
+int detectar_oportunidades_alteradas(TradingSystem* sistema);
 void executar_arbitragem_detector(TradingSystem* sistema, void* oportunidade);
 void processar_oportunidades_pendentes(TradingSystem* sistema);
 void exibir_estatisticas_arbitragem();
@@ -362,6 +1153,11 @@ void* iniciar_medicao_processamento(int is_process);
 void finalizar_medicao_processamento(int is_process, int order_accepted);
 void* iniciar_medicao_resposta_end_to_end(int is_process);
 void finalizar_medicao_resposta_end_to_end(int is_process);
+void registrar_tamanho_lote(int is_process, int tamanho);
+void registrar_ordens_shard(int shard, int ordens, double tempo_ocupado_ms);
+void registrar_latencia_execucao_preco(double latencia_ms);
+void registrar_latencia_preco_arbitragem(double latencia_ms, double latencia_total_ms);
+void registrar_latencia_preco_deteccao(double latencia_ms);
 void coletar_estatisticas_recursos(int is_process);
 void calcular_throughput(int is_process, double total_time_seconds);
 void calcular_metricas_mercado(TradingSystem* sistema);
@@ -4,9 +4,6 @@
 #include <unistd.h>
 #include <sys/time.h>
 
-// Declaração da função calcular_correlacao
-double calcular_correlacao(TradingSystem* sistema, int acao1, int acao2);
-
 // Estrutura para armazenar dados de oferta/demanda
 typedef struct {
     int ordens_compra;
@@ -19,6 +16,10 @@ typedef struct {
 
 static OfertaDemanda dados_mercado[MAX_ACOES];
 
+// Faixa de preço aceita para ordens geradas e validadas (R$ 10,00 a R$ 200,00)
+#define PRECO_MINIMO_ORDEM (10 * ESCALA_PRECO)
+#define PRECO_MAXIMO_ORDEM (200 * ESCALA_PRECO)
+
 
 
 // Função para gerar ordens aleatórias realistas
@@ -26,26 +27,26 @@ Ordem gerar_ordem_aleatoria(TradingSystem* sistema) {
     Ordem ordem;
     
     // Gerar trader aleatório
-    ordem.trader_id = rand() % sistema->num_traders;
+    ordem.trader_id = aleatorio_proximo() % sistema->num_traders;
     
     // Gerar ação aleatória
-    ordem.acao_id = rand() % sistema->num_acoes;
+    ordem.acao_id = aleatorio_proximo() % sistema->num_acoes;
     
     // Gerar tipo de ordem (60% compra, 40% venda)
-    ordem.tipo = (rand() % 100 < 60) ? 'C' : 'V';
+    ordem.tipo = (aleatorio_proximo() % 100 < 60) ? 'C' : 'V';
     
     // Gerar quantidade realista (100-1000 ações)
-    ordem.quantidade = 100 + (rand() % 901);
+    ordem.quantidade = 100 + (aleatorio_proximo() % 901);
     
     // Gerar preço baseado no preço atual da ação com variação realista
     Acao* acao = &sistema->acoes[ordem.acao_id];
-    double preco_atual = acao->preco_atual;
-    double variacao = (rand() % 200 - 100) / 1000.0; // ±10%
-    ordem.preco = preco_atual * (1.0 + variacao);
+    double preco_atual = PRECO_EM_REAIS(acao->preco_atual);
+    double variacao = (aleatorio_proximo() % 200 - 100) / 1000.0; // ±10%
+    ordem.preco = PRECO_DE_REAIS(preco_atual * (1.0 + variacao));
     
     // Garantir preço mínimo
-    if (ordem.preco < 10.0) ordem.preco = 10.0;
-    if (ordem.preco > 200.0) ordem.preco = 200.0;
+    if (ordem.preco < PRECO_MINIMO_ORDEM) ordem.preco = PRECO_MINIMO_ORDEM;
+    if (ordem.preco > PRECO_MAXIMO_ORDEM) ordem.preco = PRECO_MAXIMO_ORDEM;
     
     // Gerar timestamp
     ordem.timestamp = time(NULL);
@@ -60,17 +61,21 @@ Ordem gerar_ordem_aleatoria(TradingSystem* sistema) {
 void gerar_ordens_aleatorias(TradingSystem* sistema, int num_ordens) {
     printf("Gerando %d ordens aleatórias...\n", num_ordens);
     
-    for (int i = 0; i < num_ordens && sistema->num_ordens < MAX_ORDENS; i++) {
+    for (int i = 0; i < num_ordens; i++) {
         Ordem nova_ordem = gerar_ordem_aleatoria(sistema);
         
         // Validar ordem antes de adicionar
         if (validar_ordem(sistema, &nova_ordem)) {
             // Adicionar ordem ao sistema
+            nova_ordem.id = gerar_id_ordem(sistema);
             pthread_mutex_lock(&sistema->mutex_geral);
             
-            nova_ordem.id = sistema->num_ordens;
-            sistema->ordens[sistema->num_ordens] = nova_ordem;
-            sistema->num_ordens++;
+            int indice;
+            if (pool_ordens_alocar(&sistema->ordens, &nova_ordem, &indice) == HANDLE_ORDEM_INVALIDO) {
+                pthread_mutex_unlock(&sistema->mutex_geral);
+                printf("Pool de ordens sem espaço, encerrando geração\n");
+                break;
+            }
             sistema->executor.total_ordens++;
             
             pthread_mutex_unlock(&sistema->mutex_geral);
@@ -87,7 +92,7 @@ void gerar_ordens_aleatorias(TradingSystem* sistema, int num_ordens) {
 }
 
 // Função para calcular novo preço baseado em oferta/demanda
-double calcular_preco_oferta_demanda(TradingSystem* sistema, int acao_id) {
+preco_t calcular_preco_oferta_demanda(TradingSystem* sistema, int acao_id) {
     if (acao_id < 0 || acao_id >= sistema->num_acoes) {
         return sistema->acoes[acao_id].preco_atual;
     }
@@ -100,19 +105,20 @@ double calcular_preco_oferta_demanda(TradingSystem* sistema, int acao_id) {
     double pressao_venda = 0.0;
     
     // Analisar ordens pendentes
-    for (int i = 0; i < sistema->num_ordens; i++) {
-        Ordem* ordem = &sistema->ordens[i];
-        if (ordem->acao_id == acao_id && ordem->status == 0) {
+    int limite = pool_ordens_limite(&sistema->ordens);
+    for (int i = 0; i < limite; i++) {
+        Ordem* ordem = pool_ordens_slot(&sistema->ordens, i);
+        if (ordem && ordem->acao_id == acao_id && ordem->status == 0) {
             if (ordem->tipo == 'C') {
-                pressao_compra += ordem->quantidade * (ordem->preco / acao->preco_atual);
+                pressao_compra += ordem->quantidade * ((double)ordem->preco / acao->preco_atual);
                 od->ordens_compra++;
                 od->volume_compra += ordem->quantidade;
-                od->preco_medio_compra += ordem->preco;
+                od->preco_medio_compra += PRECO_EM_REAIS(ordem->preco);
             } else {
-                pressao_venda += ordem->quantidade * (acao->preco_atual / ordem->preco);
+                pressao_venda += ordem->quantidade * ((double)acao->preco_atual / ordem->preco);
                 od->ordens_venda++;
                 od->volume_venda += ordem->quantidade;
-                od->preco_medio_venda += ordem->preco;
+                od->preco_medio_venda += PRECO_EM_REAIS(ordem->preco);
             }
         }
     }
@@ -139,15 +145,15 @@ double calcular_preco_oferta_demanda(TradingSystem* sistema, int acao_id) {
     }
     
     // Adicionar componente aleatório
-    double variacao_aleatoria = (rand() % 200 - 100) / 10000.0; // ±1%
+    double variacao_aleatoria = (aleatorio_proximo() % 200 - 100) / 10000.0; // ±1%
     variacao += variacao_aleatoria;
     
     // Calcular novo preço
-    double novo_preco = acao->preco_atual * (1.0 + variacao);
+    preco_t novo_preco = PRECO_DE_REAIS(PRECO_EM_REAIS(acao->preco_atual) * (1.0 + variacao));
     
     // Garantir limites
-    if (novo_preco < 10.0) novo_preco = 10.0;
-    if (novo_preco > 200.0) novo_preco = 200.0;
+    if (novo_preco < PRECO_MINIMO_ORDEM) novo_preco = PRECO_MINIMO_ORDEM;
+    if (novo_preco > PRECO_MAXIMO_ORDEM) novo_preco = PRECO_MAXIMO_ORDEM;
     
     return novo_preco;
 }
@@ -188,14 +194,14 @@ void detectar_arbitragem_relacionadas(TradingSystem* sistema) {
                        a1->nome, a2->nome, correlacao_atual, correlacao_esperada);
                 
                 // Calcular oportunidade de arbitragem
-                double diferenca_preco = fabs(a1->preco_atual - a2->preco_atual);
-                double media_preco = (a1->preco_atual + a2->preco_atual) / 2.0;
+                double diferenca_preco = PRECO_EM_REAIS(llabs(a1->preco_atual - a2->preco_atual));
+                double media_preco = PRECO_EM_REAIS(a1->preco_atual + a2->preco_atual) / 2.0;
                 double percentual_diferenca = diferenca_preco / media_preco;
                 
                 if (percentual_diferenca > 0.05) { // 5% de diferença
                     printf("  OPORTUNIDADE: Diferença de %.2f%% entre %s (R$ %.2f) e %s (R$ %.2f)\n",
-                           percentual_diferenca * 100, a1->nome, a1->preco_atual, 
-                           a2->nome, a2->preco_atual);
+                           percentual_diferenca * 100, a1->nome, PRECO_EM_REAIS(a1->preco_atual), 
+                           a2->nome, PRECO_EM_REAIS(a2->preco_atual));
                     
                     // Sugerir ação
                     if (a1->preco_atual < a2->preco_atual) {
@@ -248,8 +254,8 @@ int validar_ordem(TradingSystem* sistema, Ordem* ordem) {
     }
     
     // Validar preço
-    if (ordem->preco < 10.0 || ordem->preco > 200.0) {
-        printf("ERRO: Preço fora do intervalo válido: R$ %.2f\n", ordem->preco);
+    if (ordem->preco < PRECO_MINIMO_ORDEM || ordem->preco > PRECO_MAXIMO_ORDEM) {
+        printf("ERRO: Preço fora do intervalo válido: R$ %.2f\n", PRECO_EM_REAIS(ordem->preco));
         return 0;
     }
     
@@ -262,11 +268,11 @@ int validar_ordem(TradingSystem* sistema, Ordem* ordem) {
     // Validar se trader tem saldo suficiente (para compras)
     if (ordem->tipo == 'C') {
         Trader* trader = &sistema->traders[ordem->trader_id];
-        double custo_total = ordem->preco * ordem->quantidade;
+        preco_t custo_total = ordem->preco * ordem->quantidade;
         
         if (trader->saldo < custo_total) {
             printf("ERRO: Saldo insuficiente. Necessário: R$ %.2f, Disponível: R$ %.2f\n", 
-                   custo_total, trader->saldo);
+                   PRECO_EM_REAIS(custo_total), PRECO_EM_REAIS(trader->saldo));
             return 0;
         }
     }
@@ -304,8 +310,8 @@ void imprimir_ordem(Ordem* ordem, TradingSystem* sistema) {
     printf("Ação: %s (ID: %d)\n", sistema->acoes[ordem->acao_id].nome, ordem->acao_id);
     printf("Tipo: %s\n", (ordem->tipo == 'C') ? "COMPRA" : "VENDA");
     printf("Quantidade: %d ações\n", ordem->quantidade);
-    printf("Preço: R$ %.2f\n", ordem->preco);
-    printf("Valor Total: R$ %.2f\n", ordem->preco * ordem->quantidade);
+    printf("Preço: R$ %.2f\n", PRECO_EM_REAIS(ordem->preco));
+    printf("Valor Total: R$ %.2f\n", PRECO_EM_REAIS(ordem->preco * ordem->quantidade));
     
     // Status da ordem
     char status_str[20];
@@ -313,6 +319,7 @@ void imprimir_ordem(Ordem* ordem, TradingSystem* sistema) {
         case 0: strcpy(status_str, "PENDENTE"); break;
         case 1: strcpy(status_str, "EXECUTADA"); break;
         case 2: strcpy(status_str, "CANCELADA"); break;
+        case 3: strcpy(status_str, "EM REPOUSO"); break;
         default: strcpy(status_str, "DESCONHECIDO"); break;
     }
     printf("Status: %s\n", status_str);
@@ -324,7 +331,7 @@ void imprimir_ordem(Ordem* ordem, TradingSystem* sistema) {
     
     // Informações adicionais do trader
     Trader* trader = &sistema->traders[ordem->trader_id];
-    printf("Saldo do Trader: R$ %.2f\n", trader->saldo);
+    printf("Saldo do Trader: R$ %.2f\n", PRECO_EM_REAIS(trader->saldo));
     printf("Ações possuídas de %s: %d\n", 
            sistema->acoes[ordem->acao_id].nome, 
            trader->acoes_possuidas[ordem->acao_id]);
@@ -343,8 +350,8 @@ void testar_funcoes_utilitarias(TradingSystem* sistema) {
     // Teste 2: Calcular preços baseados em oferta/demanda
     printf("\n2. Testando cálculo de preços por oferta/demanda...\n");
     for (int i = 0; i < sistema->num_acoes; i++) {
-        double preco_atual = sistema->acoes[i].preco_atual;
-        double novo_preco = calcular_preco_oferta_demanda(sistema, i);
+        double preco_atual = PRECO_EM_REAIS(sistema->acoes[i].preco_atual);
+        double novo_preco = PRECO_EM_REAIS(calcular_preco_oferta_demanda(sistema, i));
         printf("%s: R$ %.2f → R$ %.2f (variação: %.2f%%)\n", 
                sistema->acoes[i].nome, preco_atual, novo_preco, 
                ((novo_preco - preco_atual) / preco_atual) * 100);
@@ -363,7 +370,7 @@ void testar_funcoes_utilitarias(TradingSystem* sistema) {
     
     // Ordem inválida (preço muito alto)
     Ordem ordem_invalida = ordem_valida;
-    ordem_invalida.preco = 500.0;
+    ordem_invalida.preco = PRECO_DE_REAIS(500.0);
     validar_ordem(sistema, &ordem_invalida);
     
     // Ordem inválida (quantidade muito baixa)
@@ -400,7 +407,7 @@ void imprimir_estatisticas_mercado(TradingSystem* sistema) {
         Acao* acao = &sistema->acoes[i];
         
         printf("%s:\n", acao->nome);
-        printf("  Preço atual: R$ %.2f\n", acao->preco_atual);
+        printf("  Preço atual: R$ %.2f\n", PRECO_EM_REAIS(acao->preco_atual));
         printf("  Ordens de compra: %d (volume: %d)\n", od->ordens_compra, od->volume_compra);
         printf("  Ordens de venda: %d (volume: %d)\n", od->ordens_venda, od->volume_venda);
         